@@ -2,6 +2,7 @@
 #include "HelloWorldScene.h"
 #include "AppDelegate.h"
 #include "TitleScene.h"      // ⳡ
+#include "Core/JobSystem.h"
 
 // #define USE_AUDIO_ENGINE 1
 // #define USE_SIMPLE_AUDIO_ENGINE 1
@@ -36,6 +37,7 @@ AppDelegate::~AppDelegate()
 #elif USE_SIMPLE_AUDIO_ENGINE
     SimpleAudioEngine::end();
 #endif
+    JobSystem::destroyInstance();
 }
 
 // if you want a different context, modify the value of glContextAttrs
@@ -95,6 +97,9 @@ bool AppDelegate::applicationDidFinishLaunching() {
 
     register_all_packages();
 
+    // ˵AI·̯߳
+    JobSystem::getInstance()->start();
+
     // create a scene. it's an autorelease object
     auto scene = TitleScene::createScene();
 
@@ -0,0 +1,110 @@
+#include "AnimationClipCache.h"
+#include "Core/HitWindowTable.h"
+
+USING_NS_CC;
+
+AnimationClipCache* AnimationClipCache::s_instance = nullptr;
+
+AnimationClipCache* AnimationClipCache::getInstance()
+{
+    if (!s_instance)
+        s_instance = new (std::nothrow) AnimationClipCache();
+    return s_instance;
+}
+
+void AnimationClipCache::destroyInstance()
+{
+    CC_SAFE_DELETE(s_instance);
+}
+
+AnimationClipCache::~AnimationClipCache()
+{
+    for (auto& record : _clips)
+    {
+        CC_SAFE_RELEASE(record.animation);
+    }
+}
+
+ClipId AnimationClipCache::registerClip(const std::string& modelPath, const std::string& clipName)
+{
+    std::string key = modelPath + "#" + clipName;
+    auto it = _index.find(key);
+    if (it != _index.end())
+        return it->second;
+
+    ClipRecord record;
+    record.modelPath = modelPath;
+    record.clipName = clipName;
+    loadRecord(record);
+
+    ClipId id = (ClipId)_clips.size();
+    _clips.push_back(record);
+    _index.emplace(key, id);
+    return id;
+}
+
+Animation3D* AnimationClipCache::getClip(ClipId id)
+{
+    if (id < 0 || id >= (ClipId)_clips.size())
+        return nullptr;
+
+    ClipRecord& record = _clips[id];
+    if (record.animation)
+    {
+        _hits++;
+        return record.animation;
+    }
+
+    // 加载阶段失败或未加载：运行时补加载(应当避免)
+    _misses++;
+    CCLOG("AnimationClipCache miss: %s (%s)", record.clipName.c_str(), record.modelPath.c_str());
+    loadRecord(record);
+    return record.animation;
+}
+
+float AnimationClipCache::getDuration(ClipId id)
+{
+    if (id < 0 || id >= (ClipId)_clips.size())
+        return 0.0f;
+
+    if (!_clips[id].animation)
+    {
+        // 烘焙表中已有时长时不为读时长而加载动画
+        float baked = HitWindowTable::getInstance()->getDuration(id);
+        if (baked > 0.0f)
+            return baked;
+        getClip(id);
+    }
+    return _clips[id].duration;
+}
+
+const std::string& AnimationClipCache::getClipName(ClipId id) const
+{
+    static const std::string EMPTY;
+    if (id < 0 || id >= (ClipId)_clips.size())
+        return EMPTY;
+    return _clips[id].clipName;
+}
+
+const std::string& AnimationClipCache::getModelPath(ClipId id) const
+{
+    static const std::string EMPTY;
+    if (id < 0 || id >= (ClipId)_clips.size())
+        return EMPTY;
+    return _clips[id].modelPath;
+}
+
+bool AnimationClipCache::loadRecord(ClipRecord& record)
+{
+    auto animation = Animation3D::create(record.modelPath, record.clipName);
+    if (!animation)
+    {
+        CCLOGERROR("Animation not found: %s (%s)", record.clipName.c_str(), record.modelPath.c_str());
+        return false;
+    }
+
+    animation->retain();
+    record.animation = animation;
+    record.duration = animation->getDuration();
+    return true;
+}
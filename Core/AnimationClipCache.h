@@ -0,0 +1,83 @@
+#pragma once
+
+#include "cocos2d.h"
+#include "3d/CCAnimation3D.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** 动画片段ID：登记时分配的连续整数，热路径只用它索引 */
+using ClipId = int;
+static constexpr ClipId INVALID_CLIP = -1;
+
+/**
+ * 动画片段缓存(全局单例)
+ * 以(模型路径, 片段名)为键，在场景加载时一次性登记并加载所有片段：
+ * - 登记阶段做字符串查找，返回稳定的整数ID
+ * - 运行时通过ID以O(1)取得 Animation3D 与时长，不再拼接/哈希字符串
+ * - 统计命中与未命中次数，用于确认战斗中没有运行时加载
+ */
+class AnimationClipCache
+{
+public:
+    static AnimationClipCache* getInstance();
+    static void destroyInstance();
+
+    /**
+     * 登记并立即加载片段(仅在加载阶段调用)
+     * 重复登记同一(模型, 片段)返回同一ID，不会重复加载
+     * @param modelPath 模型文件路径(.c3b)
+     * @param clipName 片段名
+     * @return 片段ID
+     */
+    ClipId registerClip(const std::string& modelPath, const std::string& clipName);
+
+    /**
+     * 获取片段(热路径)
+     * 已加载计为命中；未加载时尝试补加载并计为未命中
+     * @param id 片段ID
+     * @return 片段，ID无效或加载失败返回nullptr
+     */
+    cocos2d::Animation3D* getClip(ClipId id);
+
+    /**
+     * 获取片段时长(秒)，无需再创建 Animation3D
+     * 片段尚未加载时优先使用命中窗口表中烘焙的时长
+     * @param id 片段ID
+     * @return 时长，ID无效返回0
+     */
+    float getDuration(ClipId id);
+
+    /** 获取片段名(日志与加载阶段按名称关联数据) */
+    const std::string& getClipName(ClipId id) const;
+
+    /** 获取片段所属模型路径 */
+    const std::string& getModelPath(ClipId id) const;
+
+    int getClipCount() const { return (int)_clips.size(); }
+    unsigned int getHitCount() const { return _hits; }
+    unsigned int getMissCount() const { return _misses; }
+    void resetCounters() { _hits = 0; _misses = 0; }
+
+private:
+    AnimationClipCache() {}
+    ~AnimationClipCache();
+
+    // 片段记录
+    struct ClipRecord
+    {
+        std::string modelPath;
+        std::string clipName;
+        cocos2d::Animation3D* animation = nullptr;  // 持有引用
+        float duration = 0.0f;
+    };
+
+    bool loadRecord(ClipRecord& record);
+
+    std::vector<ClipRecord> _clips;                  // 以ClipId为下标
+    std::unordered_map<std::string, ClipId> _index;  // 登记阶段的键 -> ID
+    unsigned int _hits = 0;
+    unsigned int _misses = 0;
+
+    static AnimationClipCache* s_instance;
+};
@@ -0,0 +1,168 @@
+#include "AssetStreamer.h"
+#include <chrono>
+
+USING_NS_CC;
+
+AssetStreamer::AssetStreamer()
+    : _alive(std::make_shared<bool>(true))
+{
+}
+
+AssetStreamer::~AssetStreamer()
+{
+    *_alive = false;
+}
+
+void AssetStreamer::addTexture(const std::string& path)
+{
+    AsyncRequest request;
+    request.path = path;
+    request.timingIndex = addTiming(path, true);
+    _requests.push_back(request);
+}
+
+void AssetStreamer::addModel(const std::string& path, const std::function<void(Sprite3D*)>& onLoaded)
+{
+    AsyncRequest request;
+    request.isModel = true;
+    request.path = path;
+    request.onModelLoaded = onLoaded;
+    request.timingIndex = addTiming(path, true);
+    _requests.push_back(request);
+}
+
+void AssetStreamer::addMainThreadStep(const std::string& name, const std::function<bool()>& step)
+{
+    MainThreadStep entry;
+    entry.step = step;
+    entry.timingIndex = addTiming(name, false);
+    _steps.push_back(entry);
+}
+
+void AssetStreamer::start()
+{
+    if (_state != State::IDLE)
+        return;
+
+    _state = State::LOADING;
+    _pendingAsync = (int)_requests.size();
+
+    std::weak_ptr<bool> alive = _alive;
+    for (const auto& request : _requests)
+    {
+        int timingIndex = request.timingIndex;
+        double startMs = nowMs();
+
+        if (request.isModel)
+        {
+            auto onLoaded = request.onModelLoaded;
+            Sprite3D::createAsync(request.path, [this, alive, timingIndex, startMs, onLoaded](Sprite3D* sprite, void*) {
+                auto token = alive.lock();
+                if (!token || !*token)
+                    return;
+
+                if (sprite && onLoaded)
+                    onLoaded(sprite);
+                onAsyncFinished(timingIndex, sprite != nullptr, startMs);
+            }, nullptr);
+        }
+        else
+        {
+            Director::getInstance()->getTextureCache()->addImageAsync(request.path,
+                [this, alive, timingIndex, startMs](Texture2D* texture) {
+                auto token = alive.lock();
+                if (!token || !*token)
+                    return;
+
+                onAsyncFinished(timingIndex, texture != nullptr, startMs);
+            });
+        }
+    }
+    _requests.clear();
+
+    checkReady();
+}
+
+void AssetStreamer::update(float budgetMs)
+{
+    if (_state != State::LOADING)
+        return;
+
+    // 每帧至少推进一步，之后在预算内继续
+    double frameStart = nowMs();
+    while (_nextStep < _steps.size())
+    {
+        auto& entry = _steps[_nextStep++];
+
+        double begin = nowMs();
+        bool ok = entry.step ? entry.step() : true;
+        double end = nowMs();
+
+        auto& timing = _timings[entry.timingIndex];
+        timing.costMs = (float)(end - begin);
+        timing.done = true;
+        timing.ok = ok;
+
+        if (end - frameStart >= budgetMs)
+            break;
+    }
+
+    checkReady();
+}
+
+void AssetStreamer::flushMainThreadSteps()
+{
+    while (_state == State::LOADING && _nextStep < _steps.size())
+        update(0.0f);
+}
+
+void AssetStreamer::logTimings() const
+{
+#if defined(COCOS2D_DEBUG) && COCOS2D_DEBUG > 0
+    for (const auto& timing : _timings)
+    {
+        CCLOG("AssetStreamer [%s] %s: %.2f ms%s", timing.isAsync ? "async" : "main",
+            timing.name.c_str(), timing.costMs, timing.ok ? "" : " (FAILED)");
+    }
+#endif
+}
+
+int AssetStreamer::addTiming(const std::string& name, bool isAsync)
+{
+    StageTiming timing;
+    timing.name = name;
+    timing.isAsync = isAsync;
+    _timings.push_back(timing);
+    return (int)_timings.size() - 1;
+}
+
+void AssetStreamer::onAsyncFinished(int timingIndex, bool ok, double startMs)
+{
+    auto& timing = _timings[timingIndex];
+    timing.costMs = (float)(nowMs() - startMs);
+    timing.done = true;
+    timing.ok = ok;
+    if (!ok)
+        CCLOGERROR("AssetStreamer: failed to load %s", timing.name.c_str());
+
+    _pendingAsync--;
+    checkReady();
+}
+
+void AssetStreamer::checkReady()
+{
+    if (_state != State::LOADING)
+        return;
+
+    if (_pendingAsync <= 0 && _nextStep >= _steps.size())
+    {
+        _state = State::READY;
+        logTimings();
+    }
+}
+
+double AssetStreamer::nowMs()
+{
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
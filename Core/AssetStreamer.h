@@ -0,0 +1,111 @@
+#pragma once
+
+#include "cocos2d.h"
+#include "3d/CCSprite3D.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * 资源预取器(分阶段流式加载)
+ * - 纹理/模型：文件读取与解码/解析在引擎工作线程完成，GPU上传与节点构建回到主线程
+ * - 主线程步骤：无法异步的资源(如立方体贴图)排队，每帧在时间预算内执行若干步
+ * 全部完成后资源已常驻缓存，切换关卡时直接取用而不再同步加载。
+ * 每个阶段记录耗时(异步阶段为请求到就绪，主线程阶段为执行耗时)，便于离线评估。
+ */
+class AssetStreamer
+{
+public:
+    enum class State
+    {
+        IDLE,       // 未开始
+        LOADING,    // 预取中
+        READY       // 全部就绪
+    };
+
+    // 单个阶段的耗时记录
+    struct StageTiming
+    {
+        std::string name;
+        bool isAsync = false;     // 是否为工作线程阶段
+        float costMs = 0.0f;      // 异步：请求到就绪的耗时；主线程：执行耗时
+        bool done = false;
+        bool ok = false;
+    };
+
+    AssetStreamer();
+    ~AssetStreamer();
+
+    /**
+     * 登记纹理(工作线程解码，主线程上传进 TextureCache)
+     * @param path 图片路径
+     */
+    void addTexture(const std::string& path);
+
+    /**
+     * 登记3D模型(工作线程解析，主线程构建节点；解析数据同时进入 Sprite3D 缓存)
+     * @param path 模型路径
+     * @param onLoaded 构建完成回调(节点为autorelease，需要保留时自行retain)，可为空
+     */
+    void addModel(const std::string& path, const std::function<void(cocos2d::Sprite3D*)>& onLoaded = nullptr);
+
+    /**
+     * 登记主线程步骤(按登记顺序在 update 中分帧执行)
+     * @param name 阶段名(用于耗时记录)
+     * @param step 执行函数，返回是否成功
+     */
+    void addMainThreadStep(const std::string& name, const std::function<bool()>& step);
+
+    /** 发起全部异步请求并进入预取状态(重复调用无效) */
+    void start();
+
+    /**
+     * 每帧调用：在时间预算内执行排队的主线程步骤(每帧至少执行一步)
+     * @param budgetMs 本帧主线程预算(毫秒)
+     */
+    void update(float budgetMs);
+
+    /** 立即执行剩余全部主线程步骤(预取未完成就需要资源时调用；异步请求仍按原节奏完成) */
+    void flushMainThreadSteps();
+
+    State getState() const { return _state; }
+    bool isStarted() const { return _state != State::IDLE; }
+    bool isReady() const { return _state == State::READY; }
+    const std::vector<StageTiming>& getTimings() const { return _timings; }
+
+    /** 打印各阶段耗时 */
+    void logTimings() const;
+
+private:
+    // 待发起的异步请求
+    struct AsyncRequest
+    {
+        bool isModel = false;
+        std::string path;
+        std::function<void(cocos2d::Sprite3D*)> onModelLoaded;
+        int timingIndex = -1;
+    };
+
+    // 排队的主线程步骤
+    struct MainThreadStep
+    {
+        std::function<bool()> step;
+        int timingIndex = -1;
+    };
+
+    int addTiming(const std::string& name, bool isAsync);
+    void onAsyncFinished(int timingIndex, bool ok, double startMs);
+    void checkReady();
+    static double nowMs();
+
+    State _state = State::IDLE;
+    std::vector<AsyncRequest> _requests;
+    std::vector<MainThreadStep> _steps;
+    size_t _nextStep = 0;
+    int _pendingAsync = 0;
+    std::vector<StageTiming> _timings;
+
+    // 存活标记：预取器析构后，迟到的引擎回调据此忽略
+    std::shared_ptr<bool> _alive;
+};
@@ -0,0 +1,118 @@
+#include "CameraSpringArm.h"
+#include <algorithm>
+#include <cmath>
+
+USING_NS_CC;
+
+static const float CACHE_MARGIN = 100.0f;        // 跟随点离开缓存中心超过该距离才重新查询候选墙段
+static const float TELEPORT_DISTANCE = 1000.0f;  // 目标一帧内移动超过该距离视为传送，直接跳过去
+
+// 临界阻尼弹簧(Game Programming Gems 4, 1.10)：按 dt 求指数衰减的近似解，帧率不同结果一致
+static float smoothDamp(float current, float target, float& velocity, float smoothTime, float dt)
+{
+    if (smoothTime <= 0.0f)
+    {
+        velocity = 0.0f;
+        return target;
+    }
+    if (dt <= 0.0f)
+        return current;
+
+    const float omega = 2.0f / smoothTime;
+    const float x = omega * dt;
+    const float decay = 1.0f / (1.0f + x + 0.48f * x * x + 0.235f * x * x * x);
+    const float change = current - target;
+    const float temp = (velocity + omega * change) * dt;
+    velocity = (velocity - omega * temp) * decay;
+    float result = target + (change + temp) * decay;
+
+    // 不越过目标(目标静止时不回弹)
+    if ((target - current > 0.0f) == (result > target))
+    {
+        result = target;
+        velocity = 0.0f;
+    }
+    return result;
+}
+
+CameraSpringArm::CameraSpringArm()
+{
+}
+
+void CameraSpringArm::setCollisionWorld(const CollisionWorld* collision)
+{
+    _collision = collision;
+    _cacheValid = false;
+}
+
+void CameraSpringArm::setArmLength(float length)
+{
+    if (length > _armLength)
+        _cacheValid = false;   // 缓存范围按臂长查询，伸长后需重新查询
+    _armLength = std::max(0.0f, length);
+}
+
+void CameraSpringArm::snap(const Vec3& target, const Vec3& direction)
+{
+    _pivot = target + Vec3(0.0f, _pivotHeight, 0.0f);
+    _pivotVelocity = Vec3::ZERO;
+    _lengthVelocity = 0.0f;
+    _currentLength = probeLength(direction);
+    _cameraPos = _pivot + direction * _currentLength;
+    _initialized = true;
+}
+
+void CameraSpringArm::update(const Vec3& target, const Vec3& direction, float dt)
+{
+    const Vec3 desiredPivot = target + Vec3(0.0f, _pivotHeight, 0.0f);
+    if (!_initialized || desiredPivot.distance(_pivot) > TELEPORT_DISTANCE)
+    {
+        snap(target, direction);
+        return;
+    }
+
+    // 1. 跟随点逐轴平滑
+    _pivot.x = smoothDamp(_pivot.x, desiredPivot.x, _pivotVelocity.x, _smoothTime, dt);
+    _pivot.y = smoothDamp(_pivot.y, desiredPivot.y, _pivotVelocity.y, _smoothTime, dt);
+    _pivot.z = smoothDamp(_pivot.z, desiredPivot.z, _pivotVelocity.z, _smoothTime, dt);
+
+    // 2. 被遮挡时立即收臂(不能穿墙)，遮挡解除后平滑伸回
+    const float allowed = probeLength(direction);
+    if (allowed < _currentLength)
+    {
+        _currentLength = allowed;
+        _lengthVelocity = 0.0f;
+    }
+    else
+    {
+        _currentLength = smoothDamp(_currentLength, allowed, _lengthVelocity, _smoothTime, dt);
+    }
+
+    _cameraPos = _pivot + direction * _currentLength;
+}
+
+float CameraSpringArm::probeLength(const Vec3& direction)
+{
+    if (!_collision || !_collision->isBuilt() || _armLength <= 0.0f)
+        return _armLength;
+
+    if (!_cacheValid ||
+        fabsf(_pivot.x - _cacheCenter.x) > CACHE_MARGIN ||
+        fabsf(_pivot.y - _cacheCenter.y) > CACHE_MARGIN ||
+        fabsf(_pivot.z - _cacheCenter.z) > CACHE_MARGIN)
+        refreshCandidates();
+
+    const Vec3 desired = _pivot + direction * _armLength;
+    return _collision->castSphere(_pivot, desired, _probeRadius, _candidates, &_queryStats) * _armLength;
+}
+
+void CameraSpringArm::refreshCandidates()
+{
+    // 扫掠最远到达 臂长 + 半径，跟随点在缓存中心 CACHE_MARGIN 范围内时都被覆盖
+    const float extent = _armLength + _probeRadius + CACHE_MARGIN;
+    _collision->querySegments(_pivot.x - extent, _pivot.z - extent, _pivot.x + extent, _pivot.z + extent,
+        _pivot.y - extent, _pivot.y + extent, _candidates);
+    _cacheCenter = _pivot;
+    _cacheValid = true;
+    _cacheRefreshCount++;
+}
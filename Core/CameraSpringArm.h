@@ -0,0 +1,86 @@
+#pragma once
+
+#include "cocos2d.h"
+#include "Core/CollisionWorld.h"
+#include <vector>
+
+/**
+ * 相机弹簧臂
+ * 相机挂在跟随点(目标位置 + 高度偏移)上，沿给定方向伸出一段臂长：
+ * - 跟随点按临界阻尼弹簧逼近目标，结果只取决于经过的时间，与帧率无关
+ * - 每帧从跟随点向期望相机位置做球体扫掠，被墙体/柱子挡住时立即收臂，
+ *   遮挡解除后臂长按同样的弹簧平滑伸回
+ * - 扫掠只检测缓存的候选墙段：跟随点离开缓存中心一段距离(或臂长变化)后才重新查询层次包围盒
+ * 不依赖节点与相机对象，可在无头模拟中回放验证
+ */
+class CameraSpringArm
+{
+public:
+    CameraSpringArm();
+
+    /** 设置遮挡检测使用的碰撞世界(为空时不做遮挡检测)，切换关卡时调用 */
+    void setCollisionWorld(const CollisionWorld* collision);
+
+    /** 设置臂长(相机与跟随点的最大距离) */
+    void setArmLength(float length);
+    float getArmLength() const { return _armLength; }
+
+    /** 设置跟随的平滑时间(秒，越小越紧；<=0 时不平滑) */
+    void setSmoothTime(float seconds) { _smoothTime = seconds; }
+
+    /** 设置遮挡检测的球体半径(相机近裁剪面附近留出的空间) */
+    void setProbeRadius(float radius) { _probeRadius = radius; }
+
+    /** 设置跟随点相对目标的高度偏移(相机同时看向跟随点) */
+    void setPivotHeight(float height) { _pivotHeight = height; }
+
+    /**
+     * 直接跳到目标处(首帧、传送)，清空弹簧速度
+     * @param target 目标位置
+     * @param direction 从跟随点指向相机的单位方向
+     */
+    void snap(const cocos2d::Vec3& target, const cocos2d::Vec3& direction);
+
+    /**
+     * 推进一帧
+     * @param target 目标位置
+     * @param direction 从跟随点指向相机的单位方向
+     * @param dt 帧间隔
+     */
+    void update(const cocos2d::Vec3& target, const cocos2d::Vec3& direction, float dt);
+
+    /** 相机位置 */
+    const cocos2d::Vec3& getCameraPosition() const { return _cameraPos; }
+    /** 平滑后的跟随点(相机看向的位置) */
+    const cocos2d::Vec3& getPivot() const { return _pivot; }
+    /** 当前臂长(被遮挡时小于 getArmLength) */
+    float getCurrentLength() const { return _currentLength; }
+    /** 候选墙段的重新查询次数 */
+    unsigned int getCacheRefreshCount() const { return _cacheRefreshCount; }
+    /** 累计遮挡检测统计 */
+    const CollisionQueryStats& getQueryStats() const { return _queryStats; }
+
+    bool isInitialized() const { return _initialized; }
+
+private:
+    float probeLength(const cocos2d::Vec3& direction);
+    void refreshCandidates();
+
+    const CollisionWorld* _collision = nullptr;
+    std::vector<int> _candidates;          // 跟随点附近的墙段(缓存)
+    cocos2d::Vec3 _cacheCenter;            // 缓存查询时的跟随点
+    bool _cacheValid = false;
+    unsigned int _cacheRefreshCount = 0;
+    CollisionQueryStats _queryStats;
+
+    cocos2d::Vec3 _pivot;                  // 平滑后的跟随点
+    cocos2d::Vec3 _pivotVelocity;          // 跟随点弹簧速度
+    cocos2d::Vec3 _cameraPos;
+    float _currentLength = 0.0f;           // 当前臂长
+    float _lengthVelocity = 0.0f;          // 臂长弹簧速度
+    float _armLength = 250.0f;
+    float _smoothTime = 0.12f;
+    float _probeRadius = 12.0f;
+    float _pivotHeight = 10.0f;
+    bool _initialized = false;
+};
@@ -0,0 +1,554 @@
+#include "CollisionWorld.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
+USING_NS_CC;
+
+static const float WALL_MAX_NORMAL_Y = 0.7f;     // 法线Y分量小于该值的三角形视为墙(坡度大于约45度)
+static const float MIN_SEGMENT_LENGTH = 1.0f;    // 投影后过短的墙段忽略
+static const float STEP_HEIGHT = 20.0f;          // 脚下可跨越的台阶高度
+static const float SKIN_WIDTH = 0.05f;           // 撞墙后与墙保持的间隙，避免下一次扫掠从墙内出发
+static const int MAX_SLIDE_ITERATIONS = 3;       // 沿墙滑动的最多迭代次数
+static const int LEAF_SIZE = 4;                  // 叶子节点最多的墙段数
+static const int MAX_STACK_DEPTH = 64;           // 遍历栈深度(中位数切分，树高约 log2(墙段数/4))
+
+CollisionWorld::CollisionWorld()
+{
+}
+
+void CollisionWorld::clear()
+{
+    _segments.clear();
+    _order.clear();
+    _nodes.clear();
+}
+
+int CollisionWorld::addModel(const std::string& path, const Mat4& transform)
+{
+    Bundle3D* bundle = Bundle3D::createBundle();
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(path);
+    if (!bundle || !bundle->load(fullPath))
+    {
+        CCLOGWARN("CollisionWorld: failed to load %s", path.c_str());
+        if (bundle)
+            Bundle3D::destroyBundle(bundle);
+        return -1;
+    }
+
+    MeshDatas meshDatas;
+    NodeDatas nodeDatas;
+    bool loaded = bundle->loadMeshDatas(meshDatas) && bundle->loadNodes(nodeDatas);
+    Bundle3D::destroyBundle(bundle);
+    if (!loaded)
+    {
+        CCLOGWARN("CollisionWorld: no mesh data in %s", path.c_str());
+        return -1;
+    }
+
+    const size_t segmentsBefore = _segments.size();
+
+    // 按三角形提取墙段
+    auto addTriangles = [this](const MeshData* mesh, const MeshData::IndexArray& indices, const Mat4& world) {
+        // 顶点中位置属性的偏移
+        int positionOffset = -1;
+        int offset = 0;
+        for (const auto& attrib : mesh->attribs)
+        {
+            if (attrib.vertexAttrib == GLProgram::VERTEX_ATTRIB_POSITION)
+            {
+                positionOffset = offset;
+                break;
+            }
+            offset += attrib.attribSizeBytes / (int)sizeof(float);
+        }
+        if (positionOffset < 0 || mesh->vertexSizeInFloat <= 0)
+            return;
+
+        const int vertexCount = (int)mesh->vertex.size() / mesh->vertexSizeInFloat;
+        for (size_t t = 0; t + 2 < indices.size(); t += 3)
+        {
+            Vec3 v[3];
+            bool valid = true;
+            for (int k = 0; k < 3; ++k)
+            {
+                int index = indices[t + k];
+                if (index >= vertexCount)
+                {
+                    valid = false;
+                    break;
+                }
+                const float* p = &mesh->vertex[index * mesh->vertexSizeInFloat + positionOffset];
+                v[k] = Vec3(p[0], p[1], p[2]);
+                world.transformPoint(&v[k]);
+            }
+            if (!valid)
+                continue;
+
+            // 只保留陡峭的三角形，地面/天花板不参与水平碰撞
+            float e1x = v[1].x - v[0].x, e1y = v[1].y - v[0].y, e1z = v[1].z - v[0].z;
+            float e2x = v[2].x - v[0].x, e2y = v[2].y - v[0].y, e2z = v[2].z - v[0].z;
+            float nx = e1y * e2z - e1z * e2y;
+            float ny = e1z * e2x - e1x * e2z;
+            float nz = e1x * e2y - e1y * e2x;
+            float length = sqrtf(nx * nx + ny * ny + nz * nz);
+            if (length < 0.0001f || fabsf(ny) / length >= WALL_MAX_NORMAL_Y)
+                continue;
+
+            // 投影到XZ平面后取相距最远的两个顶点作为墙段
+            int bestA = 0;
+            int bestB = 1;
+            float bestDistSq = -1.0f;
+            for (int a = 0; a < 3; ++a)
+            {
+                int b = (a + 1) % 3;
+                float dx = v[b].x - v[a].x;
+                float dz = v[b].z - v[a].z;
+                if (dx * dx + dz * dz > bestDistSq)
+                {
+                    bestDistSq = dx * dx + dz * dz;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+            if (bestDistSq < MIN_SEGMENT_LENGTH * MIN_SEGMENT_LENGTH)
+                continue;
+
+            float minY = std::min(v[0].y, std::min(v[1].y, v[2].y));
+            float maxY = std::max(v[0].y, std::max(v[1].y, v[2].y));
+            addSegment(v[bestA].x, v[bestA].z, v[bestB].x, v[bestB].z, minY, maxY);
+        }
+    };
+
+    // 子网格ID -> (网格, 子网格序号)
+    std::unordered_map<std::string, std::pair<const MeshData*, int>> subMeshes;
+    for (const MeshData* mesh : meshDatas.meshDatas)
+    {
+        for (size_t k = 0; k < mesh->subMeshIds.size() && k < mesh->subMeshIndices.size(); ++k)
+            subMeshes[mesh->subMeshIds[k]] = std::make_pair(mesh, (int)k);
+    }
+
+    // 按节点层级累乘变换，只处理挂了模型的节点
+    std::function<void(const NodeData*, const Mat4&)> visit = [&](const NodeData* node, const Mat4& parent) {
+        Mat4 world = parent * node->transform;
+        for (const ModelData* model : node->modelNodeDatas)
+        {
+            auto it = subMeshes.find(model->subMeshId);
+            if (it != subMeshes.end())
+                addTriangles(it->second.first, it->second.first->subMeshIndices[it->second.second], world);
+        }
+        for (const NodeData* child : node->children)
+            visit(child, world);
+    };
+
+    if (nodeDatas.nodes.empty())
+    {
+        // 无节点信息：全部子网格直接使用模型变换
+        for (const MeshData* mesh : meshDatas.meshDatas)
+        {
+            for (const auto& indices : mesh->subMeshIndices)
+                addTriangles(mesh, indices, transform);
+        }
+    }
+    else
+    {
+        for (const NodeData* node : nodeDatas.nodes)
+            visit(node, transform);
+    }
+
+    int added = (int)(_segments.size() - segmentsBefore);
+    CCLOG("CollisionWorld: %d wall segments from %s", added, path.c_str());
+    return added;
+}
+
+void CollisionWorld::addSegment(float ax, float az, float bx, float bz, float minY, float maxY)
+{
+    Segment segment;
+    segment.ax = ax;
+    segment.az = az;
+    segment.bx = bx;
+    segment.bz = bz;
+    segment.minY = std::min(minY, maxY);
+    segment.maxY = std::max(minY, maxY);
+    _segments.push_back(segment);
+}
+
+void CollisionWorld::addBox(float minX, float minZ, float maxX, float maxZ, float minY, float maxY)
+{
+    addSegment(minX, minZ, maxX, minZ, minY, maxY);
+    addSegment(maxX, minZ, maxX, maxZ, minY, maxY);
+    addSegment(maxX, maxZ, minX, maxZ, minY, maxY);
+    addSegment(minX, maxZ, minX, minZ, minY, maxY);
+}
+
+void CollisionWorld::build()
+{
+    _nodes.clear();
+    _order.resize(_segments.size());
+    for (size_t i = 0; i < _segments.size(); ++i)
+        _order[i] = (int)i;
+
+    if (_segments.empty())
+        return;
+
+    _nodes.reserve(_segments.size() * 2 / LEAF_SIZE + 1);
+    _nodes.push_back(BvhNode());
+    buildNode(0, 0, (int)_segments.size());
+}
+
+void CollisionWorld::buildNode(int nodeIndex, int begin, int end)
+{
+    BvhNode node;
+    node.minX = node.minZ = node.minY = FLT_MAX;
+    node.maxX = node.maxZ = node.maxY = -FLT_MAX;
+    for (int k = begin; k < end; ++k)
+    {
+        const Segment& s = _segments[_order[k]];
+        node.minX = std::min(node.minX, std::min(s.ax, s.bx));
+        node.maxX = std::max(node.maxX, std::max(s.ax, s.bx));
+        node.minZ = std::min(node.minZ, std::min(s.az, s.bz));
+        node.maxZ = std::max(node.maxZ, std::max(s.az, s.bz));
+        node.minY = std::min(node.minY, s.minY);
+        node.maxY = std::max(node.maxY, s.maxY);
+    }
+
+    if (end - begin <= LEAF_SIZE)
+    {
+        node.first = begin;
+        node.count = end - begin;
+        _nodes[nodeIndex] = node;
+        return;
+    }
+
+    // 沿较长的轴按中点中位数切分，保证树平衡
+    const bool splitX = node.maxX - node.minX >= node.maxZ - node.minZ;
+    const int mid = (begin + end) / 2;
+    std::nth_element(_order.begin() + begin, _order.begin() + mid, _order.begin() + end, [this, splitX](int a, int b) {
+        const Segment& sa = _segments[a];
+        const Segment& sb = _segments[b];
+        return splitX ? sa.ax + sa.bx < sb.ax + sb.bx : sa.az + sa.bz < sb.az + sb.bz;
+    });
+
+    // 两个子节点相邻存放
+    const int left = (int)_nodes.size();
+    node.first = left;
+    node.count = 0;
+    _nodes[nodeIndex] = node;
+    _nodes.push_back(BvhNode());
+    _nodes.push_back(BvhNode());
+    buildNode(left, begin, mid);
+    buildNode(left + 1, mid, end);
+}
+
+// 圆沿 (dx, dz) 扫掠，求与墙段(半径 radius 的胶囊形外扩区域)的最早接触时刻
+static bool sweepSegment(float ax, float az, float bx, float bz, float px, float pz, float dx, float dz, float radius,
+    float& bestT, float& normalX, float& normalZ)
+{
+    bool hit = false;
+    const float radiusSq = radius * radius;
+
+    // 1. 两个端点圆
+    const float ends[2][2] = { { ax, az }, { bx, bz } };
+    const float a = dx * dx + dz * dz;
+    for (int e = 0; e < 2; ++e)
+    {
+        float fx = px - ends[e][0];
+        float fz = pz - ends[e][1];
+        float c = fx * fx + fz * fz - radiusSq;
+        if (c < 0.0f)
+            continue;   // 起点已重叠，由 depenetrate 处理
+        float b = fx * dx + fz * dz;
+        if (b >= 0.0f)
+            continue;   // 远离端点
+        float disc = b * b - a * c;
+        if (disc < 0.0f)
+            continue;
+        float t = (-b - sqrtf(disc)) / a;
+        if (t >= 0.0f && t < bestT)
+        {
+            bestT = t;
+            normalX = (px + dx * t - ends[e][0]) / radius;
+            normalZ = (pz + dz * t - ends[e][1]) / radius;
+            hit = true;
+        }
+    }
+
+    // 2. 线段两侧平移 radius 的平行边
+    float ux = bx - ax;
+    float uz = bz - az;
+    float length = sqrtf(ux * ux + uz * uz);
+    if (length < 0.0001f)
+        return hit;
+    ux /= length;
+    uz /= length;
+
+    float nx = -uz;
+    float nz = ux;
+    float s0 = (px - ax) * nx + (pz - az) * nz;
+    float side = s0 >= 0.0f ? 1.0f : -1.0f;
+    float distance = s0 * side;
+    float approach = (dx * nx + dz * nz) * side;
+    if (distance < radius || approach >= 0.0f)
+        return hit;
+
+    float t = (distance - radius) / -approach;
+    if (t < bestT)
+    {
+        float projection = (px + dx * t - ax) * ux + (pz + dz * t - az) * uz;
+        if (projection >= 0.0f && projection <= length)
+        {
+            bestT = t;
+            normalX = nx * side;
+            normalZ = nz * side;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+void CollisionWorld::sweep(float px, float pz, float dx, float dz, float radius, float minY, float maxY,
+    SweepHit& result, CollisionQueryStats* stats) const
+{
+    result = SweepHit();
+    if (_nodes.empty())
+        return;
+
+    // 扫掠区域的包围盒
+    const float boxMinX = std::min(px, px + dx) - radius;
+    const float boxMaxX = std::max(px, px + dx) + radius;
+    const float boxMinZ = std::min(pz, pz + dz) - radius;
+    const float boxMaxZ = std::max(pz, pz + dz) + radius;
+
+    int stack[MAX_STACK_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+    unsigned int visited = 0;
+    unsigned int tested = 0;
+
+    while (top > 0)
+    {
+        const BvhNode& node = _nodes[stack[--top]];
+        visited++;
+        if (node.minX > boxMaxX || node.maxX < boxMinX || node.minZ > boxMaxZ || node.maxZ < boxMinZ ||
+            node.minY > maxY || node.maxY < minY)
+            continue;
+
+        if (node.count == 0)
+        {
+            stack[top++] = node.first;
+            stack[top++] = node.first + 1;
+            continue;
+        }
+
+        for (int k = node.first; k < node.first + node.count; ++k)
+        {
+            const Segment& s = _segments[_order[k]];
+            if (s.minY > maxY || s.maxY < minY)
+                continue;
+            tested++;
+            if (sweepSegment(s.ax, s.az, s.bx, s.bz, px, pz, dx, dz, radius, result.t, result.normalX, result.normalZ))
+                result.hit = true;
+        }
+    }
+
+    if (stats)
+    {
+        stats->queries++;
+        stats->nodesVisited += visited;
+        stats->segmentsTested += tested;
+    }
+}
+
+void CollisionWorld::depenetrate(float& px, float& pz, float radius, float minY, float maxY, CollisionQueryStats* stats) const
+{
+    if (_nodes.empty())
+        return;
+
+    int stack[MAX_STACK_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+    unsigned int visited = 0;
+    unsigned int tested = 0;
+
+    while (top > 0)
+    {
+        const BvhNode& node = _nodes[stack[--top]];
+        visited++;
+        if (node.minX > px + radius || node.maxX < px - radius || node.minZ > pz + radius || node.maxZ < pz - radius ||
+            node.minY > maxY || node.maxY < minY)
+            continue;
+
+        if (node.count == 0)
+        {
+            stack[top++] = node.first;
+            stack[top++] = node.first + 1;
+            continue;
+        }
+
+        for (int k = node.first; k < node.first + node.count; ++k)
+        {
+            const Segment& s = _segments[_order[k]];
+            if (s.minY > maxY || s.maxY < minY)
+                continue;
+            tested++;
+
+            // 最近点距离小于半径：沿分离方向推出
+            float ux = s.bx - s.ax;
+            float uz = s.bz - s.az;
+            float lengthSq = ux * ux + uz * uz;
+            float t = lengthSq > 0.0f ? ((px - s.ax) * ux + (pz - s.az) * uz) / lengthSq : 0.0f;
+            t = std::max(0.0f, std::min(1.0f, t));
+            float ox = px - (s.ax + ux * t);
+            float oz = pz - (s.az + uz * t);
+            float distSq = ox * ox + oz * oz;
+            if (distSq >= radius * radius)
+                continue;
+
+            float dist = sqrtf(distSq);
+            if (dist < 0.0001f)
+            {
+                // 正好在墙线上：沿墙段法线推出
+                float length = sqrtf(lengthSq);
+                if (length < 0.0001f)
+                    continue;
+                ox = -uz / length;
+                oz = ux / length;
+                dist = 0.0f;
+            }
+            else
+            {
+                ox /= dist;
+                oz /= dist;
+            }
+            px += ox * (radius - dist + SKIN_WIDTH);
+            pz += oz * (radius - dist + SKIN_WIDTH);
+        }
+    }
+
+    if (stats)
+    {
+        stats->nodesVisited += visited;
+        stats->segmentsTested += tested;
+    }
+}
+
+Vec3 CollisionWorld::moveAndSlide(const Vec3& from, const Vec3& to, float radius, float height, CollisionQueryStats* stats) const
+{
+    if (_nodes.empty())
+        return to;
+
+    const float minY = from.y + STEP_HEIGHT;
+    const float maxY = from.y + std::max(height, STEP_HEIGHT);
+    float px = from.x;
+    float pz = from.z;
+    float dx = to.x - from.x;
+    float dz = to.z - from.z;
+
+    // 起点已与墙重叠(出生点/被推入墙内)：先推出
+    depenetrate(px, pz, radius, minY, maxY, stats);
+
+    for (int iteration = 0; iteration < MAX_SLIDE_ITERATIONS; ++iteration)
+    {
+        float lengthSq = dx * dx + dz * dz;
+        if (lengthSq < 1e-8f)
+            break;
+
+        SweepHit hit;
+        sweep(px, pz, dx, dz, radius, minY, maxY, hit, stats);
+        if (!hit.hit)
+        {
+            px += dx;
+            pz += dz;
+            break;
+        }
+
+        // 停在接触点前一个间隙处，剩余位移去掉指向墙内的分量后继续滑动
+        float t = std::max(0.0f, hit.t - SKIN_WIDTH / sqrtf(lengthSq));
+        px += dx * t;
+        pz += dz * t;
+        dx *= 1.0f - t;
+        dz *= 1.0f - t;
+
+        float into = dx * hit.normalX + dz * hit.normalZ;
+        if (into < 0.0f)
+        {
+            dx -= hit.normalX * into;
+            dz -= hit.normalZ * into;
+        }
+    }
+
+    return Vec3(px, to.y, pz);
+}
+
+void CollisionWorld::querySegments(float minX, float minZ, float maxX, float maxZ, float minY, float maxY, std::vector<int>& out) const
+{
+    out.clear();
+    if (_nodes.empty())
+        return;
+
+    int stack[MAX_STACK_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const BvhNode& node = _nodes[stack[--top]];
+        if (node.minX > maxX || node.maxX < minX || node.minZ > maxZ || node.maxZ < minZ ||
+            node.minY > maxY || node.maxY < minY)
+            continue;
+
+        if (node.count == 0)
+        {
+            stack[top++] = node.first;
+            stack[top++] = node.first + 1;
+            continue;
+        }
+
+        for (int k = node.first; k < node.first + node.count; ++k)
+        {
+            const Segment& s = _segments[_order[k]];
+            if (s.minY > maxY || s.maxY < minY)
+                continue;
+            if (std::max(s.ax, s.bx) < minX || std::min(s.ax, s.bx) > maxX ||
+                std::max(s.az, s.bz) < minZ || std::min(s.az, s.bz) > maxZ)
+                continue;
+            out.push_back(_order[k]);
+        }
+    }
+}
+
+float CollisionWorld::castSphere(const Vec3& from, const Vec3& to, float radius,
+    const std::vector<int>& candidates, CollisionQueryStats* stats) const
+{
+    const float dx = to.x - from.x;
+    const float dy = to.y - from.y;
+    const float dz = to.z - from.z;
+    if (dx * dx + dz * dz < 1e-8f)
+        return 1.0f;
+
+    float bestT = 1.0f;
+    for (int index : candidates)
+    {
+        const Segment& s = _segments[index];
+        float t = bestT;
+        float normalX = 0.0f;
+        float normalZ = 0.0f;
+        if (!sweepSegment(s.ax, s.az, s.bx, s.bz, from.x, from.z, dx, dz, radius, t, normalX, normalZ))
+            continue;
+
+        // 接触时球心越过墙顶或低于墙底：从墙上方/下方经过
+        float y = from.y + dy * t;
+        if (y - radius > s.maxY || y + radius < s.minY)
+            continue;
+        bestT = t;
+    }
+
+    if (stats)
+    {
+        stats->queries++;
+        stats->segmentsTested += (unsigned int)candidates.size();
+    }
+    return bestT;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "cocos2d.h"
+#include <string>
+#include <vector>
+
+// 碰撞查询统计（可选，调用方按线程各自累加）
+struct CollisionQueryStats
+{
+    unsigned int queries = 0;          // 扫掠次数（每次移动含滑动迭代）
+    unsigned int nodesVisited = 0;     // 访问的层次包围盒节点数
+    unsigned int segmentsTested = 0;   // 精确检测的墙段数
+};
+
+/**
+ * 静态碰撞世界(关卡墙体)
+ * 加载时从关卡模型中提取陡峭的三角形(墙、柱子、台阶侧面)，投影成带高度范围的XZ墙段，
+ * 再加上手工放置的边界盒，建立一棵层次包围盒(BVH)：
+ * - 角色按竖直胶囊处理：半径 + 脚下可跨越的台阶高度 ~ 身高，只与高度范围重叠的墙段碰撞
+ * - moveAndSlide 沿移动方向扫掠胶囊，撞墙后去掉法向分量沿墙滑动，最多迭代3次
+ * 建好后只读，查询可在多个线程上同时进行
+ */
+class CollisionWorld
+{
+public:
+    CollisionWorld();
+
+    /** 清空全部墙段 */
+    void clear();
+
+    /**
+     * 从 .c3b/.c3t 模型提取墙段(按模型内节点变换，再乘以 transform)
+     * @param path 模型路径
+     * @param transform 模型在场景中的世界变换
+     * @return 提取的墙段数，加载失败返回 -1
+     */
+    int addModel(const std::string& path, const cocos2d::Mat4& transform);
+
+    /**
+     * 添加一段墙(双面)
+     * @param minY 墙底高度
+     * @param maxY 墙顶高度
+     */
+    void addSegment(float ax, float az, float bx, float bz, float minY, float maxY);
+
+    /** 添加矩形的四条边(空气墙边界、柱子等手工碰撞) */
+    void addBox(float minX, float minZ, float maxX, float maxZ, float minY, float maxY);
+
+    /** 建立层次包围盒(添加墙段后调用一次) */
+    void build();
+
+    /**
+     * 移动并沿墙滑动
+     * @param from 起点(脚底)
+     * @param to 期望终点
+     * @param radius 胶囊半径
+     * @param height 胶囊高度
+     * @param stats 统计(可为nullptr)
+     * @return 实际到达的位置(Y取期望终点的Y)
+     */
+    cocos2d::Vec3 moveAndSlide(const cocos2d::Vec3& from, const cocos2d::Vec3& to, float radius, float height,
+        CollisionQueryStats* stats = nullptr) const;
+
+    /**
+     * 收集包围盒内(XZ矩形 + 高度范围)的墙段，调用方缓存后用 castSphere 反复检测，省去每次遍历层次包围盒
+     * @param out 输出墙段下标(先清空)
+     */
+    void querySegments(float minX, float minZ, float maxX, float maxZ, float minY, float maxY, std::vector<int>& out) const;
+
+    /**
+     * 球体沿 from -> to 扫掠，只检测 candidates 中的墙段(相机遮挡探测)
+     * 墙段是竖直的，按XZ平面求最早接触，再检查接触时球心高度是否落在墙段的高度范围(外扩半径)内
+     * @param candidates querySegments 的结果
+     * @return 最早接触时已走过的比例[0, 1]，无遮挡返回1
+     */
+    float castSphere(const cocos2d::Vec3& from, const cocos2d::Vec3& to, float radius,
+        const std::vector<int>& candidates, CollisionQueryStats* stats = nullptr) const;
+
+    bool isBuilt() const { return !_nodes.empty(); }
+    int getSegmentCount() const { return (int)_segments.size(); }
+    int getNodeCount() const { return (int)_nodes.size(); }
+
+private:
+    // 墙段：XZ平面线段 + 高度范围
+    struct Segment
+    {
+        float ax, az, bx, bz;
+        float minY, maxY;
+    };
+
+    // 层次包围盒节点：count > 0 为叶子，first 指向 _order；否则 first 为左子节点，右子节点紧随其后
+    struct BvhNode
+    {
+        float minX, minZ, maxX, maxZ;
+        float minY, maxY;
+        int first = 0;
+        int count = 0;
+    };
+
+    // 扫掠结果
+    struct SweepHit
+    {
+        float t = 1.0f;
+        float normalX = 0.0f;
+        float normalZ = 0.0f;
+        bool hit = false;
+    };
+
+    void buildNode(int nodeIndex, int begin, int end);
+    void sweep(float px, float pz, float dx, float dz, float radius, float minY, float maxY,
+        SweepHit& result, CollisionQueryStats* stats) const;
+    void depenetrate(float& px, float& pz, float radius, float minY, float maxY, CollisionQueryStats* stats) const;
+
+    std::vector<Segment> _segments;
+    std::vector<int> _order;          // 叶子引用的墙段下标
+    std::vector<BvhNode> _nodes;
+};
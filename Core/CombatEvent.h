@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Core/EntityRegistry.h"
+#include <cstdint>
+
+/** 战斗事件类型 */
+enum class CombatEventType : unsigned char
+{
+    HIT,     // 命中并扣血
+    BLOCK,   // 被格挡(伤害为减伤后的值，可为0)
+    DODGE,   // 闪避/无敌帧免疫(伤害为被免除的值)
+    DEATH    // 目标因本次命中死亡(紧跟在该次 HIT/BLOCK 之后)
+};
+
+/**
+ * 受击方对一次命中的结算结果
+ * 由 takeDamage 系列接口返回，结算阶段据此生成事件
+ */
+struct HitResult
+{
+    CombatEventType type = CombatEventType::HIT;
+    int damage = 0;         // 实际扣除的血量(DODGE 为被免除的伤害)
+    bool killed = false;    // 本次命中致死
+    bool ignored = false;   // 目标已死亡等，本次命中没有任何效果(不生成事件)
+
+    static HitResult hit(int damage, bool killed)
+    {
+        HitResult result;
+        result.damage = damage;
+        result.killed = killed;
+        return result;
+    }
+
+    static HitResult make(CombatEventType type, int damage, bool killed)
+    {
+        HitResult result;
+        result.type = type;
+        result.damage = damage;
+        result.killed = killed;
+        return result;
+    }
+
+    static HitResult none()
+    {
+        HitResult result;
+        result.ignored = true;
+        return result;
+    }
+};
+
+/** 已结算的战斗事件(遥测与回放的数据源，可平凡拷贝) */
+struct CombatEvent
+{
+    uint32_t tick = 0;                          // 结算时的逻辑tick
+    CombatEventType type = CombatEventType::HIT;
+    EntityKind targetKind = EntityKind::NONE;
+    EntityHandle source;                        // 攻击方(可为空)
+    EntityHandle target;                        // 受击方
+    int amount = 0;                             // 见 HitResult::damage；DEATH 为0
+};
@@ -0,0 +1,89 @@
+#include "CombatEventQueue.h"
+#include "Player/Player.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/EnemyStore.h"
+#include "Enemy/Boss/BossLogic.h"
+
+CombatEventQueue::CombatEventQueue()
+{
+}
+
+void CombatEventQueue::reserve(int count)
+{
+    _pending.reserve(count);
+    _events.reserve(count * 2);   // 致死的命中另有一条 DEATH
+}
+
+void CombatEventQueue::pushHit(EntityHandle source, EntityHandle target, int damage)
+{
+    HitRequest request;
+    request.source = source;
+    request.target = target;
+    request.damage = damage;
+    _pending.push_back(request);
+}
+
+int CombatEventQueue::resolve()
+{
+    _tick++;
+    _events.clear();
+
+    auto registry = EntityRegistry::getInstance();
+    for (size_t k = 0; k < _pending.size(); ++k)
+    {
+        // 受击方可能在结算中登记新的命中(扩容)，按值取出
+        const HitRequest request = _pending[k];
+        const EntityKind kind = registry->getKind(request.target);
+
+        HitResult result = HitResult::none();
+        switch (kind)
+        {
+        case EntityKind::PLAYER:
+            result = registry->getPlayer(request.target)->takeDamage(request.damage);
+            break;
+        case EntityKind::ENEMY:
+            result = registry->getEnemy(request.target)->takeDamage(request.damage);
+            break;
+        case EntityKind::BOSS:
+            result = registry->getBoss(request.target)->TakeDamage(request.damage);
+            break;
+        case EntityKind::STORED_ENEMY:
+        {
+            int index = -1;
+            EnemyStore* store = registry->getStoredEnemy(request.target, index);
+            result = store->applyDamage(index, request.damage);
+            break;
+        }
+        default:
+            break;   // 目标已失效
+        }
+        if (result.ignored)
+            continue;
+
+        CombatEvent event;
+        event.tick = _tick;
+        event.type = result.type;
+        event.targetKind = kind;
+        event.source = request.source;
+        event.target = request.target;
+        event.amount = result.damage;
+        _events.push_back(event);
+        _totals[(int)event.type]++;
+
+        if (result.killed)
+        {
+            event.type = CombatEventType::DEATH;
+            event.amount = 0;
+            _events.push_back(event);
+            _totals[(int)CombatEventType::DEATH]++;
+        }
+    }
+    _pending.clear();
+    return (int)_events.size();
+}
+
+void CombatEventQueue::clear()
+{
+    _pending.clear();
+    _events.clear();
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Core/CombatEvent.h"
+#include <vector>
+
+/**
+ * 战斗事件队列(由模拟驱动器持有)
+ * tick 内各处的命中判定只登记请求，不直接调用受击方；
+ * tick 结束时 resolve 按登记顺序一次性分发给受击方，受击方返回的结果写成事件流：
+ * - 同一tick内状态变化(受击硬直、死亡)集中发生，判定阶段读到的都是tick开始时的一致状态
+ * - 并行阶段的生产者先写各自的缓冲，合并时按固定顺序登记即可保证结果与线程数无关
+ * - 事件流保留最近一次结算的全部事件，并累计各类型数量，供遥测与回放使用
+ */
+class CombatEventQueue
+{
+public:
+    CombatEventQueue();
+
+    /** 预分配容量(之后在该数量内不再分配内存) */
+    void reserve(int count);
+
+    /**
+     * 登记一次命中
+     * @param source 攻击方句柄(可为空)
+     * @param target 受击方句柄
+     * @param damage 伤害值
+     */
+    void pushHit(EntityHandle source, EntityHandle target, int damage);
+
+    /**
+     * 结算本tick登记的全部命中(结算中新登记的命中也在本次处理)
+     * @return 生成的事件数
+     */
+    int resolve();
+
+    /** 丢弃未结算的命中与事件流 */
+    void clear();
+
+    /** 最近一次结算生成的事件(按结算顺序) */
+    const std::vector<CombatEvent>& getEvents() const { return _events; }
+    /** 尚未结算的命中数 */
+    int getPendingCount() const { return (int)_pending.size(); }
+    /** 累计事件数 */
+    unsigned long long getTotalCount(CombatEventType type) const { return _totals[(int)type]; }
+
+private:
+    struct HitRequest
+    {
+        EntityHandle source;
+        EntityHandle target;
+        int damage = 0;
+    };
+
+    std::vector<HitRequest> _pending;
+    std::vector<CombatEvent> _events;
+    uint32_t _tick = 0;
+    unsigned long long _totals[4] = {};
+};
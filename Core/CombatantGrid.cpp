@@ -0,0 +1,127 @@
+#include "CombatantGrid.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/Boss/Boss.h"
+#include <cmath>
+
+USING_NS_CC;
+
+CombatantGrid::CombatantGrid(float cellSize, int bucketCount)
+{
+    _cellSize = cellSize > 0.0f ? cellSize : 128.0f;
+    _invCellSize = 1.0f / _cellSize;
+
+    // 桶数量取2的幂，哈希时用掩码代替取模
+    int buckets = 1;
+    while (buckets < bucketCount)
+        buckets <<= 1;
+    _bucketMask = buckets - 1;
+
+    _bucketHeads.assign(buckets, -1);
+    _entries.reserve(256);
+    _usedBuckets.reserve(256);
+}
+
+void CombatantGrid::clear()
+{
+    for (int bucket : _usedBuckets)
+        _bucketHeads[bucket] = -1;
+
+    _usedBuckets.clear();
+    _entries.clear();
+}
+
+void CombatantGrid::insert(EnemyBase* enemy, const Vec3& position)
+{
+    if (!enemy)
+        return;
+
+    insert(enemy->getEntityHandle(), EntityKind::ENEMY, position);
+}
+
+void CombatantGrid::insert(Boss* boss, const Vec3& position)
+{
+    if (!boss)
+        return;
+
+    insert(boss->getEntityHandle(), EntityKind::BOSS, position);
+}
+
+void CombatantGrid::insert(EntityHandle handle, EntityKind kind, const Vec3& position)
+{
+    if (handle.isNull())
+        return;
+
+    Combatant combatant;
+    combatant.handle = handle;
+    combatant.kind = kind;
+    combatant.x = position.x;
+    combatant.y = position.y;
+    combatant.z = position.z;
+    insertEntry(combatant);
+}
+
+int CombatantGrid::queryRadius(const Vec3& center, float radius, std::vector<Combatant>& out) const
+{
+    out.clear();
+    if (_entries.empty() || radius < 0.0f)
+        return 0;
+
+    const float radiusSq = radius * radius;
+    const int minX = cellCoord(center.x - radius);
+    const int maxX = cellCoord(center.x + radius);
+    const int minZ = cellCoord(center.z - radius);
+    const int maxZ = cellCoord(center.z + radius);
+
+    for (int cz = minZ; cz <= maxZ; ++cz)
+    {
+        for (int cx = minX; cx <= maxX; ++cx)
+        {
+            int index = _bucketHeads[bucketIndex(cx, cz)];
+            while (index >= 0)
+            {
+                const Entry& entry = _entries[index];
+
+                // 同桶内可能有其它格子的记录(哈希冲突)，只取本格
+                if (entry.cellX == cx && entry.cellZ == cz)
+                {
+                    float dx = entry.combatant.x - center.x;
+                    float dz = entry.combatant.z - center.z;
+                    if (dx * dx + dz * dz <= radiusSq)
+                        out.push_back(entry.combatant);
+                }
+                index = entry.next;
+            }
+        }
+    }
+
+    return (int)out.size();
+}
+
+void CombatantGrid::insertEntry(const Combatant& combatant)
+{
+    Entry entry;
+    entry.combatant = combatant;
+    entry.cellX = cellCoord(combatant.x);
+    entry.cellZ = cellCoord(combatant.z);
+
+    int bucket = bucketIndex(entry.cellX, entry.cellZ);
+    if (_bucketHeads[bucket] < 0)
+        _usedBuckets.push_back(bucket);
+
+    // 头插法加入桶链表
+    entry.next = _bucketHeads[bucket];
+    _bucketHeads[bucket] = (int)_entries.size();
+    _entries.push_back(entry);
+}
+
+int CombatantGrid::cellCoord(float value) const
+{
+    return (int)floorf(value * _invCellSize);
+}
+
+int CombatantGrid::bucketIndex(int cellX, int cellZ) const
+{
+    // 两个大质数混合格子坐标
+    unsigned int h = (unsigned int)cellX * 73856093u ^ (unsigned int)cellZ * 19349663u;
+    return (int)(h & (unsigned int)_bucketMask);
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "cocos2d.h"
+#include "Core/EntityRegistry.h"
+#include <vector>
+
+class EnemyBase;
+class Boss;
+
+/**
+ * 网格中的战斗单位记录
+ * 只保存实体句柄与类别：查询方按类别经 EntityRegistry 取出类型化指针，无需 dynamic_cast；
+ * 记录之后单位被回收(如延迟回调触发时)，查表返回nullptr，不会访问已复用的节点
+ */
+struct Combatant
+{
+    EntityHandle handle;         // 实体句柄
+    EntityKind kind = EntityKind::NONE;  // ENEMY、STORED_ENEMY 或 BOSS
+    float x = 0.0f;              // 登记时的世界坐标X
+    float y = 0.0f;              // 登记时的世界坐标Y
+    float z = 0.0f;              // 登记时的世界坐标Z
+
+    /** 登记时的模拟位置(敌人节点只是渲染代理，判定应以此为准) */
+    cocos2d::Vec3 getPosition() const { return cocos2d::Vec3(x, y, z); }
+};
+
+/**
+ * 战斗单位空间哈希网格(XZ平面均匀网格)
+ * 由场景在每个逻辑tick末尾用存活的敌人/Boss重建，
+ * 攻击判定只检查查询半径覆盖到的格子，不再遍历整个场景的子节点
+ */
+class CombatantGrid
+{
+public:
+    /**
+     * 构造网格
+     * @param cellSize 格子边长(世界单位)
+     * @param bucketCount 哈希桶数量(向上取整为2的幂)
+     */
+    explicit CombatantGrid(float cellSize = 128.0f, int bucketCount = 1024);
+
+    /** 清空所有登记(只重置用到过的桶) */
+    void clear();
+
+    /** 登记普通敌人 */
+    void insert(EnemyBase* enemy, const cocos2d::Vec3& position);
+
+    /** 登记Boss */
+    void insert(Boss* boss, const cocos2d::Vec3& position);
+
+    /**
+     * 按句柄与类别登记(无渲染节点的单位，如无头模拟中的敌人与Boss)
+     * @param handle 实体句柄
+     * @param kind 实体类别
+     * @param position 世界坐标
+     */
+    void insert(EntityHandle handle, EntityKind kind, const cocos2d::Vec3& position);
+
+    /**
+     * 半径查询(XZ平面)
+     * @param center 查询中心
+     * @param radius 查询半径
+     * @param out 输出候选列表(先清空，调用方复用以避免分配)
+     * @return 候选数量
+     */
+    int queryRadius(const cocos2d::Vec3& center, float radius, std::vector<Combatant>& out) const;
+
+    int getCount() const { return (int)_entries.size(); }
+    float getCellSize() const { return _cellSize; }
+
+private:
+    // 内部记录：附带所在格子坐标，用于排除哈希冲突
+    struct Entry
+    {
+        Combatant combatant;
+        int cellX = 0;
+        int cellZ = 0;
+        int next = -1;   // 同桶链表的下一项
+    };
+
+    void insertEntry(const Combatant& combatant);
+    int cellCoord(float value) const;
+    int bucketIndex(int cellX, int cellZ) const;
+
+    float _cellSize = 128.0f;
+    float _invCellSize = 1.0f / 128.0f;
+    int _bucketMask = 1023;
+
+    std::vector<Entry> _entries;
+    std::vector<int> _bucketHeads;     // 每个桶的链表头(-1为空)
+    std::vector<int> _usedBuckets;     // 本轮用到的桶，clear时只重置这些
+};
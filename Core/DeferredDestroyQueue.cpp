@@ -0,0 +1,76 @@
+#include "DeferredDestroyQueue.h"
+#include "EntityLayer.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+DeferredDestroyQueue::~DeferredDestroyQueue()
+{
+    for (auto& entry : _pending)
+        entry.node->release();
+}
+
+void DeferredDestroyQueue::push(Node* node, const DestroyedCallback& onDestroyed)
+{
+    if (!node)
+        return;
+
+    node->retain();
+
+    Entry entry;
+    entry.node = node;
+    entry.onDestroyed = onDestroyed;
+    _pending.push_back(entry);
+}
+
+int DeferredDestroyQueue::drain()
+{
+    if (_pending.empty())
+        return 0;
+
+    _draining.swap(_pending);
+
+    // 按父节点分组(父节点取排空时的值)
+    for (auto& entry : _draining)
+        entry.parent = entry.node->getParent();
+    std::stable_sort(_draining.begin(), _draining.end(),
+        [](const Entry& a, const Entry& b) { return a.parent < b.parent; });
+
+    size_t begin = 0;
+    while (begin < _draining.size())
+    {
+        Node* parent = _draining[begin].parent;
+        size_t end = begin;
+        while (end < _draining.size() && _draining[end].parent == parent)
+            end++;
+
+        if (parent)
+        {
+            // 每组只判断一次容器类型
+            auto layer = dynamic_cast<EntityLayer*>(parent);
+            if (layer && end - begin > 1)
+            {
+                _batch.clear();
+                for (size_t i = begin; i < end; ++i)
+                    _batch.push_back(_draining[i].node);
+                layer->removeChildrenBatch(_batch);
+            }
+            else
+            {
+                for (size_t i = begin; i < end; ++i)
+                    _draining[i].node->removeFromParent();
+            }
+        }
+        begin = end;
+    }
+
+    int removed = (int)_draining.size();
+    for (auto& entry : _draining)
+    {
+        if (entry.onDestroyed)
+            entry.onDestroyed(entry.node);
+        entry.node->release();
+    }
+    _draining.clear();
+    return removed;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "cocos2d.h"
+#include <functional>
+#include <vector>
+
+/**
+ * 延迟销毁队列
+ * 逻辑代码(动作回调、对象池、Boss死亡等)不直接 removeFromParent，而是把节点交给队列；
+ * 场景每帧统一排空一次：按父节点分组，实体容器(EntityLayer)下的节点批量移除，
+ * 其余节点逐个移除，最后依次调用销毁回调(例如对象池把节点放回空闲表)。
+ * 入队期间队列持有节点引用，保证节点在排空前不会被释放。
+ */
+class DeferredDestroyQueue
+{
+public:
+    using DestroyedCallback = std::function<void(cocos2d::Node*)>;
+
+    DeferredDestroyQueue() {}
+    ~DeferredDestroyQueue();
+
+    /**
+     * 节点入队(调用方保证同一节点在排空前只入队一次)
+     * @param node 待移除的节点
+     * @param onDestroyed 移出场景后的回调(可为空)
+     */
+    void push(cocos2d::Node* node, const DestroyedCallback& onDestroyed = nullptr);
+
+    /**
+     * 排空队列(每帧调用一次)
+     * 回调中新入队的节点留到下一次排空
+     * @return 本次移除的节点数
+     */
+    int drain();
+
+    int getPendingCount() const { return (int)_pending.size(); }
+
+private:
+    struct Entry
+    {
+        cocos2d::Node* node = nullptr;
+        cocos2d::Node* parent = nullptr;
+        DestroyedCallback onDestroyed;
+    };
+
+    std::vector<Entry> _pending;
+    std::vector<Entry> _draining;          // 正在排空的批次(复用)
+    std::vector<cocos2d::Node*> _batch;    // 同一容器下的节点(复用)
+};
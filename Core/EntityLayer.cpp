@@ -0,0 +1,36 @@
+#include "EntityLayer.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+int EntityLayer::removeChildrenBatch(std::vector<Node*>& children, bool cleanup)
+{
+    // 只保留确实属于本容器的节点，排序后用二分查找判定
+    children.erase(std::remove_if(children.begin(), children.end(),
+        [this](Node* child) { return !child || child->getParent() != this; }), children.end());
+    if (children.empty())
+        return 0;
+
+    std::sort(children.begin(), children.end());
+    children.erase(std::unique(children.begin(), children.end()), children.end());
+
+    // 与 Node::detachChild 相同的退出流程
+    for (auto child : children)
+    {
+        if (_running)
+        {
+            child->onExitTransitionDidStart();
+            child->onExit();
+        }
+        if (cleanup)
+            child->cleanup();
+        child->setParent(nullptr);
+    }
+
+    // 一次稳定分区把待移除节点移到尾部，再一次性删除(Vector::erase 负责 release)
+    auto removedBegin = std::stable_partition(_children.begin(), _children.end(),
+        [&children](Node* child) { return !std::binary_search(children.begin(), children.end(), child); });
+    _children.erase(removedBegin, _children.end());
+
+    return (int)children.size();
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "cocos2d.h"
+#include <vector>
+
+/**
+ * 实体容器节点
+ * 敌人等大量同类实体挂在专用容器下，而不是直接挂在场景上：
+ * - 场景的子节点列表保持很短，其他节点的增删不受实体数量影响
+ * - 批量移除时只对本容器的子节点列表做一次稳定分区与一次区间删除，
+ *   代替逐个 removeFromParent 的线性查找 + 中间删除
+ */
+class EntityLayer : public cocos2d::Node
+{
+public:
+    CREATE_FUNC(EntityLayer);
+
+    /**
+     * 批量移除子节点(保持剩余子节点的相对顺序)
+     * @param children 待移除节点(会被排序去重；不属于本容器的节点被忽略)
+     * @param cleanup 是否停止被移除节点的动作与调度
+     * @return 实际移除的数量
+     */
+    int removeChildrenBatch(std::vector<cocos2d::Node*>& children, bool cleanup = true);
+};
@@ -0,0 +1,153 @@
+#include "EntityRegistry.h"
+#include "Player/Player.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/EnemyStore.h"
+#include "Enemy/Boss/BossLogic.h"
+
+USING_NS_CC;
+
+// 空闲槽位数超过该值才复用最早释放的槽位
+static const size_t MIN_FREE_SLOTS = 256;
+
+EntityRegistry* EntityRegistry::s_instance = nullptr;
+
+EntityRegistry* EntityRegistry::getInstance()
+{
+    if (!s_instance)
+        s_instance = new (std::nothrow) EntityRegistry();
+    return s_instance;
+}
+
+void EntityRegistry::destroyInstance()
+{
+    CC_SAFE_DELETE(s_instance);
+}
+
+EntityHandle EntityRegistry::createPlayer(Player* player, Node* node)
+{
+    return create(EntityKind::PLAYER, player, node);
+}
+
+EntityHandle EntityRegistry::createEnemy(EnemyBase* enemy)
+{
+    return create(EntityKind::ENEMY, enemy, enemy);
+}
+
+EntityHandle EntityRegistry::createBoss(BossLogic* boss, Node* node)
+{
+    return create(EntityKind::BOSS, boss, node);
+}
+
+EntityHandle EntityRegistry::createStoredEnemy(EnemyStore* store, int index)
+{
+    EntityHandle handle = create(EntityKind::STORED_ENEMY, store, nullptr);
+    if (!handle.isNull())
+        _slots[handle.getIndex()].index = index;
+    return handle;
+}
+
+void EntityRegistry::setStoredEnemyIndex(EntityHandle handle, int index)
+{
+    const Slot* slot = lookup(handle);
+    if (!slot || slot->kind != EntityKind::STORED_ENEMY)
+        return;
+    _slots[handle.getIndex()].index = index;
+}
+
+EntityHandle EntityRegistry::create(EntityKind kind, void* object, Node* node)
+{
+    if (!object)
+        return EntityHandle();
+
+    uint32_t index = 0;
+    if (_freeSlots.size() > MIN_FREE_SLOTS)
+    {
+        index = _freeSlots.front();
+        _freeSlots.pop_front();
+    }
+    else
+    {
+        CCASSERT(_slots.size() <= EntityHandle::INDEX_MASK, "EntityRegistry: out of slots");
+        index = (uint32_t)_slots.size();
+        _slots.push_back(Slot());
+    }
+
+    Slot& slot = _slots[index];
+    slot.node = node;
+    slot.object = object;
+    slot.kind = kind;
+    _aliveCount++;
+    return EntityHandle(index, slot.generation);
+}
+
+void EntityRegistry::destroy(EntityHandle handle)
+{
+    if (!lookup(handle))
+        return;
+
+    uint32_t index = handle.getIndex();
+    Slot& slot = _slots[index];
+    slot.node = nullptr;
+    slot.object = nullptr;
+    slot.index = -1;
+    slot.kind = EntityKind::NONE;
+
+    // 代数回绕时跳过0，保证句柄值永不为0
+    slot.generation = (slot.generation + 1) & EntityHandle::GENERATION_MASK;
+    if (slot.generation == 0)
+        slot.generation = 1;
+
+    _freeSlots.push_back(index);
+    _aliveCount--;
+}
+
+const EntityRegistry::Slot* EntityRegistry::lookup(EntityHandle handle) const
+{
+    uint32_t index = handle.getIndex();
+    if (handle.isNull() || index >= _slots.size())
+        return nullptr;
+
+    const Slot& slot = _slots[index];
+    if (slot.generation != handle.getGeneration() || slot.kind == EntityKind::NONE)
+        return nullptr;
+    return &slot;
+}
+
+EntityKind EntityRegistry::getKind(EntityHandle handle) const
+{
+    const Slot* slot = lookup(handle);
+    return slot ? slot->kind : EntityKind::NONE;
+}
+
+Node* EntityRegistry::getNode(EntityHandle handle) const
+{
+    const Slot* slot = lookup(handle);
+    return slot ? slot->node : nullptr;
+}
+
+Player* EntityRegistry::getPlayer(EntityHandle handle) const
+{
+    const Slot* slot = lookup(handle);
+    return slot && slot->kind == EntityKind::PLAYER ? static_cast<Player*>(slot->object) : nullptr;
+}
+
+EnemyBase* EntityRegistry::getEnemy(EntityHandle handle) const
+{
+    const Slot* slot = lookup(handle);
+    return slot && slot->kind == EntityKind::ENEMY ? static_cast<EnemyBase*>(slot->object) : nullptr;
+}
+
+BossLogic* EntityRegistry::getBoss(EntityHandle handle) const
+{
+    const Slot* slot = lookup(handle);
+    return slot && slot->kind == EntityKind::BOSS ? static_cast<BossLogic*>(slot->object) : nullptr;
+}
+
+EnemyStore* EntityRegistry::getStoredEnemy(EntityHandle handle, int& index) const
+{
+    const Slot* slot = lookup(handle);
+    if (!slot || slot->kind != EntityKind::STORED_ENEMY)
+        return nullptr;
+    index = slot->index;
+    return static_cast<EnemyStore*>(slot->object);
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "cocos2d.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class Player;
+class EnemyBase;
+class EnemyStore;
+class BossLogic;
+
+/**
+ * 实体句柄：32位 = 低20位槽位下标 + 高12位代数
+ * 槽位被回收时代数加一，旧句柄随即失效；值为0表示空句柄
+ * 可按值拷贝、存入网格/数组/lambda，不持有对象引用
+ */
+struct EntityHandle
+{
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
+    uint32_t value = 0;
+
+    EntityHandle() {}
+    EntityHandle(uint32_t index, uint32_t generation)
+        : value(((generation & GENERATION_MASK) << INDEX_BITS) | (index & INDEX_MASK)) {}
+
+    uint32_t getIndex() const { return value & INDEX_MASK; }
+    uint32_t getGeneration() const { return value >> INDEX_BITS; }
+    bool isNull() const { return value == 0; }
+
+    bool operator==(const EntityHandle& other) const { return value == other.value; }
+    bool operator!=(const EntityHandle& other) const { return value != other.value; }
+};
+
+// 实体类别：决定句柄可按哪种类型取出
+enum class EntityKind : unsigned char
+{
+    NONE,
+    PLAYER,   // 主角(Player接口，节点可为空，如无头模拟)
+    ENEMY,    // 普通敌人渲染代理
+    BOSS,     // Boss逻辑(节点可为空，如无头模拟)
+    STORED_ENEMY   // 无渲染代理的普通敌人(无头模拟)：按数据仓库与下标取出
+};
+
+/**
+ * 实体句柄表(全局单例)
+ * 目标选择、伤害判定与延迟回调只保存句柄，使用时经 O(1) 查表校验代数后取出指针：
+ * - 对象销毁或回到对象池时注销句柄，之后的查询返回nullptr，不会访问已释放/已复用的节点
+ * - 按类别直接取出类型化指针(getPlayer/getEnemy/getBoss/getStoredEnemy)，不需要 dynamic_cast
+ * 空闲槽位按先进先出复用，且保留一定数量不立即复用，拉长同一槽位代数回绕的周期
+ */
+class EntityRegistry
+{
+public:
+    static EntityRegistry* getInstance();
+    static void destroyInstance();
+
+    /**
+     * 登记主角
+     * @param player Player接口
+     * @param node 对应的场景节点(无头模拟中为nullptr)
+     * @return 新句柄
+     */
+    EntityHandle createPlayer(Player* player, cocos2d::Node* node = nullptr);
+
+    /** 登记普通敌人(对象池每次借出都重新登记，取得新代数) */
+    EntityHandle createEnemy(EnemyBase* enemy);
+
+    /**
+     * 登记Boss
+     * @param boss Boss逻辑
+     * @param node 对应的场景节点(无头模拟中为nullptr)
+     */
+    EntityHandle createBoss(BossLogic* boss, cocos2d::Node* node = nullptr);
+
+    /**
+     * 登记无渲染代理的普通敌人(有代理的敌人由代理登记)
+     * @param store 所在的数据仓库
+     * @param index 数据下标
+     */
+    EntityHandle createStoredEnemy(EnemyStore* store, int index);
+
+    /**
+     * 更新无代理敌人的数据下标(数据仓库移动元素时调用，失效或类别不符时忽略)
+     * @param handle 句柄
+     * @param index 新下标
+     */
+    void setStoredEnemyIndex(EntityHandle handle, int index);
+
+    /**
+     * 注销句柄，槽位代数加一(空句柄或已失效的句柄忽略)
+     * @param handle 句柄
+     */
+    void destroy(EntityHandle handle);
+
+    /** 句柄是否仍指向存活的实体 */
+    bool isValid(EntityHandle handle) const { return lookup(handle) != nullptr; }
+
+    /** 获取句柄的类别，失效返回 NONE */
+    EntityKind getKind(EntityHandle handle) const;
+
+    /** 获取场景节点，失效或无节点返回nullptr */
+    cocos2d::Node* getNode(EntityHandle handle) const;
+
+    /** 按类别取出类型化指针，失效或类别不符返回nullptr */
+    Player* getPlayer(EntityHandle handle) const;
+    EnemyBase* getEnemy(EntityHandle handle) const;
+    BossLogic* getBoss(EntityHandle handle) const;
+
+    /**
+     * 取出无代理敌人所在的数据仓库与下标
+     * @param handle 句柄
+     * @param index 输出数据下标
+     * @return 数据仓库，失效或类别不符返回nullptr
+     */
+    EnemyStore* getStoredEnemy(EntityHandle handle, int& index) const;
+
+    int getAliveCount() const { return _aliveCount; }
+    int getSlotCount() const { return (int)_slots.size(); }
+
+private:
+    EntityRegistry() {}
+
+    // 槽位记录
+    struct Slot
+    {
+        cocos2d::Node* node = nullptr;
+        void* object = nullptr;         // 按 kind 对应的类型存入，取出时按同一类型转换
+        int index = -1;                 // STORED_ENEMY 的数据下标
+        uint32_t generation = 1;
+        EntityKind kind = EntityKind::NONE;
+    };
+
+    EntityHandle create(EntityKind kind, void* object, cocos2d::Node* node);
+    const Slot* lookup(EntityHandle handle) const;
+
+    std::vector<Slot> _slots;
+    std::deque<uint32_t> _freeSlots;   // 先进先出复用
+    int _aliveCount = 0;
+
+    static EntityRegistry* s_instance;
+};
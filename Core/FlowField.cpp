@@ -0,0 +1,181 @@
+#include "FlowField.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+USING_NS_CC;
+
+// 相邻格移动代价：直行10，斜行14(约10*sqrt2)，保持整数运算
+static const unsigned int STRAIGHT_COST = 10;
+static const unsigned int DIAGONAL_COST = 14;
+static const unsigned int UNREACHABLE = UINT_MAX;
+
+// 8邻域偏移(前4个为直行)
+static const int NEIGHBOR_DX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int NEIGHBOR_DZ[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+FlowField::FlowField()
+{
+}
+
+void FlowField::setBounds(float minX, float minZ, float maxX, float maxZ, float cellSize)
+{
+    _cellSize = cellSize > 0.0f ? cellSize : 50.0f;
+    _invCellSize = 1.0f / _cellSize;
+    _minX = std::min(minX, maxX);
+    _minZ = std::min(minZ, maxZ);
+    _width = std::max(1, (int)ceilf((std::max(minX, maxX) - _minX) * _invCellSize));
+    _height = std::max(1, (int)ceilf((std::max(minZ, maxZ) - _minZ) * _invCellSize));
+
+    _cells.assign(_width * _height, Cell());
+    _goalCell = -1;
+    _dirty = true;
+}
+
+void FlowField::blockArea(float minX, float minZ, float maxX, float maxZ)
+{
+    if (_cells.empty())
+        return;
+
+    int x0 = std::max(0, (int)floorf((std::min(minX, maxX) - _minX) * _invCellSize));
+    int x1 = std::min(_width - 1, (int)floorf((std::max(minX, maxX) - _minX) * _invCellSize));
+    int z0 = std::max(0, (int)floorf((std::min(minZ, maxZ) - _minZ) * _invCellSize));
+    int z1 = std::min(_height - 1, (int)floorf((std::max(minZ, maxZ) - _minZ) * _invCellSize));
+
+    for (int z = z0; z <= z1; ++z)
+    {
+        for (int x = x0; x <= x1; ++x)
+            _cells[z * _width + x].walkable = false;
+    }
+    _dirty = true;
+}
+
+void FlowField::clear()
+{
+    _cells.clear();
+    _width = 0;
+    _height = 0;
+    _goalCell = -1;
+    _dirty = true;
+}
+
+bool FlowField::setGoal(const Vec3& goal)
+{
+    if (_cells.empty())
+        return false;
+
+    // 目标在区域外时取最近的边缘格子(主角受走廊边界碰撞限制，通常不会出界)
+    int x = std::max(0, std::min(_width - 1, (int)floorf((goal.x - _minX) * _invCellSize)));
+    int z = std::max(0, std::min(_height - 1, (int)floorf((goal.z - _minZ) * _invCellSize)));
+    int goalCell = z * _width + x;
+
+    if (goalCell == _goalCell && !_dirty)
+        return false;
+
+    _goalCell = goalCell;
+    rebuild();
+    return true;
+}
+
+void FlowField::rebuild()
+{
+    for (auto& cell : _cells)
+    {
+        cell.cost = UNREACHABLE;
+        cell.next = -1;
+    }
+
+    // Dijkstra：从目标格向外积分(目标格即使被标记为不可行走也作为起点)
+    // 边代价只有10/14两种，用按代价取模的桶队列代替堆：桶数大于最大边代价，新入队的代价不会落回当前桶
+    for (auto& bucket : _buckets)
+        bucket.clear();
+    _cells[_goalCell].cost = 0;
+    _buckets[0].push_back(_goalCell);
+    int pending = 1;
+
+    for (unsigned int cost = 0; pending > 0; ++cost)
+    {
+        std::vector<int>& bucket = _buckets[cost % BUCKET_COUNT];
+        for (size_t k = 0; k < bucket.size(); ++k)
+        {
+            const int index = bucket[k];
+            if (_cells[index].cost != cost)
+                continue;   // 已有更短路径，过期记录
+
+            const int cx = index % _width;
+            const int cz = index / _width;
+            for (int n = 0; n < 8; ++n)
+            {
+                const int nx = cx + NEIGHBOR_DX[n];
+                const int nz = cz + NEIGHBOR_DZ[n];
+                if (nx < 0 || nx >= _width || nz < 0 || nz >= _height)
+                    continue;
+
+                const int neighbor = nz * _width + nx;
+                if (!_cells[neighbor].walkable)
+                    continue;
+
+                // 斜向不允许切过墙角：两个直行邻格都须可行走
+                const bool diagonal = n >= 4;
+                if (diagonal && (!_cells[cz * _width + nx].walkable || !_cells[nz * _width + cx].walkable))
+                    continue;
+
+                unsigned int neighborCost = cost + (diagonal ? DIAGONAL_COST : STRAIGHT_COST);
+                if (neighborCost < _cells[neighbor].cost)
+                {
+                    _cells[neighbor].cost = neighborCost;
+                    _cells[neighbor].next = index;   // 对称代价：邻格沿来路即为最短方向
+                    _buckets[neighborCost % BUCKET_COUNT].push_back(neighbor);
+                    pending++;
+                }
+            }
+        }
+        pending -= (int)bucket.size();
+        bucket.clear();
+    }
+
+    _dirty = false;
+    _rebuildCount++;
+}
+
+int FlowField::cellIndexAt(float x, float z) const
+{
+    const float fx = (x - _minX) * _invCellSize;
+    const float fz = (z - _minZ) * _invCellSize;
+    if (fx < 0.0f || fz < 0.0f)
+        return -1;
+
+    const int cx = (int)fx;
+    const int cz = (int)fz;
+    if (cx >= _width || cz >= _height)
+        return -1;
+    return cz * _width + cx;
+}
+
+bool FlowField::sample(float x, float z, float& dirX, float& dirZ) const
+{
+    if (_goalCell < 0)
+        return false;
+
+    const int index = cellIndexAt(x, z);
+    if (index < 0)
+        return false;
+
+    // 下一格就是目标格(或本格即目标/不可达)：交给调用方直线逼近
+    const int next = _cells[index].next;
+    if (next < 0 || next == _goalCell)
+        return false;
+
+    // 朝下一格中心前进：比固定的8方向更平滑，且仍沿最短路径
+    const float targetX = _minX + ((next % _width) + 0.5f) * _cellSize;
+    const float targetZ = _minZ + ((next / _width) + 0.5f) * _cellSize;
+    const float dx = targetX - x;
+    const float dz = targetZ - z;
+    const float length = sqrtf(dx * dx + dz * dz);
+    if (length < 0.0001f)
+        return false;
+
+    dirX = dx / length;
+    dirZ = dz / length;
+    return true;
+}
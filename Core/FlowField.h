@@ -0,0 +1,82 @@
+#pragma once
+
+#include "cocos2d.h"
+#include <vector>
+
+/**
+ * 流场寻路(XZ平面均匀网格)
+ * 覆盖关卡的可行走区域，由目标(主角)所在格子出发做一次 Dijkstra 积分，
+ * 每个格子记录通往目标代价最低的相邻格子：
+ * - 只在目标换格时重建，耗时只与格子数有关，与跟随的敌人数量无关
+ * - 敌人按所在格子 O(1) 取得前进方向，绕开不可行走的格子
+ * 积分与采样都只读写本对象，重建须在主线程、并行更新开始之前完成
+ */
+class FlowField
+{
+public:
+    FlowField();
+
+    /**
+     * 设置可行走区域(全部格子重置为可行走，需重新设置目标)
+     * @param minX 区域X最小值
+     * @param minZ 区域Z最小值
+     * @param maxX 区域X最大值
+     * @param maxZ 区域Z最大值
+     * @param cellSize 格子边长(世界单位)
+     */
+    void setBounds(float minX, float minZ, float maxX, float maxZ, float cellSize);
+
+    /** 把矩形区域覆盖到的格子标记为不可行走(柱子、墙体等)，下次 setGoal 时生效 */
+    void blockArea(float minX, float minZ, float maxX, float maxZ);
+
+    /** 清空区域(之后 sample 一律返回 false) */
+    void clear();
+
+    /**
+     * 更新目标位置，目标换格(或区域改动)时重建流场
+     * @param goal 目标世界坐标
+     * @return 本次是否重建
+     */
+    bool setGoal(const cocos2d::Vec3& goal);
+
+    /**
+     * 采样前进方向
+     * @param x 世界坐标X
+     * @param z 世界坐标Z
+     * @param dirX 输出单位方向X
+     * @param dirZ 输出单位方向Z
+     * @return false 表示不在区域内、不可达或已与目标相邻，调用方应直接朝目标移动
+     */
+    bool sample(float x, float z, float& dirX, float& dirZ) const;
+
+    bool isValid() const { return !_cells.empty(); }
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+    float getCellSize() const { return _cellSize; }
+    unsigned int getRebuildCount() const { return _rebuildCount; }
+
+private:
+    // 单个格子
+    struct Cell
+    {
+        unsigned int cost = 0;   // 到目标的积分代价
+        int next = -1;           // 通往目标的下一格(-1：目标格/不可达/不可行走)
+        bool walkable = true;
+    };
+
+    void rebuild();
+    int cellIndexAt(float x, float z) const;
+
+    std::vector<Cell> _cells;
+    static const int BUCKET_COUNT = 16;                // 桶队列的桶数(须大于最大边代价)
+    std::vector<int> _buckets[BUCKET_COUNT];           // Dijkstra 桶队列(按代价取模，复用容量)
+    float _minX = 0.0f;
+    float _minZ = 0.0f;
+    float _cellSize = 50.0f;
+    float _invCellSize = 1.0f / 50.0f;
+    int _width = 0;
+    int _height = 0;
+    int _goalCell = -1;
+    bool _dirty = true;
+    unsigned int _rebuildCount = 0;
+};
@@ -0,0 +1,220 @@
+#include "FrameProfiler.h"
+
+#if FRAME_PROFILER_ENABLED
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+USING_NS_CC;
+
+// 每帧样本数远小于此值(作用域数 x 每帧tick数)，留足余量给卡顿帧的追帧
+static const unsigned int RING_CAPACITY = 4096;
+
+//------------------------------
+// ProfileRingBuffer
+//------------------------------
+
+ProfileRingBuffer::ProfileRingBuffer(unsigned int capacity)
+    : _head(0)
+    , _tail(0)
+    , _dropped(0)
+{
+    unsigned int size = 1;
+    while (size < capacity)
+        size <<= 1;
+    _slots.resize(size);
+    _mask = size - 1;
+}
+
+bool ProfileRingBuffer::push(const ProfileSample& sample)
+{
+    unsigned int head = _head.load(std::memory_order_relaxed);
+    unsigned int tail = _tail.load(std::memory_order_acquire);
+    if (head - tail > _mask)
+    {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    _slots[head & _mask] = sample;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool ProfileRingBuffer::pop(ProfileSample& sample)
+{
+    unsigned int tail = _tail.load(std::memory_order_relaxed);
+    unsigned int head = _head.load(std::memory_order_acquire);
+    if (tail == head)
+        return false;
+
+    sample = _slots[tail & _mask];
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+//------------------------------
+// FrameProfiler
+//------------------------------
+
+FrameProfiler* FrameProfiler::s_instance = nullptr;
+
+FrameProfiler* FrameProfiler::getInstance()
+{
+    if (!s_instance)
+        s_instance = new (std::nothrow) FrameProfiler();
+    return s_instance;
+}
+
+void FrameProfiler::destroyInstance()
+{
+    CC_SAFE_DELETE(s_instance);
+}
+
+FrameProfiler::FrameProfiler()
+    : _ring(RING_CAPACITY)
+{
+    _epoch = now();
+    _trace.resize(TRACE_CAPACITY);
+}
+
+long long FrameProfiler::now() const
+{
+    auto ticks = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(ticks).count() - _epoch;
+}
+
+int FrameProfiler::registerScope(const char* name)
+{
+    // 同名作用域(例如不同文件中的同名标注)共用一条统计
+    for (size_t i = 0; i < _scopes.size(); ++i)
+    {
+        if (strcmp(_scopes[i].name, name) == 0)
+            return (int)i;
+    }
+
+    ScopeRecord record;
+    record.name = name;
+    record.depth = _depth;
+    record.historyMs.resize(HISTORY_FRAMES);
+    _scopes.push_back(record);
+    return (int)_scopes.size() - 1;
+}
+
+void FrameProfiler::beginFrame()
+{
+    _frameIndex++;
+    _depth = 0;
+}
+
+void FrameProfiler::leaveScope(int scopeId, int depth, long long beginNs)
+{
+    _depth = depth;
+
+    ProfileSample sample;
+    sample.beginNs = beginNs;
+    sample.durationNs = now() - beginNs;
+    sample.frame = _frameIndex;
+    sample.scopeId = (unsigned short)scopeId;
+    sample.depth = (unsigned short)depth;
+    _ring.push(sample);
+}
+
+void FrameProfiler::endFrame()
+{
+    drain();
+
+    for (auto& scope : _scopes)
+    {
+        scope.lastFrameCalls = scope.frameCalls;
+        if (scope.frameCalls > 0)
+        {
+            // 本帧未进入的作用域不计入分位数(例如Boss出现前的Boss逻辑)
+            scope.historyMs[scope.historyNext] = scope.frameNs / 1000000.0f;
+            scope.historyNext = (scope.historyNext + 1) % HISTORY_FRAMES;
+            scope.historyCount = std::min(scope.historyCount + 1, HISTORY_FRAMES);
+        }
+        scope.frameNs = 0;
+        scope.frameCalls = 0;
+    }
+}
+
+void FrameProfiler::drain()
+{
+    ProfileSample sample;
+    while (_ring.pop(sample))
+    {
+        if (sample.scopeId < _scopes.size())
+        {
+            ScopeRecord& scope = _scopes[sample.scopeId];
+            scope.frameNs += sample.durationNs;
+            scope.frameCalls++;
+        }
+
+        _trace[_traceNext] = sample;
+        _traceNext = (_traceNext + 1) % TRACE_CAPACITY;
+        _traceCount = std::min(_traceCount + 1, TRACE_CAPACITY);
+    }
+}
+
+void FrameProfiler::getSummaries(std::vector<ProfileScopeSummary>& out) const
+{
+    out.clear();
+
+    std::vector<float> sorted;
+    for (const auto& scope : _scopes)
+    {
+        ProfileScopeSummary summary;
+        summary.name = scope.name;
+        summary.depth = scope.depth;
+        summary.callsLastFrame = scope.lastFrameCalls;
+
+        if (scope.historyCount > 0)
+        {
+            sorted.assign(scope.historyMs.begin(), scope.historyMs.begin() + scope.historyCount);
+            std::sort(sorted.begin(), sorted.end());
+            auto percentile = [&sorted](float p) {
+                int index = (int)(p * (sorted.size() - 1) + 0.5f);
+                return sorted[index];
+            };
+            summary.p50Ms = percentile(0.50f);
+            summary.p95Ms = percentile(0.95f);
+            summary.p99Ms = percentile(0.99f);
+            summary.maxMs = sorted.back();
+        }
+        out.push_back(summary);
+    }
+}
+
+bool FrameProfiler::dumpChromeTrace(const std::string& path) const
+{
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file)
+    {
+        CCLOGERROR("FrameProfiler: cannot write %s", path.c_str());
+        return false;
+    }
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"main\"}}");
+
+    // 从最旧的样本开始输出
+    int first = (_traceNext - _traceCount + TRACE_CAPACITY) % TRACE_CAPACITY;
+    for (int n = 0; n < _traceCount; ++n)
+    {
+        const ProfileSample& sample = _trace[(first + n) % TRACE_CAPACITY];
+        const char* name = sample.scopeId < _scopes.size() ? _scopes[sample.scopeId].name : "?";
+        fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%u}}",
+            name, sample.beginNs / 1000.0, sample.durationNs / 1000.0, sample.frame);
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+
+    CCLOG("FrameProfiler: %d samples written to %s", _traceCount, path.c_str());
+    return true;
+}
+
+#endif // FRAME_PROFILER_ENABLED
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "cocos2d.h"
+
+// 编译开关：调试构建(COCOS2D_DEBUG>0)默认开启，发布构建整体编译掉（宏展开为空，不留任何代码）
+// 也可在工程中显式定义 FRAME_PROFILER_ENABLED=0/1 覆盖
+#ifndef FRAME_PROFILER_ENABLED
+#if defined(COCOS2D_DEBUG) && COCOS2D_DEBUG > 0
+#define FRAME_PROFILER_ENABLED 1
+#else
+#define FRAME_PROFILER_ENABLED 0
+#endif
+#endif
+
+#if FRAME_PROFILER_ENABLED
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+/** 一次作用域计时记录 */
+struct ProfileSample
+{
+    long long beginNs = 0;        // 开始时间(相对分析器启动，纳秒)
+    long long durationNs = 0;     // 耗时(纳秒)
+    unsigned int frame = 0;       // 所在帧序号
+    unsigned short scopeId = 0;   // 作用域ID(registerScope分配)
+    unsigned short depth = 0;     // 嵌套深度(0为最外层)
+};
+
+/**
+ * 单生产者/单消费者无锁环形缓冲
+ * 生产者只写 head，消费者只写 tail，满时丢弃新样本并计数，不阻塞生产者
+ */
+class ProfileRingBuffer
+{
+public:
+    /** @param capacity 容量(向上取整为2的幂) */
+    explicit ProfileRingBuffer(unsigned int capacity);
+
+    /** 写入样本(生产者线程)，缓冲满返回false */
+    bool push(const ProfileSample& sample);
+
+    /** 取出样本(消费者线程)，缓冲空返回false */
+    bool pop(ProfileSample& sample);
+
+    unsigned int getDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<ProfileSample> _slots;
+    unsigned int _mask = 0;
+    std::atomic<unsigned int> _head;     // 下一个写入位置
+    std::atomic<unsigned int> _tail;     // 下一个读取位置
+    std::atomic<unsigned int> _dropped;
+};
+
+/** 作用域统计摘要(毫秒，按帧汇总：同一帧内多次进入的耗时相加) */
+struct ProfileScopeSummary
+{
+    std::string name;
+    int depth = 0;
+    int callsLastFrame = 0;
+    float p50Ms = 0.0f;
+    float p95Ms = 0.0f;
+    float p99Ms = 0.0f;
+    float maxMs = 0.0f;
+};
+
+/**
+ * 帧耗时分析器(全局单例，仅调试构建)
+ * 通过 PROFILE_FRAME / PROFILE_SCOPE 宏在代码中标注命名、可嵌套的作用域：
+ * - 作用域结束时把样本写入无锁环形缓冲
+ * - 每帧结束时取出样本，按作用域累计本帧耗时，保留最近若干帧用于分位数统计
+ * - 同时保留最近一段样本，可导出为 Chrome trace JSON（chrome://tracing 打开）
+ * 作用域的登记与计时只在主线程进行
+ */
+class FrameProfiler
+{
+public:
+    static FrameProfiler* getInstance();
+    static void destroyInstance();
+
+    /**
+     * 登记作用域名称(每个标注点只调用一次，由宏缓存结果)
+     * @param name 名称(字符串字面量，需长期有效)
+     * @return 作用域ID
+     */
+    int registerScope(const char* name);
+
+    /** 开始一帧 */
+    void beginFrame();
+
+    /** 结束一帧：取出本帧样本并汇总 */
+    void endFrame();
+
+    /** 进入作用域，返回嵌套深度 */
+    int enterScope() { return _depth++; }
+
+    /** 离开作用域，写入样本 */
+    void leaveScope(int scopeId, int depth, long long beginNs);
+
+    /** 当前时间(相对分析器启动，纳秒) */
+    long long now() const;
+
+    /**
+     * 获取各作用域统计(按首次进入的顺序，父作用域在前)
+     * @param out 输出摘要(先清空)
+     */
+    void getSummaries(std::vector<ProfileScopeSummary>& out) const;
+
+    /**
+     * 导出最近的样本为 Chrome trace JSON
+     * @param path 输出文件路径
+     * @return 写入成功返回true
+     */
+    bool dumpChromeTrace(const std::string& path) const;
+
+    unsigned int getFrameIndex() const { return _frameIndex; }
+    unsigned int getDroppedCount() const { return _ring.getDroppedCount(); }
+
+    static const int HISTORY_FRAMES = 300;     // 分位数统计的帧窗口
+    static const int TRACE_CAPACITY = 65536;   // 可导出的最近样本数
+
+private:
+    FrameProfiler();
+
+    // 单个作用域的统计
+    struct ScopeRecord
+    {
+        const char* name = nullptr;
+        int depth = 0;
+        long long frameNs = 0;            // 本帧累计耗时
+        int frameCalls = 0;               // 本帧进入次数
+        int lastFrameCalls = 0;
+        std::vector<float> historyMs;     // 最近各帧耗时(环形)
+        int historyNext = 0;
+        int historyCount = 0;
+    };
+
+    void drain();
+
+    static FrameProfiler* s_instance;
+
+    ProfileRingBuffer _ring;
+    std::vector<ScopeRecord> _scopes;
+    std::vector<ProfileSample> _trace;    // 最近样本(环形)
+    int _traceNext = 0;
+    int _traceCount = 0;
+    unsigned int _frameIndex = 0;
+    int _depth = 0;
+    long long _epoch = 0;
+};
+
+/** 作用域计时对象(由 PROFILE_SCOPE 宏创建) */
+class FrameProfileScope
+{
+public:
+    explicit FrameProfileScope(int scopeId)
+        : _scopeId(scopeId)
+    {
+        FrameProfiler* profiler = FrameProfiler::getInstance();
+        _depth = profiler->enterScope();
+        _beginNs = profiler->now();
+    }
+
+    ~FrameProfileScope()
+    {
+        FrameProfiler::getInstance()->leaveScope(_scopeId, _depth, _beginNs);
+    }
+
+private:
+    int _scopeId;
+    int _depth;
+    long long _beginNs;
+};
+
+/** 帧计时对象(由 PROFILE_FRAME 宏创建)：构造时开始一帧，析构时结束，提前 return 也能正确收尾 */
+class FrameProfileFrame
+{
+public:
+    explicit FrameProfileFrame(int scopeId)
+        : _scopeId(scopeId)
+    {
+        FrameProfiler* profiler = FrameProfiler::getInstance();
+        profiler->beginFrame();
+        _depth = profiler->enterScope();
+        _beginNs = profiler->now();
+    }
+
+    ~FrameProfileFrame()
+    {
+        FrameProfiler* profiler = FrameProfiler::getInstance();
+        profiler->leaveScope(_scopeId, _depth, _beginNs);
+        profiler->endFrame();
+    }
+
+private:
+    int _scopeId;
+    int _depth;
+    long long _beginNs;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+/** 标注一个命名作用域(到所在块结束为止) */
+#define PROFILE_SCOPE(name) \
+    static const int PROFILE_CONCAT(_profileScopeId, __LINE__) = FrameProfiler::getInstance()->registerScope(name); \
+    FrameProfileScope PROFILE_CONCAT(_profileScope, __LINE__)(PROFILE_CONCAT(_profileScopeId, __LINE__))
+
+/** 标注一帧的最外层作用域(每帧调用一次) */
+#define PROFILE_FRAME(name) \
+    static const int PROFILE_CONCAT(_profileFrameId, __LINE__) = FrameProfiler::getInstance()->registerScope(name); \
+    FrameProfileFrame PROFILE_CONCAT(_profileFrame, __LINE__)(PROFILE_CONCAT(_profileFrameId, __LINE__))
+
+#else
+
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME(name) ((void)0)
+
+#endif // FRAME_PROFILER_ENABLED
@@ -0,0 +1,220 @@
+#include "GameplayTask.h"
+#include <algorithm>
+
+// =========================================================================
+// TaskArena
+// =========================================================================
+
+void* TaskArena::allocate(size_t size)
+{
+    if (size > (size_t)SLOT_BYTES)
+        return nullptr;
+
+    for (int i = 0; i < SLOT_COUNT; ++i)
+    {
+        if ((_usedMask & (1u << i)) == 0)
+        {
+            _usedMask |= 1u << i;
+            return _slots[i];
+        }
+    }
+    return nullptr;
+}
+
+void TaskArena::release(void* memory)
+{
+    const ptrdiff_t offset = static_cast<unsigned char*>(memory) - &_slots[0][0];
+    if (offset < 0 || offset >= (ptrdiff_t)sizeof(_slots))
+        return;
+    _usedMask &= ~(1u << (offset / SLOT_BYTES));
+}
+
+int TaskArena::getUsedCount() const
+{
+    int count = 0;
+    for (int i = 0; i < SLOT_COUNT; ++i)
+    {
+        if (_usedMask & (1u << i))
+            count++;
+    }
+    return count;
+}
+
+// =========================================================================
+// GameplayTask
+// =========================================================================
+
+void GameplayTask::waitTicks(uint32_t ticks)
+{
+    _wakeTick = _scheduler->getCurrentTick() + std::max(1u, ticks);
+}
+
+void GameplayTask::waitSeconds(float seconds)
+{
+    waitTicks(_scheduler->secondsToTicks(seconds));
+}
+
+void GameplayTask::startClip(ClipId clip, float fallbackDuration)
+{
+    _clipStartTick = _scheduler->getCurrentTick();
+    _clipDuration = AnimationClipCache::getInstance()->getDuration(clip);
+    if (_clipDuration <= 0.0f)
+        _clipDuration = fallbackDuration;
+    _clipStarted = true;
+}
+
+bool GameplayTask::waitMarker(float fraction)
+{
+    if (!_clipStarted)
+        return false;
+
+    return waitClipTime(_clipDuration * fraction);
+}
+
+bool GameplayTask::waitClipTime(float seconds)
+{
+    if (!_clipStarted)
+        return false;
+
+    const uint64_t target = _clipStartTick + (uint64_t)std::max(0.0f, seconds * _scheduler->getTicksPerSecond() + 0.5f);
+    if (target <= _scheduler->getCurrentTick())
+        return false;
+
+    _wakeTick = target;
+    return true;
+}
+
+float GameplayTask::getClipTime() const
+{
+    if (!_clipStarted)
+        return 0.0f;
+    return (float)(_scheduler->getCurrentTick() - _clipStartTick) / _scheduler->getTicksPerSecond();
+}
+
+uint64_t GameplayTask::getCurrentTick() const
+{
+    return _scheduler->getCurrentTick();
+}
+
+// =========================================================================
+// TaskScheduler
+// =========================================================================
+
+TaskScheduler::TaskScheduler()
+{
+}
+
+void TaskScheduler::reserve(int count)
+{
+    _entries.reserve(count);
+}
+
+void TaskScheduler::setTickInterval(float seconds)
+{
+    if (seconds > 0.0f)
+        _ticksPerSecond = 1.0f / seconds;
+}
+
+uint32_t TaskScheduler::secondsToTicks(float seconds) const
+{
+    if (seconds <= 0.0f)
+        return 1;
+    return std::max(1u, (uint32_t)(seconds * _ticksPerSecond + 0.5f));
+}
+
+bool TaskScheduler::launch(GameplayTask* task, TaskArena& arena, EntityHandle owner)
+{
+    task->_scheduler = this;
+    task->_wakeTick = _now;
+
+    // 先登记再执行：第一段脚本中取消所属实体的任务时也能找到它
+    Entry entry;
+    entry.wakeTick = _now;
+    entry.task = task;
+    entry.arena = &arena;
+    entry.owner = owner;
+    _entries.push_back(entry);
+    _runningCount++;
+    return resumeEntry(_entries.size() - 1);
+}
+
+bool TaskScheduler::resumeEntry(size_t index)
+{
+    // 任务中可能启动新任务导致表扩容，执行后按下标重新取表项
+    GameplayTask* task = _entries[index].task;
+    task->_executing = true;
+    const bool waiting = task->resume();
+    task->_executing = false;
+    _resumeCount++;
+
+    Entry& entry = _entries[index];
+    if (!waiting || task->_cancelled)
+    {
+        entry.arena->release(task);
+        entry.task = nullptr;
+        _runningCount--;
+        return false;
+    }
+    entry.wakeTick = task->_wakeTick;
+    return true;
+}
+
+int TaskScheduler::cancelOwner(EntityHandle owner)
+{
+    if (owner.isNull())
+        return 0;
+
+    int cancelled = 0;
+    for (auto& entry : _entries)
+    {
+        if (!entry.task || entry.owner != owner)
+            continue;
+
+        cancelled++;
+        if (entry.task->_executing)
+        {
+            // 正在执行(可能就是调用者自己)：返回后再释放
+            entry.task->_cancelled = true;
+            continue;
+        }
+        entry.arena->release(entry.task);
+        entry.task = nullptr;
+        _runningCount--;
+    }
+    return cancelled;
+}
+
+void TaskScheduler::advance()
+{
+    _now++;
+
+    // 成批扫描：只比较表项中的唤醒tick，到期的才访问任务内存
+    auto registry = EntityRegistry::getInstance();
+    for (size_t i = 0; i < _entries.size(); ++i)
+    {
+        const Entry& entry = _entries[i];
+        if (!entry.task || entry.wakeTick > _now)
+            continue;
+
+        // 所属实体已销毁：内存池随实体一起释放，任务内存已失效，不能再访问，直接丢弃表项
+        if (!entry.owner.isNull() && !registry->isValid(entry.owner))
+        {
+            _entries[i].task = nullptr;
+            _runningCount--;
+            continue;
+        }
+        if (entry.task->_executing)
+            continue;
+        resumeEntry(i);
+    }
+
+    _entries.erase(std::remove_if(_entries.begin(), _entries.end(),
+        [](const Entry& entry) { return entry.task == nullptr; }), _entries.end());
+}
+
+void TaskScheduler::clear()
+{
+    // 不访问任务内存(所属实体可能已经销毁)
+    _entries.clear();
+    _runningCount = 0;
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "Core/EntityRegistry.h"
+#include "Core/AnimationClipCache.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class TaskScheduler;
+
+/**
+ * 单个角色的任务内存池
+ * 固定数量、固定大小的槽位内嵌在角色对象中，启动任务时从这里取内存，不经全局堆
+ */
+class TaskArena
+{
+public:
+    static const int SLOT_BYTES = 192;   // 单个任务(含成员)的最大字节数
+    static const int SLOT_COUNT = 4;     // 同一角色同时运行的最大任务数
+
+    TaskArena() {}
+    TaskArena(const TaskArena&) = delete;
+    TaskArena& operator=(const TaskArena&) = delete;
+
+    /** 取一个槽位(尺寸超限或槽位用尽返回nullptr) */
+    void* allocate(size_t size);
+    /** 归还槽位 */
+    void release(void* memory);
+
+    int getUsedCount() const;
+
+private:
+    alignas(std::max_align_t) unsigned char _slots[SLOT_COUNT][SLOT_BYTES];
+    unsigned int _usedMask = 0;
+};
+
+/**
+ * 玩法脚本任务(无栈协程)
+ * 派生类在 resume() 中用 TASK_BEGIN/TASK_END 包住脚本，中间以 TASK_AWAIT_* 挂起：
+ *   bool resume() override
+ *   {
+ *       TASK_BEGIN();
+ *       startClip(clip);
+ *       TASK_AWAIT_MARKER(0.5f);     // 动画播放到一半(判定帧)
+ *       ...
+ *       TASK_AWAIT_SECONDS(3.0f);
+ *       TASK_END();
+ *   }
+ * 挂起点之间的局部变量不会保存，跨挂起点的状态放在任务成员中(跨越初始化时编译器会报错)。
+ * 恢复点以行号区分：同一行不能写两个 TASK_AWAIT_*，否则会产生重复的 case 标签。
+ * 任务内存在所属角色的 TaskArena 中，必须可平凡析构：被取消或所属实体失效时直接丢弃，不调用析构函数。
+ */
+class GameplayTask
+{
+public:
+    /**
+     * 从上次挂起处继续执行，直到下一个挂起点或脚本结束
+     * @return true 表示挂起等待，false 表示已结束
+     */
+    virtual bool resume() = 0;
+
+protected:
+    /** 挂起指定tick数(至少1个) */
+    void waitTicks(uint32_t ticks);
+    /** 挂起指定秒数(四舍五入到tick，至少1个) */
+    void waitSeconds(float seconds);
+
+    /**
+     * 记录开始播放的动画片段，之后的 TASK_AWAIT_MARKER 以它的时长为准
+     * @param clip 动画片段
+     * @param fallbackDuration 片段时长未知(未登记或资源缺失，如无头模拟)时使用的时长
+     */
+    void startClip(ClipId clip, float fallbackDuration = 0.0f);
+    /**
+     * 挂起到当前片段播放到指定比例处
+     * @param fraction 片段内的归一化时间(0~1)
+     * @return 是否需要挂起(该时刻已过返回false)
+     */
+    bool waitMarker(float fraction);
+    /**
+     * 挂起到当前片段播放到指定时刻(秒)
+     * @return 是否需要挂起(该时刻已过返回false)
+     */
+    bool waitClipTime(float seconds);
+    /** 当前片段已播放的时间(秒)，未调用 startClip 返回0 */
+    float getClipTime() const;
+
+    uint64_t getCurrentTick() const;
+
+    int _resumePoint = 0;   // 恢复点(TASK_* 宏使用)
+
+private:
+    friend class TaskScheduler;
+
+    TaskScheduler* _scheduler = nullptr;
+    uint64_t _wakeTick = 0;
+    uint64_t _clipStartTick = 0;
+    float _clipDuration = 0.0f;   // startClip 时确定的片段时长
+    bool _clipStarted = false;
+    bool _executing = false;   // 正在 resume 中
+    bool _cancelled = false;   // 执行中被取消，返回后再释放
+};
+
+#define TASK_BEGIN() switch (_resumePoint) { case 0:
+
+#define TASK_END() } _resumePoint = -1; return false
+
+/** 挂起指定tick数 */
+#define TASK_AWAIT_TICKS(ticks) \
+    do { waitTicks(ticks); _resumePoint = __LINE__; return true; case __LINE__:; } while (0)
+
+/** 挂起指定秒数 */
+#define TASK_AWAIT_SECONDS(seconds) \
+    do { waitSeconds(seconds); _resumePoint = __LINE__; return true; case __LINE__:; } while (0)
+
+/** 挂起到 startClip 登记的片段播放到指定比例处 */
+#define TASK_AWAIT_MARKER(fraction) \
+    do { if (waitMarker(fraction)) { _resumePoint = __LINE__; return true; case __LINE__:; } } while (0)
+
+/** 挂起到 startClip 登记的片段播放到指定秒数处(命中窗口等烘焙数据使用) */
+#define TASK_AWAIT_CLIP_TIME(seconds) \
+    do { if (waitClipTime(seconds)) { _resumePoint = __LINE__; return true; case __LINE__:; } } while (0)
+
+/**
+ * 挂起直到条件成立(每个tick检查一次，成立时立即继续)
+ * 首次检查不成立才记录恢复点并返回，恢复时从 case 标签处重新检查，没有贯穿进入标签的路径
+ */
+#define TASK_AWAIT_UNTIL(condition) \
+    do { if (!(condition)) { waitTicks(1); _resumePoint = __LINE__; return true; \
+        case __LINE__: if (!(condition)) { waitTicks(1); return true; } } } while (0)
+
+/**
+ * 任务调度器(由模拟驱动器持有，每个逻辑tick推进一次)
+ * - 启动时在角色的内存池中构造任务并立即执行到第一个挂起点
+ * - 每tick按唤醒tick成批扫描等待中的任务并恢复执行
+ * - 所属实体被打断(cancelOwner)或失效时丢弃其任务；任务执行中取消自身也是安全的
+ */
+class TaskScheduler
+{
+public:
+    TaskScheduler();
+
+    /** 预分配任务表容量 */
+    void reserve(int count);
+
+    /** 设置tick间隔(秒)，用于把等待秒数换算成tick数 */
+    void setTickInterval(float seconds);
+
+    /**
+     * 启动任务
+     * @param arena 所属角色的内存池
+     * @param owner 所属实体(空句柄表示不属于任何实体)
+     * @param args 任务构造参数
+     * @return 仍在等待的任务；立即结束或内存池已满返回nullptr
+     */
+    template <typename T, typename... Args>
+    T* start(TaskArena& arena, EntityHandle owner, Args&&... args)
+    {
+        static_assert(std::is_base_of<GameplayTask, T>::value, "TaskScheduler: task must derive from GameplayTask");
+        static_assert(sizeof(T) <= TaskArena::SLOT_BYTES, "TaskScheduler: task too large for TaskArena");
+        static_assert(std::is_trivially_destructible<T>::value, "TaskScheduler: task must be trivially destructible");
+
+        void* memory = arena.allocate(sizeof(T));
+        if (!memory)
+        {
+            _rejectedCount++;
+            return nullptr;
+        }
+        T* task = new (memory) T(std::forward<Args>(args)...);
+        return launch(task, arena, owner) ? task : nullptr;
+    }
+
+    /**
+     * 取消实体的全部任务(被打断、死亡时调用)
+     * @return 取消的数量
+     */
+    int cancelOwner(EntityHandle owner);
+
+    /** 推进一个tick，恢复到期的任务 */
+    void advance();
+
+    /** 丢弃全部任务 */
+    void clear();
+
+    uint64_t getCurrentTick() const { return _now; }
+    uint32_t secondsToTicks(float seconds) const;
+    float getTicksPerSecond() const { return _ticksPerSecond; }
+    int getRunningCount() const { return _runningCount; }
+    /** 累计恢复执行次数 */
+    unsigned long long getResumeCount() const { return _resumeCount; }
+    /** 内存池已满而未能启动的次数 */
+    unsigned int getRejectedCount() const { return _rejectedCount; }
+
+private:
+    struct Entry
+    {
+        uint64_t wakeTick = 0;            // 与任务内的唤醒tick同步，扫描时不必访问任务内存
+        GameplayTask* task = nullptr;     // 为空表示已结束/已取消(推进结束时压缩)
+        TaskArena* arena = nullptr;
+        EntityHandle owner;
+    };
+
+    bool launch(GameplayTask* task, TaskArena& arena, EntityHandle owner);
+    bool resumeEntry(size_t index);
+
+    std::vector<Entry> _entries;        // 结束/取消的表项在每次推进结束时统一移除
+    uint64_t _now = 0;
+    float _ticksPerSecond = 60.0f;
+    int _runningCount = 0;
+    unsigned long long _resumeCount = 0;
+    unsigned int _rejectedCount = 0;
+};
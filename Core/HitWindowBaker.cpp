@@ -0,0 +1,232 @@
+#include "HitWindowBaker.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+USING_NS_CC;
+
+static const float MERGE_GAP = 0.05f;        // 间隔短于该值(秒)的相邻窗口合并
+static const float MIN_WINDOW = 0.03f;       // 短于该值(秒)的窗口视为抖动丢弃
+static const float MIN_PEAK_SPEED = 1e-3f;   // 峰值速度低于该值视为骨骼未运动
+
+namespace
+{
+    // 取关键帧曲线在 time 处的插值；曲线为空返回false
+    bool sampleVec3(const std::vector<Animation3DData::Vec3Key>& keys, float time, Vec3* out)
+    {
+        if (keys.empty())
+            return false;
+        if (time <= keys.front()._time)
+        {
+            *out = keys.front()._key;
+            return true;
+        }
+        for (size_t k = 1; k < keys.size(); ++k)
+        {
+            if (time <= keys[k]._time)
+            {
+                const float span = keys[k]._time - keys[k - 1]._time;
+                const float t = span > 0.0f ? (time - keys[k - 1]._time) / span : 1.0f;
+                *out = keys[k - 1]._key.lerp(keys[k]._key, t);
+                return true;
+            }
+        }
+        *out = keys.back()._key;
+        return true;
+    }
+
+    bool sampleQuat(const std::vector<Animation3DData::QuatKey>& keys, float time, Quaternion* out)
+    {
+        if (keys.empty())
+            return false;
+        if (time <= keys.front()._time)
+        {
+            *out = keys.front()._key;
+            return true;
+        }
+        for (size_t k = 1; k < keys.size(); ++k)
+        {
+            if (time <= keys[k]._time)
+            {
+                const float span = keys[k]._time - keys[k - 1]._time;
+                const float t = span > 0.0f ? (time - keys[k - 1]._time) / span : 1.0f;
+                Quaternion::slerp(keys[k - 1]._key, keys[k]._key, t, out);
+                return true;
+            }
+        }
+        *out = keys.back()._key;
+        return true;
+    }
+
+    // 一次采样：按层级累乘各节点的局部变换，记下每个节点在模型空间中的位置
+    void samplePose(const NodeData* node, const Mat4& parent, const Animation3DData& animation, float keyTime,
+        std::map<std::string, Vec3>& positions)
+    {
+        Mat4 local = node->transform;
+        Vec3 translation, scale;
+        Quaternion rotation;
+        auto translationIt = animation._translationKeys.find(node->id);
+        auto rotationIt = animation._rotationKeys.find(node->id);
+        auto scaleIt = animation._scaleKeys.find(node->id);
+        const bool animated = translationIt != animation._translationKeys.end() ||
+            rotationIt != animation._rotationKeys.end() || scaleIt != animation._scaleKeys.end();
+        if (animated)
+        {
+            // 没有关键帧的通道沿用绑定姿势
+            node->transform.decompose(&scale, &rotation, &translation);
+            if (translationIt != animation._translationKeys.end())
+                sampleVec3(translationIt->second, keyTime, &translation);
+            if (rotationIt != animation._rotationKeys.end())
+                sampleQuat(rotationIt->second, keyTime, &rotation);
+            if (scaleIt != animation._scaleKeys.end())
+                sampleVec3(scaleIt->second, keyTime, &scale);
+
+            Mat4 t, r, s;
+            Mat4::createTranslation(translation, &t);
+            Mat4::createRotation(rotation, &r);
+            Mat4::createScale(scale, &s);
+            local = t * r * s;
+        }
+
+        Mat4 world = parent * local;
+        positions[node->id] = Vec3(world.m[12], world.m[13], world.m[14]);
+        for (const NodeData* child : node->children)
+            samplePose(child, world, animation, keyTime, positions);
+    }
+}
+
+bool HitWindowBaker::bakeClip(const HitWindowBakeSpec& spec, HitWindowTable* table)
+{
+    Bundle3D* bundle = Bundle3D::createBundle();
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(spec.modelPath);
+    if (!bundle || !bundle->load(fullPath))
+    {
+        CCLOGWARN("HitWindowBaker: failed to load %s", spec.modelPath.c_str());
+        if (bundle)
+            Bundle3D::destroyBundle(bundle);
+        return false;
+    }
+
+    NodeDatas nodeDatas;
+    Animation3DData animation;
+    bool loaded = bundle->loadNodes(nodeDatas) && bundle->loadAnimationData(spec.clipName, &animation);
+    Bundle3D::destroyBundle(bundle);
+    if (!loaded || animation._totalTime <= 0.0f)
+    {
+        CCLOGWARN("HitWindowBaker: no clip %s in %s", spec.clipName.c_str(), spec.modelPath.c_str());
+        return false;
+    }
+
+    // 逐帧采样全部节点位置(c3b 关键帧时间为片段内归一化时间)
+    const float duration = animation._totalTime;
+    const int sampleCount = std::max(3, (int)std::ceil(duration * SAMPLE_RATE) + 1);
+    const float dt = duration / (sampleCount - 1);
+    std::map<std::string, std::vector<Vec3>> tracks;
+    std::map<std::string, Vec3> positions;
+    for (int i = 0; i < sampleCount; ++i)
+    {
+        positions.clear();
+        const float keyTime = (float)i / (sampleCount - 1);
+        for (const NodeData* root : nodeDatas.skeleton)
+            samplePose(root, Mat4::IDENTITY, animation, keyTime, positions);
+        for (const NodeData* root : nodeDatas.nodes)
+            samplePose(root, Mat4::IDENTITY, animation, keyTime, positions);
+        for (const auto& position : positions)
+            tracks[position.first].push_back(position.second * spec.scale);
+    }
+
+    // 各节点速度(中心差分)
+    auto computeSpeeds = [sampleCount, dt](const std::vector<Vec3>& track) {
+        std::vector<float> speeds(sampleCount, 0.0f);
+        for (int i = 0; i < sampleCount; ++i)
+        {
+            const int a = std::max(0, i - 1);
+            const int b = std::min(sampleCount - 1, i + 1);
+            speeds[i] = track[a].distance(track[b]) / ((b - a) * dt);
+        }
+        return speeds;
+    };
+
+    // 出招骨骼：指定名称优先，否则取峰值速度最大的节点(出拳的手、踢腿的脚)
+    std::string bone = spec.strikeBone;
+    if (bone.empty() || tracks.find(bone) == tracks.end())
+    {
+        if (!bone.empty())
+            CCLOGWARN("HitWindowBaker: bone %s not found in %s, picking fastest bone", bone.c_str(), spec.modelPath.c_str());
+        float bestPeak = 0.0f;
+        for (const auto& track : tracks)
+        {
+            const std::vector<float> speeds = computeSpeeds(track.second);
+            const float peak = *std::max_element(speeds.begin(), speeds.end());
+            if (peak > bestPeak)
+            {
+                bestPeak = peak;
+                bone = track.first;
+            }
+        }
+    }
+    if (tracks.find(bone) == tracks.end())
+        return false;
+
+    const std::vector<Vec3>& track = tracks[bone];
+    const std::vector<float> speeds = computeSpeeds(track);
+    const float peak = *std::max_element(speeds.begin(), speeds.end());
+    if (peak < MIN_PEAK_SPEED)
+    {
+        CCLOGWARN("HitWindowBaker: bone %s does not move in %s", bone.c_str(), spec.clipName.c_str());
+        return false;
+    }
+
+    // 速度高于阈值的连续区间 -> 采样下标范围 [first, last]
+    std::vector<std::pair<int, int>> runs;
+    const float limit = peak * spec.threshold;
+    for (int i = 0; i < sampleCount; ++i)
+    {
+        if (speeds[i] < limit)
+            continue;
+        if (!runs.empty() && (i - runs.back().second) * dt <= MERGE_GAP)
+            runs.back().second = i;
+        else
+            runs.push_back(std::make_pair(i, i));
+    }
+
+    std::vector<HitWindow> windows;
+    for (const auto& run : runs)
+    {
+        HitWindow window;
+        window.start = run.first * dt;
+        window.end = std::min(duration, (run.second + 1) * dt);
+        if (window.end - window.start < MIN_WINDOW)
+            continue;
+
+        int fastest = run.first;
+        for (int i = run.first; i <= run.second; ++i)
+        {
+            if (speeds[i] > speeds[fastest])
+                fastest = i;
+        }
+        window.shape.x = track[fastest].x;
+        window.shape.y = track[fastest].y;
+        window.shape.z = track[fastest].z;
+        window.shape.radius = spec.radius;
+        windows.push_back(window);
+    }
+    if (windows.empty())
+        return false;
+
+    table->addClip(spec.modelPath, spec.clipName, duration, windows);
+    CCLOG("HitWindowBaker: %s %s -> %d windows (bone %s, first %.3f-%.3f s)", spec.modelPath.c_str(),
+        spec.clipName.c_str(), (int)windows.size(), bone.c_str(), windows[0].start, windows[0].end);
+    return true;
+}
+
+int HitWindowBaker::bake(const std::vector<HitWindowBakeSpec>& specs, HitWindowTable* table)
+{
+    int baked = 0;
+    for (const auto& spec : specs)
+    {
+        if (bakeClip(spec, table))
+            baked++;
+    }
+    return baked;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Core/HitWindowTable.h"
+#include <string>
+#include <vector>
+
+/** 单个攻击片段的烘焙参数 */
+struct HitWindowBakeSpec
+{
+    std::string modelPath;          // 模型文件路径(.c3b)
+    std::string clipName;           // 片段名
+    std::string strikeBone;         // 出招骨骼；为空或模型中不存在时取峰值速度最大的骨骼
+    float scale = 1.0f;             // 游戏内模型缩放(骨骼坐标乘以该值换算为世界单位)
+    float radius = 40.0f;           // 判定球半径(世界单位)
+    float threshold = 0.5f;         // 速度达到峰值的该比例视为有效帧
+};
+
+/**
+ * 命中窗口离线烘焙
+ * 读入 .c3b 的骨架与动画关键帧，以 SAMPLE_RATE 采样出招骨骼在模型空间中的轨迹：
+ * 速度高于阈值的连续区间即命中窗口，判定球放在区间内速度峰值处的骨骼位置。
+ * 只在 Headless 的 --bake-hit-windows 模式中运行，结果写入 HitWindowTable 后保存为二进制文件。
+ */
+class HitWindowBaker
+{
+public:
+    static const int SAMPLE_RATE = 120;   // 采样频率(Hz)
+
+    /**
+     * 烘焙一个片段并加入命中窗口表
+     * @return 模型/片段无法读取或没有有效帧时返回false
+     */
+    static bool bakeClip(const HitWindowBakeSpec& spec, HitWindowTable* table);
+
+    /**
+     * 烘焙一组片段
+     * @return 成功的数量
+     */
+    static int bake(const std::vector<HitWindowBakeSpec>& specs, HitWindowTable* table);
+};
@@ -0,0 +1,263 @@
+#include "HitWindowTable.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+USING_NS_CC;
+
+static const uint32_t FILE_MAGIC = 0x31545748;   // "HWT1"
+static const uint16_t FILE_VERSION = 1;
+static const size_t HEADER_BYTES = 16;
+static const size_t CLIP_BYTES = 20;
+static const size_t WINDOW_BYTES = 24;
+
+HitWindowTable* HitWindowTable::s_instance = nullptr;
+
+Vec3 HitShape::getCenter(const Vec3& origin, float yawDegrees) const
+{
+    // 绕Y轴旋转：右 = (cos, 0, -sin)，前 = (sin, 0, cos)
+    const float yaw = CC_DEGREES_TO_RADIANS(yawDegrees);
+    const float s = sinf(yaw);
+    const float c = cosf(yaw);
+    return Vec3(origin.x + x * c + z * s, origin.y + y, origin.z - x * s + z * c);
+}
+
+HitWindowTable* HitWindowTable::getInstance()
+{
+    if (!s_instance)
+        s_instance = new (std::nothrow) HitWindowTable();
+    return s_instance;
+}
+
+void HitWindowTable::destroyInstance()
+{
+    CC_SAFE_DELETE(s_instance);
+}
+
+void HitWindowTable::clear()
+{
+    _records.clear();
+    _windows.clear();
+    _byClip.clear();
+}
+
+void HitWindowTable::addClip(const std::string& modelPath, const std::string& clipName, float duration,
+    const std::vector<HitWindow>& windows)
+{
+    Record record;
+    record.modelPath = modelPath;
+    record.clipName = clipName;
+    record.duration = duration;
+    record.firstWindow = (int)_windows.size();
+    record.windowCount = (int)windows.size();
+    _windows.insert(_windows.end(), windows.begin(), windows.end());
+    std::sort(_windows.begin() + record.firstWindow, _windows.end(),
+        [](const HitWindow& a, const HitWindow& b) { return a.start < b.start; });
+    _records.push_back(record);
+}
+
+// 按小端顺序逐字段读写
+namespace
+{
+    struct Reader
+    {
+        const unsigned char* data;
+        size_t size;
+        size_t offset;
+
+        bool read(void* out, size_t bytes)
+        {
+            if (offset + bytes > size)
+                return false;
+            memcpy(out, data + offset, bytes);
+            offset += bytes;
+            return true;
+        }
+    };
+
+    template <typename T>
+    void append(std::vector<unsigned char>& out, T value)
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+}
+
+bool HitWindowTable::load(const std::string& path)
+{
+    clear();
+
+    Data data = FileUtils::getInstance()->getDataFromFile(path);
+    if (data.isNull())
+        return false;
+
+    Reader reader = { data.getBytes(), (size_t)data.getSize(), 0 };
+    uint32_t magic = 0, windowCount = 0, stringBytes = 0;
+    uint16_t version = 0, clipCount = 0;
+    if (!reader.read(&magic, 4) || !reader.read(&version, 2) || !reader.read(&clipCount, 2) ||
+        !reader.read(&windowCount, 4) || !reader.read(&stringBytes, 4) ||
+        magic != FILE_MAGIC || version != FILE_VERSION)
+    {
+        CCLOGWARN("HitWindowTable: bad header in %s", path.c_str());
+        return false;
+    }
+
+    const size_t expected = HEADER_BYTES + clipCount * CLIP_BYTES + windowCount * WINDOW_BYTES + stringBytes;
+    if (reader.size != expected)
+    {
+        CCLOGWARN("HitWindowTable: size mismatch in %s", path.c_str());
+        return false;
+    }
+
+    const char* strings = reinterpret_cast<const char*>(reader.data) + expected - stringBytes;
+    auto stringAt = [strings, stringBytes](uint32_t offset, std::string& out) {
+        if (offset >= stringBytes)
+            return false;
+        const void* end = memchr(strings + offset, '\0', stringBytes - offset);
+        if (!end)
+            return false;
+        out.assign(strings + offset, static_cast<const char*>(end));
+        return true;
+    };
+
+    _records.resize(clipCount);
+    for (auto& record : _records)
+    {
+        uint32_t modelOffset = 0, clipOffset = 0, firstWindow = 0, count = 0;
+        reader.read(&modelOffset, 4);
+        reader.read(&clipOffset, 4);
+        reader.read(&record.duration, 4);
+        reader.read(&firstWindow, 4);
+        reader.read(&count, 4);
+        if (!stringAt(modelOffset, record.modelPath) || !stringAt(clipOffset, record.clipName) ||
+            firstWindow + count > windowCount)
+        {
+            CCLOGWARN("HitWindowTable: bad clip record in %s", path.c_str());
+            clear();
+            return false;
+        }
+        record.firstWindow = (int)firstWindow;
+        record.windowCount = (int)count;
+    }
+
+    _windows.resize(windowCount);
+    for (auto& window : _windows)
+    {
+        reader.read(&window.start, 4);
+        reader.read(&window.end, 4);
+        reader.read(&window.shape.x, 4);
+        reader.read(&window.shape.y, 4);
+        reader.read(&window.shape.z, 4);
+        reader.read(&window.shape.radius, 4);
+    }
+
+    CCLOG("HitWindowTable: %d clips, %d windows from %s", (int)_records.size(), (int)_windows.size(), path.c_str());
+    return true;
+}
+
+bool HitWindowTable::save(const std::string& path) const
+{
+    // 字符串池(相同的模型路径只存一次)
+    std::vector<char> strings;
+    std::vector<uint32_t> offsets;
+    auto intern = [&strings](const std::string& text) {
+        for (size_t offset = 0; offset < strings.size(); offset += strlen(&strings[offset]) + 1)
+        {
+            if (text == &strings[offset])
+                return (uint32_t)offset;
+        }
+        uint32_t offset = (uint32_t)strings.size();
+        strings.insert(strings.end(), text.begin(), text.end());
+        strings.push_back('\0');
+        return offset;
+    };
+    for (const auto& record : _records)
+    {
+        offsets.push_back(intern(record.modelPath));
+        offsets.push_back(intern(record.clipName));
+    }
+
+    std::vector<unsigned char> out;
+    append<uint32_t>(out, FILE_MAGIC);
+    append<uint16_t>(out, FILE_VERSION);
+    append<uint16_t>(out, (uint16_t)_records.size());
+    append<uint32_t>(out, (uint32_t)_windows.size());
+    append<uint32_t>(out, (uint32_t)strings.size());
+    for (size_t i = 0; i < _records.size(); ++i)
+    {
+        append<uint32_t>(out, offsets[i * 2]);
+        append<uint32_t>(out, offsets[i * 2 + 1]);
+        append<float>(out, _records[i].duration);
+        append<uint32_t>(out, (uint32_t)_records[i].firstWindow);
+        append<uint32_t>(out, (uint32_t)_records[i].windowCount);
+    }
+    for (const auto& window : _windows)
+    {
+        append<float>(out, window.start);
+        append<float>(out, window.end);
+        append<float>(out, window.shape.x);
+        append<float>(out, window.shape.y);
+        append<float>(out, window.shape.z);
+        append<float>(out, window.shape.radius);
+    }
+    out.insert(out.end(), strings.begin(), strings.end());
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        CCLOGERROR("HitWindowTable: cannot write %s", path.c_str());
+        return false;
+    }
+    bool written = fwrite(out.data(), 1, out.size(), file) == out.size();
+    fclose(file);
+    return written;
+}
+
+void HitWindowTable::bindClips()
+{
+    auto cache = AnimationClipCache::getInstance();
+    _byClip.assign(cache->getClipCount(), -1);
+    int bound = 0;
+    for (ClipId id = 0; id < cache->getClipCount(); ++id)
+    {
+        for (int index = 0; index < (int)_records.size(); ++index)
+        {
+            if (_records[index].clipName == cache->getClipName(id) &&
+                _records[index].modelPath == cache->getModelPath(id))
+            {
+                _byClip[id] = index;
+                bound++;
+                break;
+            }
+        }
+    }
+    CCLOG("HitWindowTable: %d of %d clips have baked hit windows", bound, cache->getClipCount());
+}
+
+const HitWindowTable::Record* HitWindowTable::findRecord(ClipId id) const
+{
+    if (id < 0 || id >= (ClipId)_byClip.size() || _byClip[id] < 0)
+        return nullptr;
+    return &_records[_byClip[id]];
+}
+
+float HitWindowTable::getDuration(ClipId id) const
+{
+    const Record* record = findRecord(id);
+    return record ? record->duration : 0.0f;
+}
+
+int HitWindowTable::getWindowCount(ClipId id) const
+{
+    const Record* record = findRecord(id);
+    return record ? record->windowCount : 0;
+}
+
+const HitWindow* HitWindowTable::getWindow(ClipId id, int index) const
+{
+    const Record* record = findRecord(id);
+    if (!record || index < 0 || index >= record->windowCount)
+        return nullptr;
+    return &_windows[record->firstWindow + index];
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "cocos2d.h"
+#include "Core/AnimationClipCache.h"
+#include <string>
+#include <vector>
+
+/**
+ * 判定球
+ * 偏移相对角色根节点，处于角色朝向坐标系(x右 y上 z前)，已按游戏内模型缩放换算为世界单位
+ */
+struct HitShape
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float radius = 0.0f;
+
+    /**
+     * 计算判定球在世界中的球心
+     * @param origin 角色位置
+     * @param yawDegrees 角色绕Y轴的朝向(角度，前方为 (sin, 0, cos))
+     */
+    cocos2d::Vec3 getCenter(const cocos2d::Vec3& origin, float yawDegrees) const;
+};
+
+/** 命中窗口：片段内打开/关闭的时间(秒)与判定形状 */
+struct HitWindow
+{
+    float start = 0.0f;
+    float end = 0.0f;
+    HitShape shape;
+
+    bool isOpen(float time) const { return time >= start && time < end; }
+};
+
+/**
+ * 命中窗口表(全局单例)
+ * 由离线烘焙(HitWindowBaker)从 .c3b 动画中提取：每个攻击片段的时长、有效帧窗口与判定球，
+ * 存为紧凑的二进制文件；游戏加载时读入一次并与 AnimationClipCache 的片段ID关联，
+ * 战斗逻辑只在窗口打开期间做命中判定。表中没有的片段由调用方沿用代码中的默认时机。
+ *
+ * 文件格式(小端)：
+ *   u32 magic 'HWT1' | u16 version | u16 clipCount | u32 windowCount | u32 stringBytes
+ *   clipCount   x { u32 modelOffset, u32 clipOffset, f32 duration, u32 firstWindow, u32 windowCount }
+ *   windowCount x { f32 start, f32 end, f32 x, f32 y, f32 z, f32 radius }
+ *   stringBytes 字节的字符串池(以 '\0' 结尾)
+ */
+class HitWindowTable
+{
+public:
+    static HitWindowTable* getInstance();
+    static void destroyInstance();
+
+    /**
+     * 读入烘焙好的表(替换已有内容，之后需重新 bindClips)
+     * @param path 文件路径
+     * @return 文件不存在或格式错误返回false(表保持为空)
+     */
+    bool load(const std::string& path);
+
+    /** 写出(离线烘焙使用) */
+    bool save(const std::string& path) const;
+
+    /** 添加一个片段的记录(离线烘焙使用) */
+    void addClip(const std::string& modelPath, const std::string& clipName, float duration,
+        const std::vector<HitWindow>& windows);
+
+    /** 按(模型, 片段名)与 AnimationClipCache 中已登记的片段关联(预加载结束后调用一次) */
+    void bindClips();
+
+    /** 清空 */
+    void clear();
+
+    //------------------------------
+    // 查询(热路径，按片段ID下标访问；绑定后只读，可在并行阶段调用)
+    //------------------------------
+    /** 片段是否有烘焙数据 */
+    bool hasClip(ClipId id) const { return findRecord(id) != nullptr; }
+    /** 片段时长(秒)，无数据返回0 */
+    float getDuration(ClipId id) const;
+    /** 片段的窗口数 */
+    int getWindowCount(ClipId id) const;
+    /** 片段的第 index 个窗口(按开始时间排序)，越界返回nullptr */
+    const HitWindow* getWindow(ClipId id, int index) const;
+
+    int getRecordCount() const { return (int)_records.size(); }
+
+private:
+    HitWindowTable() {}
+
+    struct Record
+    {
+        std::string modelPath;
+        std::string clipName;
+        float duration = 0.0f;
+        int firstWindow = 0;
+        int windowCount = 0;
+    };
+
+    const Record* findRecord(ClipId id) const;
+
+    std::vector<Record> _records;
+    std::vector<HitWindow> _windows;
+    std::vector<int> _byClip;   // ClipId -> 记录下标(-1 表示无数据)
+
+    static HitWindowTable* s_instance;
+};
@@ -0,0 +1,179 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+JobSystem* JobSystem::s_instance = nullptr;
+
+JobSystem* JobSystem::getInstance()
+{
+    if (!s_instance)
+        s_instance = new (std::nothrow) JobSystem();
+    return s_instance;
+}
+
+void JobSystem::destroyInstance()
+{
+    CC_SAFE_DELETE(s_instance);
+}
+
+JobSystem::~JobSystem()
+{
+    stop();
+}
+
+void JobSystem::start(int workerCount)
+{
+    stop();
+
+    if (workerCount < 0)
+    {
+        int hardware = (int)std::thread::hardware_concurrency();
+        workerCount = std::max(0, hardware - 1);
+    }
+
+    // 调用线程的队列放在最后
+    for (int i = 0; i <= workerCount; ++i)
+        _queues.push_back(new WorkQueue());
+
+    _stopping = false;
+    for (int i = 0; i < workerCount; ++i)
+        _workers.emplace_back(&JobSystem::workerLoop, this, i);
+
+    CCLOG("JobSystem: %d worker threads", workerCount);
+}
+
+void JobSystem::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _stopping = true;
+    }
+    _wakeCondition.notify_all();
+
+    for (auto& worker : _workers)
+        worker.join();
+    _workers.clear();
+
+    for (auto queue : _queues)
+        delete queue;
+    _queues.clear();
+    _pendingTasks = 0;
+}
+
+int JobSystem::getChunkCount(int count, int grainSize)
+{
+    if (count <= 0)
+        return 0;
+    grainSize = std::max(1, grainSize);
+    return (count + grainSize - 1) / grainSize;
+}
+
+int JobSystem::parallelFor(int count, int grainSize, const RangeFunc& func)
+{
+    const int chunkCount = getChunkCount(count, grainSize);
+    grainSize = std::max(1, grainSize);
+    if (chunkCount == 0)
+        return 0;
+
+    // 无工作线程或只有一块：直接在调用线程上顺序执行
+    if (_workers.empty() || chunkCount == 1)
+    {
+        for (int chunk = 0; chunk < chunkCount; ++chunk)
+            func(chunk * grainSize, std::min(count, (chunk + 1) * grainSize), chunk);
+        return chunkCount;
+    }
+
+    std::atomic<int> remaining(chunkCount);
+    const int queueCount = (int)_queues.size();
+    const int callerIndex = queueCount - 1;
+
+    // 先登记待取任务数再入队，避免工作线程取走后计数短暂为负
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _pendingTasks += chunkCount;
+    }
+
+    // 块轮流放入各队列，调用线程的队列拿第一块
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        Task task;
+        task.func = &func;
+        task.begin = chunk * grainSize;
+        task.end = std::min(count, task.begin + grainSize);
+        task.chunk = chunk;
+        task.remaining = &remaining;
+
+        WorkQueue* queue = _queues[(callerIndex + chunk) % queueCount];
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->tasks.push_back(task);
+    }
+    _wakeCondition.notify_all();
+
+    // 调用线程也参与执行，直到本次的全部块完成
+    Task task;
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+        if (popLocal(callerIndex, task) || steal(callerIndex, task))
+            execute(task);
+        else
+            std::this_thread::yield();   // 剩余块正在其它线程上执行
+    }
+    return chunkCount;
+}
+
+void JobSystem::workerLoop(int queueIndex)
+{
+    Task task;
+    while (true)
+    {
+        if (popLocal(queueIndex, task) || steal(queueIndex, task))
+        {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        _wakeCondition.wait(lock, [this]() { return _stopping || _pendingTasks.load() > 0; });
+        if (_stopping)
+            return;
+    }
+}
+
+bool JobSystem::popLocal(int queueIndex, Task& out)
+{
+    WorkQueue* queue = _queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (queue->tasks.empty())
+        return false;
+
+    out = queue->tasks.back();
+    queue->tasks.pop_back();
+    _pendingTasks--;
+    return true;
+}
+
+bool JobSystem::steal(int thiefIndex, Task& out)
+{
+    const int queueCount = (int)_queues.size();
+    for (int offset = 1; offset < queueCount; ++offset)
+    {
+        WorkQueue* queue = _queues[(thiefIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->tasks.empty())
+            continue;
+
+        out = queue->tasks.front();
+        queue->tasks.pop_front();
+        _pendingTasks--;
+        _stealCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::execute(const Task& task)
+{
+    (*task.func)(task.begin, task.end, task.chunk);
+    task.remaining->fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "cocos2d.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * 工作窃取任务调度器(全局单例)
+ * 每个工作线程(以及调用线程)各有一个任务队列：
+ * - parallelFor 把区间切成若干块，轮流放进各队列，调用线程自己也参与执行
+ * - 线程优先从自己队列的尾部取任务，空了再从其它队列的头部窃取
+ * - 调用线程在全部块完成后才返回，块内代码只能访问互不重叠的数据
+ * 只允许一个线程(主线程)调用 parallelFor，且块内不能再嵌套调用；
+ * 未启动(或工作线程数为0)时 parallelFor 在调用线程上顺序执行
+ */
+class JobSystem
+{
+public:
+    /** 区间任务：处理 [begin, end)，chunk 为块序号(从0开始、按区间顺序编号) */
+    using RangeFunc = std::function<void(int begin, int end, int chunk)>;
+
+    static JobSystem* getInstance();
+    static void destroyInstance();
+
+    /**
+     * 启动工作线程(已启动时先停止再按新数量启动)
+     * @param workerCount 工作线程数，<0 表示按硬件线程数减一(调用线程也参与执行)
+     */
+    void start(int workerCount = -1);
+
+    /** 停止并等待全部工作线程退出 */
+    void stop();
+
+    /** 工作线程数(不含调用线程) */
+    int getWorkerCount() const { return (int)_workers.size(); }
+
+    /**
+     * 并行执行区间任务，返回时全部块已完成
+     * @param count 元素数量
+     * @param grainSize 每块的元素数(至少为1)
+     * @param func 区间任务
+     * @return 块数
+     */
+    int parallelFor(int count, int grainSize, const RangeFunc& func);
+
+    /** 计算区间切块数(调用方据此预先准备每块的输出缓冲) */
+    static int getChunkCount(int count, int grainSize);
+
+    /** 累计被其它线程窃取执行的任务数 */
+    unsigned int getStealCount() const { return _stealCount.load(std::memory_order_relaxed); }
+
+private:
+    JobSystem() {}
+    ~JobSystem();
+
+    // 一个区间块
+    struct Task
+    {
+        const RangeFunc* func = nullptr;
+        int begin = 0;
+        int end = 0;
+        int chunk = 0;
+        std::atomic<int>* remaining = nullptr;   // 所属 parallelFor 的未完成块数
+    };
+
+    // 单个线程的任务队列
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(int queueIndex);
+    bool popLocal(int queueIndex, Task& out);
+    bool steal(int thiefIndex, Task& out);
+    void execute(const Task& task);
+
+    std::vector<std::thread> _workers;
+    std::vector<WorkQueue*> _queues;           // [0, workers) 为工作线程，最后一个属于调用线程
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;
+    std::atomic<int> _pendingTasks{ 0 };       // 已入队未取出的任务数
+    std::atomic<bool> _stopping{ false };
+    std::atomic<unsigned int> _stealCount{ 0 };
+
+    static JobSystem* s_instance;
+};
@@ -0,0 +1,73 @@
+#include "ProfilerOverlay.h"
+
+#if FRAME_PROFILER_ENABLED
+
+#include <cstdio>
+
+USING_NS_CC;
+
+bool ProfilerOverlay::init()
+{
+    if (!Node::init())
+        return false;
+
+    auto visibleSize = Director::getInstance()->getWinSize();
+
+    _label = Label::createWithSystemFont("", "Courier New", 14);
+    _label->setAnchorPoint(Vec2(1.0f, 1.0f));
+    _label->setPosition(Vec2(visibleSize.width - 10, visibleSize.height - 10));
+    _label->setTextColor(Color4B(180, 255, 180, 255));
+    _label->enableShadow(Color4B::BLACK, Size(1, -1), 0);
+    this->addChild(_label);
+
+    auto keyboardListener = EventListenerKeyboard::create();
+    keyboardListener->onKeyPressed = [this](EventKeyboard::KeyCode keyCode, Event*) {
+        if (keyCode == EventKeyboard::KeyCode::KEY_F3) {
+            this->setVisible(!this->isVisible());
+        }
+        else if (keyCode == EventKeyboard::KeyCode::KEY_F4) {
+            std::string path = FileUtils::getInstance()->getWritablePath() + "frame_trace.json";
+            FrameProfiler::getInstance()->dumpChromeTrace(path);
+        }
+    };
+    Director::getInstance()->getEventDispatcher()->addEventListenerWithSceneGraphPriority(keyboardListener, this);
+
+    this->scheduleUpdate();
+    return true;
+}
+
+void ProfilerOverlay::update(float dt)
+{
+    _refreshTimer += dt;
+    if (_refreshTimer < REFRESH_INTERVAL || !isVisible())
+        return;
+
+    _refreshTimer = 0.0f;
+    refreshText();
+}
+
+void ProfilerOverlay::refreshText()
+{
+    FrameProfiler* profiler = FrameProfiler::getInstance();
+    profiler->getSummaries(_summaries);
+
+    std::string text = "scope               calls   p50    p95    p99  (ms)\n";
+    char line[128];
+    for (const auto& summary : _summaries)
+    {
+        std::string name = std::string(summary.depth * 2, ' ') + summary.name;
+        snprintf(line, sizeof(line), "%-20s %4d %6.2f %6.2f %6.2f\n",
+            name.c_str(), summary.callsLastFrame, summary.p50Ms, summary.p95Ms, summary.p99Ms);
+        text += line;
+    }
+
+    unsigned int dropped = profiler->getDroppedCount();
+    if (dropped > 0)
+    {
+        snprintf(line, sizeof(line), "dropped samples: %u\n", dropped);
+        text += line;
+    }
+    _label->setString(text);
+}
+
+#endif // FRAME_PROFILER_ENABLED
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "FrameProfiler.h"
+
+#if FRAME_PROFILER_ENABLED
+
+#include "cocos2d.h"
+#include <vector>
+
+/**
+ * 帧耗时分析面板(仅调试构建)
+ * 在屏幕右上角显示各作用域最近若干帧的 p50/p95/p99 耗时，每0.5秒刷新一次；
+ * F3 显示/隐藏，F4 将最近的样本导出为 Chrome trace JSON(可写目录下 frame_trace.json)
+ */
+class ProfilerOverlay : public cocos2d::Node
+{
+public:
+    CREATE_FUNC(ProfilerOverlay);
+
+    virtual bool init() override;
+    virtual void update(float dt) override;
+
+private:
+    void refreshText();
+
+    cocos2d::Label* _label = nullptr;
+    float _refreshTimer = 0.0f;
+    std::vector<ProfileScopeSummary> _summaries;   // 复用，避免每次刷新分配
+
+    const float REFRESH_INTERVAL = 0.5f;
+};
+
+#endif // FRAME_PROFILER_ENABLED
@@ -0,0 +1,175 @@
+#include "SimulationDriver.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+USING_NS_CC;
+
+// 统计值平滑系数(指数滑动平均)
+static const float STATS_SMOOTHING = 0.1f;
+
+SimulationDriver::SimulationDriver(float tickRate)
+{
+    setTickRate(tickRate);
+}
+
+SimulationDriver::~SimulationDriver()
+{
+    // 释放所有登记节点的引用
+    for (auto& body : _bodies)
+    {
+        CC_SAFE_RELEASE(body.node);
+    }
+    _bodies.clear();
+}
+
+void SimulationDriver::setTickRate(float tickRate)
+{
+    if (tickRate <= 0.0f)
+        return;
+
+    _tickRate = tickRate;
+    _tickInterval = 1.0f / tickRate;
+    _timers.setTickInterval(_tickInterval);
+    _tasks.setTickInterval(_tickInterval);
+}
+
+void SimulationDriver::setMaxTicksPerFrame(int maxTicks)
+{
+    _maxTicksPerFrame = std::max(1, maxTicks);
+}
+
+void SimulationDriver::addInterpolatedNode(Node* node)
+{
+    if (!node)
+        return;
+
+    // 避免重复登记
+    for (const auto& body : _bodies)
+    {
+        if (body.node == node)
+            return;
+    }
+
+    InterpolatedBody body;
+    body.node = node;
+    body.previous = node->getPosition3D();
+    body.current = body.previous;
+    body.rendered = body.previous;
+    node->retain();
+    _bodies.push_back(body);
+}
+
+void SimulationDriver::removeInterpolatedNode(Node* node)
+{
+    for (auto it = _bodies.begin(); it != _bodies.end(); ++it)
+    {
+        if (it->node != node)
+            continue;
+
+        // 移除前恢复为模拟位置，避免节点停留在插值位置
+        if (it->isRendered)
+            node->setPosition3D(it->current);
+
+        node->release();
+        _bodies.erase(it);
+        return;
+    }
+}
+
+int SimulationDriver::advance(float frameTime, const TickFunc& tick)
+{
+    if (frameTime < 0.0f)
+        frameTime = 0.0f;
+
+    // ---- 帧节奏统计 ----
+    _stats.frameCount++;
+    _stats.lastFrameTime = frameTime;
+    _stats.maxFrameTime = std::max(_stats.maxFrameTime, frameTime);
+    _stats.avgFrameTime = (_stats.frameCount == 1)
+        ? frameTime
+        : _stats.avgFrameTime + (frameTime - _stats.avgFrameTime) * STATS_SMOOTHING;
+
+    // 渲染后若未恢复，这里兜底撤销插值；再读取帧间被动作/事件修改后的位置
+    restoreSimulationState();
+    captureCurrent(false);
+
+    _accumulator += frameTime;
+
+    int ticks = 0;
+    while (_accumulator >= _tickInterval && ticks < _maxTicksPerFrame)
+    {
+        captureCurrent(true);
+
+        auto begin = std::chrono::steady_clock::now();
+        _timers.advance();
+        _tasks.advance();
+        if (tick)
+            tick(_tickInterval);
+        _combatEvents.resolve();
+        auto end = std::chrono::steady_clock::now();
+
+        captureCurrent(false);
+
+        // ---- tick耗时统计 ----
+        float costUs = std::chrono::duration<float, std::micro>(end - begin).count();
+        _stats.tickCount++;
+        _stats.lastTickCostUs = costUs;
+        _stats.maxTickCostUs = std::max(_stats.maxTickCostUs, costUs);
+        _stats.avgTickCostUs = (_stats.tickCount == 1)
+            ? costUs
+            : _stats.avgTickCostUs + (costUs - _stats.avgTickCostUs) * STATS_SMOOTHING;
+
+        _accumulator -= _tickInterval;
+        ticks++;
+    }
+
+    // 达到追帧上限：丢弃整数个步长，只保留不足一步的余量用于插值
+    if (_accumulator >= _tickInterval)
+    {
+        float remainder = fmodf(_accumulator, _tickInterval);
+        _stats.droppedTime += _accumulator - remainder;
+        _accumulator = remainder;
+    }
+
+    _stats.ticksLastFrame = ticks;
+    _alpha = _accumulator / _tickInterval;
+
+    applyInterpolation();
+    return ticks;
+}
+
+void SimulationDriver::restoreSimulationState()
+{
+    for (auto& body : _bodies)
+    {
+        if (!body.isRendered)
+            continue;
+
+        // 节点仍停留在插值位置才恢复；若已被外部移动，则以外部位置为准
+        if (body.node->getPosition3D() == body.rendered)
+            body.node->setPosition3D(body.current);
+
+        body.isRendered = false;
+    }
+}
+
+void SimulationDriver::captureCurrent(bool shiftPrevious)
+{
+    for (auto& body : _bodies)
+    {
+        if (shiftPrevious)
+            body.previous = body.current;
+        body.current = body.node->getPosition3D();
+    }
+}
+
+void SimulationDriver::applyInterpolation()
+{
+    for (auto& body : _bodies)
+    {
+        body.rendered = body.previous.lerp(body.current, _alpha);
+        body.node->setPosition3D(body.rendered);
+        body.isRendered = true;
+    }
+}
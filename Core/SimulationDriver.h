@@ -0,0 +1,132 @@
+#pragma once
+
+#include "cocos2d.h"
+#include "Core/TimerWheel.h"
+#include "Core/GameplayTask.h"
+#include "Core/CombatEventQueue.h"
+#include <functional>
+#include <vector>
+
+/**
+ * 模拟统计数据
+ * 记录帧节奏与每个逻辑tick的耗时，用于对比不同刷新率机器上的表现
+ */
+struct SimulationStats
+{
+    unsigned int frameCount = 0;    // 已处理的渲染帧数
+    unsigned int tickCount = 0;     // 已执行的逻辑tick总数
+    int ticksLastFrame = 0;         // 上一帧执行的tick数
+
+    float lastFrameTime = 0.0f;     // 上一帧间隔(秒)
+    float avgFrameTime = 0.0f;      // 帧间隔平滑均值(秒)
+    float maxFrameTime = 0.0f;      // 最大帧间隔(秒)
+
+    float lastTickCostUs = 0.0f;    // 上一个tick耗时(微秒)
+    float avgTickCostUs = 0.0f;     // tick耗时平滑均值(微秒)
+    float maxTickCostUs = 0.0f;     // 最大tick耗时(微秒)
+
+    float droppedTime = 0.0f;       // 超出追帧上限而被丢弃的累计时间(秒)
+};
+
+/**
+ * 固定步长模拟驱动器
+ * 由场景持有，是玩家、敌人、Boss逻辑的唯一调用者：
+ * - 累加渲染帧时间，按固定间隔执行逻辑tick，保证不同帧率下结果一致
+ * - 对登记的节点在相邻两个tick之间做位置插值，渲染保持平滑
+ * - 统计帧节奏与每个tick的耗时
+ * - 持有玩法定时器时间轮与脚本任务调度器，每个tick开始时推进(到期回调与任务先于本tick的逻辑执行)
+ * - 持有战斗事件队列，每个tick结束时统一结算本tick登记的命中
+ */
+class SimulationDriver
+{
+public:
+    using TickFunc = std::function<void(float)>;
+
+    /**
+     * 构造驱动器
+     * @param tickRate 逻辑频率(次/秒)
+     */
+    explicit SimulationDriver(float tickRate = 60.0f);
+    ~SimulationDriver();
+
+    /**
+     * 设置逻辑频率
+     * @param tickRate 逻辑频率(次/秒)，非正数将被忽略
+     */
+    void setTickRate(float tickRate);
+    float getTickRate() const { return _tickRate; }
+    float getTickInterval() const { return _tickInterval; }
+
+    /**
+     * 设置每帧最多追赶的tick数，防止卡顿后陷入追帧死循环
+     * @param maxTicks 每帧tick上限(至少为1)
+     */
+    void setMaxTicksPerFrame(int maxTicks);
+
+    /**
+     * 登记需要渲染插值的节点(驱动器持有其引用)
+     * @param node 由逻辑tick移动的节点
+     */
+    void addInterpolatedNode(cocos2d::Node* node);
+
+    /**
+     * 取消节点的渲染插值并释放引用
+     * @param node 之前登记过的节点
+     */
+    void removeInterpolatedNode(cocos2d::Node* node);
+
+    /**
+     * 推进一帧：执行若干个固定步长tick，然后对登记节点应用插值位置
+     * @param frameTime 本帧经过的真实时间(秒)
+     * @param tick 每个逻辑tick的回调，参数为固定步长
+     * @return 本帧执行的tick数
+     */
+    int advance(float frameTime, const TickFunc& tick);
+
+    /**
+     * 将登记节点恢复为最新的模拟位置(撤销渲染插值)
+     * 应在渲染结束后调用，使输入事件与动作在帧间读到真实的模拟状态
+     */
+    void restoreSimulationState();
+
+    /** 获取当前插值系数(0~1)：累加器剩余时间 / 固定步长 */
+    float getInterpolationAlpha() const { return _alpha; }
+
+    /** 玩法定时器(按逻辑tick计时，暂停时随模拟一起停止) */
+    TimerWheel& getTimers() { return _timers; }
+
+    /** 玩法脚本任务(攻击/技能时间线，按逻辑tick恢复执行) */
+    TaskScheduler& getTasks() { return _tasks; }
+
+    /** 战斗事件队列(tick内登记命中，tick结束时按登记顺序结算) */
+    CombatEventQueue& getCombatEvents() { return _combatEvents; }
+
+    const SimulationStats& getStats() const { return _stats; }
+    void resetStats() { _stats = SimulationStats(); }
+
+private:
+    // 插值节点记录
+    struct InterpolatedBody
+    {
+        cocos2d::Node* node = nullptr;
+        cocos2d::Vec3 previous;     // 上一个tick结束时的位置
+        cocos2d::Vec3 current;      // 最新tick结束时的位置
+        cocos2d::Vec3 rendered;     // 最近一次写入的插值位置
+        bool isRendered = false;    // 节点当前是否处于插值位置
+    };
+
+    void captureCurrent(bool shiftPrevious);  // 从节点读取最新模拟位置
+    void applyInterpolation();                // 写入插值位置
+
+    float _tickRate = 60.0f;
+    float _tickInterval = 1.0f / 60.0f;
+    int _maxTicksPerFrame = 5;
+    float _accumulator = 0.0f;
+    float _alpha = 0.0f;
+
+    std::vector<InterpolatedBody> _bodies;
+    TimerWheel _timers;
+    TaskScheduler _tasks;
+    CombatEventQueue _combatEvents;
+    SimulationStats _stats;
+};
@@ -0,0 +1,300 @@
+#include "TimerWheel.h"
+#include <algorithm>
+#include <cstring>
+
+static const int MIN_GROW = 64;   // 槽位不足时至少扩容的数量
+
+TimerWheel::TimerWheel()
+{
+    std::fill(_heads, _heads + FIRING_BUCKET + 1, -1);
+    std::fill(_tails, _tails + FIRING_BUCKET + 1, -1);
+}
+
+void TimerWheel::reserve(int count)
+{
+    const int oldSize = (int)_timers.size();
+    if (count <= oldSize)
+        return;
+
+    // 新槽位按下标从小到大接到空闲链表头部
+    _timers.resize(count);
+    for (int i = count - 1; i >= oldSize; --i)
+    {
+        _timers[i].bucket = FREE_BUCKET;
+        _timers[i].next = _freeHead;
+        _freeHead = i;
+    }
+}
+
+void TimerWheel::setTickInterval(float seconds)
+{
+    if (seconds > 0.0f)
+        _ticksPerSecond = 1.0f / seconds;
+}
+
+uint32_t TimerWheel::secondsToTicks(float seconds) const
+{
+    if (seconds <= 0.0f)
+        return 1;
+    return std::max(1u, (uint32_t)(seconds * _ticksPerSecond + 0.5f));
+}
+
+int TimerWheel::allocate(EntityHandle owner, uint32_t ticks)
+{
+    if (_freeHead < 0)
+    {
+        reserve(std::max(MIN_GROW, (int)_timers.size() * 2));
+        _growCount++;
+    }
+
+    const int index = _freeHead;
+    Timer& timer = _timers[index];
+    _freeHead = timer.next;
+
+    timer.due = _now + std::max(1u, ticks);
+    timer.owner = owner;
+    timer.invoke = nullptr;
+    insert(index);
+    linkOwner(index);
+    _pendingCount++;
+    return index;
+}
+
+void TimerWheel::release(int index)
+{
+    Timer& timer = _timers[index];
+    timer.serial++;
+    if (timer.serial == 0)
+        timer.serial = 1;
+    timer.bucket = FREE_BUCKET;
+    timer.owner = EntityHandle();
+    timer.invoke = nullptr;
+    timer.next = _freeHead;
+    _freeHead = index;
+}
+
+TimerHandle TimerWheel::makeHandle(int index) const
+{
+    TimerHandle handle;
+    handle.index = (uint32_t)index;
+    handle.serial = _timers[index].serial;
+    return handle;
+}
+
+void TimerWheel::insert(int index)
+{
+    Timer& timer = _timers[index];
+
+    // 按剩余tick数选层：第L层容纳 256^(L+1) 以内的延迟
+    uint64_t delta = timer.due > _now ? timer.due - _now : 0;
+    const uint64_t maxDelta = (1ull << (LEVEL_BITS * LEVELS)) - 1;
+    if (delta > maxDelta)
+    {
+        delta = maxDelta;
+        timer.due = _now + maxDelta;
+    }
+
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (1ull << (LEVEL_BITS * (level + 1))))
+        level++;
+
+    const int slot = (int)((timer.due >> (LEVEL_BITS * level)) & (SLOTS - 1));
+    link(level * SLOTS + slot, index);
+}
+
+void TimerWheel::link(int bucket, int index)
+{
+    // 接到链表尾部，保持登记顺序
+    Timer& timer = _timers[index];
+    timer.bucket = bucket;
+    timer.prev = _tails[bucket];
+    timer.next = -1;
+    if (_tails[bucket] >= 0)
+        _timers[_tails[bucket]].next = index;
+    else
+        _heads[bucket] = index;
+    _tails[bucket] = index;
+}
+
+void TimerWheel::unlink(int index)
+{
+    Timer& timer = _timers[index];
+    const int bucket = timer.bucket;
+    if (timer.prev >= 0)
+        _timers[timer.prev].next = timer.next;
+    else
+        _heads[bucket] = timer.next;
+    if (timer.next >= 0)
+        _timers[timer.next].prev = timer.prev;
+    else
+        _tails[bucket] = timer.prev;
+    timer.prev = -1;
+    timer.next = -1;
+}
+
+void TimerWheel::linkOwner(int index)
+{
+    Timer& timer = _timers[index];
+    timer.ownerPrev = -1;
+    timer.ownerNext = -1;
+    if (timer.owner.isNull())
+        return;
+
+    const uint32_t slot = timer.owner.getIndex();
+    if (slot >= _owners.size())
+        _owners.resize(std::max<size_t>(slot + 1, _owners.size() * 2));
+
+    // 槽位被新代数的实体复用：旧实体残留的定时器不再挂在表头上(触发时按句柄失效丢弃)
+    OwnerList& list = _owners[slot];
+    if (list.owner != timer.owner)
+    {
+        list.owner = timer.owner;
+        list.head = -1;
+    }
+
+    timer.ownerNext = list.head;
+    if (list.head >= 0)
+        _timers[list.head].ownerPrev = index;
+    list.head = index;
+}
+
+void TimerWheel::unlinkOwner(int index)
+{
+    Timer& timer = _timers[index];
+    if (timer.owner.isNull())
+        return;
+
+    if (timer.ownerPrev >= 0)
+    {
+        _timers[timer.ownerPrev].ownerNext = timer.ownerNext;
+    }
+    else
+    {
+        OwnerList& list = _owners[timer.owner.getIndex()];
+        if (list.owner == timer.owner)
+            list.head = timer.ownerNext;
+    }
+    if (timer.ownerNext >= 0)
+        _timers[timer.ownerNext].ownerPrev = timer.ownerPrev;
+    timer.ownerPrev = -1;
+    timer.ownerNext = -1;
+}
+
+bool TimerWheel::cancel(TimerHandle& handle)
+{
+    const uint32_t index = handle.index;
+    const bool pending = isPending(handle);
+    handle = TimerHandle();
+    if (!pending)
+        return false;
+
+    unlink((int)index);
+    unlinkOwner((int)index);
+    release((int)index);
+    _pendingCount--;
+    return true;
+}
+
+int TimerWheel::cancelOwner(EntityHandle owner)
+{
+    if (owner.isNull() || owner.getIndex() >= _owners.size())
+        return 0;
+
+    OwnerList& list = _owners[owner.getIndex()];
+    if (list.owner != owner)
+        return 0;
+
+    int cancelled = 0;
+    while (list.head >= 0)
+    {
+        const int index = list.head;
+        unlink(index);
+        unlinkOwner(index);
+        release(index);
+        _pendingCount--;
+        cancelled++;
+    }
+    return cancelled;
+}
+
+bool TimerWheel::isPending(const TimerHandle& handle) const
+{
+    if (handle.isNull() || handle.index >= _timers.size())
+        return false;
+    const Timer& timer = _timers[handle.index];
+    return timer.serial == handle.serial && timer.bucket != FREE_BUCKET;
+}
+
+void TimerWheel::cascade(int level, int slot)
+{
+    const int bucket = level * SLOTS + slot;
+    int index = _heads[bucket];
+    _heads[bucket] = -1;
+    _tails[bucket] = -1;
+
+    // 逐个按剩余时间重新放入较低的层
+    while (index >= 0)
+    {
+        const int next = _timers[index].next;
+        insert(index);
+        index = next;
+    }
+}
+
+void TimerWheel::advance()
+{
+    _now++;
+
+    // 各层一轮走完时，把上一层对应格子里的定时器下放(先高层后低层)
+    for (int level = LEVELS - 1; level >= 1; --level)
+    {
+        if ((_now & ((1ull << (LEVEL_BITS * level)) - 1)) == 0)
+            cascade(level, (int)((_now >> (LEVEL_BITS * level)) & (SLOTS - 1)));
+    }
+
+    // 第0层当前格整体转入触发链表：回调中取消同一tick的其他定时器也是 O(1)
+    const int slot = (int)(_now & (SLOTS - 1));
+    _heads[FIRING_BUCKET] = _heads[slot];
+    _tails[FIRING_BUCKET] = _tails[slot];
+    _heads[slot] = -1;
+    _tails[slot] = -1;
+    for (int index = _heads[FIRING_BUCKET]; index >= 0; index = _timers[index].next)
+        _timers[index].bucket = FIRING_BUCKET;
+
+    auto registry = EntityRegistry::getInstance();
+    while (_heads[FIRING_BUCKET] >= 0)
+    {
+        const int index = _heads[FIRING_BUCKET];
+        unlink(index);
+        unlinkOwner(index);
+
+        // 回调中登记定时器可能扩容，先把回调复制出来再释放槽位
+        Timer& timer = _timers[index];
+        const bool alive = timer.owner.isNull() || registry->isValid(timer.owner);
+        void (*invoke)(void*) = timer.invoke;
+        alignas(std::max_align_t) unsigned char storage[INLINE_BYTES];
+        memcpy(storage, timer.storage, INLINE_BYTES);
+        release(index);
+        _pendingCount--;
+
+        if (alive && invoke)
+        {
+            invoke(storage);
+            _firedCount++;
+        }
+    }
+}
+
+void TimerWheel::clear()
+{
+    for (int index = 0; index < (int)_timers.size(); ++index)
+    {
+        if (_timers[index].bucket != FREE_BUCKET)
+            release(index);
+    }
+    std::fill(_heads, _heads + FIRING_BUCKET + 1, -1);
+    std::fill(_tails, _tails + FIRING_BUCKET + 1, -1);
+    for (auto& list : _owners)
+        list = OwnerList();
+    _pendingCount = 0;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Core/EntityRegistry.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * 定时器句柄：槽位下标 + 序号
+ * 定时器触发或取消后槽位序号加一，旧句柄随即失效；值为0表示空句柄
+ */
+struct TimerHandle
+{
+    uint32_t index = 0;
+    uint32_t serial = 0;
+
+    bool isNull() const { return serial == 0; }
+};
+
+/**
+ * 分层时间轮(由模拟驱动器持有，每个逻辑tick推进一格)
+ * 替代 Sequence/DelayTime/CallFunc 动作链实现玩法延迟：
+ * - 4层 x 256格，第0层精确到tick，其余各层到期前逐层下放，schedule/cancel 均为 O(1)
+ * - 回调按值内联存放在定时器槽位中(不经 std::function)，槽位预分配并按空闲链表复用，稳定后每tick零分配
+ * - 每个定时器记录所属实体句柄，同一实体的定时器串成链表：
+ *   cancelOwner 只遍历该实体自己的定时器；实体销毁(句柄失效)后到期的回调直接丢弃
+ * 同一tick到期的定时器按登记顺序触发；回调中可以登记或取消定时器
+ */
+class TimerWheel
+{
+public:
+    static const int INLINE_BYTES = 48;   // 回调捕获的最大字节数
+
+    TimerWheel();
+
+    /** 预分配定时器槽位(之后在该数量内不再分配内存) */
+    void reserve(int count);
+
+    /** 设置tick间隔(秒)，用于把延迟秒数换算成tick数 */
+    void setTickInterval(float seconds);
+
+    /**
+     * 登记定时器
+     * 回调只能捕获可平凡拷贝的值(this指针、句柄、数值)，且不超过 INLINE_BYTES
+     * @param owner 所属实体(空句柄表示不属于任何实体，总会触发)
+     * @param delaySeconds 延迟秒数(四舍五入到tick，至少1个tick)
+     * @param callback 到期回调
+     * @return 定时器句柄(可用于取消)
+     */
+    template <typename F>
+    TimerHandle schedule(EntityHandle owner, float delaySeconds, const F& callback)
+    {
+        return scheduleTicks(owner, secondsToTicks(delaySeconds), callback);
+    }
+
+    /** 按tick数登记定时器(至少1个tick) */
+    template <typename F>
+    TimerHandle scheduleTicks(EntityHandle owner, uint32_t ticks, const F& callback)
+    {
+        static_assert(sizeof(F) <= INLINE_BYTES, "TimerWheel: callback capture too large");
+        static_assert(alignof(F) <= alignof(std::max_align_t), "TimerWheel: callback over-aligned");
+        static_assert(std::is_trivially_copyable<F>::value, "TimerWheel: callback must only capture trivially copyable values");
+
+        int index = allocate(owner, ticks);
+        Timer& timer = _timers[index];
+        new (timer.storage) F(callback);
+        timer.invoke = &invokeCallback<F>;
+        return makeHandle(index);
+    }
+
+    /**
+     * 取消定时器(已触发/已取消的句柄忽略)，并把句柄置空
+     * @return 是否取消了一个等待中的定时器
+     */
+    bool cancel(TimerHandle& handle);
+
+    /**
+     * 取消实体的全部定时器(死亡、被打断时调用)
+     * @return 取消的数量
+     */
+    int cancelOwner(EntityHandle owner);
+
+    /** 定时器是否仍在等待 */
+    bool isPending(const TimerHandle& handle) const;
+
+    /** 推进一个tick，触发到期的定时器 */
+    void advance();
+
+    /** 取消全部定时器 */
+    void clear();
+
+    uint64_t getCurrentTick() const { return _now; }
+    int getPendingCount() const { return _pendingCount; }
+    int getCapacity() const { return (int)_timers.size(); }
+    /** 槽位扩容次数(稳定运行时应不再增长) */
+    unsigned int getGrowCount() const { return _growCount; }
+    /** 累计触发数 */
+    unsigned long long getFiredCount() const { return _firedCount; }
+
+private:
+    static const int LEVEL_BITS = 8;
+    static const int SLOTS = 1 << LEVEL_BITS;
+    static const int LEVELS = 4;
+    static const int FIRING_BUCKET = LEVELS * SLOTS;   // 正在触发的链表
+    static const int FREE_BUCKET = -1;
+
+    struct Timer
+    {
+        uint64_t due = 0;                     // 到期tick
+        EntityHandle owner;
+        int bucket = FREE_BUCKET;             // 所在格子(FREE_BUCKET 为空闲)
+        int prev = -1;                        // 格子内链表
+        int next = -1;                        // 格子内链表(空闲时为空闲链表)
+        int ownerPrev = -1;                   // 同一实体的定时器链表
+        int ownerNext = -1;
+        uint32_t serial = 1;
+        void (*invoke)(void* storage) = nullptr;
+        alignas(std::max_align_t) unsigned char storage[INLINE_BYTES];
+    };
+
+    // 实体 -> 定时器链表头(按句柄槽位下标索引，代数不符视为空)
+    struct OwnerList
+    {
+        EntityHandle owner;
+        int head = -1;
+    };
+
+    template <typename F>
+    static void invokeCallback(void* storage)
+    {
+        (*static_cast<F*>(storage))();
+    }
+
+    uint32_t secondsToTicks(float seconds) const;
+    int allocate(EntityHandle owner, uint32_t ticks);
+    void release(int index);
+    TimerHandle makeHandle(int index) const;
+    void insert(int index);
+    void link(int bucket, int index);
+    void unlink(int index);
+    void linkOwner(int index);
+    void unlinkOwner(int index);
+    void cascade(int level, int slot);
+
+    std::vector<Timer> _timers;
+    std::vector<OwnerList> _owners;
+    int _heads[FIRING_BUCKET + 1];
+    int _tails[FIRING_BUCKET + 1];
+    int _freeHead = -1;
+    uint64_t _now = 0;
+    float _ticksPerSecond = 60.0f;
+    int _pendingCount = 0;
+    unsigned int _growCount = 0;
+    unsigned long long _firedCount = 0;
+};
@@ -1,22 +1,7 @@
 #include "Boss.h"
-#include "Player/Maria.h"  // ͷļ
 
 USING_NS_CC;
 
-// Դ (.c3bļĿе·ı޸)
-static const std::string ANIM_IDLE = "Armature|maw_idle";               // ö
-static const std::string ANIM_WALK = "Armature|maw_walk";               // ߶
-static const std::string ANIM_RUN = "Armature|maw_run";                 // ܶ
-static const std::string ANIM_DEAD = "Armature|maw_dead";               // 
-static const std::string ANIM_SHOW_MUSLE = "Armature|maw_showMusle";     // չʾ⶯
-static const std::string ANIM_ROAR = "Armature|maw_roar";               // 
-static const std::string ANIM_DODGE = "Armature|maw_dodge_right";        // ܶ
-static const std::vector<std::string> ATTACK_ANIMS = {                   // б
-    "Armature|maw_punch",
-    "Armature|maw_swipe",
-    "Armature|maw_jumpAttack_2"
-};
-
 /**
  * Bossʵ
  * @param modelPath ģļ·
@@ -44,145 +29,48 @@ bool Boss::init(const std::string& modelPath)
     if (!Sprite3D::initWithFile(modelPath))
         return false;
 
-    _modelPath = modelPath;
-    current_blood = max_blood;  // ʼѪΪѪ
-    _state = State::IDLE;       // ʼ״̬Ϊ
-
-    // ʼ
-    CrossFadeAnim(ANIM_IDLE, true, 0.0f);
+    if (!BossLogic::isPreloaded())
+        preloadAnimations(modelPath);  // δԤʱ
 
-    this->scheduleUpdate();     // ֡
+    // ǼǾö
+    // ֡£update() ɳĹ̶ģͳһ
+    _logic.init(this, this);
     return true;
 }
 
 /**
- * ֡º
+ * ֡º߼ºͬڵ任(ģtick֮ȡڵλֵ)
  * @param dt ֡ʱ
  */
 void Boss::update(float dt)
 {
-    if (_state == State::DEAD)
-        return;
-
-    attackTimer += dt;  // ¹ʱ
-    HandleAI(dt);       // AI߼
+    _logic.update(dt);
+    setPosition3D(_logic.getPosition3D());
+    setRotation3D(Vec3(0, _logic.getYaw(), 0));
 }
 
 /**
- * AI߼
- * @param dt ֡ʱ
+ * Boss
+ * @param position 
  */
-void Boss::HandleAI(float dt)
+void Boss::setSpawnPosition(const Vec3& position)
 {
-    if (!_player)
-        return;
-
-    // 񱩡״̬²ִAI߼
-    if (_state == State::DEAD || _state == State::RAGING || _state == State::DODGING)
-        return;
-
-    float dist = Distance_BossPlayer();  // ҵľ
-
-    // ڹΧ
-    if (dist <= attack_range)
-    {
-        // ȴҵǰǹ״̬
-        if (attackTimer >= attack_cooldown && _state != State::ATTACK)
-        {
-            attackTimer = 0.0f;
-            // ״̬ѡ񹥻ʽʹĬϹ
-            PerformAttack(is_rage ? cocos2d::random(0, (int)ATTACK_ANIMS.size() - 1) : 0);
-        }
-        // ǹ״̬ʱл
-        else if (_state != State::ATTACK && _state != State::IDLE)
-        {
-            _state = State::IDLE;
-            CrossFadeAnim(ANIM_IDLE, true);
-        }
-
-        // ת
-        Vec3 dir = _player->getPosition3D() - getPosition3D();
-        setRotation3D(Vec3(0, CC_RADIANS_TO_DEGREES(atan2(dir.x, dir.z)), 0));
-    }
-    // ڹΧҷǹ״̬ʱƶ
-    else if (_state != State::ATTACK)
-    {
-        MoveToPlayer(dt);
-    }
+    _logic.setPosition3D(position);
+    setPosition3D(position);
 }
 
 /**
- * ƶ
- * @param dt ֡ʱ
- */
-void Boss::MoveToPlayer(float dt)
-{
-    if (!_player || _state == State::DEAD)
-        return;
-
-    Vec3 bossPos = getPosition3D();
-    Vec3 playerPos = _player->getPosition3D();
-
-    // 1. 㷽Yᣨˮƽƶ
-    Vec3 dir = playerPos - bossPos;
-    dir.y = 0;  // ȷBossˮƽƶ
-
-    float distance = dir.length();  // 
-
-    // 2. ӽΧʱֹͣƶ
-    if (distance <= attack_range * 0.95f)
-    {
-        if (_state != State::IDLE && _state != State::ATTACK)
-        {
-            _state = State::IDLE;
-            CrossFadeAnim(ANIM_IDLE, true);
-        }
-        return;
-    }
-
-    // 3. һ
-    dir.normalize();
-
-    // 4. ִλø£XZᣩ
-    float speed = is_rage ? run_speed : walk_speed;  // ״̬ʹñٶ
-    this->setPosition3D(Vec3(
-        bossPos.x + dir.x * speed * dt,
-        bossPos.y,  // ԭY겻
-        bossPos.z + dir.z * speed * dt
-    ));
-
-    // 5. תƶ
-    float targetAngle = CC_RADIANS_TO_DEGREES(atan2f(dir.x, dir.z));
-    setRotation3D(Vec3(0, targetAngle, 0));
-
-    // 6. ƶ״̬Ͷ
-    State moveState = is_rage ? State::RUN : State::WALK;
-    if (_state != moveState)
-    {
-        _state = moveState;
-        CrossFadeAnim(is_rage ? ANIM_RUN : ANIM_WALK, true);
-    }
-}
-
-/**
- * л뵭Ч
- * @param animName 
+ * л
+ * @param clip ƬID
  * @param loop Ƿѭ
- * @param duration ʱ
  */
-void Boss::CrossFadeAnim(const std::string& animName, bool loop, float duration)
+void Boss::playClip(ClipId clip, bool loop)
 {
-    // ظͬһ
-    if (_currentAnimName == animName)
-        return;
-
-    _currentAnimName = animName;
-
     // ֹͣǰ
     this->stopActionByTag(TAG_ANIM);
 
-    // ʵ
-    auto animation = Animation3D::create(_modelPath, animName);
+    // ӻȡƬ
+    auto animation = AnimationClipCache::getInstance()->getClip(clip);
     if (!animation)
         return;
 
@@ -203,206 +91,40 @@ void Boss::CrossFadeAnim(const std::string& animName, bool loop, float duration)
 }
 
 /**
- * ִй
- * @param type ͣӦATTACK_ANIMS
- */
-void Boss::PerformAttack(int type)
-{
-    _state = State::ATTACK;
-    std::string animName = ATTACK_ANIMS[type];
-    CrossFadeAnim(animName, false);  // Źѭ
-
-    // ȡʱ
-    auto anim = Animation3D::create(_modelPath, animName);
-    float totalTime = anim->getDuration();
-
-    // ж֡Ͷص
-    this->runAction(Sequence::create(
-        DelayTime::create(totalTime * 0.5f),  // ӳٵ;ж֡
-        CallFunc::create([this]() {
-            this->OnAttackFrameReached(is_rage ? 30 : 15);  // ״̬˺
-            }),
-        DelayTime::create(totalTime * 0.5f),  // ʣදʱ
-        CallFunc::create(CC_CALLBACK_0(Boss::OnActionFinished, this)),  // 
-        nullptr
-    ));
-}
-
-/**
- * ж֡˺
- * @param damage ˺ֵ
- */
-void Boss::OnAttackFrameReached(int damage)
-{
-    // ڹΧ˺
-    if (_player && Distance_BossPlayer() < attack_range + 30.0f)
-    {
-        auto m = dynamic_cast<Maria*>(_player);
-        if (m)
-            m->takeDamage(damage);
-    }
-}
-
-/**
- * 
+ * ֹͣж
  */
-void Boss::OnActionFinished()
+void Boss::stopActions()
 {
-    if (_state == State::DEAD)
-        return;
-
-    _state = State::IDLE;  // ص״̬
-    _currentAnimName = "";
+    this->stopAllActions();
 }
 
 /**
- * ˺
- * @param damage ˺ֵ
+ * ܻ˸Чɫɫ
  */
-void Boss::TakeDamage(int damage)
+void Boss::flashHit()
 {
-    if (_state == State::DEAD)
-        return;
-
-    current_blood -= damage;  // ۳Ѫ
-
-    // ǿ״̬ҷǹ״̬£50%
-    if (!is_rage && _state != State::ATTACK && CCRANDOM_0_1() < 0.5f)
-    {
-        performDodge();
-        return;
-    }
-
-    // ܻ˸Чɫɫ
     this->runAction(Sequence::create(
         TintTo::create(0.1f, 255, 100, 100),
         TintTo::create(0.1f, 255, 255, 255),
         nullptr
     ));
-
-    // Ѫһʱģʽ
-    if (!is_rage && current_blood < max_blood / 2)
-    {
-        is_rage = true;
-        enterRageMode();
-    }
-
-    CCLOG("Boss took %d damage, remaining HP: %d", damage, current_blood);
-
-    // ѪΪ0ʱ
-    if (current_blood <= 0)
-        Die();
 }
 
 /**
- * 
+ * ֣ź󵭳Ƴڶڲ RemoveSelf
+ * жʤģ漴ֹͣʱƽʹýڵ㶯
  */
-void Boss::Die()
+void Boss::playDeath()
 {
-    _state = State::DEAD;
-    this->stopAllActions();  // ֹͣж
-    CrossFadeAnim(ANIM_DEAD, false);  // 
-
-    // ź󵭳Ƴ
     this->runAction(Sequence::create(
         DelayTime::create(2.0f),
         FadeOut::create(1.0f),
-        RemoveSelf::create(),
-        nullptr
-    ));
-}
-
-/**
- * ҵľ
- * @return ֵ
- */
-float Boss::Distance_BossPlayer()
-{
-    return _player ? getPosition3D().distance(_player->getPosition3D()) : 9999.0f;
-}
-
-/**
- * ģʽ
- */
-void Boss::enterRageMode()
-{
-    is_rage = true;
-    _state = State::RAGING;
-    this->stopAllActions();  // ֹͣǰж
-
-    // ģʽУȴָս״̬ȴ̣
-    auto sequence = Sequence::create(
-        CallFunc::create([this]() { CrossFadeAnim(ANIM_ROAR, false); }),
-        DelayTime::create(3.0f),  // ʱ
         CallFunc::create([this]() {
-            attack_cooldown *= 0.6f;  // ȴΪ60%
-            _state = State::IDLE;
-            }),
+            if (_onDeathFinished)
+                _onDeathFinished(this);
+            else
+                this->removeFromParent();
+        }),
         nullptr
-    );
-    this->runAction(sequence);
-}
-
-/**
- * ִܶ
- */
-void Boss::performDodge()
-{
-    if (_state == State::DODGING || !_player)
-        return;
-
-    _state = State::DODGING;
-    CrossFadeAnim(ANIM_DODGE, false);  // ܶ
-
-    // 1. ¼ǰYָ꣨߶Ȳ䣩
-    Vec3 currentPos = this->getPosition3D();
-    float lockY = currentPos.y;
-
-    // Զҵķ
-    Vec3 dir = currentPos - _player->getPosition3D();
-    dir.y = 0;
-    dir.normalize();
-
-    // 2. Ŀλ
-    float dodgeDist = 150.0f;
-    Vec3 targetPos = Vec3(
-        currentPos.x + dir.x * dodgeDist,
-        lockY,
-        currentPos.z + dir.z * dodgeDist
-    );
-
-    // 3. ִƶ
-    auto moveAction = MoveTo::create(0.4f, targetPos);
-
-    // ܽص״̬
-    auto callback = CallFunc::create([this]() {
-        _state = State::IDLE;
-        });
-
-    this->runAction(Sequence::create(moveAction, callback, nullptr));
-}
-
-/**
- * Ŀ
- * @param player ҽڵ
- */
-void Boss::setTarget(Node* player)
-{
-    _player = player;
-}
-
-/**
- * жǷ
- * @return Ƿ
- */
-bool Boss::IsDead() const
-{
-    return _state == State::DEAD;
-}
-
-/**
- * 
- */
-Boss::~Boss()
-{
+    ));
 }
\ No newline at end of file
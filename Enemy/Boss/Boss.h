@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include "cocos2d.h"
+#include "BossLogic.h"
+#include <functional>
 
 // 定义常量标签，防止重复定义
 #ifndef BOSS_CONSTANTS
@@ -9,9 +11,11 @@ static constexpr int TAG_HIT = 101;   // 受击动作标签
 #endif
 
 /**
- * Boss类 - 继承自Sprite3D，实现Boss的所有行为逻辑
+ * Boss类(渲染代理) - 继承自Sprite3D
+ * 行为逻辑全部在持有的 BossLogic 中：本类转发接口，实现动画与受击/死亡表现，
+ * 并在逻辑更新后把位置/朝向同步到节点
  */
-class Boss : public cocos2d::Sprite3D
+class Boss : public cocos2d::Sprite3D, public BossView
 {
 public:
     /**
@@ -21,6 +25,12 @@ public:
      */
     static Boss* createBoss(const std::string& modelPath);
 
+    /**
+     * 预加载Boss的全部动画片段(场景加载时调用一次)
+     * @param modelPath 模型文件路径
+     */
+    static void preloadAnimations(const std::string& modelPath) { BossLogic::preloadAnimations(modelPath); }
+
     /**
      * 初始化Boss
      * @param modelPath 模型文件路径
@@ -35,81 +45,94 @@ public:
     virtual void update(float dt);
 
     /**
-     * 析构函数
+     * 放置Boss(逻辑与节点同时设置)
+     * @param position 世界坐标
      */
-    virtual ~Boss();
+    void setSpawnPosition(const cocos2d::Vec3& position);
 
     /**
      * 设置攻击目标（玩家）
-     * @param player 玩家节点指针
+     * @param player 玩家的实体句柄，每次使用时查表校验
+     */
+    void setTarget(EntityHandle player) { _logic.setTarget(player); }
+
+    /**
+     * 设置关卡静态碰撞（由场景持有），追击玩家与闪避时撞墙沿墙滑动
+     * @param collision 碰撞世界，为空时不做墙体碰撞
+     */
+    void setCollisionWorld(const CollisionWorld* collision) { _logic.setCollisionWorld(collision); }
+
+    /**
+     * 设置玩法定时器（由场景的模拟驱动器持有），闪避的结束在其中登记
+     * @param timers 时间轮
+     */
+    void setTimerWheel(TimerWheel* timers) { _logic.setTimerWheel(timers); }
+
+    /**
+     * 设置脚本任务调度器（由场景的模拟驱动器持有），攻击与狂暴时间线作为任务运行
+     * @param tasks 任务调度器
      */
-    void setTarget(cocos2d::Node* player);
+    void setTaskScheduler(TaskScheduler* tasks) { _logic.setTaskScheduler(tasks); }
+
+    /**
+     * 设置战斗事件队列（由场景的模拟驱动器持有），对玩家的命中登记其中，tick结束时统一结算
+     * @param events 事件队列
+     */
+    void setCombatEvents(CombatEventQueue* events) { _logic.setCombatEvents(events); }
+
+    /** Boss逻辑(无渲染依赖) */
+    BossLogic& getLogic() { return _logic; }
+
+    /** 获取Boss自身的实体句柄 */
+    EntityHandle getEntityHandle() const { return _logic.getEntityHandle(); }
 
     /**
      * 承受伤害
      * @param damage 伤害值
+     * @return 结算结果（已死亡时为空结果）
      */
-    void TakeDamage(int damage);
+    HitResult TakeDamage(int damage) { return _logic.TakeDamage(damage); }
 
     /**
      * 判断Boss是否死亡
      * @return 是否死亡
      */
-    bool IsDead() const;
+    bool IsDead() const { return _logic.IsDead(); }
 
     /**
      * 获取当前血量
      * @return 当前血量值
      */
-    int getCurrentBlood() const { return current_blood; }
+    int getCurrentBlood() const { return _logic.getCurrentBlood(); }
 
     /**
      * 获取最大血量
      * @return 最大血量值
      */
-    int getMaxBlood() const { return max_blood; }
+    int getMaxBlood() const { return _logic.getMaxBlood(); }
+
+    /**
+     * 设置血量变化回调(受击扣血时调用)，HUD据此按需刷新
+     * @param callback 回调
+     */
+    void setHealthChangedCallback(const std::function<void()>& callback) { _logic.setHealthChangedCallback(callback); }
+
+    /**
+     * 设置死亡表现结束回调(死亡动画与淡出完成后调用)，由场景决定何时移除节点
+     * 未设置时直接从父节点移除
+     * @param callback 回调
+     */
+    void setDeathFinishedCallback(const std::function<void(Boss*)>& callback) { _onDeathFinished = callback; }
+
+    //------------------------------
+    // BossView接口实现
+    //------------------------------
+    virtual void playClip(ClipId clip, bool loop) override;
+    virtual void stopActions() override;
+    virtual void flashHit() override;
+    virtual void playDeath() override;
 
 private:
-    // Boss状态枚举
-    enum class State
-    {
-        IDLE,       // 闲置
-        ATTACK,     // 攻击
-        DEAD,       // 死亡
-        WALK,       // 行走
-        RUN,        // 奔跑
-        HIT,        // 受击
-        RAGING,     // 狂暴中
-        DODGING     // 闪避中
-    };
-
-    // AI与逻辑处理
-    void HandleAI(float dt);              // 处理AI逻辑
-    void MoveToPlayer(float dt);          // 向玩家移动
-    void PerformAttack(int type);         // 执行攻击动作
-    void Die();                           // 死亡处理
-    void enterRageMode();                 // 进入狂暴模式
-    void performDodge();                  // 执行闪避动作
-
-    // 动画控制
-    void CrossFadeAnim(const std::string& animName, bool loop, float duration = 0.2f);  // 动画切换
-    void OnAttackFrameReached(int damage);  // 攻击判定帧处理
-    void OnActionFinished();                // 动作结束处理
-    float Distance_BossPlayer();            // 计算与玩家的距离
-
-    // 成员变量
-    State _state;                          // 当前状态
-    cocos2d::Node* _player = nullptr;      // 目标玩家
-    std::string _modelPath;                // 模型路径
-    std::string _currentAnimName = "";     // 当前播放的动画名称
-
-    int max_blood = 500;                   // 最大血量
-    int current_blood;                     // 当前血量
-    float attack_cooldown = 7.0f;          // 攻击冷却时间
-    float attackTimer = 0.0f;              // 攻击计时器
-    bool is_rage = false;                  // 是否处于狂暴状态
-
-    float walk_speed = 60.0f;              // 行走速度
-    float run_speed = 90.0f;               // 奔跑速度
-    float attack_range = 170.0f;           // 攻击范围
+    BossLogic _logic;                            // Boss逻辑
+    std::function<void(Boss*)> _onDeathFinished; // 死亡表现结束回调
 };
\ No newline at end of file
@@ -0,0 +1,479 @@
+#include "BossLogic.h"
+#include "Player/Player.h"  // 玩家接口头文件
+#include "Core/CollisionWorld.h"
+#include "Core/HitWindowTable.h"
+#include <cstdlib>  // 用于随机数
+
+USING_NS_CC;
+
+// 碰撞胶囊尺寸
+static const float COLLISION_RADIUS = 60.0f;
+static const float COLLISION_HEIGHT = 250.0f;
+// 命中窗口判定时玩家的身体半径
+static const float PLAYER_HIT_RADIUS = 30.0f;
+// 攻击动画缺失时的兜底时长(判定帧在一半处)
+static const float ATTACK_FALLBACK_DURATION = 1.5f;
+// 闪避距离与时长
+static const float DODGE_DISTANCE = 150.0f;
+static const float DODGE_TIME = 0.4f;
+
+// 动画资源定义 (如果动画.c3b文件在项目中的路径改变需修改)
+static const std::string ANIM_IDLE = "Armature|maw_idle";               // 闲置动画
+static const std::string ANIM_WALK = "Armature|maw_walk";               // 行走动画
+static const std::string ANIM_RUN = "Armature|maw_run";                 // 奔跑动画
+static const std::string ANIM_DEAD = "Armature|maw_dead";               // 死亡动画
+static const std::string ANIM_SHOW_MUSLE = "Armature|maw_showMusle";     // 展示肌肉动画
+static const std::string ANIM_ROAR = "Armature|maw_roar";               // 咆哮动画
+static const std::string ANIM_DODGE = "Armature|maw_dodge_right";        // 闪避动画
+static const int ATTACK_CLIP_COUNT = 3;
+static const char* const ATTACK_ANIMS[ATTACK_CLIP_COUNT] = {            // 攻击动画列表
+    "Armature|maw_punch",
+    "Armature|maw_swipe",
+    "Armature|maw_jumpAttack_2"
+};
+
+// 动画片段ID (preloadAnimations 中登记，运行时只按ID取缓存；未登记时为 INVALID_CLIP)
+static ClipId CLIP_IDLE = INVALID_CLIP;
+static ClipId CLIP_WALK = INVALID_CLIP;
+static ClipId CLIP_RUN = INVALID_CLIP;
+static ClipId CLIP_DEAD = INVALID_CLIP;
+static ClipId CLIP_ROAR = INVALID_CLIP;
+static ClipId CLIP_DODGE = INVALID_CLIP;
+static ClipId ATTACK_CLIPS[ATTACK_CLIP_COUNT] = { INVALID_CLIP, INVALID_CLIP, INVALID_CLIP };
+
+/**
+ * 预加载Boss动画片段
+ * @param modelPath 模型文件路径
+ */
+void BossLogic::preloadAnimations(const std::string& modelPath)
+{
+    auto cache = AnimationClipCache::getInstance();
+
+    CLIP_IDLE = cache->registerClip(modelPath, ANIM_IDLE);
+    CLIP_WALK = cache->registerClip(modelPath, ANIM_WALK);
+    CLIP_RUN = cache->registerClip(modelPath, ANIM_RUN);
+    CLIP_DEAD = cache->registerClip(modelPath, ANIM_DEAD);
+    CLIP_ROAR = cache->registerClip(modelPath, ANIM_ROAR);
+    CLIP_DODGE = cache->registerClip(modelPath, ANIM_DODGE);
+
+    for (int i = 0; i < ATTACK_CLIP_COUNT; ++i)
+        ATTACK_CLIPS[i] = cache->registerClip(modelPath, ATTACK_ANIMS[i]);
+}
+
+/**
+ * 动画片段是否已登记
+ */
+bool BossLogic::isPreloaded()
+{
+    return CLIP_IDLE != INVALID_CLIP;
+}
+
+/**
+ * 登记实体句柄并进入闲置状态
+ * @param view 表现接口
+ * @param node 场景节点
+ */
+void BossLogic::init(BossView* view, Node* node)
+{
+    _view = view;
+    current_blood = max_blood;  // 初始血量设为最大血量
+    _state = State::IDLE;       // 初始状态为闲置
+
+    EntityRegistry::getInstance()->destroy(_entityHandle);
+    _entityHandle = EntityRegistry::getInstance()->createBoss(this, node);
+
+    // 初始化动画
+    CrossFadeAnim(CLIP_IDLE, true, 0.0f);
+}
+
+/**
+ * 析构：注销实体句柄
+ */
+BossLogic::~BossLogic()
+{
+    EntityRegistry::getInstance()->destroy(_entityHandle);
+}
+
+/**
+ * 帧更新函数
+ * @param dt 帧间隔时间
+ */
+void BossLogic::update(float dt)
+{
+    if (_state == State::DEAD)
+        return;
+
+    attackTimer += dt;  // 更新攻击计时器
+
+    // 闪避中：按闪避速度位移（结束由定时器切回闲置）
+    if (_state == State::DODGING)
+        _position = moveTo(_position + _dodgeVelocity * dt);
+
+    HandleAI(dt);       // 处理AI逻辑
+}
+
+/**
+ * 从当前位置移动到期望位置，撞墙时沿墙滑动
+ * @param desired 期望位置
+ */
+Vec3 BossLogic::moveTo(const Vec3& desired) const
+{
+    if (!_collision)
+        return desired;
+    return _collision->moveAndSlide(_position, desired, COLLISION_RADIUS, COLLISION_HEIGHT);
+}
+
+/**
+ * 处理AI逻辑
+ * @param dt 帧间隔时间
+ */
+void BossLogic::HandleAI(float dt)
+{
+    Player* player = getTargetPlayer();
+    if (!player)
+        return;
+
+    // 死亡、狂暴、闪避状态下不执行AI逻辑
+    if (_state == State::DEAD || _state == State::RAGING || _state == State::DODGING)
+        return;
+
+    float dist = Distance_BossPlayer();  // 计算与玩家的距离
+
+    // 在攻击范围内
+    if (dist <= attack_range)
+    {
+        // 攻击冷却结束且当前不是攻击状态
+        if (attackTimer >= attack_cooldown && _state != State::ATTACK)
+        {
+            attackTimer = 0.0f;
+            // 狂暴状态随机选择攻击方式，否则使用默认攻击
+            PerformAttack(is_rage ? rand() % ATTACK_CLIP_COUNT : 0);
+        }
+        // 非攻击和闲置状态时切换到闲置
+        else if (_state != State::ATTACK && _state != State::IDLE)
+        {
+            _state = State::IDLE;
+            CrossFadeAnim(CLIP_IDLE, true);
+        }
+
+        // 转向玩家
+        Vec3 dir = player->getPosition3D() - _position;
+        _yaw = CC_RADIANS_TO_DEGREES(atan2(dir.x, dir.z));
+    }
+    // 不在攻击范围内且非攻击状态时，向玩家移动
+    else if (_state != State::ATTACK)
+    {
+        MoveToPlayer(dt);
+    }
+}
+
+/**
+ * 向玩家移动
+ * @param dt 帧间隔时间
+ */
+void BossLogic::MoveToPlayer(float dt)
+{
+    Player* player = getTargetPlayer();
+    if (!player || _state == State::DEAD)
+        return;
+
+    Vec3 bossPos = _position;
+    Vec3 playerPos = player->getPosition3D();
+
+    // 1. 计算方向向量并忽略Y轴（保持水平移动）
+    Vec3 dir = playerPos - bossPos;
+    dir.y = 0;  // 确保Boss在水平面上移动
+
+    float distance = dir.length();  // 计算距离
+
+    // 2. 接近攻击范围时停止移动
+    if (distance <= attack_range * 0.95f)
+    {
+        if (_state != State::IDLE && _state != State::ATTACK)
+        {
+            _state = State::IDLE;
+            CrossFadeAnim(CLIP_IDLE, true);
+        }
+        return;
+    }
+
+    // 3. 归一化方向向量
+    dir.normalize();
+
+    // 4. 执行位置更新（仅X和Z轴，撞墙时沿墙滑动）
+    float speed = is_rage ? run_speed : walk_speed;  // 狂暴状态下使用奔跑速度
+    Vec3 nextPos(
+        bossPos.x + dir.x * speed * dt,
+        bossPos.y,  // 保持原Y坐标不变
+        bossPos.z + dir.z * speed * dt
+    );
+    _position = moveTo(nextPos);
+
+    // 5. 转向移动方向
+    _yaw = CC_RADIANS_TO_DEGREES(atan2f(dir.x, dir.z));
+
+    // 6. 更新移动状态和动画
+    State moveState = is_rage ? State::RUN : State::WALK;
+    if (_state != moveState)
+    {
+        _state = moveState;
+        CrossFadeAnim(is_rage ? CLIP_RUN : CLIP_WALK, true);
+    }
+}
+
+/**
+ * 动画切换（淡入淡出效果）
+ * @param clip 动画片段ID
+ * @param loop 是否循环播放
+ * @param duration 过渡时间
+ */
+void BossLogic::CrossFadeAnim(ClipId clip, bool loop, float duration)
+{
+    // 避免重复播放同一动画
+    if (_currentClip == clip)
+        return;
+
+    _currentClip = clip;
+    if (_view)
+        _view->playClip(clip, loop);
+}
+
+/**
+ * 攻击时间线：动画播放到一半时判定，播放完毕后结束动作
+ */
+struct BossLogic::AttackTask : public GameplayTask
+{
+    BossLogic* self;
+    ClipId clip;
+    const HitWindow* window;   // 烘焙的命中窗口(没有时按动画一半处判定)
+
+    AttackTask(BossLogic* owner, ClipId attackClip)
+        : self(owner), clip(attackClip), window(HitWindowTable::getInstance()->getWindow(attackClip, 0)) {}
+
+    bool resume() override
+    {
+        TASK_BEGIN();
+        startClip(clip, ATTACK_FALLBACK_DURATION);
+        if (window) {
+            // 窗口打开期间逐tick检测判定球，命中一次或窗口关闭即止
+            TASK_AWAIT_CLIP_TIME(window->start);
+            TASK_AWAIT_UNTIL(self->OnHitWindowTick(*window, self->is_rage ? 30 : 15) || getClipTime() >= window->end);
+        }
+        else {
+            TASK_AWAIT_MARKER(0.5f);  // 判定帧
+            self->OnAttackFrameReached(self->is_rage ? 30 : 15);  // 狂暴状态伤害更高
+        }
+        TASK_AWAIT_MARKER(1.0f);  // 动画结束
+        self->OnActionFinished();
+        TASK_END();
+    }
+};
+
+/**
+ * 狂暴时间线：咆哮→等待→恢复战斗状态（攻击冷却缩短）
+ */
+struct BossLogic::RageTask : public GameplayTask
+{
+    BossLogic* self;
+
+    explicit RageTask(BossLogic* owner) : self(owner) {}
+
+    bool resume() override
+    {
+        TASK_BEGIN();
+        self->CrossFadeAnim(CLIP_ROAR, false);
+        TASK_AWAIT_SECONDS(3.0f);  // 咆哮动画持续时间
+        self->attack_cooldown *= 0.6f;  // 攻击冷却缩短为60%
+        self->_state = State::IDLE;
+        TASK_END();
+    }
+};
+
+/**
+ * 执行攻击动作
+ * @param type 攻击类型（对应ATTACK_CLIPS的索引）
+ */
+void BossLogic::PerformAttack(int type)
+{
+    _state = State::ATTACK;
+    ClipId clip = ATTACK_CLIPS[type];
+    CrossFadeAnim(clip, false);  // 播放攻击动画（非循环）
+
+    // 判定帧与动作结束按动画时长推进（时长已在缓存中记录）
+    if (_tasks)
+        _tasks->start<AttackTask>(_taskArena, _entityHandle, this, clip);
+}
+
+/**
+ * 攻击判定帧处理（造成伤害）
+ * @param damage 伤害值
+ */
+void BossLogic::OnAttackFrameReached(int damage)
+{
+    // 在攻击范围内则对玩家造成伤害
+    Player* player = getTargetPlayer();
+    if (player && _combatEvents && Distance_BossPlayer() < attack_range + 30.0f)
+        _combatEvents->pushHit(_entityHandle, _player, damage);
+}
+
+/**
+ * 命中窗口内的逐tick判定：判定球接触玩家时造成伤害
+ * @param window 命中窗口
+ * @param damage 伤害值
+ * @return 是否命中
+ */
+bool BossLogic::OnHitWindowTick(const HitWindow& window, int damage)
+{
+    Player* player = getTargetPlayer();
+    if (!player)
+        return false;
+
+    Vec3 center = window.shape.getCenter(_position, _yaw);
+    float reach = window.shape.radius + PLAYER_HIT_RADIUS;
+    if (center.distanceSquared(player->getPosition3D()) > reach * reach)
+        return false;
+
+    if (_combatEvents)
+        _combatEvents->pushHit(_entityHandle, _player, damage);
+    return true;
+}
+
+/**
+ * 动作结束处理
+ */
+void BossLogic::OnActionFinished()
+{
+    if (_state == State::DEAD)
+        return;
+
+    _state = State::IDLE;  // 回到闲置状态
+    _currentClip = INVALID_CLIP;
+}
+
+/**
+ * 承受伤害处理
+ * @param damage 伤害值
+ */
+HitResult BossLogic::TakeDamage(int damage)
+{
+    if (_state == State::DEAD)
+        return HitResult::none();
+
+    current_blood -= damage;  // 扣除血量
+    if (_onHealthChanged)
+        _onHealthChanged();
+
+    // 非狂暴状态且非攻击状态下，有50%概率闪避
+    if (!is_rage && _state != State::ATTACK && static_cast<float>(rand()) / RAND_MAX < 0.5f)
+    {
+        performDodge();
+        return HitResult::hit(damage, false);
+    }
+
+    // 受击闪烁效果（红色→白色）
+    if (_view)
+        _view->flashHit();
+
+    // 血量低于一半时进入狂暴模式
+    if (!is_rage && current_blood < max_blood / 2)
+    {
+        is_rage = true;
+        enterRageMode();
+    }
+
+    CCLOG("Boss took %d damage, remaining HP: %d", damage, current_blood);
+
+    // 血量为0时死亡
+    if (current_blood <= 0)
+    {
+        Die();
+        return HitResult::hit(damage, true);
+    }
+    return HitResult::hit(damage, false);
+}
+
+/**
+ * 死亡处理
+ */
+void BossLogic::Die()
+{
+    _state = State::DEAD;
+    if (_view)
+        _view->stopActions();  // 停止所有动作
+    cancelScheduled();         // 取消未触发的攻击判定等
+    CrossFadeAnim(CLIP_DEAD, false);  // 播放死亡动画
+
+    // 死亡动画播放后淡出，移除交给场景
+    if (_view)
+        _view->playDeath();
+}
+
+/**
+ * 计算与玩家的距离
+ * @return 距离值
+ */
+float BossLogic::Distance_BossPlayer()
+{
+    Player* player = getTargetPlayer();
+    return player ? _position.distance(player->getPosition3D()) : 9999.0f;
+}
+
+/**
+ * 解析目标玩家句柄
+ * @return 目标玩家，句柄失效返回nullptr
+ */
+Player* BossLogic::getTargetPlayer() const
+{
+    return EntityRegistry::getInstance()->getPlayer(_player);
+}
+
+/**
+ * 进入狂暴模式
+ */
+void BossLogic::enterRageMode()
+{
+    is_rage = true;
+    _state = State::RAGING;
+    if (_view)
+        _view->stopActions();  // 停止当前所有动作
+    cancelScheduled();         // 打断进行中的攻击
+
+    if (_tasks)
+        _tasks->start<RageTask>(_taskArena, _entityHandle, this);
+}
+
+/**
+ * 取消自身的定时器与脚本任务
+ */
+void BossLogic::cancelScheduled()
+{
+    if (_timers)
+        _timers->cancelOwner(_entityHandle);
+    if (_tasks)
+        _tasks->cancelOwner(_entityHandle);
+}
+
+/**
+ * 执行闪避动作
+ */
+void BossLogic::performDodge()
+{
+    Player* player = getTargetPlayer();
+    if (_state == State::DODGING || !player)
+        return;
+
+    _state = State::DODGING;
+    CrossFadeAnim(CLIP_DODGE, false);  // 播放闪避动画
+
+    // 计算远离玩家的方向（保持高度不变）
+    Vec3 dir = _position - player->getPosition3D();
+    dir.y = 0;
+    dir.normalize();
+
+    // 闪避期间以恒定速度后撤（逐tick位移，撞墙时沿墙滑动）
+    _dodgeVelocity = dir * (DODGE_DISTANCE / DODGE_TIME);
+
+    // 闪避结束后回到闲置状态
+    if (_timers)
+        _timers->schedule(_entityHandle, DODGE_TIME, [this]() { _state = State::IDLE; });
+}
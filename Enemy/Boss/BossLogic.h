@@ -0,0 +1,171 @@
+#pragma once
+#include "cocos2d.h"
+#include "Core/AnimationClipCache.h"
+#include "Core/EntityRegistry.h"
+#include "Core/TimerWheel.h"
+#include "Core/GameplayTask.h"
+#include "Core/CombatEventQueue.h"
+#include <functional>
+#include <string>
+
+class Player;
+class CollisionWorld;
+struct HitWindow;
+
+/**
+ * Boss的表现接口(由渲染代理实现)
+ * 逻辑只通过它切换动画与播放受击/死亡表现，无头模拟中没有表现接口
+ */
+class BossView
+{
+public:
+    virtual ~BossView() {}
+
+    /**
+     * 切换动画片段(只替换正在播放的动画，受击闪烁等其他动作不受影响)
+     * @param clip 动画片段ID
+     * @param loop 是否循环播放
+     */
+    virtual void playClip(ClipId clip, bool loop) = 0;
+
+    /** 停止全部动作(被打断或死亡时) */
+    virtual void stopActions() = 0;
+
+    /** 受击闪烁 */
+    virtual void flashHit() = 0;
+
+    /** 死亡表现(死亡动画之后淡出并通知场景) */
+    virtual void playDeath() = 0;
+};
+
+/**
+ * Boss的逻辑(AI、攻击与狂暴时间线、闪避、受击与死亡)
+ * 位置与朝向保存在逻辑中，不依赖 Sprite3D/Action：攻击与狂暴作为脚本任务、闪避位移按速度逐tick推进，
+ * 动画片段缺失(如无头模拟不加载资源)时攻击按兜底时长推进。
+ * 场景中由 Boss 节点持有并把位置/朝向同步到节点；无头模拟直接持有本类。
+ */
+class BossLogic
+{
+public:
+    BossLogic() {}
+    ~BossLogic();
+
+    BossLogic(const BossLogic&) = delete;
+    BossLogic& operator=(const BossLogic&) = delete;
+
+    /**
+     * 预加载Boss的全部动画片段(场景加载时调用一次)
+     * @param modelPath 模型文件路径
+     */
+    static void preloadAnimations(const std::string& modelPath);
+
+    /** 动画片段是否已登记 */
+    static bool isPreloaded();
+
+    /**
+     * 登记实体句柄并进入闲置状态
+     * @param view 表现接口(无头模拟中为nullptr)
+     * @param node 对应的场景节点(无头模拟中为nullptr)
+     */
+    void init(BossView* view, cocos2d::Node* node);
+
+    /**
+     * 逻辑更新(由固定步长模拟调用)
+     * @param dt 固定步长
+     */
+    void update(float dt);
+
+    /**
+     * 设置攻击目标（玩家）
+     * @param player 玩家的实体句柄，每次使用时查表校验
+     */
+    void setTarget(EntityHandle player) { _player = player; }
+
+    void setCollisionWorld(const CollisionWorld* collision) { _collision = collision; }
+    void setTimerWheel(TimerWheel* timers) { _timers = timers; }
+    void setTaskScheduler(TaskScheduler* tasks) { _tasks = tasks; }
+    void setCombatEvents(CombatEventQueue* events) { _combatEvents = events; }
+    void setHealthChangedCallback(const std::function<void()>& callback) { _onHealthChanged = callback; }
+
+    /** 放置Boss */
+    void setPosition3D(const cocos2d::Vec3& position) { _position = position; }
+    cocos2d::Vec3 getPosition3D() const { return _position; }
+    float getYaw() const { return _yaw; }   // 朝向(绕Y轴，角度制)
+
+    EntityHandle getEntityHandle() const { return _entityHandle; }
+
+    /**
+     * 承受伤害（由战斗事件队列结算时调用）
+     * @param damage 伤害值
+     * @return 结算结果（已死亡时为空结果）
+     */
+    HitResult TakeDamage(int damage);
+
+    bool IsDead() const { return _state == State::DEAD; }
+    bool isRaging() const { return is_rage; }
+    int getCurrentBlood() const { return current_blood; }
+    int getMaxBlood() const { return max_blood; }
+
+private:
+    // Boss状态枚举
+    enum class State
+    {
+        IDLE,       // 闲置
+        ATTACK,     // 攻击
+        DEAD,       // 死亡
+        WALK,       // 行走
+        RUN,        // 奔跑
+        HIT,        // 受击
+        RAGING,     // 狂暴中
+        DODGING     // 闪避中
+    };
+
+    // AI与逻辑处理
+    void HandleAI(float dt);              // 处理AI逻辑
+    void MoveToPlayer(float dt);          // 向玩家移动
+    void PerformAttack(int type);         // 执行攻击动作
+    void Die();                           // 死亡处理
+    void enterRageMode();                 // 进入狂暴模式
+    void performDodge();                  // 执行闪避动作
+    void cancelScheduled();               // 取消自身的定时器与脚本任务
+    cocos2d::Vec3 moveTo(const cocos2d::Vec3& desired) const;  // 经墙体碰撞修正的移动
+
+    // 时间线（脚本任务）
+    struct AttackTask;                    // 攻击：判定帧→动作结束
+    struct RageTask;                      // 狂暴：咆哮→恢复战斗
+
+    // 动画控制
+    void CrossFadeAnim(ClipId clip, bool loop, float duration = 0.2f);  // 动画切换
+    void OnAttackFrameReached(int damage);  // 攻击判定帧处理
+    bool OnHitWindowTick(const HitWindow& window, int damage);  // 命中窗口内逐tick判定(命中返回true)
+    void OnActionFinished();                // 动作结束处理
+    float Distance_BossPlayer();            // 计算与玩家的距离
+    Player* getTargetPlayer() const;        // 解析目标句柄，失效返回nullptr
+
+    // 成员变量
+    State _state = State::IDLE;            // 当前状态
+    cocos2d::Vec3 _position;               // 模拟位置
+    float _yaw = 0.0f;                     // 朝向(角度制)
+    cocos2d::Vec3 _dodgeVelocity;          // 闪避速度(闪避中逐tick位移)
+    BossView* _view = nullptr;             // 表现接口(无头模拟中为空)
+    EntityHandle _player;                  // 目标玩家句柄
+    EntityHandle _entityHandle;            // 自身句柄
+    const CollisionWorld* _collision = nullptr;   // 墙体碰撞（场景持有）
+    TimerWheel* _timers = nullptr;         // 玩法定时器（场景持有）
+    TaskScheduler* _tasks = nullptr;       // 脚本任务调度器（场景持有）
+    CombatEventQueue* _combatEvents = nullptr;   // 战斗事件队列（场景持有）
+    TaskArena _taskArena;                  // 自身脚本任务的内存池
+    ClipId _currentClip = INVALID_CLIP;    // 当前播放的动画片段
+
+    int max_blood = 500;                   // 最大血量
+    int current_blood = 500;               // 当前血量
+    float attack_cooldown = 7.0f;          // 攻击冷却时间
+    float attackTimer = 0.0f;              // 攻击计时器
+    bool is_rage = false;                  // 是否处于狂暴状态
+
+    float walk_speed = 60.0f;              // 行走速度
+    float run_speed = 90.0f;               // 奔跑速度
+    float attack_range = 170.0f;           // 攻击范围
+
+    std::function<void()> _onHealthChanged; // 血量变化回调
+};
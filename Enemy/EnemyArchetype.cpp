@@ -0,0 +1,20 @@
+#include "EnemyArchetype.h"
+
+constexpr EnemyArchetype EnemyArchetypes::TABLE[ENEMY_TYPE_COUNT];
+
+ClipId EnemyArchetypes::s_clips[ENEMY_TYPE_COUNT][ENEMY_CLIP_COUNT] = {
+    { INVALID_CLIP, INVALID_CLIP, INVALID_CLIP, INVALID_CLIP, INVALID_CLIP, INVALID_CLIP },
+    { INVALID_CLIP, INVALID_CLIP, INVALID_CLIP, INVALID_CLIP, INVALID_CLIP, INVALID_CLIP },
+    { INVALID_CLIP, INVALID_CLIP, INVALID_CLIP, INVALID_CLIP, INVALID_CLIP, INVALID_CLIP },
+};
+
+void EnemyArchetypes::registerClips(EnemyType type)
+{
+    const EnemyArchetype& archetype = get(type);
+    auto cache = AnimationClipCache::getInstance();
+    for (int clip = 0; clip < ENEMY_CLIP_COUNT; ++clip)
+    {
+        if (archetype.clips[clip])
+            s_clips[(int)type][clip] = cache->registerClip(archetype.modelPath, archetype.clips[clip]);
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "EnemyType.h"
+#include "Core/AnimationClipCache.h"
+
+// 敌人的出生属性（每种敌人一份，取自原型表）
+struct EnemyStats
+{
+    int maxHp = 0;
+    int attack = 0;
+    float speed = 0.0f;
+    // 攻击起手距离：进入攻击动画的判定距离（实际命中距离由子类自行控制）
+    float attackRange = 50.0f;
+    // 攻击冷却：完整一次攻击行为结束后的冷却
+    float attackCooldown = 2.0f;
+    // 警戒 / 发现主角的距离
+    float detectionRange = 250.0f;
+
+    EnemyStats() = default;
+    constexpr EnemyStats(int maxHp, int attack, float speed, float attackRange, float attackCooldown, float detectionRange)
+        : maxHp(maxHp), attack(attack), speed(speed), attackRange(attackRange),
+          attackCooldown(attackCooldown), detectionRange(detectionRange)
+    {
+    }
+};
+
+// 原型中的动画片段槽位
+enum class EnemyClip : unsigned char
+{
+    IDLE,
+    RUN,
+    ATTACK,
+    HIT,
+    BLOCK,
+    DEAD
+};
+
+static constexpr int ENEMY_CLIP_COUNT = 6;
+
+/**
+ * 敌人原型：一种敌人的全部静态参数（编译期常量）
+ * 行为参数为0表示该类型没有对应行为（如牛头人无后摇、无受击硬直）
+ */
+struct EnemyArchetype
+{
+    EnemyType type;
+    const char* name;              // 日志/统计用名称
+    const char* modelPath;         // 模型路径
+    float modelScale;              // 模型缩放（命中窗口烘焙按此换算为世界单位）
+    EnemyStats stats;              // 出生属性
+    float hitTiming;               // 攻击前摇（无烘焙命中窗口时的判定时刻）
+    float hitTolerance;            // 实际命中距离 = 攻击起手距离 + 容错（避免模型偏移导致判定失效）
+    bool hitInclusive;             // 命中距离是否含边界
+    float hitRadius;               // 烘焙命中窗口时的判定球半径
+    float backSwing;               // 攻击后摇
+    float hitStun;                 // 受击硬直
+    float retreatDistance;         // 后退距离
+    float retreatTime;             // 后退时间
+    float blockChance;             // 格挡概率
+    float blockTime;               // 格挡持续时间
+    const char* clips[ENEMY_CLIP_COUNT];   // 动画片段名（按 EnemyClip 排列，nullptr 表示无）
+};
+
+/**
+ * 敌人原型表
+ * 属性、距离、冷却、片段名与模型路径集中在一张编译期表中，按 EnemyType 下标访问；
+ * 片段ID要等场景加载时向 AnimationClipCache 登记后才有，单独存放在运行期表中。
+ */
+class EnemyArchetypes
+{
+public:
+    static constexpr EnemyArchetype TABLE[ENEMY_TYPE_COUNT] = {
+        {
+            EnemyType::GOBLIN, "Goblin", "model/goblin/goblin.c3b", 0.15f,
+            EnemyStats(60, 12, 70.0f, 70.0f, 4.0f, 300.0f),   // 移动较快
+            1.5f, 10.0f, true, 40.0f,
+            1.0f, 0.5f, 60.0f, 0.6f, 0.0f, 0.0f,
+            { "Armature|goblin_idle", "Armature|goblin_run", "Armature|goblin_attack",
+              "Armature|goblin_hit", nullptr, "Armature|goblin_dead" }
+        },
+        {
+            EnemyType::MINOTAUR, "Minotaur", "model/minotaur/minotaur.c3b", 1.0f,
+            EnemyStats(200, 28, 35.0f, 40.0f, 3.0f, 350.0f),  // 高血量高攻击，移动较慢，检测范围较广
+            0.6f, 25.0f, false, 70.0f,
+            0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+            { "Armature|minotaur_idle", "Armature|minotaur_walk", "Armature|minotaur_attack",
+              "Armature|minotaur_hit", nullptr, "Armature|minotaur_dead" }
+        },
+        {
+            EnemyType::KNIGHT, "Knight", "model/knight/knight.c3b", 0.15f,
+            EnemyStats(150, 20, 45.0f, 35.0f, 5.0f, 250.0f),  // 持盾，75%概率格挡
+            0.45f, 20.0f, false, 50.0f,
+            0.0f, 0.4f, 0.0f, 0.0f, 0.75f, 0.5f,
+            { "Armature|knight_idle", "Armature|knight_walk", "Armature|knight_attack",
+              "Armature|knight_hit", "Armature|knight_block", "Armature|knight_death" }
+        },
+    };
+
+    /** 按类型取原型（常量表达式，可用于 constexpr/static_assert） */
+    static constexpr const EnemyArchetype& get(EnemyType type) { return TABLE[(int)type]; }
+
+    /** 向动画片段缓存登记该类型的全部片段（场景加载时调用一次） */
+    static void registerClips(EnemyType type);
+    /** 已登记的片段ID，未登记返回 INVALID_CLIP */
+    static ClipId getClip(EnemyType type, EnemyClip clip) { return s_clips[(int)type][(int)clip]; }
+
+private:
+    static ClipId s_clips[ENEMY_TYPE_COUNT][ENEMY_CLIP_COUNT];
+};
+
+static_assert(EnemyArchetypes::get(EnemyType::GOBLIN).type == EnemyType::GOBLIN &&
+    EnemyArchetypes::get(EnemyType::MINOTAUR).type == EnemyType::MINOTAUR &&
+    EnemyArchetypes::get(EnemyType::KNIGHT).type == EnemyType::KNIGHT,
+    "EnemyArchetypes: TABLE must be ordered by EnemyType");
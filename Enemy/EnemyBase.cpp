@@ -1,4 +1,5 @@
 #include "EnemyBase.h"
+#include "EnemyStore.h"
 
 USING_NS_CC;
 
@@ -6,6 +7,7 @@ EnemyBase::EnemyBase() {}
 
 EnemyBase::~EnemyBase()
 {
+    releaseEntityHandle();
     CC_SAFE_RELEASE(_idleAction);
     CC_SAFE_RELEASE(_runAction);
     CC_SAFE_RELEASE(_attackAction);
@@ -19,105 +21,104 @@ bool EnemyBase::init()
     if (!Node::init())
         return false;
 
-    _attackRange = 50.0f;  // ĬϹ
-    _attackCooldown = 2.0f;   // ĬϹȴ
-    _detectionRange = 250.0f;
-
-    _attackTimer = 0.0f;
-    _state = EnemyState::IDLE;
-
-    scheduleUpdate();
+    //  scheduleUpdate߼ɳĹ̶ģͳһ
+    _entityHandle = EntityRegistry::getInstance()->createEnemy(this);
     return true;
 }
 
-void EnemyBase::update(float dt)
-{
-    if (_state == EnemyState::DEAD)
-        return;
-
-    _attackTimer += dt;
-}
-
-void EnemyBase::setTarget(Node* target)
+HitResult EnemyBase::takeDamage(int damage)
 {
-    _target = target;
+    if (!_store)
+        return HitResult::none();
+    return _store->applyDamage(_storeIndex, damage);
 }
 
 bool EnemyBase::isDead() const
 {
-    return _state == EnemyState::DEAD;
+    return !_store || _store->isDead(_storeIndex);
 }
 
-bool EnemyBase::isInAttackRange() const
+void EnemyBase::bindStore(EnemyStore* store, int index)
 {
-    if (!_target || !_target->getParent())
-        return false;
-
-    float dist = this->getPosition3D().distance(_target->getPosition3D());
-    return dist <= _attackRange;
+    _store = store;
+    _storeIndex = index;
 }
 
-void EnemyBase::moveTowardsTarget(float dt)
+void EnemyBase::applyRenderState(const Vec3& position, float yaw, EnemyState anim, unsigned int animSerial)
 {
-    if (!_target || _state == EnemyState::ATTACK || _state == EnemyState::BLOCK)
-        return;
+    this->setPosition3D(position);
 
-    Vec3 dir = _target->getPosition3D() - this->getPosition3D();
-    dir.normalize();
+    if (yaw != _shownYaw)
+    {
+        _shownYaw = yaw;
+        this->setRotation3D(Vec3(0, yaw, 0));
+    }
 
-    this->setPosition3D(
-        this->getPosition3D() + dir * _speed * dt);
+    if (animSerial != _shownAnimSerial)
+    {
+        _shownAnimSerial = animSerial;
+        playStateAnimation(anim);
+    }
 }
 
-void EnemyBase::rotateToTarget()
+void EnemyBase::setAnimationFrozen(bool frozen)
 {
-    if (!_target)
+    if (_animationFrozen == frozen)
         return;
 
-    Vec3 dir = _target->getPosition3D() - this->getPosition3D();
-    float angle = CC_RADIANS_TO_DEGREES(atan2(dir.x, dir.z));
-    this->setRotation3D(Vec3(0, angle, 0));
-}
-
-void EnemyBase::takeDamage(int damage)
-{
-    if (_state == EnemyState::DEAD)
+    _animationFrozen = frozen;
+    if (!_model)
         return;
 
-    _hp -= damage;
-
-    if (_hp <= 0)
-    {
-        _hp = 0;
-        changeState(EnemyState::DEAD);
-    }
+    if (frozen)
+        _model->pause();
     else
-    {
-        changeState(EnemyState::HIT);
-    }
+        _model->resume();
 }
 
-void EnemyBase::changeState(EnemyState state)
+void EnemyBase::reset(const Vec3& position)
 {
-    // л
-    if (_state == EnemyState::DEAD)
-        return;
+    this->stopAllActions();
+    if (_model)
+        _model->stopAllActions();
+    setAnimationFrozen(false);
+
+    _store = nullptr;
+    _storeIndex = -1;
+    _shownYaw = 0.0f;
+    _shownAnimSerial = 0;  // ǼǺ״ͬز
+
+    // µǼǣǰеľɾȫʧЧ
+    releaseEntityHandle();
+    _entityHandle = EntityRegistry::getInstance()->createEnemy(this);
+
+    this->setPosition3D(position);
+    this->setRotation3D(Vec3::ZERO);
+    this->setVisible(true);
+}
 
-    // У״̬
-    if (_state == EnemyState::BLOCK && state != EnemyState::DEAD)
-        return;
+float EnemyBase::getDeathDuration() const
+{
+    return _deadAction ? _deadAction->getDuration() : 0.0f;
+}
 
-    if (_state == state)
+void EnemyBase::releaseEntityHandle()
+{
+    if (_entityHandle.isNull())
         return;
 
-    _state = state;
+    EntityRegistry::getInstance()->destroy(_entityHandle);
+    _entityHandle = EntityHandle();
+}
 
+void EnemyBase::playStateAnimation(EnemyState anim)
+{
     if (!_model)
         return;
 
     _model->stopAllActions();
 
-    switch (_state)
+    switch (anim)
     {
     case EnemyState::IDLE:
         if (_idleAction)
@@ -151,4 +152,4 @@ void EnemyBase::changeState(EnemyState state)
             _model->runAction(_deadAction);
         break;
     }
-}
\ No newline at end of file
+}
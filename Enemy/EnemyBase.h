@@ -1,7 +1,15 @@
 #pragma once
 #include "cocos2d.h"
 #include "EnemyState.h"
+#include "EnemyType.h"
+#include "Core/EntityRegistry.h"
+#include "Core/CombatEvent.h"
 
+class EnemyStore;
+class EnemyPool;
+struct EnemyStats;
+
+// Ⱦ߼ݴ EnemyStore Уڵֻģ붯
 class EnemyBase : public cocos2d::Node
 {
 public:
@@ -9,47 +17,80 @@ public:
     virtual ~EnemyBase();
 
     virtual bool init() override;
-    virtual void update(float dt) override;
 
-    // ===== ӿ =====
-    void setTarget(cocos2d::Node* target);
-    virtual void takeDamage(int damage);
+    // ===== ʵ =====
+    virtual EnemyType getType() const = 0;
+    virtual const EnemyStats& getStats() const = 0;
+
+    // ===== ӿڣתݲֿ⣩ =====
+    HitResult takeDamage(int damage);
     bool isDead() const;
 
-protected:
-    // ===== ʵ =====
-    virtual void doAttack() = 0;
+    // ===== ݲֿ =====
+    void bindStore(EnemyStore* store, int index);
+    int getStoreIndex() const { return _storeIndex; }
 
-    // ===== Ϊߺ =====
-    bool isInAttackRange() const;
-    void moveTowardsTarget(float dt);
-    void rotateToTarget();
-    void changeState(EnemyState state);
+    // ===== ʵÿνµǼǣպɾʧЧ =====
+    EntityHandle getEntityHandle() const { return _entityHandle; }
+
+    /**
+     * ͬȾ״̬ EnemyStore ÿ֡һΣ
+     * @param position ֵλ
+     * @param yaw 򣨽Ƕȣ
+     * @param anim ӦŵĶ
+     * @param animSerial ţ仯ʱز
+     */
+    void applyRenderState(const cocos2d::Vec3& position, float yaw, EnemyState anim, unsigned int animSerial);
+
+    /**
+     * /ָģͶAI ʱ EnemyStore ãƽ
+     * @param frozen Ƿ񶳽
+     */
+    void setAnimationFrozen(bool frozen);
+    bool isAnimationFrozen() const { return _animationFrozen; }
+
+    // ===== ظ =====
+    /**
+     * λΪմʱı״ֹֿ̬ͣ󶨡ʾ
+     * @param position λ
+     */
+    void reset(const cocos2d::Vec3& position);
+
+    /** ʱ룩ؾݴӳٻ */
+    float getDeathDuration() const;
 
 protected:
-    // ===== ״̬ =====
-    EnemyState _state = EnemyState::IDLE;
+    // ״̬ӦĶ
+    void playStateAnimation(EnemyState anim);
 
-    // =====  =====
-    int _maxHp = 0;
-    int _hp = 0;
-    int _attack = 0;
-    float _speed = 0.0f;
-    // ־룺빥ж
-    // ע⣺ʵо루пƣ
-    float _attackRange;
+    // עʵյػʱ
+    void releaseEntityHandle();
 
-    // ȴָһιΪȴ
-    float _attackCooldown;
+protected:
+    friend class EnemyPool;
 
+    // е״̬
+    enum class PoolState : unsigned char
+    {
+        UNPOOLED,   // ɶع
+        ACTIVE,     // ѽڳ
+        RETIRING,   // ڲ
+        RELEASING,  // ѽӳٶУƳصб
+        AVAILABLE   // 
+    };
+    PoolState _poolState = PoolState::UNPOOLED;
 
-    float _attackTimer = 0.0f;
+    // ===== ݲֿ =====
+    EnemyStore* _store = nullptr;
+    int _storeIndex = -1;
 
-    //  / ǵľ
-    float _detectionRange;
+    // ===== ʵ =====
+    EntityHandle _entityHandle;
 
-    // ===== Ŀ =====
-    cocos2d::Node* _target = nullptr;
+    // ===== ʾȾ״̬ =====
+    float _shownYaw = 0.0f;
+    unsigned int _shownAnimSerial = 0;
+    bool _animationFrozen = false;
 
     // ===== ģ =====
     cocos2d::Sprite3D* _model = nullptr;
@@ -61,4 +102,4 @@ protected:
     cocos2d::Animate3D* _hitAction = nullptr;
     cocos2d::Animate3D* _blockAction = nullptr;
     cocos2d::Animate3D* _deadAction = nullptr;
-};
\ No newline at end of file
+};
@@ -2,6 +2,7 @@
 #include "EnemyGoblin.h"
 #include "EnemyMinotaur.h"
 #include "EnemyKnight.h"
+#include "EnemyPool.h"
 
 USING_NS_CC;
 
@@ -35,4 +36,16 @@ EnemyBase* EnemyFactory::createEnemy(
     }
 
     return enemy;
+}
+
+EnemyBase* EnemyFactory::acquireEnemy(
+    EnemyType type,
+    const Vec3& position)
+{
+    return EnemyPool::getInstance()->acquire(type, position);
+}
+
+void EnemyFactory::retireEnemy(EnemyBase* enemy)
+{
+    EnemyPool::getInstance()->retire(enemy);
 }
\ No newline at end of file
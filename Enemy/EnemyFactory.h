@@ -8,8 +8,18 @@ class EnemyBase;
 class EnemyFactory
 {
 public:
+    // 直接创建新实例（加载模型并创建动画动作）
     static EnemyBase* createEnemy(
         EnemyType type,
         const cocos2d::Vec3& position
     );
+
+    // 从对象池借出实例（已复位到出生位置，无分配、无模型读取）
+    static EnemyBase* acquireEnemy(
+        EnemyType type,
+        const cocos2d::Vec3& position
+    );
+
+    // 死亡后交还对象池（死亡动画播完后回收）
+    static void retireEnemy(EnemyBase* enemy);
 };
\ No newline at end of file
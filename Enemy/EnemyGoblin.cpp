@@ -1,23 +1,11 @@
 #include "EnemyGoblin.h"
 #include "player/Player.h"
+#include "Core/AnimationClipCache.h"
 
 USING_NS_CC;
 
-// ================= Դ =================
-static const std::string GOBLIN_MODEL = "model/goblin/goblin.c3b";  // ģ·
-static const std::string ANIM_IDLE = "Armature|goblin_idle";     //  idle
-static const std::string ANIM_RUN = "Armature|goblin_run";      // ܲ
-static const std::string ANIM_ATTACK = "Armature|goblin_attack";   // 
-static const std::string ANIM_HIT = "Armature|goblin_hit";      // ܻ
-static const std::string ANIM_DEAD = "Armature|goblin_dead";     // 
-static const std::string ANIM_BLOCK = "Armature|goblin_block";    // 񵲶
-
-// ================= Ϊ =================
-static const float GOBLIN_DETECTION_RANGE = 300.0f;   // ⷶΧ
-static const float GOBLIN_ATTACK_START_DISTANCE = 70.0f; // 
-static const float GOBLIN_REAL_HIT_DISTANCE = 80.0f;   // ʵʹж
-static const float GOBLIN_RETREAT_DISTANCE = 60.0f;   // ˾
-static const float GOBLIN_RETREAT_TIME = 0.6f;    // ʱ
+// ================= ԭͣԡΪģ붯 =================
+static constexpr const EnemyArchetype& GOBLIN = EnemyArchetypes::get(EnemyType::GOBLIN);
 
 // ؾʵ
 EnemyGoblin* EnemyGoblin::create()
@@ -32,217 +20,51 @@ EnemyGoblin* EnemyGoblin::create()
     return nullptr;
 }
 
-// ʼ
+// ԤضƬΣʱһΣ
+void EnemyGoblin::preloadAnimations()
+{
+    EnemyArchetypes::registerClips(EnemyType::GOBLIN);
+}
+
+// 
+const EnemyStats& EnemyGoblin::getDefaultStats()
+{
+    return GOBLIN.stats;
+}
+
+// ʼֻȾģ붯
 bool EnemyGoblin::init()
 {
     if (!EnemyBase::init())
         return false;
 
-    // ʼ
-    _maxHp = 60;
-    _hp = _maxHp;
-    _attack = 12;
-    _speed = 70.0f;  // ƶٶȽϿ
-    _attackRange = GOBLIN_ATTACK_START_DISTANCE;  // Χ
-    _attackCooldown = 4.0f;  // ȴʱ
-
     // ģ
-    _model = Sprite3D::create(GOBLIN_MODEL);
+    _model = Sprite3D::create(GOBLIN.modelPath);
     if (_model)
     {
-        _model->setScale(0.15f);  // ģ
+        _model->setScale(GOBLIN.modelScale);  // ģ
         this->addChild(_model);
 
-        // Ԥضԭʼʵ֣
-        _idleAction = Animate3D::create(Animation3D::create(GOBLIN_MODEL, ANIM_IDLE));
+        // ӶƬλ洴ʱԤأ
+        auto cache = AnimationClipCache::getInstance();
+        if (EnemyArchetypes::getClip(EnemyType::GOBLIN, EnemyClip::IDLE) == INVALID_CLIP)
+            preloadAnimations();  // δԤʱ
+
+        _idleAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::GOBLIN, EnemyClip::IDLE)));
         _idleAction->retain();
 
-        _runAction = Animate3D::create(Animation3D::create(GOBLIN_MODEL, ANIM_RUN));
+        _runAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::GOBLIN, EnemyClip::RUN)));
         _runAction->retain();
 
-        _attackAction = Animate3D::create(Animation3D::create(GOBLIN_MODEL, ANIM_ATTACK));
+        _attackAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::GOBLIN, EnemyClip::ATTACK)));
         _attackAction->retain();
 
-        _hitAction = Animate3D::create(Animation3D::create(GOBLIN_MODEL, ANIM_HIT));
+        _hitAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::GOBLIN, EnemyClip::HIT)));
         _hitAction->retain();
 
-        _deadAction = Animate3D::create(Animation3D::create(GOBLIN_MODEL, ANIM_DEAD));
+        _deadAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::GOBLIN, EnemyClip::DEAD)));
         _deadAction->retain();
     }
 
-    // ʼ״̬ΪIdle
-    changeState(EnemyState::IDLE);
     return true;
 }
-
-// ֡
-void EnemyGoblin::update(float dt)
-{
-    // /ܻ״̬ʱִƶ߼
-    if (_state == EnemyState::ATTACK || _state == EnemyState::HIT)
-        return;
-
-    EnemyBase::update(dt);
-    // ״̬Ŀʱ˳
-    if (_state == EnemyState::DEAD || !_target)
-        return;
-
-    // Ŀľ
-    float distance = getPosition3D().distance(_target->getPosition3D());
-
-    // --- ״̬߼ ---
-    // ⷶΧصIdle
-    if (distance > GOBLIN_DETECTION_RANGE)
-    {
-        changeState(EnemyState::IDLE);
-        return;
-    }
-
-    // ڹΧ
-    if (distance <= _attackRange)
-    {
-        // Ŀ
-        rotateToTarget();
-
-        // ȴִй
-        if (_attackTimer >= _attackCooldown)
-        {
-            _attackTimer = 0.0f;
-            changeState(EnemyState::ATTACK);
-
-            // Уǰҡȴ -> ִй -> ҡȴ -> 
-            float hitTiming = 1.5f;   // ǰҡʱ䣨ж㣩
-            float backSwing = 1.0f;   // ҡʱ
-
-            auto attackSequence = Sequence::create(
-                DelayTime::create(hitTiming),                  // ǰҡȴ
-                CallFunc::create(CC_CALLBACK_0(EnemyGoblin::doAttack, this)),  // ִйж
-                DelayTime::create(backSwing),                  // ҡȴ
-                CallFunc::create(CC_CALLBACK_0(EnemyGoblin::retreatFromTarget, this)),  // 
-                nullptr
-            );
-            this->runAction(attackSequence);
-        }
-        else
-        {
-            // ȴУIdle
-            changeState(EnemyState::IDLE);
-        }
-    }
-    else
-    {
-        // ڹΧƶĿ
-        changeState(EnemyState::RUN);
-        moveTowardsTarget(dt);
-    }
-}
-
-// ܻ
-void EnemyGoblin::takeDamage(int damage)
-{
-    // 
-    if (_state == EnemyState::DEAD)
-        return;
-
-    // 1. Ѫʹø߼Զ壩
-    _hp -= damage;
-    CCLOG("Goblin took %d damage, remaining HP: %d", damage, _hp);
-
-    // Ѫ0л״̬
-    if (_hp <= 0)
-    {
-        _hp = 0;
-        changeState(EnemyState::DEAD);
-        return;
-    }
-
-    // 2. ϵǰж
-    this->stopAllActions();
-    if (_model)
-        _model->stopAllActions();
-
-    // 3. лܻ״̬changeStateͻ
-    _state = EnemyState::HIT;
-
-    // 4. ܻ
-    if (_hitAction && _model)
-    {
-        _model->runAction(_hitAction);
-    }
-
-    // 5. ܻ߼ȴ0.5s -> 
-    auto reactionSeq = Sequence::create(
-        DelayTime::create(0.5f),  // ܻӲֱ
-        CallFunc::create(CC_CALLBACK_0(EnemyGoblin::retreatFromTarget, this)),
-        nullptr
-    );
-    this->runAction(reactionSeq);
-}
-
-// ִйж
-void EnemyGoblin::doAttack()
-{
-    if (_state == EnemyState::DEAD)
-        return;
-
-    // жĿǷΪ
-    auto player = dynamic_cast<Player*>(_target);
-    if (!player)
-        return;
-
-    // ЧΧڣ˺
-    if (getPosition3D().distance(player->getPosition3D()) <= GOBLIN_REAL_HIT_DISTANCE)
-    {
-        player->takeDamage(_attack);
-    }
-}
-
-// Ŀ
-void EnemyGoblin::retreatFromTarget()
-{
-    // Ŀ꣺صIdle
-    if (_state == EnemyState::DEAD || !_target)
-    {
-        changeState(EnemyState::IDLE);
-        return;
-    }
-
-    // 1. ˷Ŀ෴
-    Vec3 selfPos = getPosition3D();
-    Vec3 targetPos = _target->getPosition3D();
-    Vec3 runDir = selfPos - targetPos;
-    runDir.y = 0;  // Y
-
-    // 0ĬϷ
-    if (runDir.lengthSquared() < 0.0001f)
-        runDir = Vec3(0, 0, 1);
-    else
-        runDir.normalize();
-
-    // 2. ת˷
-    float radians = atan2f(runDir.x, runDir.z);  // 㻡
-    float degrees = CC_RADIANS_TO_DEGREES(radians);  // תΪǶ
-    this->setRotation3D(Vec3(0, degrees, 0));  // Ӧת
-
-    // 3. ܲ
-    if (_model)
-    {
-        _model->stopAllActions();
-        _model->runAction(RepeatForever::create(_runAction));
-    }
-
-    // 4. ִкƶ
-    Vec3 retreatVec = runDir * GOBLIN_RETREAT_DISTANCE;  // ˾
-    auto moveAction = MoveBy::create(GOBLIN_RETREAT_TIME, retreatVec);  // ˶
-
-    // ˽صIdle
-    auto finishRetreat = CallFunc::create([this]()
-        {
-            if (_state != EnemyState::DEAD)
-            {
-                this->changeState(EnemyState::IDLE);
-            }
-        });
-
-    this->runAction(Sequence::create(moveAction, finishRetreat, nullptr));
-}
\ No newline at end of file
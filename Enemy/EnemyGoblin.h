@@ -1,5 +1,6 @@
 #pragma once
 #include "EnemyBase.h" 
+#include "EnemyStore.h"
 
 // ؾ
 class EnemyGoblin : public EnemyBase
@@ -7,16 +8,14 @@ class EnemyGoblin : public EnemyBase
 public:
     // ؾʵ
     static EnemyGoblin* create();
+    // ԤضƬΣʱһΣ
+    static void preloadAnimations();
     // ʼ
     virtual bool init() override;
-    // ֡
-    virtual void update(float dt) override;
-    // ܻ
-    virtual virtual void takeDamage(int damage) override;
+    // 
+    virtual EnemyType getType() const override { return EnemyType::GOBLIN; }
+    virtual const EnemyStats& getStats() const override { return getDefaultStats(); }
+    static const EnemyStats& getDefaultStats();
 
-protected:
-    // ִй
-    void doAttack();
-    // Ŀ
-    void retreatFromTarget();
-};
\ No newline at end of file
+    // ݲֿе߼ߡжܻ EnemyKernel.h EnemyStore ͷ
+};
@@ -0,0 +1,337 @@
+#pragma once
+#include "EnemyStore.h"
+#include <cstdlib>  // 用于随机数
+
+/**
+ * 按类型特化的敌人逻辑内核
+ * EnemyStore 以模板参数选定类型后，组内每个敌人直接调用该类型的静态逻辑，
+ * 不再逐个敌人判断类型，也没有虚调用；没有对应行为的类型提供空实现。
+ * 逻辑写在头文件中，由 EnemyStore.cpp 实例化，组内循环可以把决策连同
+ * EnemyStore 的状态切换、移动等辅助函数一起内联（EnemyGoblin 等类只保留渲染代理）。
+ */
+template <EnemyType T>
+struct EnemyKernel;
+
+// =========================================================================
+// 地精：攻击后摇结束或受击硬直结束后后退
+// =========================================================================
+template <>
+struct EnemyKernel<EnemyType::GOBLIN>
+{
+    static constexpr const EnemyArchetype& archetype() { return EnemyArchetypes::get(EnemyType::GOBLIN); }
+
+    // 决策
+    static void think(EnemyStore& store, int i, float dt)
+    {
+        // 攻击/受击状态时不执行移动逻辑（后退由定时阶段驱动）
+        if (store.state[i] == EnemyState::ATTACK || store.state[i] == EnemyState::HIT)
+            return;
+
+        store.attackTimer[i] += dt;
+
+        // --- 状态逻辑 ---
+        // 超出检测范围：回到Idle
+        if (!store.inDetection[i])
+        {
+            store.setState(i, EnemyState::IDLE);
+            store.stop(i);
+            return;
+        }
+
+        // 在攻击范围内
+        if (store.inAttack[i])
+        {
+            // 面向目标
+            store.faceTarget(i);
+
+            // 攻击冷却结束：执行攻击
+            // 攻击流程：前摇等待 -> 执行攻击 -> 后摇等待 -> 后退
+            if (store.attackTimer[i] >= store.attackCooldown[i])
+            {
+                store.beginAttack(i, EnemyArchetypes::getClip(EnemyType::GOBLIN, EnemyClip::ATTACK), archetype().hitTiming);
+            }
+            else
+            {
+                // 冷却中：保持Idle
+                store.setState(i, EnemyState::IDLE);
+                store.stop(i);
+            }
+        }
+        else
+        {
+            // 不在攻击范围：移动到目标
+            store.setState(i, EnemyState::RUN);
+            store.moveTowardsTarget(i);
+        }
+    }
+
+    // 前摇结束：执行攻击判定，进入后摇
+    static void onStrike(EnemyStore& store, int i)
+    {
+        // 距离在有效攻击范围内：造成伤害
+        store.strikeTarget(i, store.attackRange[i] + archetype().hitTolerance, archetype().hitInclusive);
+        store.startPhase(i, EnemyPhase::BACKSWING, archetype().backSwing);
+    }
+
+    // 定时阶段结束
+    static void onPhaseEnd(EnemyStore& store, int i, EnemyPhase endedPhase)
+    {
+        switch (endedPhase)
+        {
+        case EnemyPhase::BACKSWING:   // 后摇结束：后退
+        case EnemyPhase::HIT_STUN:    // 受击硬直结束：后退
+            retreatFromTarget(store, i);
+            break;
+
+        case EnemyPhase::RETREAT:     // 后退结束：回到Idle
+            store.stop(i);
+            store.forceState(i, EnemyState::IDLE);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // 受击处理
+    static void onDamaged(EnemyStore& store, int i, int damage)
+    {
+        // 1. 扣血
+        store.hp[i] -= damage;
+        CCLOG("Goblin took %d damage, remaining HP: %d", damage, store.hp[i]);
+
+        // 血量归0：切换死亡状态
+        if (store.hp[i] <= 0)
+        {
+            store.hp[i] = 0;
+            store.setState(i, EnemyState::DEAD);
+            return;
+        }
+
+        // 2. 打断当前攻击/后退
+        store.cancelTimers(i);
+        store.stop(i);
+
+        // 3. 切换受击状态并重播受击动画（不走状态切换规则，避免冲突）
+        store.forceState(i, EnemyState::HIT);
+
+        // 4. 受击硬直结束后后退
+        store.startPhase(i, EnemyPhase::HIT_STUN, archetype().hitStun);
+    }
+
+    // 从目标后退
+    static void retreatFromTarget(EnemyStore& store, int i)
+    {
+        // 无目标：回到Idle
+        if (!store.getTarget())
+        {
+            store.forceState(i, EnemyState::IDLE);
+            return;
+        }
+
+        // 1. 计算后退方向（与目标相反，忽略Y轴）
+        cocos2d::Vec3 runDir = store.getPosition(i) - store.getTargetPosition();
+        runDir.y = 0;
+
+        // 避免除0：默认方向
+        if (runDir.lengthSquared() < 0.0001f)
+            runDir = cocos2d::Vec3(0, 0, 1);
+        else
+            runDir.normalize();
+
+        // 2. 旋转面向后退方向
+        float radians = atan2f(runDir.x, runDir.z);  // 计算弧度
+        store.yaw[i] = CC_RADIANS_TO_DEGREES(radians);  // 转为角度
+
+        // 3. 播放跑步动画（逻辑状态不变）
+        store.playAnimation(i, EnemyState::RUN);
+
+        // 4. 以恒定速度后退，结束时回到Idle
+        float retreatSpeed = archetype().retreatDistance / archetype().retreatTime;
+        store.velX[i] = runDir.x * retreatSpeed;
+        store.velZ[i] = runDir.z * retreatSpeed;
+        store.startPhase(i, EnemyPhase::RETREAT, archetype().retreatTime);
+    }
+};
+
+// =========================================================================
+// 牛头人：没有后摇与定时阶段
+// =========================================================================
+template <>
+struct EnemyKernel<EnemyType::MINOTAUR>
+{
+    static constexpr const EnemyArchetype& archetype() { return EnemyArchetypes::get(EnemyType::MINOTAUR); }
+
+    // 决策
+    static void think(EnemyStore& store, int i, float dt)
+    {
+        // 1. 攻击计时
+        store.attackTimer[i] += dt;
+
+        // 受击状态时不执行移动逻辑
+        if (store.state[i] == EnemyState::HIT)
+            return;
+
+        // 超出检测范围：回到Idle
+        if (!store.inDetection[i])
+        {
+            store.setState(i, EnemyState::IDLE);
+            store.stop(i);
+            return;
+        }
+
+        // 2. 战斗逻辑
+        if (store.inAttack[i])  // 在攻击范围内
+        {
+            // 面向目标
+            store.faceTarget(i);
+
+            // 攻击冷却结束：执行攻击（前摇结束后判定）
+            if (store.attackTimer[i] >= store.attackCooldown[i])
+            {
+                store.beginAttack(i, EnemyArchetypes::getClip(EnemyType::MINOTAUR, EnemyClip::ATTACK), archetype().hitTiming);
+            }
+            else
+            {
+                // 冷却中：保持Idle
+                store.setState(i, EnemyState::IDLE);
+                store.stop(i);
+            }
+        }
+        else
+        {
+            // 不在攻击范围：移动到目标
+            store.setState(i, EnemyState::RUN);
+            store.moveTowardsTarget(i);
+        }
+    }
+
+    // 前摇结束：执行攻击判定
+    static void onStrike(EnemyStore& store, int i)
+    {
+        store.strikeTarget(i, store.attackRange[i] + archetype().hitTolerance, archetype().hitInclusive);
+    }
+
+    static void onPhaseEnd(EnemyStore&, int, EnemyPhase) {}   // 牛头人没有定时阶段
+
+    // 受击处理
+    static void onDamaged(EnemyStore& store, int i, int damage)
+    {
+        store.hp[i] -= damage;
+
+        if (store.hp[i] <= 0)
+        {
+            store.hp[i] = 0;
+            store.setState(i, EnemyState::DEAD);
+        }
+        else
+        {
+            store.stop(i);
+            store.setState(i, EnemyState::HIT);
+        }
+    }
+};
+
+// =========================================================================
+// 骑士：持盾，受击时按概率格挡
+// =========================================================================
+template <>
+struct EnemyKernel<EnemyType::KNIGHT>
+{
+    static constexpr const EnemyArchetype& archetype() { return EnemyArchetypes::get(EnemyType::KNIGHT); }
+
+    // 决策
+    static void think(EnemyStore& store, int i, float dt)
+    {
+        // 攻击计时
+        store.attackTimer[i] += dt;
+
+        // 受击/格挡状态时不执行移动逻辑
+        if (store.state[i] == EnemyState::HIT || store.state[i] == EnemyState::BLOCK)
+            return;
+
+        // 超出检测范围：回到Idle
+        if (!store.inDetection[i])
+        {
+            store.setState(i, EnemyState::IDLE);
+            store.stop(i);
+            return;
+        }
+
+        // ===== 战斗逻辑 =====
+        if (store.inAttack[i])  // 在攻击范围内
+        {
+            // 面向目标
+            store.faceTarget(i);
+
+            // 攻击冷却结束：执行攻击（前摇结束后判定）
+            if (store.attackTimer[i] >= store.attackCooldown[i])
+            {
+                store.beginAttack(i, EnemyArchetypes::getClip(EnemyType::KNIGHT, EnemyClip::ATTACK), archetype().hitTiming);
+            }
+            else
+            {
+                // 冷却中：保持Idle
+                store.setState(i, EnemyState::IDLE);
+                store.stop(i);
+            }
+        }
+        else
+        {
+            // 不在攻击范围：移动到目标
+            store.setState(i, EnemyState::RUN);
+            store.moveTowardsTarget(i);
+        }
+    }
+
+    // 前摇结束：执行攻击判定
+    static void onStrike(EnemyStore& store, int i)
+    {
+        store.strikeTarget(i, store.attackRange[i] + archetype().hitTolerance, archetype().hitInclusive);
+    }
+
+    // 定时阶段结束：格挡/受击硬直结束后回到Idle
+    static void onPhaseEnd(EnemyStore& store, int i, EnemyPhase endedPhase)
+    {
+        if (endedPhase == EnemyPhase::BLOCK_HOLD || endedPhase == EnemyPhase::HIT_STUN)
+        {
+            // 格挡状态不接受普通切换，这里强制结束
+            store.forceState(i, EnemyState::IDLE);
+        }
+    }
+
+    // 受击处理（含格挡逻辑）
+    static void onDamaged(EnemyStore& store, int i, int damage)
+    {
+        // ===== 格挡判定 =====
+        float r = static_cast<float>(rand()) / RAND_MAX;  // 生成0-1随机数
+        if (r < archetype().blockChance)  // 触发格挡
+        {
+            // 仅在非格挡状态时切换状态
+            if (store.state[i] != EnemyState::BLOCK)
+            {
+                store.stop(i);
+                store.setState(i, EnemyState::BLOCK);
+                store.startPhase(i, EnemyPhase::BLOCK_HOLD, archetype().blockTime);
+            }
+            // 格挡成功：不受伤害（可改为减伤，如 hp -= damage * 0.1f）
+            return;
+        }
+
+        // ===== 格挡失败：扣血 =====
+        store.hp[i] -= damage;
+
+        // 血量归0：切换死亡状态
+        if (store.hp[i] <= 0)
+        {
+            store.hp[i] = 0;
+            store.setState(i, EnemyState::DEAD);
+        }
+        else  // 仍存活：受击硬直，之后回到Idle
+        {
+            store.stop(i);
+            store.setState(i, EnemyState::HIT);
+            store.startPhase(i, EnemyPhase::HIT_STUN, archetype().hitStun);
+        }
+    }
+};
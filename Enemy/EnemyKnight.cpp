@@ -1,20 +1,11 @@
 #include "EnemyKnight.h"
 #include "Player/Player.h"
-#include <cstdlib>  // 
+#include "Core/AnimationClipCache.h"
 
 USING_NS_CC;
 
-// ================= ģ붯· =================
-static const std::string KNIGHT_MODEL = "model/knight/knight.c3b";  // ģ·
-static const std::string ANIM_IDLE = "Armature|knight_idle";     // idle
-static const std::string ANIM_RUN = "Armature|knight_walk";     // ߶
-static const std::string ANIM_ATTACK = "Armature|knight_attack";   // 
-static const std::string ANIM_HIT = "Armature|knight_hit";      // ܻ
-static const std::string ANIM_BLOCK = "Armature|knight_block";    // 񵲶
-static const std::string ANIM_DEAD = "Armature|knight_death";    // 
-
-// ================= Ϊ =================
-static const float KNIGHT_DETECTION_RANGE = 250.0f;  // ⷶΧȵؾС
+// ================= ԭͣԡΪģ붯 =================
+static constexpr const EnemyArchetype& KNIGHT = EnemyArchetypes::get(EnemyType::KNIGHT);
 
 // ʿʵ
 EnemyKnight* EnemyKnight::create()
@@ -29,25 +20,29 @@ EnemyKnight* EnemyKnight::create()
     return nullptr;
 }
 
-// ʼ
+// ԤضƬΣʱһΣ
+void EnemyKnight::preloadAnimations()
+{
+    EnemyArchetypes::registerClips(EnemyType::KNIGHT);
+}
+
+// 
+const EnemyStats& EnemyKnight::getDefaultStats()
+{
+    return KNIGHT.stats;
+}
+
+// ʼֻȾģ͡붯
 bool EnemyKnight::init()
 {
     if (!EnemyBase::init())
         return false;
 
-    // ʼ
-    _maxHp = 150;
-    _hp = _maxHp;
-    _attack = 20;
-    _speed = 45.0f;
-    _attackRange = 35.0f;
-    _attackCooldown = 5.0f;
-
     // ģ
-    _model = Sprite3D::create(KNIGHT_MODEL);
+    _model = Sprite3D::create(KNIGHT.modelPath);
     if (_model)
     {
-        _model->setScale(0.15f);
+        _model->setScale(KNIGHT.modelScale);
 
         // =================  & Shader =================
         auto texDiffuse = Director::getInstance()->getTextureCache()->addImage("model/knight/knight_diffuse.png");  // 
@@ -78,158 +73,29 @@ bool EnemyKnight::init()
 
         this->addChild(_model);
 
-        // Ԥض
-        _idleAction = Animate3D::create(Animation3D::create(KNIGHT_MODEL, ANIM_IDLE));
+        // ӶƬλ洴ʱԤأ
+        auto cache = AnimationClipCache::getInstance();
+        if (EnemyArchetypes::getClip(EnemyType::KNIGHT, EnemyClip::IDLE) == INVALID_CLIP)
+            preloadAnimations();  // δԤʱ
+
+        _idleAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::KNIGHT, EnemyClip::IDLE)));
         _idleAction->retain();
 
-        _runAction = Animate3D::create(Animation3D::create(KNIGHT_MODEL, ANIM_RUN));
+        _runAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::KNIGHT, EnemyClip::RUN)));
         _runAction->retain();
 
-        _attackAction = Animate3D::create(Animation3D::create(KNIGHT_MODEL, ANIM_ATTACK));
+        _attackAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::KNIGHT, EnemyClip::ATTACK)));
         _attackAction->retain();
 
-        _hitAction = Animate3D::create(Animation3D::create(KNIGHT_MODEL, ANIM_HIT));
+        _hitAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::KNIGHT, EnemyClip::HIT)));
         _hitAction->retain();
 
-        _blockAction = Animate3D::create(Animation3D::create(KNIGHT_MODEL, ANIM_BLOCK));
+        _blockAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::KNIGHT, EnemyClip::BLOCK)));
         _blockAction->retain();
 
-        _deadAction = Animate3D::create(Animation3D::create(KNIGHT_MODEL, ANIM_DEAD));
+        _deadAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::KNIGHT, EnemyClip::DEAD)));
         _deadAction->retain();
     }
 
-    // ʼ״̬ΪIdle
-    changeState(EnemyState::IDLE);
     return true;
 }
-
-// ֡
-void EnemyKnight::update(float dt)
-{
-    // ״̬Ŀʱ˳
-    if (_state == EnemyState::DEAD || !_target)
-        return;
-
-    // ø£繥ʱ
-    EnemyBase::update(dt);
-    // ܻ/״̬ʱִƶ߼
-    if (_state == EnemyState::HIT || _state == EnemyState::BLOCK)
-        return;
-
-    // Ŀľ
-    float distance = getPosition3D().distance(_target->getPosition3D());
-
-    // ⷶΧصIdle
-    if (distance > KNIGHT_DETECTION_RANGE)
-    {
-        changeState(EnemyState::IDLE);
-        return;
-    }
-
-    // ===== ս߼ =====
-    if (isInAttackRange())  // ڹΧ
-    {
-        // Ŀ
-        rotateToTarget();
-
-        // ȴִй
-        if (_attackTimer >= _attackCooldown)
-        {
-            _attackTimer = 0.0f;
-            changeState(EnemyState::ATTACK);
-
-            // Уǰҡȴ -> ִй
-            runAction(Sequence::create(
-                DelayTime::create(0.45f),  // ǰҡʱ䣨ݶ
-                CallFunc::create(CC_CALLBACK_0(EnemyKnight::doAttack, this)),  // ִйж
-                nullptr
-            ));
-        }
-        else
-        {
-            // ȴУIdle
-            changeState(EnemyState::IDLE);
-        }
-    }
-    else
-    {
-        // ڹΧƶĿ
-        changeState(EnemyState::RUN);
-        moveTowardsTarget(dt);
-    }
-}
-
-// ִйж
-void EnemyKnight::doAttack()
-{
-    auto player = dynamic_cast<Player*>(_target);
-    if (player)
-    {
-        // չΧݴģƫƵжʧЧ
-        if (getPosition3D().distance(player->getPosition3D()) < _attackRange + 20.0f)
-        {
-            player->takeDamage(_attack);
-        }
-    }
-}
-
-// ܻ߼
-void EnemyKnight::takeDamage(int damage)
-{
-    if (_state == EnemyState::DEAD)
-        return;
-
-    // ===== ж =====
-    float r = static_cast<float>(rand()) / RAND_MAX;  // 0-1
-    if (r < _blockChance)  // 
-    {
-        // ڷǸ״̬ʱл״̬
-        if (_state != EnemyState::BLOCK)
-        {
-            changeState(EnemyState::BLOCK);
-            // Ÿ񵲶
-            if (_blockAction && _model)
-            {
-                _model->stopAllActions();
-                _model->runAction(_blockAction);
-            }
-
-            // 񵲽صIdle
-            runAction(Sequence::create(
-                DelayTime::create(0.5f),  // 񵲳ʱ
-                CallFunc::create([this]()
-                    {
-                        if (_state != EnemyState::DEAD)
-                            changeState(EnemyState::IDLE);
-                    }),
-                nullptr
-            ));
-        }
-        // 񵲳ɹ˺ɸΪˣ_hp -= damage * 0.1f
-        return;
-    }
-
-    // ===== ʧܣѪ =====
-    _hp -= damage;
-
-    // Ѫ0л״̬
-    if (_hp <= 0)
-    {
-        _hp = 0;
-        changeState(EnemyState::DEAD);
-    }
-    else  // ԴܻӲֱ
-    {
-        changeState(EnemyState::HIT);
-        // ܻصIdle
-        runAction(Sequence::create(
-            DelayTime::create(0.4f),  // ܻӲֱʱ
-            CallFunc::create([this]()
-                {
-                    if (_state != EnemyState::DEAD)
-                        changeState(EnemyState::IDLE);
-                }),
-            nullptr
-        ));
-    }
-}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "EnemyBase.h"
+#include "EnemyStore.h"
 
 // ʿ
 class EnemyKnight : public EnemyBase
@@ -7,17 +8,14 @@ class EnemyKnight : public EnemyBase
 public:
     // ʿʵ
     static EnemyKnight* create();
+    // ԤضƬΣʱһΣ
+    static void preloadAnimations();
     // ʼ
     virtual bool init() override;
-    // ֡
-    virtual void update(float dt) override;
-    // ܻ߼
-    virtual void takeDamage(int damage) override;
+    // 
+    virtual EnemyType getType() const override { return EnemyType::KNIGHT; }
+    virtual const EnemyStats& getStats() const override { return getDefaultStats(); }
+    static const EnemyStats& getDefaultStats();
 
-protected:
-    // ִй
-    virtual void doAttack() override;
-
-private:
-    float _blockChance = 0.75f;  // 񵲸ʣ75%
-};
\ No newline at end of file
+    // ݲֿе߼ߡжܻ EnemyKernel.h EnemyStore ͷ
+};
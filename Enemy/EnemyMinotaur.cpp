@@ -1,18 +1,11 @@
 #include "EnemyMinotaur.h"
 #include "Player/Player.h"
+#include "Core/AnimationClipCache.h"
 
 USING_NS_CC;
 
-// ================= ģ붯· =================
-static const std::string MINOTAUR_MODEL = "model/minotaur/minotaur.c3b";  // ģ·
-static const std::string ANIM_IDLE = "Armature|minotaur_idle";       // idle
-static const std::string ANIM_WALK = "Armature|minotaur_walk";       // ߶
-static const std::string ANIM_ATTACK = "Armature|minotaur_attack";     // 
-static const std::string ANIM_HIT = "Armature|minotaur_hit";        // ܻ
-static const std::string ANIM_DEAD = "Armature|minotaur_dead";       // 
-
-// ================= Ϊ =================
-static const float MINOTAUR_DETECTION_RANGE = 350.0f;  // ⷶΧϹ㣩
+// ================= ԭͣԡΪģ붯 =================
+static constexpr const EnemyArchetype& MINOTAUR = EnemyArchetypes::get(EnemyType::MINOTAUR);
 
 // ţͷʵ
 EnemyMinotaur* EnemyMinotaur::create()
@@ -27,116 +20,51 @@ EnemyMinotaur* EnemyMinotaur::create()
     return nullptr;
 }
 
-// ʼ
+// ԤضƬΣʱһΣ
+void EnemyMinotaur::preloadAnimations()
+{
+    EnemyArchetypes::registerClips(EnemyType::MINOTAUR);
+}
+
+// 
+const EnemyStats& EnemyMinotaur::getDefaultStats()
+{
+    return MINOTAUR.stats;
+}
+
+// ʼֻȾģ붯޸񵲶
 bool EnemyMinotaur::init()
 {
     if (!EnemyBase::init())
         return false;
 
-    // ===== ʼ =====
-    _maxHp = 200;    // Ѫ
-    _hp = _maxHp;
-    _attack = 28;     // ߹
-    _speed = 35.0f;  // ƶ
-    _attackRange = 40.0f;  // Χϴ
-    _attackCooldown = 3.0f; // ȴ϶
-
     // ģ
-    _model = Sprite3D::create(MINOTAUR_MODEL);
+    _model = Sprite3D::create(MINOTAUR.modelPath);
     if (_model)
     {
         // _model->setScale(1.2f);  // ŴģͿ
         this->addChild(_model);
 
-        // Ԥض
-        _idleAction = Animate3D::create(Animation3D::create(MINOTAUR_MODEL, ANIM_IDLE));
+        // ӶƬλ洴ʱԤأ
+        auto cache = AnimationClipCache::getInstance();
+        if (EnemyArchetypes::getClip(EnemyType::MINOTAUR, EnemyClip::IDLE) == INVALID_CLIP)
+            preloadAnimations();  // δԤʱ
+
+        _idleAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::MINOTAUR, EnemyClip::IDLE)));
         _idleAction->retain();
 
-        _runAction = Animate3D::create(Animation3D::create(MINOTAUR_MODEL, ANIM_WALK));
+        _runAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::MINOTAUR, EnemyClip::RUN)));
         _runAction->retain();
 
-        _attackAction = Animate3D::create(Animation3D::create(MINOTAUR_MODEL, ANIM_ATTACK));
+        _attackAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::MINOTAUR, EnemyClip::ATTACK)));
         _attackAction->retain();
 
-        _hitAction = Animate3D::create(Animation3D::create(MINOTAUR_MODEL, ANIM_HIT));
+        _hitAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::MINOTAUR, EnemyClip::HIT)));
         _hitAction->retain();
 
-        _deadAction = Animate3D::create(Animation3D::create(MINOTAUR_MODEL, ANIM_DEAD));
+        _deadAction = Animate3D::create(cache->getClip(EnemyArchetypes::getClip(EnemyType::MINOTAUR, EnemyClip::DEAD)));
         _deadAction->retain();
     }
 
-    // ʼ״̬ΪIdle޸񵲶
-    _blockAction = nullptr;
-    changeState(EnemyState::IDLE);
     return true;
 }
-
-// ֡
-void EnemyMinotaur::update(float dt)
-{
-    // 1. ״̬Ŀʱ˳
-    if (_state == EnemyState::DEAD || !_target)
-        return;
-
-    // 2. ø£繥ʱ
-    EnemyBase::update(dt);
-    // ܻ״̬ʱִƶ߼
-    if (_state == EnemyState::HIT)
-        return;
-
-    // 3. Ŀľ
-    float distance = getPosition3D().distance(_target->getPosition3D());
-
-    // ⷶΧصIdle
-    if (distance > MINOTAUR_DETECTION_RANGE)
-    {
-        changeState(EnemyState::IDLE);
-        return;
-    }
-
-    // 4. ս߼
-    if (isInAttackRange())  // ڹΧ
-    {
-        // Ŀ
-        rotateToTarget();
-
-        // ȴִй
-        if (_attackTimer >= _attackCooldown)
-        {
-            _attackTimer = 0.0f;
-            changeState(EnemyState::ATTACK);
-
-            // Уǰҡȴ -> ִй
-            runAction(Sequence::create(
-                DelayTime::create(0.6f),  // ǰҡʱ䣨ţͷ˶
-                CallFunc::create(CC_CALLBACK_0(EnemyMinotaur::doAttack, this)),  // ִйж
-                nullptr
-            ));
-        }
-        else
-        {
-            // ȴУIdle
-            changeState(EnemyState::IDLE);
-        }
-    }
-    else
-    {
-        // ڹΧƶĿ
-        changeState(EnemyState::RUN);
-        moveTowardsTarget(dt);
-    }
-}
-
-// ִйж
-void EnemyMinotaur::doAttack()
-{
-    auto player = dynamic_cast<Player*>(_target);
-    if (player)
-    {
-        // չΧݴ
-        if (getPosition3D().distance(player->getPosition3D()) < _attackRange + 25.0f)
-        {
-            player->takeDamage(_attack);
-        }
-    }
-}
\ No newline at end of file
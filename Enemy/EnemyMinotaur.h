@@ -1,5 +1,6 @@
 #pragma once
 #include "EnemyBase.h"
+#include "EnemyStore.h"
 
 // ţͷ˵
 class EnemyMinotaur : public EnemyBase
@@ -7,12 +8,14 @@ class EnemyMinotaur : public EnemyBase
 public:
     // ţͷʵ
     static EnemyMinotaur* create();
+    // ԤضƬΣʱһΣ
+    static void preloadAnimations();
     // ʼ
     virtual bool init() override;
-    // ֡
-    virtual void update(float dt) override;
+    // 
+    virtual EnemyType getType() const override { return EnemyType::MINOTAUR; }
+    virtual const EnemyStats& getStats() const override { return getDefaultStats(); }
+    static const EnemyStats& getDefaultStats();
 
-protected:
-    // ִй
-    virtual void doAttack() override;
-};
\ No newline at end of file
+    // ݲֿе߼ߡжܻ EnemyKernel.h EnemyStore ͷ
+};
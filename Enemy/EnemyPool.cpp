@@ -0,0 +1,193 @@
+#include "EnemyPool.h"
+#include "EnemyBase.h"
+#include "EnemyFactory.h"
+#include "EnemyArchetype.h"
+#include "Core/DeferredDestroyQueue.h"
+
+USING_NS_CC;
+
+// 死亡动画回收动作的标签（reset 时会随 stopAllActions 一起停止）
+static const int TAG_RETIRE = 0x454E;
+
+EnemyPool* EnemyPool::s_instance = nullptr;
+
+EnemyPool* EnemyPool::getInstance()
+{
+    if (!s_instance)
+        s_instance = new (std::nothrow) EnemyPool();
+    return s_instance;
+}
+
+void EnemyPool::destroyInstance()
+{
+    CC_SAFE_DELETE(s_instance);
+}
+
+EnemyPool::~EnemyPool()
+{
+    for (auto& pool : _pools)
+    {
+        for (auto enemy : pool.owned)
+        {
+            enemy->removeFromParent();
+            enemy->release();
+        }
+    }
+}
+
+EnemyBase* EnemyPool::createNode(EnemyType type)
+{
+    EnemyBase* enemy = EnemyFactory::createEnemy(type, Vec3::ZERO);
+    if (!enemy)
+        return nullptr;
+
+    enemy->retain();
+    _pools[(int)type].owned.push_back(enemy);
+    _pools[(int)type].stats.created++;
+    return enemy;
+}
+
+void EnemyPool::prewarm(EnemyType type, int count)
+{
+    TypePool& pool = _pools[(int)type];
+    while ((int)pool.available.size() < count)
+    {
+        EnemyBase* enemy = createNode(type);
+        if (!enemy)
+            break;
+
+        enemy->setVisible(false);
+        enemy->releaseEntityHandle();  // 空闲节点不可被选为目标
+        enemy->_poolState = EnemyBase::PoolState::AVAILABLE;
+        pool.available.push_back(enemy);
+    }
+    pool.stats.available = (int)pool.available.size();
+}
+
+EnemyBase* EnemyPool::acquire(EnemyType type, const Vec3& position)
+{
+    TypePool& pool = _pools[(int)type];
+
+    EnemyBase* enemy = nullptr;
+    if (!pool.available.empty())
+    {
+        enemy = pool.available.back();
+        pool.available.pop_back();
+    }
+    else
+    {
+        // 池空：临时创建（计入未命中）
+        enemy = createNode(type);
+        if (!enemy)
+            return nullptr;
+        pool.stats.misses++;
+    }
+
+    enemy->reset(position);
+    enemy->_poolState = EnemyBase::PoolState::ACTIVE;
+
+    pool.stats.available = (int)pool.available.size();
+    pool.stats.active++;
+    updateHighWater(pool);
+    return enemy;
+}
+
+void EnemyPool::retire(EnemyBase* enemy)
+{
+    if (!enemy || enemy->_poolState != EnemyBase::PoolState::ACTIVE)
+        return;
+
+    TypePool& pool = _pools[(int)enemy->getType()];
+    pool.stats.active--;
+    pool.stats.retiring++;
+    enemy->_poolState = EnemyBase::PoolState::RETIRING;
+    enemy->setAnimationFrozen(false);
+
+    // 死亡动画已由 EnemyStore::removeDead 在解除绑定前推送的最终渲染状态触发，播完后回收
+    auto recycle = Sequence::create(
+        DelayTime::create(enemy->getDeathDuration()),
+        CallFunc::create([this, enemy]() { this->release(enemy); }),
+        nullptr);
+    recycle->setTag(TAG_RETIRE);
+    enemy->runAction(recycle);
+}
+
+void EnemyPool::release(EnemyBase* enemy)
+{
+    if (!enemy)
+        return;
+
+    TypePool& pool = _pools[(int)enemy->getType()];
+    switch (enemy->_poolState)
+    {
+    case EnemyBase::PoolState::ACTIVE:
+        pool.stats.active--;
+        break;
+    case EnemyBase::PoolState::RETIRING:
+        pool.stats.retiring--;
+        break;
+    default:
+        return;  // 未借出或重复回收
+    }
+
+    enemy->_poolState = EnemyBase::PoolState::RELEASING;
+    enemy->stopActionByTag(TAG_RETIRE);
+    enemy->bindStore(nullptr, -1);
+    enemy->releaseEntityHandle();
+    enemy->setVisible(false);
+
+    if (_destroyQueue && enemy->getParent())
+    {
+        _destroyQueue->push(enemy, [this](Node* node) { this->finishRelease(static_cast<EnemyBase*>(node)); });
+        return;
+    }
+
+    enemy->removeFromParent();
+    finishRelease(enemy);
+}
+
+void EnemyPool::finishRelease(EnemyBase* enemy)
+{
+    if (enemy->_poolState != EnemyBase::PoolState::RELEASING)
+        return;
+
+    TypePool& pool = _pools[(int)enemy->getType()];
+    enemy->_poolState = EnemyBase::PoolState::AVAILABLE;
+    pool.available.push_back(enemy);
+    pool.stats.available = (int)pool.available.size();
+}
+
+void EnemyPool::reclaim(Node* parent)
+{
+    for (auto& pool : _pools)
+    {
+        for (auto enemy : pool.owned)
+        {
+            if (enemy->getParent() == parent &&
+                (enemy->_poolState == EnemyBase::PoolState::ACTIVE || enemy->_poolState == EnemyBase::PoolState::RETIRING))
+            {
+                release(enemy);
+            }
+        }
+    }
+}
+
+void EnemyPool::updateHighWater(TypePool& pool)
+{
+    int inUse = pool.stats.active + pool.stats.retiring;
+    if (inUse > pool.stats.highWater)
+        pool.stats.highWater = inUse;
+}
+
+void EnemyPool::logStats() const
+{
+#if defined(COCOS2D_DEBUG) && COCOS2D_DEBUG > 0
+    for (int i = 0; i < ENEMY_TYPE_COUNT; ++i)
+    {
+        const EnemyPoolStats& stats = _pools[i].stats;
+        CCLOG("EnemyPool[%s]: created %d, available %d, active %d, retiring %d, high-water %d, misses %d",
+            EnemyArchetypes::get((EnemyType)i).name, stats.created, stats.available, stats.active, stats.retiring,
+            stats.highWater, stats.misses);
+    }
+#endif
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "cocos2d.h"
+#include "EnemyType.h"
+#include <vector>
+
+class EnemyBase;
+class DeferredDestroyQueue;
+
+// 单个敌人类型的对象池统计
+struct EnemyPoolStats
+{
+    int created = 0;      // 累计创建的节点数（含预热）
+    int available = 0;    // 池中空闲
+    int active = 0;       // 已借出、在场景中战斗
+    int retiring = 0;     // 正在播放死亡动画，结束后回收
+    int highWater = 0;    // 借出数（active + retiring）峰值
+    int misses = 0;       // 池空时临时创建的次数（应为0，否则需加大预热数量）
+};
+
+/**
+ * 敌人对象池（全局单例，按 EnemyType 分组）
+ * 敌人节点（模型与六个 Animate3D）只在预热或池空时创建一次，之后：
+ * - acquire：从空闲表取出并 reset 到出生位置，不分配、不读模型文件
+ * - retire：死亡动画播完后自动回收（节点移出场景、隐藏）
+ * 池持有全部节点的引用，场景销毁时由 reclaim 收回仍挂在该场景下的节点
+ */
+class EnemyPool
+{
+public:
+    static EnemyPool* getInstance();
+    static void destroyInstance();
+
+    /**
+     * 预热：补足空闲节点数量
+     * @param type 敌人类型
+     * @param count 目标空闲数量
+     */
+    void prewarm(EnemyType type, int count);
+
+    /**
+     * 借出敌人（已复位，未加入场景，未登记数据仓库）
+     * @param type 敌人类型
+     * @param position 出生位置
+     * @return 敌人节点，创建失败返回nullptr
+     */
+    EnemyBase* acquire(EnemyType type, const cocos2d::Vec3& position);
+
+    /**
+     * 退役：保留在场景中播放完死亡动画后回收
+     * @param enemy 已从数据仓库移除的敌人
+     */
+    void retire(EnemyBase* enemy);
+
+    /**
+     * 回收：隐藏并移出场景后放回空闲表
+     * 设置了延迟销毁队列时由队列在帧末批量移出，否则立即移出
+     * @param enemy 由 acquire 借出的敌人
+     */
+    void release(EnemyBase* enemy);
+
+    /**
+     * 设置延迟销毁队列(由场景持有，场景析构前需置空)
+     * @param queue 延迟销毁队列
+     */
+    void setDestroyQueue(DeferredDestroyQueue* queue) { _destroyQueue = queue; }
+    DeferredDestroyQueue* getDestroyQueue() const { return _destroyQueue; }
+
+    /**
+     * 回收仍挂在指定父节点下的全部借出节点（场景析构时调用）
+     * @param parent 父节点
+     */
+    void reclaim(cocos2d::Node* parent);
+
+    const EnemyPoolStats& getStats(EnemyType type) const { return _pools[(int)type].stats; }
+
+    /** 输出各类型的占用统计 */
+    void logStats() const;
+
+private:
+    EnemyPool() {}
+    ~EnemyPool();
+
+    // 单个类型的池
+    struct TypePool
+    {
+        std::vector<EnemyBase*> owned;      // 全部节点（池持有引用）
+        std::vector<EnemyBase*> available;  // 空闲节点
+        EnemyPoolStats stats;
+    };
+
+    EnemyBase* createNode(EnemyType type);
+    void finishRelease(EnemyBase* enemy);
+    void updateHighWater(TypePool& pool);
+
+    static EnemyPool* s_instance;
+
+    TypePool _pools[ENEMY_TYPE_COUNT];
+    DeferredDestroyQueue* _destroyQueue = nullptr;
+};
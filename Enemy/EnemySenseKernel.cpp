@@ -0,0 +1,179 @@
+#include "EnemySenseKernel.h"
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ENEMY_SENSE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENEMY_SENSE_SSE2 1
+#endif
+
+USING_NS_CC;
+
+// atan 多项式近似系数（[0,1] 区间）
+static const float ATAN_C1 = -0.0464964749f;
+static const float ATAN_C2 = 0.15931422f;
+static const float ATAN_C3 = -0.327622764f;
+static const float PI_F = 3.14159265f;
+static const float HALF_PI_F = 1.57079633f;
+static const float RAD_TO_DEG = 57.2957795f;
+
+// 标量版 atan2(y, x)，与SIMD版同一近似，保证各实现结果一致
+static inline float approxAtan2(float y, float x)
+{
+    float ax = fabsf(x);
+    float ay = fabsf(y);
+    float mx = ax > ay ? ax : ay;
+    float mn = ax > ay ? ay : ax;
+    float a = mx > 0.0f ? mn / mx : 0.0f;
+    float s = a * a;
+    float r = ((ATAN_C1 * s + ATAN_C2) * s + ATAN_C3) * s * a + a;
+    if (ay > ax) r = HALF_PI_F - r;
+    if (x < 0.0f) r = PI_F - r;
+    if (y < 0.0f) r = -r;
+    return r;
+}
+
+void EnemySenseKernel::run(const Vec3& target, const EnemySenseInput& input, const EnemySenseOutput& output)
+{
+    const int count = input.count;
+    int i = 0;
+
+#if defined(ENEMY_SENSE_AVX2)
+    const __m256 tx = _mm256_set1_ps(target.x);
+    const __m256 ty = _mm256_set1_ps(target.y);
+    const __m256 tz = _mm256_set1_ps(target.z);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 c1 = _mm256_set1_ps(ATAN_C1);
+    const __m256 c2 = _mm256_set1_ps(ATAN_C2);
+    const __m256 c3 = _mm256_set1_ps(ATAN_C3);
+    const __m256 pi = _mm256_set1_ps(PI_F);
+    const __m256 halfPi = _mm256_set1_ps(HALF_PI_F);
+    const __m256 toDeg = _mm256_set1_ps(RAD_TO_DEG);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 dx = _mm256_sub_ps(tx, _mm256_loadu_ps(input.posX + i));
+        __m256 dy = _mm256_sub_ps(ty, _mm256_loadu_ps(input.posY + i));
+        __m256 dz = _mm256_sub_ps(tz, _mm256_loadu_ps(input.posZ + i));
+        __m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+        _mm256_storeu_ps(output.distanceSq + i, d2);
+
+        // 范围掩码：d^2 <= r^2
+        __m256 det = _mm256_loadu_ps(input.detectionRange + i);
+        __m256 atk = _mm256_loadu_ps(input.attackRange + i);
+        int detMask = _mm256_movemask_ps(_mm256_cmp_ps(d2, _mm256_mul_ps(det, det), _CMP_LE_OQ));
+        int atkMask = _mm256_movemask_ps(_mm256_cmp_ps(d2, _mm256_mul_ps(atk, atk), _CMP_LE_OQ));
+        for (int k = 0; k < 8; ++k)
+        {
+            output.inDetection[i + k] = (unsigned char)((detMask >> k) & 1);
+            output.inAttack[i + k] = (unsigned char)((atkMask >> k) & 1);
+        }
+
+        // 朝向：atan2(dx, dz)
+        __m256 ax = _mm256_andnot_ps(signMask, dz);
+        __m256 ay = _mm256_andnot_ps(signMask, dx);
+        __m256 mx = _mm256_max_ps(ax, ay);
+        __m256 mn = _mm256_min_ps(ax, ay);
+        __m256 safeMx = _mm256_blendv_ps(mx, _mm256_set1_ps(1.0f), _mm256_cmp_ps(mx, zero, _CMP_EQ_OQ));
+        __m256 a = _mm256_div_ps(mn, safeMx);
+        __m256 s = _mm256_mul_ps(a, a);
+        __m256 r = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(c1, s), c2), s), c3), s), a), a);
+        r = _mm256_blendv_ps(r, _mm256_sub_ps(halfPi, r), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+        r = _mm256_blendv_ps(r, _mm256_sub_ps(pi, r), _mm256_cmp_ps(dz, zero, _CMP_LT_OQ));
+        r = _mm256_blendv_ps(r, _mm256_sub_ps(zero, r), _mm256_cmp_ps(dx, zero, _CMP_LT_OQ));
+        _mm256_storeu_ps(output.facingYaw + i, _mm256_mul_ps(r, toDeg));
+    }
+#elif defined(ENEMY_SENSE_SSE2)
+    const __m128 tx = _mm_set1_ps(target.x);
+    const __m128 ty = _mm_set1_ps(target.y);
+    const __m128 tz = _mm_set1_ps(target.z);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 c1 = _mm_set1_ps(ATAN_C1);
+    const __m128 c2 = _mm_set1_ps(ATAN_C2);
+    const __m128 c3 = _mm_set1_ps(ATAN_C3);
+    const __m128 pi = _mm_set1_ps(PI_F);
+    const __m128 halfPi = _mm_set1_ps(HALF_PI_F);
+    const __m128 toDeg = _mm_set1_ps(RAD_TO_DEG);
+
+    // SSE2 没有 blendv：按掩码选择 (mask & b) | (~mask & a)
+    #define SENSE_SELECT(mask, a, b) _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a))
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(tx, _mm_loadu_ps(input.posX + i));
+        __m128 dy = _mm_sub_ps(ty, _mm_loadu_ps(input.posY + i));
+        __m128 dz = _mm_sub_ps(tz, _mm_loadu_ps(input.posZ + i));
+        __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        _mm_storeu_ps(output.distanceSq + i, d2);
+
+        // 范围掩码：d^2 <= r^2
+        __m128 det = _mm_loadu_ps(input.detectionRange + i);
+        __m128 atk = _mm_loadu_ps(input.attackRange + i);
+        int detMask = _mm_movemask_ps(_mm_cmple_ps(d2, _mm_mul_ps(det, det)));
+        int atkMask = _mm_movemask_ps(_mm_cmple_ps(d2, _mm_mul_ps(atk, atk)));
+        for (int k = 0; k < 4; ++k)
+        {
+            output.inDetection[i + k] = (unsigned char)((detMask >> k) & 1);
+            output.inAttack[i + k] = (unsigned char)((atkMask >> k) & 1);
+        }
+
+        // 朝向：atan2(dx, dz)
+        __m128 ax = _mm_andnot_ps(signMask, dz);
+        __m128 ay = _mm_andnot_ps(signMask, dx);
+        __m128 mx = _mm_max_ps(ax, ay);
+        __m128 mn = _mm_min_ps(ax, ay);
+        __m128 safeMx = SENSE_SELECT(_mm_cmpeq_ps(mx, zero), mx, one);
+        __m128 a = _mm_div_ps(mn, safeMx);
+        __m128 s = _mm_mul_ps(a, a);
+        __m128 r = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(c1, s), c2), s), c3), s), a), a);
+        r = SENSE_SELECT(_mm_cmpgt_ps(ay, ax), r, _mm_sub_ps(halfPi, r));
+        r = SENSE_SELECT(_mm_cmplt_ps(dz, zero), r, _mm_sub_ps(pi, r));
+        r = SENSE_SELECT(_mm_cmplt_ps(dx, zero), r, _mm_sub_ps(zero, r));
+        _mm_storeu_ps(output.facingYaw + i, _mm_mul_ps(r, toDeg));
+    }
+
+    #undef SENSE_SELECT
+#endif
+
+    // 尾部（及无SIMD平台的全部）走标量
+    runRange(target, input, output, i);
+}
+
+void EnemySenseKernel::runScalar(const Vec3& target, const EnemySenseInput& input, const EnemySenseOutput& output)
+{
+    runRange(target, input, output, 0);
+}
+
+const char* EnemySenseKernel::getInstructionSet()
+{
+#if defined(ENEMY_SENSE_AVX2)
+    return "AVX2";
+#elif defined(ENEMY_SENSE_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+void EnemySenseKernel::runRange(const Vec3& target, const EnemySenseInput& input, const EnemySenseOutput& output, int begin)
+{
+    for (int i = begin; i < input.count; ++i)
+    {
+        float dx = target.x - input.posX[i];
+        float dy = target.y - input.posY[i];
+        float dz = target.z - input.posZ[i];
+        float d2 = dx * dx + dy * dy + dz * dz;
+        float det = input.detectionRange[i];
+        float atk = input.attackRange[i];
+
+        output.distanceSq[i] = d2;
+        output.inDetection[i] = (unsigned char)(d2 <= det * det);
+        output.inAttack[i] = (unsigned char)(d2 <= atk * atk);
+        output.facingYaw[i] = approxAtan2(dx, dz) * RAD_TO_DEG;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "cocos2d.h"
+
+// 批量感知输入：敌人数据仓库中的连续数组
+struct EnemySenseInput
+{
+    const float* posX = nullptr;
+    const float* posY = nullptr;
+    const float* posZ = nullptr;
+    const float* detectionRange = nullptr;
+    const float* attackRange = nullptr;
+    int count = 0;
+};
+
+// 批量感知输出
+struct EnemySenseOutput
+{
+    float* distanceSq = nullptr;          // 到目标的距离平方（3D）
+    float* facingYaw = nullptr;           // 面向目标的朝向（角度，XZ平面）
+    unsigned char* inDetection = nullptr; // 1：在警戒范围内
+    unsigned char* inAttack = nullptr;    // 1：在攻击起手范围内
+};
+
+/**
+ * 敌人感知批处理内核
+ * 一次遍历算出所有敌人相对目标的距离平方、警戒/攻击范围掩码与朝向角，
+ * 全程比较平方值不开方；朝向用多项式近似 atan2（误差约0.012度）。
+ * 编译期按指令集选择 AVX2 / SSE2 实现，其余平台走标量实现，三者结果一致。
+ */
+class EnemySenseKernel
+{
+public:
+    /**
+     * 执行批量感知（自动选择最快实现）
+     * @param target 目标位置
+     * @param input 输入数组
+     * @param output 输出数组（长度不小于 input.count）
+     */
+    static void run(const cocos2d::Vec3& target, const EnemySenseInput& input, const EnemySenseOutput& output);
+
+    /** 标量实现（无SIMD平台的回退，也用于校验） */
+    static void runScalar(const cocos2d::Vec3& target, const EnemySenseInput& input, const EnemySenseOutput& output);
+
+    /** 当前编译启用的指令集名称 */
+    static const char* getInstructionSet();
+
+private:
+    static void runRange(const cocos2d::Vec3& target, const EnemySenseInput& input, const EnemySenseOutput& output, int begin);
+};
@@ -0,0 +1,213 @@
+#include "EnemySeparation.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENEMY_SEPARATION_SSE2 1
+#endif
+
+USING_NS_CC;
+
+static const float DISTANCE_EPSILON = 0.001f;   // 避免除0（自身距离为0，贡献为0）
+static const float OVERLAP_JITTER = 0.01f;      // 重合偏移幅度（世界单位）
+static const int MIN_CELL_LIMIT = 1024;         // 格子数上限至少为该值，之外按敌人数的4倍
+
+// 4位掩码中1的个数
+static const int MASK_BITS[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+// 单个敌人的累加器：4条并行通道 + 尾部标量，合并顺序固定
+struct SeparationAccum
+{
+    float laneX[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float laneZ[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float tailX = 0.0f;
+    float tailZ = 0.0f;
+    int neighbours = 0;
+};
+
+// 一个邻居的贡献：方向 * (1 - d/r)，超出半径为0；运算顺序与SIMD版一致
+static inline void accumulateOne(float px, float pz, float sx, float sz, float radius, float invRadius,
+    float& outX, float& outZ, int& neighbours)
+{
+    float dx = px - sx;
+    float dz = pz - sz;
+    float d = sqrtf(dx * dx + dz * dz);
+    if (d < radius)
+    {
+        float w = (1.0f - d * invRadius) / (d + DISTANCE_EPSILON);
+        outX += dx * w;
+        outZ += dz * w;
+        neighbours++;
+    }
+}
+
+// 累加排序数组 [from, to) 的贡献：前面4个一组进各通道，余下进尾部
+static void accumulateRange(const float* sortedX, const float* sortedZ, int from, int to,
+    float px, float pz, float radius, float invRadius, SeparationAccum& acc)
+{
+    int j = from;
+
+#if defined(ENEMY_SEPARATION_SSE2)
+    const __m128 vpx = _mm_set1_ps(px);
+    const __m128 vpz = _mm_set1_ps(pz);
+    const __m128 vr = _mm_set1_ps(radius);
+    const __m128 vinvR = _mm_set1_ps(invRadius);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 eps = _mm_set1_ps(DISTANCE_EPSILON);
+    __m128 ax = _mm_loadu_ps(acc.laneX);
+    __m128 az = _mm_loadu_ps(acc.laneZ);
+
+    for (; j + 4 <= to; j += 4)
+    {
+        __m128 dx = _mm_sub_ps(vpx, _mm_loadu_ps(sortedX + j));
+        __m128 dz = _mm_sub_ps(vpz, _mm_loadu_ps(sortedZ + j));
+        __m128 d = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz)));
+        __m128 mask = _mm_cmplt_ps(d, vr);
+        __m128 w = _mm_div_ps(_mm_sub_ps(one, _mm_mul_ps(d, vinvR)), _mm_add_ps(d, eps));
+        w = _mm_and_ps(mask, w);
+        ax = _mm_add_ps(ax, _mm_mul_ps(dx, w));
+        az = _mm_add_ps(az, _mm_mul_ps(dz, w));
+        acc.neighbours += MASK_BITS[_mm_movemask_ps(mask)];
+    }
+    _mm_storeu_ps(acc.laneX, ax);
+    _mm_storeu_ps(acc.laneZ, az);
+#else
+    for (; j + 4 <= to; j += 4)
+    {
+        for (int lane = 0; lane < 4; ++lane)
+            accumulateOne(px, pz, sortedX[j + lane], sortedZ[j + lane], radius, invRadius, acc.laneX[lane], acc.laneZ[lane], acc.neighbours);
+    }
+#endif
+
+    for (; j < to; ++j)
+        accumulateOne(px, pz, sortedX[j], sortedZ[j], radius, invRadius, acc.tailX, acc.tailZ, acc.neighbours);
+}
+
+const char* EnemySeparation::getInstructionSet()
+{
+#if defined(ENEMY_SEPARATION_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+void EnemySeparation::build(const float* posX, const float* posZ, const int* agents, int count, float radius)
+{
+    _agents.assign(agents, agents + count);
+    _agentSlot.resize(count);
+    _agentCell.resize(count);
+    _sortedX.resize(count);
+    _sortedZ.resize(count);
+    _radius = radius > 0.0f ? radius : 1.0f;
+    _width = 0;
+    _height = 0;
+    _cellStart.assign(1, 0);
+    if (count == 0)
+        return;
+
+    float minX = posX[agents[0]];
+    float maxX = minX;
+    float minZ = posZ[agents[0]];
+    float maxZ = minZ;
+    for (int k = 1; k < count; ++k)
+    {
+        minX = std::min(minX, posX[agents[k]]);
+        maxX = std::max(maxX, posX[agents[k]]);
+        minZ = std::min(minZ, posZ[agents[k]]);
+        maxZ = std::max(maxZ, posZ[agents[k]]);
+    }
+
+    // 格子边长不小于分离半径（周围8格即覆盖半径）；敌人分布很散时放大格子，限制格子数
+    const int cellLimit = std::max(MIN_CELL_LIMIT, count * 4);
+    float cellSize = _radius;
+    while (true)
+    {
+        _width = (int)((maxX - minX) / cellSize) + 1;
+        _height = (int)((maxZ - minZ) / cellSize) + 1;
+        if ((long long)_width * _height <= cellLimit)
+            break;
+        cellSize *= 1.5f;
+    }
+    _minX = minX;
+    _minZ = minZ;
+    _invCellSize = 1.0f / cellSize;
+
+    // 计数排序（稳定）：同一格内保持登记顺序
+    const int cellCount = _width * _height;
+    _cellStart.assign(cellCount + 1, 0);
+    for (int k = 0; k < count; ++k)
+    {
+        int cx = std::min(_width - 1, (int)((posX[agents[k]] - _minX) * _invCellSize));
+        int cz = std::min(_height - 1, (int)((posZ[agents[k]] - _minZ) * _invCellSize));
+        _agentCell[k] = cz * _width + cx;
+        _cellStart[_agentCell[k] + 1]++;
+    }
+    for (int c = 0; c < cellCount; ++c)
+        _cellStart[c + 1] += _cellStart[c];
+
+    std::vector<int>& cursor = _agentSlot;   // 借用：先按格子分配位置
+    for (int k = 0; k < count; ++k)
+    {
+        int slot = _cellStart[_agentCell[k]]++;
+        cursor[k] = slot;
+
+        // 按登记序号取固定偏移，重合的敌人也有确定的推开方向
+        unsigned int hash = (unsigned int)k * 2654435761u;
+        float jitterX = ((hash & 0xFFFF) / 65535.0f - 0.5f) * OVERLAP_JITTER;
+        float jitterZ = ((hash >> 16) / 65535.0f - 0.5f) * OVERLAP_JITTER;
+        _sortedX[slot] = posX[agents[k]] + jitterX;
+        _sortedZ[slot] = posZ[agents[k]] + jitterZ;
+    }
+
+    // 分配后起点被推到了下一格的起点，整体回移一格
+    for (int c = cellCount; c > 0; --c)
+        _cellStart[c] = _cellStart[c - 1];
+    _cellStart[0] = 0;
+}
+
+void EnemySeparation::compute(int begin, int end, float strength, float maxSpeed, float* outX, float* outZ, EnemySeparationStats& stats) const
+{
+    const float invRadius = 1.0f / _radius;
+    const float maxSpeedSq = maxSpeed * maxSpeed;
+
+    for (int k = begin; k < end; ++k)
+    {
+        const int slot = _agentSlot[k];
+        const float px = _sortedX[slot];
+        const float pz = _sortedZ[slot];
+        const int cx = _agentCell[k] % _width;
+        const int cz = _agentCell[k] / _width;
+        const int x0 = std::max(0, cx - 1);
+        const int x1 = std::min(_width - 1, cx + 1);
+
+        // 同一行相邻3格在排序数组中连续，每行一段
+        SeparationAccum acc;
+        for (int z = std::max(0, cz - 1); z <= std::min(_height - 1, cz + 1); ++z)
+        {
+            const int from = _cellStart[z * _width + x0];
+            const int to = _cellStart[z * _width + x1 + 1];
+            accumulateRange(_sortedX.data(), _sortedZ.data(), from, to, px, pz, _radius, invRadius, acc);
+            stats.candidates += to - from;
+        }
+        stats.neighbours += acc.neighbours - 1;   // 去掉自身
+
+        float pushX = ((acc.laneX[0] + acc.laneX[1]) + (acc.laneX[2] + acc.laneX[3])) + acc.tailX;
+        float pushZ = ((acc.laneZ[0] + acc.laneZ[1]) + (acc.laneZ[2] + acc.laneZ[3])) + acc.tailZ;
+        float velX = pushX * strength;
+        float velZ = pushZ * strength;
+
+        float speedSq = velX * velX + velZ * velZ;
+        if (speedSq > maxSpeedSq)
+        {
+            float scale = maxSpeed / sqrtf(speedSq);
+            velX *= scale;
+            velZ *= scale;
+        }
+
+        const int index = _agents[k];
+        outX[index] = velX;
+        outZ[index] = velZ;
+    }
+}
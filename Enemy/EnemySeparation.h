@@ -0,0 +1,66 @@
+#pragma once
+#include "cocos2d.h"
+#include <vector>
+
+// 分离计算统计（按块累加后合并）
+struct EnemySeparationStats
+{
+    unsigned long long candidates = 0;   // 检查过的候选对数（相邻格内的全部敌人，含自身）
+    unsigned long long neighbours = 0;   // 其中距离小于分离半径的对数（不含自身）
+};
+
+/**
+ * 敌人群体分离（局部避让）
+ * 每tick用参与更新的敌人位置建一张XZ均匀网格（计数排序，格子边长不小于分离半径），
+ * 每个敌人只检查自身所在格及周围8格内的敌人，按重叠程度把彼此推开：
+ * - 网格按行存放，同一行相邻3格在排序数组中连续，内层循环是一段连续数组的无分支遍历
+ * - 编译期启用 SSE2 时4个一组计算，标量实现按相同的分组顺序累加，两者结果一致
+ * - 排序稳定（按登记顺序），结果与线程划分无关
+ * 位置重合的敌人按登记顺序加微小偏移，保证能被推开。
+ * build 在主线程执行；之后 compute 只读网格，可按块并行，各块写互不重叠的输出。
+ */
+class EnemySeparation
+{
+public:
+    /**
+     * 建立网格
+     * @param posX 位置X数组（按敌人下标）
+     * @param posZ 位置Z数组（按敌人下标）
+     * @param agents 参与分离的敌人下标
+     * @param count 参与数量
+     * @param radius 分离半径
+     */
+    void build(const float* posX, const float* posZ, const int* agents, int count, float radius);
+
+    /**
+     * 计算 agents[begin, end) 的分离速度
+     * @param begin 起始序号（agents 中的位置）
+     * @param end 结束序号
+     * @param strength 完全重叠时一个邻居产生的推开速度
+     * @param maxSpeed 推开速度上限
+     * @param outX 输出速度X（按敌人下标写入）
+     * @param outZ 输出速度Z（按敌人下标写入）
+     * @param stats 累加统计
+     */
+    void compute(int begin, int end, float strength, float maxSpeed, float* outX, float* outZ, EnemySeparationStats& stats) const;
+
+    int getAgentCount() const { return (int)_agents.size(); }
+    int getCellCount() const { return _width * _height; }
+
+    /** 当前编译启用的指令集名称 */
+    static const char* getInstructionSet();
+
+private:
+    std::vector<int> _agents;       // 敌人下标（登记顺序）
+    std::vector<int> _agentSlot;    // 登记序号 -> 排序数组中的位置
+    std::vector<int> _agentCell;    // 登记序号 -> 所在格子
+    std::vector<int> _cellStart;    // 每格在排序数组中的起点（长度为格子数+1）
+    std::vector<float> _sortedX;    // 按格子排序的位置（含重合偏移）
+    std::vector<float> _sortedZ;
+    float _minX = 0.0f;
+    float _minZ = 0.0f;
+    float _invCellSize = 1.0f;
+    float _radius = 1.0f;
+    int _width = 0;
+    int _height = 0;
+};
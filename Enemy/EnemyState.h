@@ -1,6 +1,6 @@
 #pragma once
 
-enum class EnemyState
+enum class EnemyState : unsigned char
 {
     IDLE,
     RUN,
@@ -0,0 +1,1109 @@
+#include "EnemyStore.h"
+#include "EnemyBase.h"
+#include "EnemyKernel.h"
+#include "EnemySenseKernel.h"
+#include "Player/Player.h"
+#include "Core/JobSystem.h"
+#include "Core/FlowField.h"
+#include "Core/CollisionWorld.h"
+#include "Core/HitWindowTable.h"
+#include "Core/CombatEventQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+
+USING_NS_CC;
+
+// AI 细节层级的距离阈值：在各自警戒范围之外再加的余量
+static const float LOD_FULL_MARGIN = 100.0f;      // 警戒范围+100以内：每tick思考
+static const float LOD_SLEEP_MARGIN = 500.0f;     // 警戒范围+500以外：休眠
+static const float LOD_WAKE_HYSTERESIS = 50.0f;   // 休眠者需再靠近50才唤醒，避免在边界反复切换
+static const unsigned int LOD_REDUCED_INTERVAL = 4;  // 降频思考间隔（tick）
+
+// 思考预算
+static const int THINK_MAX_DEFER_TICKS = 6;      // 每个敌人最多连续推迟的tick数（决定每tick最少思考数）
+static const int THINK_CLOCK_STRIDE = 8;         // 每思考若干次读一次时钟，降低计时开销
+
+// 并行更新
+static const int PARALLEL_MIN_ENEMIES = 512;     // 敌人少于该数量时串行更新（分发开销大于收益）
+static const int PARALLEL_GRAIN = 256;           // 计时器/决策/积分每块的敌人数
+static const int SENSE_GRAIN = 2048;             // 感知内核每块的敌人数
+
+// 群体分离
+static const float SEPARATION_RADIUS = 40.0f;       // 分离半径（两个敌人身体不重叠的最小间距）
+static const float SEPARATION_STRENGTH = 60.0f;     // 完全重叠时一个同伴产生的推开速度
+static const float SEPARATION_MAX_SPEED = 60.0f;    // 推开速度上限
+
+// 墙体碰撞
+static const float ENEMY_COLLISION_RADIUS = 20.0f;  // 敌人碰撞胶囊半径
+static const float ENEMY_COLLISION_HEIGHT = 100.0f; // 敌人碰撞胶囊高度
+static const float STRIKE_TARGET_RADIUS = 25.0f;    // 命中窗口判定时目标的身体半径
+
+// 并行阶段中当前块的命中记录（为空时直接结算）
+static thread_local std::vector<int>* t_strikeSink = nullptr;
+
+// 逐个敌人按类型分支（默认分派方式，预算模式下的轮转思考也走这里）
+struct EnemyStore::SwitchDispatch
+{
+    static void think(EnemyStore& store, int i, float dt) { store.think(i, dt); }
+    static void onStrike(EnemyStore& store, int i) { store.onStrike(i); }
+    static void onPhaseEnd(EnemyStore& store, int i, EnemyPhase endedPhase) { store.onPhaseEnd(i, endedPhase); }
+};
+
+// 逐个敌人经虚函数分派（对照基准：数据仓库之前每个敌人节点虚调用 update 的做法）
+namespace
+{
+    struct EnemyLogic
+    {
+        virtual ~EnemyLogic() {}
+        virtual void think(EnemyStore& store, int i, float dt) const = 0;
+        virtual void onStrike(EnemyStore& store, int i) const = 0;
+        virtual void onPhaseEnd(EnemyStore& store, int i, EnemyPhase endedPhase) const = 0;
+    };
+
+    template <EnemyType T>
+    struct EnemyLogicOf : EnemyLogic
+    {
+        void think(EnemyStore& store, int i, float dt) const override { EnemyKernel<T>::think(store, i, dt); }
+        void onStrike(EnemyStore& store, int i) const override { EnemyKernel<T>::onStrike(store, i); }
+        void onPhaseEnd(EnemyStore& store, int i, EnemyPhase endedPhase) const override { EnemyKernel<T>::onPhaseEnd(store, i, endedPhase); }
+    };
+
+    const EnemyLogicOf<EnemyType::GOBLIN> GOBLIN_LOGIC;
+    const EnemyLogicOf<EnemyType::MINOTAUR> MINOTAUR_LOGIC;
+    const EnemyLogicOf<EnemyType::KNIGHT> KNIGHT_LOGIC;
+    const EnemyLogic* const ENEMY_LOGIC[ENEMY_TYPE_COUNT] = { &GOBLIN_LOGIC, &MINOTAUR_LOGIC, &KNIGHT_LOGIC };
+}
+
+struct EnemyStore::VirtualDispatch
+{
+    static void think(EnemyStore& store, int i, float dt) { ENEMY_LOGIC[(int)store.type[i]]->think(store, i, dt); }
+    static void onStrike(EnemyStore& store, int i) { ENEMY_LOGIC[(int)store.type[i]]->onStrike(store, i); }
+    static void onPhaseEnd(EnemyStore& store, int i, EnemyPhase endedPhase) { ENEMY_LOGIC[(int)store.type[i]]->onPhaseEnd(store, i, endedPhase); }
+};
+
+EnemyStore::EnemyStore()
+{
+    reserve(64);
+}
+
+EnemyStore::~EnemyStore()
+{
+    // 只注销仓库自己登记的句柄；代理节点由场景树持有，此时可能已释放，不再访问
+    auto registry = EntityRegistry::getInstance();
+    for (int i = 0; i < getCount(); ++i)
+    {
+        if (!proxy[i])
+            registry->destroy(entity[i]);
+    }
+}
+
+void EnemyStore::reserve(int capacity)
+{
+    type.reserve(capacity);
+    state.reserve(capacity);
+    phase.reserve(capacity);
+    posX.reserve(capacity);
+    posY.reserve(capacity);
+    posZ.reserve(capacity);
+    prevX.reserve(capacity);
+    prevZ.reserve(capacity);
+    velX.reserve(capacity);
+    velZ.reserve(capacity);
+    yaw.reserve(capacity);
+    hp.reserve(capacity);
+    maxHp.reserve(capacity);
+    attack.reserve(capacity);
+    speed.reserve(capacity);
+    attackRange.reserve(capacity);
+    attackCooldown.reserve(capacity);
+    detectionRange.reserve(capacity);
+    attackTimer.reserve(capacity);
+    strikeTimer.reserve(capacity);
+    strikeWindow.reserve(capacity);
+    strikeOpen.reserve(capacity);
+    strikeHit.reserve(capacity);
+    phaseTimer.reserve(capacity);
+    targetDistanceSq.reserve(capacity);
+    targetYaw.reserve(capacity);
+    inDetection.reserve(capacity);
+    inAttack.reserve(capacity);
+    lod.reserve(capacity);
+    lodDt.reserve(capacity);
+    _due.reserve(capacity);
+    _awake.reserve(capacity);
+    _awakeGrouped.reserve(capacity);
+    anim.reserve(capacity);
+    animSerial.reserve(capacity);
+    proxy.reserve(capacity);
+    entity.reserve(capacity);
+}
+
+int EnemyStore::add(EnemyBase* enemy)
+{
+    if (!enemy)
+        return -1;
+
+    return add(enemy, enemy->getStats());
+}
+
+int EnemyStore::add(EnemyBase* enemy, const EnemyStats& stats)
+{
+    if (!enemy)
+        return -1;
+
+    int index = pushSlot(enemy->getType(), stats, enemy->getPosition3D(), enemy->getRotation3D().y);
+    proxy[index] = enemy;
+    entity[index] = enemy->getEntityHandle();
+    enemy->bindStore(this, index);
+    return index;
+}
+
+int EnemyStore::spawn(EnemyType enemyType, const EnemyStats& stats, const Vec3& position, float initialYaw)
+{
+    int index = pushSlot(enemyType, stats, position, initialYaw);
+    entity[index] = EntityRegistry::getInstance()->createStoredEnemy(this, index);
+    return index;
+}
+
+int EnemyStore::pushSlot(EnemyType enemyType, const EnemyStats& stats, const Vec3& position, float initialYaw)
+{
+    int index = getCount();
+
+    type.push_back(enemyType);
+    state.push_back(EnemyState::IDLE);
+    phase.push_back(EnemyPhase::NONE);
+    posX.push_back(position.x);
+    posY.push_back(position.y);
+    posZ.push_back(position.z);
+    prevX.push_back(position.x);
+    prevZ.push_back(position.z);
+    velX.push_back(0.0f);
+    velZ.push_back(0.0f);
+    yaw.push_back(initialYaw);
+    hp.push_back(stats.maxHp);
+    maxHp.push_back(stats.maxHp);
+    attack.push_back(stats.attack);
+    speed.push_back(stats.speed);
+    attackRange.push_back(stats.attackRange);
+    attackCooldown.push_back(stats.attackCooldown);
+    detectionRange.push_back(stats.detectionRange);
+    attackTimer.push_back(0.0f);
+    strikeTimer.push_back(0.0f);
+    strikeWindow.push_back(nullptr);
+    strikeOpen.push_back(0.0f);
+    strikeHit.push_back(0);
+    phaseTimer.push_back(0.0f);
+    targetDistanceSq.push_back(0.0f);
+    targetYaw.push_back(0.0f);
+    inDetection.push_back(0);
+    inAttack.push_back(0);
+    lod.push_back(EnemyLod::FULL);
+    lodDt.push_back(0.0f);
+    anim.push_back(EnemyState::IDLE);
+    animSerial.push_back(1);  // 代理首次同步时播放待机动画
+    proxy.push_back(nullptr);
+    entity.push_back(EntityHandle());
+    return index;
+}
+
+const EnemyStats& EnemyStore::getDefaultStats(EnemyType enemyType)
+{
+    return EnemyArchetypes::get(enemyType).stats;
+}
+
+void EnemyStore::tick(float dt)
+{
+    const int count = getCount();
+    if (count == 0)
+        return;
+
+    // 目标句柄每tick只校验一次，之后的感知/命中判定直接使用解析出的指针
+    _target = EntityRegistry::getInstance()->getPlayer(_targetHandle);
+
+    const bool parallel = _jobSystem && _jobSystem->getWorkerCount() > 0 && count >= PARALLEL_MIN_ENEMIES;
+    computeTargetDistances(parallel);
+    if (_flowField && _target)
+        _flowField->setGoal(_targetPos);   // 只在主角换格时重建，之后并行阶段只读
+    updateLod(dt);
+    if (_separationEnabled)
+        computeSeparation(parallel);
+
+    // 限预算时决策须按轮转顺序串行执行；否则决策与计时器、积分在同一遍中完成
+    const bool budgeted = _target && _thinkBudgetUs > 0.0f;
+    updateAwake(dt, budgeted, parallel);
+
+    if (budgeted)
+    {
+        runThinks(dt);
+        integrate(dt);
+    }
+    _tickCount++;
+}
+
+HitResult EnemyStore::applyDamage(int index, int damage)
+{
+    if (index < 0 || index >= getCount() || state[index] == EnemyState::DEAD)
+        return HitResult::none();
+
+    const int hpBefore = hp[index];
+
+    // 受击即唤醒：本帧同步时解冻代理，受击/死亡动画照常播放
+    lod[index] = EnemyLod::FULL;
+
+    switch (type[index])
+    {
+    case EnemyType::GOBLIN:
+        EnemyKernel<EnemyType::GOBLIN>::onDamaged(*this, index, damage);
+        break;
+    case EnemyType::KNIGHT:
+        EnemyKernel<EnemyType::KNIGHT>::onDamaged(*this, index, damage);
+        break;
+    case EnemyType::MINOTAUR:
+        EnemyKernel<EnemyType::MINOTAUR>::onDamaged(*this, index, damage);
+        break;
+    }
+
+    // 死亡后不再有后续判定，记录下标留待批量移除
+    const bool killed = state[index] == EnemyState::DEAD;
+    if (killed)
+    {
+        cancelTimers(index);
+        stop(index);
+        _dying.push_back(index);
+    }
+
+    const int dealt = hpBefore - hp[index];
+    const bool blocked = dealt < damage && !killed && state[index] == EnemyState::BLOCK;
+    return HitResult::make(blocked ? CombatEventType::BLOCK : CombatEventType::HIT, dealt, killed);
+}
+
+int EnemyStore::removeDead(std::vector<EnemyBase*>& outProxies)
+{
+    outProxies.clear();
+    if (_dying.empty())
+        return 0;
+
+    // 从大到小处理：末尾元素总是存活者（更大的死亡下标已先被移除）
+    std::sort(_dying.begin(), _dying.end(), std::greater<int>());
+    auto registry = EntityRegistry::getInstance();
+    for (int index : _dying)
+    {
+        if (proxy[index])
+        {
+            // 解除绑定前推送最终渲染状态：一帧内跑多个tick时，渲染同步可能还没看到死亡状态
+            // （动画序号未变时不会重播，已在播放的死亡动画不受影响）
+            proxy[index]->applyRenderState(Vec3(posX[index], posY[index], posZ[index]), yaw[index], anim[index], animSerial[index]);
+            proxy[index]->bindStore(nullptr, -1);
+            outProxies.push_back(proxy[index]);
+        }
+        else
+        {
+            registry->destroy(entity[index]);   // 无代理：旧句柄随即失效
+        }
+
+        int last = getCount() - 1;
+        if (index != last)
+            moveSlot(last, index);
+        popBack();
+    }
+
+    int removed = (int)_dying.size();
+    _dying.clear();
+    return removed;
+}
+
+void EnemyStore::syncProxies(float alpha)
+{
+    const int count = getCount();
+    for (int i = 0; i < count; ++i)
+    {
+        if (!proxy[i])
+            continue;
+
+        // 休眠者：最后同步一次后冻结动画，之后不再触碰节点
+        if (lod[i] == EnemyLod::SLEEPING)
+        {
+            if (!proxy[i]->isAnimationFrozen())
+            {
+                proxy[i]->applyRenderState(Vec3(posX[i], posY[i], posZ[i]), yaw[i], anim[i], animSerial[i]);
+                proxy[i]->setAnimationFrozen(true);
+            }
+            continue;
+        }
+        if (proxy[i]->isAnimationFrozen())
+            proxy[i]->setAnimationFrozen(false);
+
+        float x = prevX[i] + (posX[i] - prevX[i]) * alpha;
+        float z = prevZ[i] + (posZ[i] - prevZ[i]) * alpha;
+        proxy[i]->applyRenderState(Vec3(x, posY[i], z), yaw[i], anim[i], animSerial[i]);
+    }
+}
+
+void EnemyStore::clear()
+{
+    auto registry = EntityRegistry::getInstance();
+    for (int i = 0; i < getCount(); ++i)
+    {
+        if (proxy[i])
+            proxy[i]->bindStore(nullptr, -1);
+        else
+            registry->destroy(entity[i]);
+    }
+
+    while (getCount() > 0)
+        popBack();
+    _dying.clear();
+    _awake.clear();
+    _awakeGrouped.clear();
+    std::fill(_groupBegin, _groupBegin + ENEMY_TYPE_COUNT + 1, 0);
+    _sleepingCount = 0;
+    _thinkCursor = 0;
+}
+
+//------------------------------
+// 行为工具
+//------------------------------
+
+void EnemyStore::setState(int i, EnemyState newState)
+{
+    // 死亡后不允许切换
+    if (state[i] == EnemyState::DEAD)
+        return;
+
+    // 格挡中，不被其他状态打断
+    if (state[i] == EnemyState::BLOCK && newState != EnemyState::DEAD)
+        return;
+
+    if (state[i] == newState)
+        return;
+
+    state[i] = newState;
+    playAnimation(i, newState);
+}
+
+void EnemyStore::forceState(int i, EnemyState newState)
+{
+    if (state[i] == EnemyState::DEAD)
+        return;
+
+    state[i] = newState;
+    playAnimation(i, newState);
+}
+
+void EnemyStore::playAnimation(int i, EnemyState newAnim)
+{
+    anim[i] = newAnim;
+    animSerial[i]++;
+}
+
+void EnemyStore::faceTarget(int i)
+{
+    yaw[i] = targetYaw[i];
+}
+
+void EnemyStore::moveTowardsTarget(int i)
+{
+    if (state[i] == EnemyState::ATTACK || state[i] == EnemyState::BLOCK)
+    {
+        stop(i);
+        return;
+    }
+
+    // 沿流场绕开不可行走的格子，朝向随移动方向
+    float dirX = 0.0f;
+    float dirZ = 0.0f;
+    if (_flowField && _flowField->sample(posX[i], posZ[i], dirX, dirZ))
+    {
+        velX[i] = dirX * speed[i];
+        velZ[i] = dirZ * speed[i];
+        yaw[i] = CC_RADIANS_TO_DEGREES(atan2f(dirX, dirZ));
+        return;
+    }
+
+    // 无流场、不在区域内或已接近目标：直线逼近
+    float dx = _targetPos.x - posX[i];
+    float dz = _targetPos.z - posZ[i];
+    float length = sqrtf(dx * dx + dz * dz);
+    if (length < 0.0001f)
+    {
+        stop(i);
+        return;
+    }
+
+    float scale = speed[i] / length;
+    velX[i] = dx * scale;
+    velZ[i] = dz * scale;
+}
+
+void EnemyStore::beginAttack(int i, ClipId clip, float windup)
+{
+    attackTimer[i] = 0.0f;
+    stop(i);
+    setState(i, EnemyState::ATTACK);
+
+    const HitWindow* window = HitWindowTable::getInstance()->getWindow(clip, 0);
+    strikeWindow[i] = window;
+    strikeOpen[i] = 0.0f;
+    strikeHit[i] = 0;
+    strikeTimer[i] = window ? std::max(window->start, 0.0001f) : windup;
+}
+
+void EnemyStore::startPhase(int i, EnemyPhase newPhase, float duration)
+{
+    phase[i] = newPhase;
+    phaseTimer[i] = duration;
+}
+
+void EnemyStore::cancelTimers(int i)
+{
+    strikeTimer[i] = 0.0f;
+    strikeOpen[i] = 0.0f;
+    phase[i] = EnemyPhase::NONE;
+    phaseTimer[i] = 0.0f;
+}
+
+void EnemyStore::strikeTarget(int i, float range, bool inclusive)
+{
+    if (!_target)
+        return;
+
+    if (strikeWindow[i])
+    {
+        if (!strikeHit[i])
+            return;
+    }
+    else
+    {
+        float distanceSq = targetDistanceSq[i];
+        float rangeSq = range * range;
+        if (!(inclusive ? distanceSq <= rangeSq : distanceSq < rangeSq))
+            return;
+    }
+
+    // 并行阶段只记录，合并阶段按下标顺序登记（主角受击逻辑只在主线程执行）
+    if (t_strikeSink)
+        t_strikeSink->push_back(i);
+    else
+        submitStrike(i);
+}
+
+void EnemyStore::submitStrike(int i)
+{
+    if (_combatEvents)
+        _combatEvents->pushHit(entity[i], _targetHandle, attack[i]);
+    else
+        _target->takeDamage(attack[i]);
+}
+
+//------------------------------
+// tick各阶段
+//------------------------------
+
+void EnemyStore::computeTargetDistances(bool parallel)
+{
+    if (!_target)
+        return;
+
+    // 本tick的只读快照：并行阶段只读取该位置，不访问主角对象
+    _targetPos = _target->getPosition3D();
+
+    auto sense = [this](int begin, int end, int) {
+        EnemySenseInput input;
+        input.posX = posX.data() + begin;
+        input.posY = posY.data() + begin;
+        input.posZ = posZ.data() + begin;
+        input.detectionRange = detectionRange.data() + begin;
+        input.attackRange = attackRange.data() + begin;
+        input.count = end - begin;
+
+        EnemySenseOutput output;
+        output.distanceSq = targetDistanceSq.data() + begin;
+        output.facingYaw = targetYaw.data() + begin;
+        output.inDetection = inDetection.data() + begin;
+        output.inAttack = inAttack.data() + begin;
+
+        EnemySenseKernel::run(_targetPos, input, output);
+    };
+
+    if (parallel)
+        _jobSystem->parallelFor(getCount(), SENSE_GRAIN, sense);
+    else
+        sense(0, getCount(), 0);
+}
+
+void EnemyStore::updateLod(float dt)
+{
+    const int count = getCount();
+    const bool lodActive = _lodEnabled && _target != nullptr;
+    _awake.clear();
+    _sleepingCount = 0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        if (state[i] == EnemyState::DEAD)
+        {
+            lod[i] = EnemyLod::FULL;
+            continue;
+        }
+
+        float distanceSq = targetDistanceSq[i];
+
+        // 休眠者的状态只会被受击改变（受击时已改回 FULL），这里只需检查是否靠近
+        if (lodActive && lod[i] == EnemyLod::SLEEPING)
+        {
+            float wakeRange = detectionRange[i] + LOD_SLEEP_MARGIN - LOD_WAKE_HYSTERESIS;
+            if (distanceSq > wakeRange * wakeRange)
+            {
+                lodDt[i] += dt;  // 唤醒后的第一次思考补上（攻击冷却照常累计）
+                _sleepingCount++;
+                continue;
+            }
+        }
+
+        // 无目标、关闭LOD或正在行动（移动/攻击/受击/定时阶段）时全速更新，行为与不分级完全一致
+        EnemyLod level = EnemyLod::FULL;
+        if (lodActive && isQuiescent(i))
+        {
+            float fullRange = detectionRange[i] + LOD_FULL_MARGIN;
+            float sleepRange = detectionRange[i] + LOD_SLEEP_MARGIN;
+            if (distanceSq > sleepRange * sleepRange)
+                level = EnemyLod::SLEEPING;
+            else if (distanceSq > fullRange * fullRange)
+                level = EnemyLod::REDUCED;
+        }
+        lod[i] = level;
+
+        if (level == EnemyLod::SLEEPING)
+        {
+            lodDt[i] += dt;
+            _sleepingCount++;
+            continue;
+        }
+        _awake.push_back(i);
+    }
+}
+
+void EnemyStore::groupAwakeByType()
+{
+    // 计数排序，组内保持下标升序；只有按类型分组的分派方式需要
+    int groupCount[ENEMY_TYPE_COUNT] = {};
+    for (int i : _awake)
+        groupCount[(int)type[i]]++;
+
+    int cursor[ENEMY_TYPE_COUNT];
+    _groupBegin[0] = 0;
+    for (int t = 0; t < ENEMY_TYPE_COUNT; ++t)
+    {
+        cursor[t] = _groupBegin[t];
+        _groupBegin[t + 1] = _groupBegin[t] + groupCount[t];
+    }
+    _awakeGrouped.resize(_awake.size());
+    for (int i : _awake)
+        _awakeGrouped[cursor[(int)type[i]]++] = i;
+}
+
+bool EnemyStore::strikeWindowTouches(int i) const
+{
+    const HitShape& shape = strikeWindow[i]->shape;
+    const Vec3 center = shape.getCenter(Vec3(posX[i], posY[i], posZ[i]), yaw[i]);
+    const float reach = shape.radius + STRIKE_TARGET_RADIUS;
+    return center.distanceSquared(_targetPos) <= reach * reach;
+}
+
+bool EnemyStore::isQuiescent(int i) const
+{
+    return state[i] == EnemyState::IDLE && phase[i] == EnemyPhase::NONE && strikeTimer[i] <= 0.0f &&
+        strikeOpen[i] <= 0.0f &&
+        velX[i] == 0.0f && velZ[i] == 0.0f;
+}
+
+void EnemyStore::computeSeparation(bool parallel)
+{
+    // 只在参与更新的存活敌人之间分离；死亡者不推人也不被推
+    const int count = getCount();
+    if ((int)_sepX.size() < count)
+    {
+        _sepX.resize(count, 0.0f);
+        _sepZ.resize(count, 0.0f);
+    }
+
+    _crowd.clear();
+    for (int i : _awake)
+    {
+        if (state[i] == EnemyState::DEAD)
+        {
+            _sepX[i] = 0.0f;
+            _sepZ[i] = 0.0f;
+        }
+        else
+        {
+            _crowd.push_back(i);
+        }
+    }
+
+    const int crowdCount = (int)_crowd.size();
+    _separation.build(posX.data(), posZ.data(), _crowd.data(), crowdCount, SEPARATION_RADIUS);
+
+    auto separate = [this](int first, int last, int chunk) {
+        _chunkSeparation[chunk] = EnemySeparationStats();
+        _separation.compute(first, last, SEPARATION_STRENGTH, SEPARATION_MAX_SPEED, _sepX.data(), _sepZ.data(), _chunkSeparation[chunk]);
+    };
+
+    const int chunkCount = parallel ? JobSystem::getChunkCount(crowdCount, PARALLEL_GRAIN) : 1;
+    if ((int)_chunkSeparation.size() < chunkCount)
+        _chunkSeparation.resize(chunkCount);
+
+    if (parallel)
+        _jobSystem->parallelFor(crowdCount, PARALLEL_GRAIN, separate);
+    else
+        separate(0, crowdCount, 0);
+
+    _separationStats = EnemySeparationStats();
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        _separationStats.candidates += _chunkSeparation[chunk].candidates;
+        _separationStats.neighbours += _chunkSeparation[chunk].neighbours;
+    }
+}
+
+void EnemyStore::updateAwake(float dt, bool budgeted, bool parallel)
+{
+    const int awakeCount = (int)_awake.size();
+    auto begin = std::chrono::steady_clock::now();
+
+    // 只有分组分派需要排序；计入更新耗时，与逐个分派的对比才公平
+    if (_dispatchMode == EnemyDispatchMode::GROUPED)
+        groupAwakeByType();
+
+    // 每块只写自己负责的敌人字段，命中记录写入本块的缓冲（串行时整体作为一块）
+    auto update = [this, dt, budgeted](int first, int last, int chunk) {
+        std::vector<int>& strikes = _chunkStrikes[chunk];
+        strikes.clear();
+        t_strikeSink = &strikes;
+        _chunkThinks[chunk] = updateAwakeRange(first, last, dt, budgeted);
+        t_strikeSink = nullptr;
+    };
+
+    const int chunkCount = parallel ? JobSystem::getChunkCount(awakeCount, PARALLEL_GRAIN) : 1;
+    if ((int)_chunkStrikes.size() < chunkCount)
+        _chunkStrikes.resize(chunkCount);
+    _chunkThinks.assign(chunkCount, 0);
+
+    if (parallel)
+        _jobSystem->parallelFor(awakeCount, PARALLEL_GRAIN, update);
+    else
+        update(0, awakeCount, 0);
+
+    // 合并：分组遍历不按下标顺序，命中排序后按下标升序登记，分派方式与线程数不同结果也一致
+    int thinks = 0;
+    _strikes.clear();
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        _strikes.insert(_strikes.end(), _chunkStrikes[chunk].begin(), _chunkStrikes[chunk].end());
+        thinks += _chunkThinks[chunk];
+    }
+    std::sort(_strikes.begin(), _strikes.end());
+    for (int i : _strikes)
+    {
+        if (_target)
+            submitStrike(i);
+    }
+
+    if (!budgeted && _target)
+    {
+        _thinkStats.usedUs += std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - begin).count();
+        _thinkStats.thinks += thinks;
+        _thinkStats.totalThinks += thinks;
+    }
+}
+
+int EnemyStore::updateAwakeRange(int first, int last, float dt, bool budgeted)
+{
+    if (_dispatchMode == EnemyDispatchMode::SWITCH)
+        return updateRange<SwitchDispatch>(_awake.data() + first, last - first, dt, budgeted);
+    if (_dispatchMode == EnemyDispatchMode::VIRTUAL)
+        return updateRange<VirtualDispatch>(_awake.data() + first, last - first, dt, budgeted);
+
+    // 分组分派（基准对照）：块可能跨越类型分组，逐组截取本块负责的部分，每组只在这里判断一次类型
+    int thinks = 0;
+    for (int t = 0; t < ENEMY_TYPE_COUNT; ++t)
+    {
+        const int from = std::max(first, _groupBegin[t]);
+        const int to = std::min(last, _groupBegin[t + 1]);
+        if (from >= to)
+            continue;
+
+        const int* indices = _awakeGrouped.data() + from;
+        switch ((EnemyType)t)
+        {
+        case EnemyType::GOBLIN:
+            thinks += updateRange<EnemyKernel<EnemyType::GOBLIN>>(indices, to - from, dt, budgeted);
+            break;
+        case EnemyType::MINOTAUR:
+            thinks += updateRange<EnemyKernel<EnemyType::MINOTAUR>>(indices, to - from, dt, budgeted);
+            break;
+        case EnemyType::KNIGHT:
+            thinks += updateRange<EnemyKernel<EnemyType::KNIGHT>>(indices, to - from, dt, budgeted);
+            break;
+        }
+    }
+    return thinks;
+}
+
+template <typename Kernel>
+int EnemyStore::updateRange(const int* indices, int count, float dt, bool budgeted)
+{
+    int thinks = 0;
+    for (int k = 0; k < count; ++k)
+    {
+        const int i = indices[k];
+
+        // 上一tick位置，供渲染插值（休眠者不移动，prev 与当前位置一致）
+        prevX[i] = posX[i];
+        prevZ[i] = posZ[i];
+
+        if (state[i] != EnemyState::DEAD)
+            updateTimers<Kernel>(i, dt);
+
+        // 限预算时决策与积分由 runThinks/integrate 串行完成
+        if (budgeted)
+            continue;
+
+        if (_target && state[i] != EnemyState::DEAD)
+        {
+            // 降频者错开tick思考，跳过的时间一并交给下一次思考
+            if (lod[i] == EnemyLod::REDUCED && ((unsigned int)i + _tickCount) % LOD_REDUCED_INTERVAL != 0)
+            {
+                lodDt[i] += dt;
+            }
+            else
+            {
+                const float thinkDt = dt + lodDt[i];
+                lodDt[i] = 0.0f;
+                Kernel::think(*this, i, thinkDt);
+                thinks++;
+            }
+        }
+
+        integrateOne(i, dt);
+    }
+    return thinks;
+}
+
+template <typename Kernel>
+void EnemyStore::updateTimers(int i, float dt)
+{
+    if (strikeTimer[i] > 0.0f)
+    {
+        strikeTimer[i] -= dt;
+        if (strikeTimer[i] <= 0.0f)
+        {
+            strikeTimer[i] = 0.0f;
+            if (strikeWindow[i])
+                strikeOpen[i] = std::max(strikeWindow[i]->end - strikeWindow[i]->start, 0.0001f);   // 窗口打开
+            else
+                Kernel::onStrike(*this, i);
+        }
+    }
+
+    // 命中窗口打开期间逐tick检测，首次接触或窗口关闭时结算(每次攻击只结算一次)
+    if (strikeOpen[i] > 0.0f)
+    {
+        strikeOpen[i] -= dt;
+        if (strikeWindowTouches(i))
+        {
+            strikeHit[i] = 1;
+            strikeOpen[i] = 0.0f;
+            Kernel::onStrike(*this, i);
+        }
+        else if (strikeOpen[i] <= 0.0f)
+        {
+            strikeOpen[i] = 0.0f;
+            Kernel::onStrike(*this, i);
+        }
+    }
+
+    if (phase[i] != EnemyPhase::NONE)
+    {
+        phaseTimer[i] -= dt;
+        if (phaseTimer[i] <= 0.0f)
+        {
+            EnemyPhase endedPhase = phase[i];
+            phase[i] = EnemyPhase::NONE;
+            phaseTimer[i] = 0.0f;
+            Kernel::onPhaseEnd(*this, i, endedPhase);
+        }
+    }
+}
+
+void EnemyStore::beginThinkFrame()
+{
+    _thinkStats.thinks = 0;
+    _thinkStats.deferred = 0;
+    _thinkStats.usedUs = 0.0f;
+    _thinkStats.overrun = false;
+}
+
+void EnemyStore::runThinks(float dt)
+{
+    // 本tick应思考的敌人：降频者错开tick，跳过的时间一并交给下一次思考
+    _due.clear();
+    for (int i : _awake)
+    {
+        if (state[i] == EnemyState::DEAD)
+            continue;
+
+        if (lod[i] == EnemyLod::REDUCED && ((unsigned int)i + _tickCount) % LOD_REDUCED_INTERVAL != 0)
+        {
+            lodDt[i] += dt;
+            continue;
+        }
+        _due.push_back(i);
+    }
+
+    const int dueCount = (int)_due.size();
+    if (dueCount == 0)
+        return;
+
+    // 轮转：从上次预算用尽处继续，每个敌人轮流得到思考机会
+    int start = (int)(std::lower_bound(_due.begin(), _due.end(), _thinkCursor) - _due.begin());
+    if (start >= dueCount)
+        start = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    float remainingUs = _thinkBudgetUs - _thinkStats.usedUs;
+    bool exhausted = remainingUs <= 0.0f;
+    int thinks = 0;
+    int forced = 0;         // 预算用尽后为保底而执行的思考
+    int firstDeferred = -1;
+
+    // 保底：每tick至少思考 1/(N+1)，轮转下每个敌人最多连续推迟N个tick，不会饿死
+    const int minThinks = (dueCount + THINK_MAX_DEFER_TICKS) / (THINK_MAX_DEFER_TICKS + 1);
+
+    for (int k = 0; k < dueCount; ++k)
+    {
+        int slot = start + k;
+        if (slot >= dueCount)
+            slot -= dueCount;
+        int i = _due[slot];
+
+        // 预算用尽且已达保底：推迟思考，只做廉价转向
+        if (exhausted && thinks >= minThinks)
+        {
+            if (firstDeferred < 0)
+                firstDeferred = i;
+            lodDt[i] += dt;
+            steer(i);
+            _thinkStats.deferred++;
+            continue;
+        }
+
+        if (exhausted)
+            forced++;
+        thinkNow(i, dt);
+        thinks++;
+
+        if (!exhausted && thinks % THINK_CLOCK_STRIDE == 0)
+        {
+            float elapsedUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - begin).count();
+            exhausted = elapsedUs >= remainingUs;
+        }
+    }
+
+    float elapsedUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - begin).count();
+    _thinkStats.usedUs += elapsedUs;
+    _thinkStats.thinks += thinks;
+    _thinkStats.totalThinks += thinks;
+    _thinkStats.totalDeferred += dueCount - thinks;
+    if (firstDeferred >= 0)
+        _thinkCursor = firstDeferred;
+
+    if (!_thinkStats.overrun && forced > 0)
+    {
+        _thinkStats.overrun = true;
+        _thinkStats.overrunFrames++;
+    }
+}
+
+void EnemyStore::thinkNow(int i, float dt)
+{
+    float thinkDt = dt + lodDt[i];
+    lodDt[i] = 0.0f;
+    think(i, thinkDt);
+}
+
+void EnemyStore::steer(int i)
+{
+    // 追击中：按目标当前位置修正速度方向，状态与动画留给下一次思考
+    if (state[i] == EnemyState::RUN)
+        moveTowardsTarget(i);
+}
+
+void EnemyStore::think(int i, float dt)
+{
+    switch (type[i])
+    {
+    case EnemyType::GOBLIN:
+        EnemyKernel<EnemyType::GOBLIN>::think(*this, i, dt);
+        break;
+    case EnemyType::KNIGHT:
+        EnemyKernel<EnemyType::KNIGHT>::think(*this, i, dt);
+        break;
+    case EnemyType::MINOTAUR:
+        EnemyKernel<EnemyType::MINOTAUR>::think(*this, i, dt);
+        break;
+    }
+}
+
+void EnemyStore::onStrike(int i)
+{
+    switch (type[i])
+    {
+    case EnemyType::GOBLIN:
+        EnemyKernel<EnemyType::GOBLIN>::onStrike(*this, i);
+        break;
+    case EnemyType::KNIGHT:
+        EnemyKernel<EnemyType::KNIGHT>::onStrike(*this, i);
+        break;
+    case EnemyType::MINOTAUR:
+        EnemyKernel<EnemyType::MINOTAUR>::onStrike(*this, i);
+        break;
+    }
+}
+
+void EnemyStore::onPhaseEnd(int i, EnemyPhase endedPhase)
+{
+    switch (type[i])
+    {
+    case EnemyType::GOBLIN:
+        EnemyKernel<EnemyType::GOBLIN>::onPhaseEnd(*this, i, endedPhase);
+        break;
+    case EnemyType::KNIGHT:
+        EnemyKernel<EnemyType::KNIGHT>::onPhaseEnd(*this, i, endedPhase);
+        break;
+    case EnemyType::MINOTAUR:
+        EnemyKernel<EnemyType::MINOTAUR>::onPhaseEnd(*this, i, endedPhase);
+        break;
+    }
+}
+
+void EnemyStore::integrate(float dt)
+{
+    // 休眠者速度为0，只积分参与更新的敌人
+    for (int i : _awake)
+        integrateOne(i, dt);
+}
+
+void EnemyStore::integrateOne(int i, float dt)
+{
+    float nextX;
+    float nextZ;
+    if (_separationEnabled)
+    {
+        nextX = posX[i] + (velX[i] + _sepX[i]) * dt;
+        nextZ = posZ[i] + (velZ[i] + _sepZ[i]) * dt;
+    }
+    else
+    {
+        nextX = posX[i] + velX[i] * dt;
+        nextZ = posZ[i] + velZ[i] * dt;
+    }
+
+    // 撞墙时沿墙滑动（静止的敌人不查询）
+    if (_collision && (nextX != posX[i] || nextZ != posZ[i]))
+    {
+        Vec3 resolved = _collision->moveAndSlide(Vec3(posX[i], posY[i], posZ[i]), Vec3(nextX, posY[i], nextZ),
+            ENEMY_COLLISION_RADIUS, ENEMY_COLLISION_HEIGHT);
+        nextX = resolved.x;
+        nextZ = resolved.z;
+    }
+    posX[i] = nextX;
+    posZ[i] = nextZ;
+}
+
+//------------------------------
+// 存储维护
+//------------------------------
+
+void EnemyStore::moveSlot(int from, int to)
+{
+    type[to] = type[from];
+    state[to] = state[from];
+    phase[to] = phase[from];
+    posX[to] = posX[from];
+    posY[to] = posY[from];
+    posZ[to] = posZ[from];
+    prevX[to] = prevX[from];
+    prevZ[to] = prevZ[from];
+    velX[to] = velX[from];
+    velZ[to] = velZ[from];
+    yaw[to] = yaw[from];
+    hp[to] = hp[from];
+    maxHp[to] = maxHp[from];
+    attack[to] = attack[from];
+    speed[to] = speed[from];
+    attackRange[to] = attackRange[from];
+    attackCooldown[to] = attackCooldown[from];
+    detectionRange[to] = detectionRange[from];
+    attackTimer[to] = attackTimer[from];
+    strikeTimer[to] = strikeTimer[from];
+    strikeWindow[to] = strikeWindow[from];
+    strikeOpen[to] = strikeOpen[from];
+    strikeHit[to] = strikeHit[from];
+    phaseTimer[to] = phaseTimer[from];
+    targetDistanceSq[to] = targetDistanceSq[from];
+    targetYaw[to] = targetYaw[from];
+    inDetection[to] = inDetection[from];
+    inAttack[to] = inAttack[from];
+    lod[to] = lod[from];
+    lodDt[to] = lodDt[from];
+    anim[to] = anim[from];
+    animSerial[to] = animSerial[from];
+    proxy[to] = proxy[from];
+    entity[to] = entity[from];
+
+    if (proxy[to])
+        proxy[to]->bindStore(this, to);
+    else
+        EntityRegistry::getInstance()->setStoredEnemyIndex(entity[to], to);
+}
+
+void EnemyStore::popBack()
+{
+    type.pop_back();
+    state.pop_back();
+    phase.pop_back();
+    posX.pop_back();
+    posY.pop_back();
+    posZ.pop_back();
+    prevX.pop_back();
+    prevZ.pop_back();
+    velX.pop_back();
+    velZ.pop_back();
+    yaw.pop_back();
+    hp.pop_back();
+    maxHp.pop_back();
+    attack.pop_back();
+    speed.pop_back();
+    attackRange.pop_back();
+    attackCooldown.pop_back();
+    detectionRange.pop_back();
+    attackTimer.pop_back();
+    strikeTimer.pop_back();
+    strikeWindow.pop_back();
+    strikeOpen.pop_back();
+    strikeHit.pop_back();
+    phaseTimer.pop_back();
+    targetDistanceSq.pop_back();
+    targetYaw.pop_back();
+    inDetection.pop_back();
+    inAttack.pop_back();
+    lod.pop_back();
+    lodDt.pop_back();
+    anim.pop_back();
+    animSerial.pop_back();
+    proxy.pop_back();
+    entity.pop_back();
+}
@@ -0,0 +1,355 @@
+#pragma once
+#include "cocos2d.h"
+#include "EnemyState.h"
+#include "EnemyType.h"
+#include "EnemyArchetype.h"
+#include "EnemySeparation.h"
+#include "Core/EntityRegistry.h"
+#include "Core/AnimationClipCache.h"
+#include "Core/CombatEvent.h"
+#include <vector>
+
+class EnemyBase;
+class Player;
+class JobSystem;
+class FlowField;
+class CollisionWorld;
+class CombatEventQueue;
+struct HitWindow;
+
+// 定时阶段：替代原先挂在节点上的 Sequence/DelayTime 动作链
+enum class EnemyPhase : unsigned char
+{
+    NONE,
+    BACKSWING,   // 攻击后摇
+    HIT_STUN,    // 受击硬直
+    BLOCK_HOLD,  // 格挡持续
+    RETREAT      // 后退移动
+};
+
+// AI 细节层级：按到目标的距离决定思考频率
+enum class EnemyLod : unsigned char
+{
+    FULL,       // 近处或正在行动：每tick思考
+    REDUCED,    // 中距离待机：每 N 个tick思考一次，补上累计时间
+    SLEEPING    // 远处待机：不思考、不推进计时器，代理动画冻结，目标靠近时唤醒
+};
+
+// 决策与计时器的分派方式（默认逐个按类型分支；另两种只作对照基准）
+enum class EnemyDispatchMode : unsigned char
+{
+    SWITCH,     // 按下标顺序逐个敌人按类型分支，各分支内联该类型的内核
+    GROUPED,    // 每tick先按类型分组，每组运行该类型特化的内核（需额外一次计数排序）
+    VIRTUAL     // 逐个敌人经虚函数分派（数据仓库之前的做法）
+};
+
+// AI 思考预算统计（本帧计数在 beginThinkFrame 时清零，total 为累计）
+struct EnemyThinkStats
+{
+    int thinks = 0;                 // 本帧执行的思考次数
+    int deferred = 0;               // 本帧因预算用尽而推迟的思考次数
+    float usedUs = 0.0f;            // 本帧思考耗时（微秒）
+    bool overrun = false;           // 本帧超出预算（预算用尽后仍执行了保底思考）
+    unsigned int totalThinks = 0;
+    unsigned int totalDeferred = 0;
+    unsigned int overrunFrames = 0;
+};
+
+/**
+ * 敌人数据仓库（结构数组 SoA）
+ * 所有普通敌人的位置、速度、计时器、距离参数与状态字节按字段连续存放，
+ * 每个逻辑tick以紧凑循环完成感知->计时器->决策->积分；
+ * EnemyBase 节点只作为渲染代理，每个渲染帧同步一次位置/朝向/动画。
+ * 各类型的决策逻辑写在 EnemyKernel<类型> 中（头文件内联，无虚调用），更新循环按下标顺序遍历，
+ * 逐个按类型分支进入内联后的内核。按类型分组的循环只作分派基准的对照：
+ * 每个敌人的开销以分离与积分为主，分派本身占比很小，分组省下的分支抵不过每tick的排序。
+ */
+class EnemyStore
+{
+public:
+    EnemyStore();
+    ~EnemyStore();
+
+    /** 预留容量，避免批量生成时反复扩容 */
+    void reserve(int capacity);
+
+    /**
+     * 登记敌人：从代理节点读取类型、属性、初始位置与朝向
+     * @param proxy 渲染代理（由场景树持有）
+     * @return 数据下标
+     */
+    int add(EnemyBase* proxy);
+
+    /**
+     * 登记敌人并覆盖出生属性（波次/精英等变体）
+     * @param proxy 渲染代理
+     * @param stats 出生属性
+     * @return 数据下标
+     */
+    int add(EnemyBase* proxy, const EnemyStats& stats);
+
+    /**
+     * 登记无渲染代理的敌人（无头模拟、压力测试用）
+     * 由仓库在 EntityRegistry 中登记句柄（STORED_ENEMY），命中经战斗事件队列直接结算到仓库
+     * @param enemyType 敌人类型
+     * @param stats 出生属性
+     * @param position 初始位置
+     * @param initialYaw 初始朝向（角度）
+     * @return 数据下标
+     */
+    int spawn(EnemyType enemyType, const EnemyStats& stats, const cocos2d::Vec3& position, float initialYaw = 0.0f);
+
+    /** 获取某类型的出生属性（取自原型表，无需创建节点） */
+    static const EnemyStats& getDefaultStats(EnemyType enemyType);
+
+    /** 设置所有敌人的攻击目标（句柄，每tick开头查表解析一次） */
+    void setTarget(EntityHandle target) { _targetHandle = target; }
+    EntityHandle getTargetHandle() const { return _targetHandle; }
+    /** 本tick解析出的目标，句柄失效时为nullptr（只在tick内使用） */
+    Player* getTarget() const { return _target; }
+    /** 本tick开头记录的目标位置（并行阶段只读此快照） */
+    const cocos2d::Vec3& getTargetPosition() const { return _targetPos; }
+
+    /**
+     * 设置并行更新使用的任务调度器（为空或敌人较少时串行）
+     * 感知、计时器、决策与积分按块并行，每块只写自己负责的敌人；
+     * 对主角的命中先按块记录，再在主线程按下标顺序登记到战斗事件队列，结果与串行一致
+     * @param jobSystem 任务调度器
+     */
+    void setJobSystem(JobSystem* jobSystem) { _jobSystem = jobSystem; }
+
+    /**
+     * 设置战斗事件队列（由模拟驱动器持有），对主角的命中登记其中，tick结束时统一结算
+     * @param events 事件队列，为空时命中立即结算
+     */
+    void setCombatEvents(CombatEventQueue* events) { _combatEvents = events; }
+
+    /**
+     * 设置追击使用的流场（为空时直线逼近目标）
+     * 每tick按目标位置更新流场，追击中的敌人按所在格子取前进方向
+     * @param flowField 覆盖关卡可行走区域的流场（由场景持有）
+     */
+    void setFlowField(FlowField* flowField) { _flowField = flowField; }
+
+    /**
+     * 设置关卡静态碰撞（为空时不做墙体碰撞）
+     * 积分时每个移动中的敌人按胶囊扫掠并沿墙滑动；碰撞世界只读，可在并行积分中查询
+     * @param collision 关卡碰撞世界（由场景持有）
+     */
+    void setCollisionWorld(const CollisionWorld* collision) { _collision = collision; }
+
+    /** 启用/关闭 AI 细节层级（关闭时所有敌人每tick思考，用于对比） */
+    void setLodEnabled(bool enabled) { _lodEnabled = enabled; }
+    bool isLodEnabled() const { return _lodEnabled; }
+
+    /**
+     * 启用/关闭群体分离（默认启用）
+     * 参与更新的敌人按网格检查相邻格内的同伴，重叠时叠加推开速度，避免挤成一团
+     */
+    void setSeparationEnabled(bool enabled) { _separationEnabled = enabled; }
+    bool isSeparationEnabled() const { return _separationEnabled; }
+    /** 上一tick的分离统计 */
+    const EnemySeparationStats& getSeparationStats() const { return _separationStats; }
+
+    /**
+     * 设置决策与计时器的分派方式（默认逐个按类型分支）
+     * 各方式行为一致，只用于对比分组特化内核、类型分支与虚函数分派的开销
+     */
+    void setDispatchMode(EnemyDispatchMode mode) { _dispatchMode = mode; }
+    EnemyDispatchMode getDispatchMode() const { return _dispatchMode; }
+
+    /** 上一tick参与更新（未休眠）的存活敌人数 */
+    int getAwakeCount() const { return (int)_awake.size(); }
+    /** 上一tick休眠的敌人数 */
+    int getSleepingCount() const { return _sleepingCount; }
+
+    /**
+     * 设置每帧的思考预算
+     * 预算用尽后剩余敌人推迟到后续tick思考（轮转，从上次中断处继续），期间只做廉价的转向；
+     * 每tick保底思考一部分，保证每个敌人连续推迟不超过固定tick数，不会饿死
+     * @param microseconds 每帧预算（微秒），<=0 表示不限
+     */
+    void setThinkBudget(float microseconds) { _thinkBudgetUs = microseconds; }
+    float getThinkBudget() const { return _thinkBudgetUs; }
+
+    /** 每个渲染帧开头调用一次：重置本帧预算与计数 */
+    void beginThinkFrame();
+
+    const EnemyThinkStats& getThinkStats() const { return _thinkStats; }
+
+    /**
+     * 逻辑tick：感知->细节层级->计时器->决策->积分
+     * @param dt 固定步长
+     */
+    void tick(float dt);
+
+    /**
+     * 对敌人造成伤害（按类型分派受击逻辑）
+     * @param index 数据下标
+     * @param damage 伤害值
+     * @return 结算结果（已死亡或下标无效时为空结果）
+     */
+    HitResult applyDamage(int index, int damage);
+
+    /**
+     * 移除已死亡的敌人（交换删除：末尾的存活者填入空位，只移动死亡数量的槽位）
+     * 存活者的相对顺序会改变，代理节点的下标随之重新绑定
+     * 被移除的代理在解除绑定前同步一次最终渲染状态（死亡动画在此之前未播放时由此开始）
+     * @param outProxies 输出被移除的代理节点（先清空），由调用方处理
+     * @return 移除数量
+     */
+    int removeDead(std::vector<EnemyBase*>& outProxies);
+
+    /**
+     * 同步渲染代理（每个渲染帧一次）
+     * @param alpha 插值系数：上一tick与当前tick位置之间
+     */
+    void syncProxies(float alpha);
+
+    /** 清空所有数据（不处理代理节点） */
+    void clear();
+
+    int getCount() const { return (int)type.size(); }
+    bool isDead(int index) const { return state[index] == EnemyState::DEAD; }
+    cocos2d::Vec3 getPosition(int index) const { return cocos2d::Vec3(posX[index], posY[index], posZ[index]); }
+    EnemyBase* getProxy(int index) const { return proxy[index]; }  // 无头模拟中为nullptr
+    EntityHandle getEntityHandle(int index) const { return entity[index]; }
+
+    //------------------------------
+    // 供各类型逻辑调用的行为工具
+    //------------------------------
+    /** 切换状态（沿用原 changeState 规则：死亡锁定、格挡不被打断、同状态忽略） */
+    void setState(int i, EnemyState newState);
+    /** 强制切换状态（不受格挡锁定影响），并重播对应动画 */
+    void forceState(int i, EnemyState newState);
+    /** 只播放动画，不改变逻辑状态 */
+    void playAnimation(int i, EnemyState anim);
+    /** 面向目标 */
+    void faceTarget(int i);
+    /** 朝目标移动（XZ平面，速度在积分阶段生效） */
+    void moveTowardsTarget(int i);
+    /** 停止移动 */
+    void stop(int i) { velX[i] = 0.0f; velZ[i] = 0.0f; }
+    /**
+     * 开始攻击：重置冷却、切换攻击状态并安排命中判定
+     * 攻击片段有烘焙的命中窗口时，窗口打开期间每tick检测判定球，首次接触目标或窗口关闭时触发；
+     * 否则沿用前摇倒计时，到时按距离判定
+     * @param clip 攻击动画片段
+     * @param windup 无命中窗口时的前摇时间
+     */
+    void beginAttack(int i, ClipId clip, float windup);
+    /** 进入定时阶段，到时由类型逻辑处理 */
+    void startPhase(int i, EnemyPhase newPhase, float duration);
+    /** 取消未触发的命中判定与定时阶段 */
+    void cancelTimers(int i);
+    /** 对目标造成伤害（有命中窗口时以窗口内是否接触为准，否则距离在 range 内时，按平方比较） */
+    void strikeTarget(int i, float range, bool inclusive);
+
+    //------------------------------
+    // 字段数组（下标即敌人编号）
+    //------------------------------
+    // 类型与状态
+    std::vector<EnemyType> type;
+    std::vector<EnemyState> state;
+    std::vector<EnemyPhase> phase;
+    // 位置（prev 为上一tick，用于渲染插值）与速度
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> prevX, prevZ;
+    std::vector<float> velX, velZ;
+    std::vector<float> yaw;               // 朝向（角度）
+    // 属性
+    std::vector<int> hp;
+    std::vector<int> maxHp;
+    std::vector<int> attack;
+    std::vector<float> speed;
+    std::vector<float> attackRange;
+    std::vector<float> attackCooldown;
+    std::vector<float> detectionRange;
+    // 计时器
+    std::vector<float> attackTimer;       // 距上次攻击的时间
+    std::vector<float> strikeTimer;       // 命中判定倒计时（<=0 表示无；有命中窗口时为距窗口打开的时间）
+    std::vector<const HitWindow*> strikeWindow;  // 本次攻击的命中窗口（为空表示按前摇倒计时判定）
+    std::vector<float> strikeOpen;        // 命中窗口剩余打开时间（<=0 表示未打开）
+    std::vector<unsigned char> strikeHit;    // 本次攻击的判定球已接触目标
+    std::vector<float> phaseTimer;        // 定时阶段剩余时间
+    // 感知结果（每tick开头由批处理内核计算）
+    std::vector<float> targetDistanceSq;  // 到目标的距离平方
+    std::vector<float> targetYaw;         // 面向目标的朝向（角度）
+    std::vector<unsigned char> inDetection;  // 在警戒范围内
+    std::vector<unsigned char> inAttack;     // 在攻击起手范围内
+    // AI 细节层级
+    std::vector<EnemyLod> lod;
+    std::vector<float> lodDt;             // 降频/休眠/推迟期间未交给思考的累计时间
+    // 动画请求：代理据此判断是否需要重播
+    std::vector<EnemyState> anim;
+    std::vector<unsigned int> animSerial;
+    // 渲染代理（可为空）
+    std::vector<EnemyBase*> proxy;
+    // 实体句柄（有代理时即代理的句柄；无代理时由仓库登记，随下标移动更新、移除时注销）
+    std::vector<EntityHandle> entity;
+
+private:
+    void computeTargetDistances(bool parallel);
+    void updateLod(float dt);
+    void groupAwakeByType();
+    bool isQuiescent(int i) const;
+    void computeSeparation(bool parallel);
+    void updateAwake(float dt, bool budgeted, bool parallel);
+    int updateAwakeRange(int first, int last, float dt, bool budgeted);
+    template <typename Kernel>
+    int updateRange(const int* indices, int count, float dt, bool budgeted);
+    template <typename Kernel>
+    void updateTimers(int i, float dt);
+    bool strikeWindowTouches(int i) const;
+    void submitStrike(int i);
+    void runThinks(float dt);
+    void thinkNow(int i, float dt);
+    void steer(int i);
+    void think(int i, float dt);
+    void onStrike(int i);
+    void onPhaseEnd(int i, EnemyPhase endedPhase);
+    void integrate(float dt);
+    void integrateOne(int i, float dt);
+    int pushSlot(EnemyType enemyType, const EnemyStats& stats, const cocos2d::Vec3& position, float initialYaw);
+    void moveSlot(int from, int to);
+    void popBack();
+
+    struct SwitchDispatch;    // 逐个敌人按类型分支（对照基准）
+    struct VirtualDispatch;   // 逐个敌人经虚函数分派（对照基准）
+
+    EntityHandle _targetHandle;
+    Player* _target = nullptr;   // 由 _targetHandle 解析，仅在本tick内有效
+    cocos2d::Vec3 _targetPos;
+    FlowField* _flowField = nullptr;   // 追击寻路（场景持有）
+    const CollisionWorld* _collision = nullptr;   // 墙体碰撞（场景持有）
+    std::vector<int> _dying;   // 上次移除后死亡的下标（applyDamage 记录）
+    std::vector<int> _awake;   // 本tick需要更新的存活下标（updateLod 生成）
+    std::vector<int> _awakeGrouped;            // 同一批下标按类型分组（组内仍为升序，只在分组分派时生成）
+    int _groupBegin[ENEMY_TYPE_COUNT + 1] = {};   // 各类型在 _awakeGrouped 中的起点
+    EnemyDispatchMode _dispatchMode = EnemyDispatchMode::SWITCH;
+    int _sleepingCount = 0;
+    unsigned int _tickCount = 0;
+    bool _lodEnabled = true;
+
+    // 群体分离
+    EnemySeparation _separation;
+    std::vector<int> _crowd;       // 本tick参与分离的存活下标
+    std::vector<float> _sepX;      // 本tick的分离速度（按下标，只对 _awake 有效）
+    std::vector<float> _sepZ;
+    EnemySeparationStats _separationStats;
+    std::vector<EnemySeparationStats> _chunkSeparation;
+    bool _separationEnabled = true;
+
+    // 思考预算
+    std::vector<int> _due;     // 本tick应思考的下标（升序，runThinks 复用）
+    float _thinkBudgetUs = 0.0f;
+    int _thinkCursor = 0;      // 轮转起点：上次预算用尽时第一个被推迟的下标
+    EnemyThinkStats _thinkStats;
+
+    // 并行更新
+    JobSystem* _jobSystem = nullptr;
+    CombatEventQueue* _combatEvents = nullptr;   // 战斗事件队列（场景/模拟驱动器持有）
+    std::vector<std::vector<int>> _chunkStrikes;   // 每块记录的命中（下标）
+    std::vector<int> _chunkThinks;                 // 每块的思考次数
+    std::vector<int> _strikes;                     // 合并后的命中（按下标排序后登记）
+};
@@ -1,8 +1,11 @@
 #pragma once
 
-enum class EnemyType
+enum class EnemyType : unsigned char
 {
     GOBLIN,     // С
     MINOTAUR,  // ţͷ
     KNIGHT     // ֶʿ
-};
\ No newline at end of file
+};
+
+// ͷıԴΪȣ
+static constexpr int ENEMY_TYPE_COUNT = 3;
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+
+/**
+ * 堆分配计数(无头模拟替换了全局 operator new)
+ * 基准在测量区间前后各取一次，差值即区间内的分配次数
+ * @return 进程启动以来的累计分配次数
+ */
+unsigned long long getAllocationCount();
@@ -0,0 +1,1165 @@
+#include "HeadlessSimulation.h"
+#include "Core/JobSystem.h"
+#include "AllocationCounter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <map>
+
+USING_NS_CC;
+
+// 寺庙走廊范围（同 HelloWorld::setupEnvironment 中的走廊边界碰撞）
+static const float CORRIDOR_LIMIT_X = 400.0f;
+static const float CORRIDOR_START_Z = 200.0f;
+static const float CORRIDOR_END_Z = -2550.0f;
+static const float FLOW_FIELD_CELL_SIZE = 50.0f;   // 同 HelloWorld::FLOW_FIELD_CELL_SIZE
+static const float WALL_MIN_Y = -10000.0f;          // 走廊边界墙的高度范围（不可翻越）
+static const float WALL_MAX_Y = 10000.0f;
+static const float PLAYER_COLLISION_RADIUS = 25.0f;   // 同 Maria 的碰撞胶囊
+static const float PLAYER_COLLISION_HEIGHT = 150.0f;
+static const float BOSS_SPAWN_Z = CORRIDOR_END_Z + 300.0f;   // Boss出生在走廊尽头
+
+HeadlessSimulation::HeadlessSimulation()
+{
+}
+
+HeadlessSimulation::~HeadlessSimulation()
+{
+}
+
+bool HeadlessSimulation::init(const HeadlessConfig& config, const ScriptedInput& script)
+{
+    _config = config;
+    _input = script;
+    if (_input.isEmpty())
+        _input.parse(ScriptedInput::getDefaultScript());
+    _input.rewind();
+
+    _simulation.setTickRate(config.tickRate);
+    _simulation.resetStats();
+    _rngState = config.seed ? config.seed : 1;
+    _enemiesSpawned = 0;
+    _enemiesKilled = 0;
+    _frames = 0;
+    _awakeTotal = 0.0;
+    _sleepingTotal = 0.0;
+    _neighbourChecksTotal = 0.0;
+    _neighboursTotal = 0.0;
+    _maxThinks = 0;
+    _maxThinkUs = 0.0f;
+    _thinkUsTotal = 0.0;
+
+    _playerHits = 0;
+    _playerDamageTaken = 0;
+    _heldMove = Vec3::ZERO;
+    _heldRunning = false;
+    _simulation.getCombatEvents().clear();
+
+    _enemyStore.clear();
+    _enemyStore.reserve(config.enemyCount);
+    _enemyStore.setLodEnabled(config.aiLod);
+    _enemyStore.setSeparationEnabled(config.separation);
+    _enemyStore.setThinkBudget(config.thinkBudgetUs);
+    _enemyStore.setDispatchMode(config.dispatch);
+
+    // 主线程也参与执行，工作线程数为总线程数减一
+    JobSystem* jobSystem = nullptr;
+    if (config.threads > 1)
+    {
+        jobSystem = JobSystem::getInstance();
+        if (jobSystem->getWorkerCount() != config.threads - 1)
+            jobSystem->start(config.threads - 1);
+    }
+    _enemyStore.setJobSystem(jobSystem);
+
+    if (config.flowField)
+    {
+        _flowField.setBounds(-CORRIDOR_LIMIT_X, CORRIDOR_END_Z, CORRIDOR_LIMIT_X, CORRIDOR_START_Z, FLOW_FIELD_CELL_SIZE);
+        _enemyStore.setFlowField(&_flowField);
+    }
+    else
+    {
+        _flowField.clear();
+        _enemyStore.setFlowField(nullptr);
+    }
+
+    _collision.clear();
+    const CollisionWorld* collision = nullptr;
+    if (config.collision)
+    {
+        _collision.addBox(-CORRIDOR_LIMIT_X, CORRIDOR_END_Z, CORRIDOR_LIMIT_X, CORRIDOR_START_Z, WALL_MIN_Y, WALL_MAX_Y);
+        _collision.build();
+        collision = &_collision;
+    }
+    _enemyStore.setCollisionWorld(collision);
+
+    // 主角与Boss使用与场景相同的逻辑类，只是没有渲染代理(重新初始化时重建，旧句柄随之失效)
+    _player.reset(new MariaLogic());
+    _player->setPosition3D(Vec3(0.0f, 0.0f, 0.0f));
+    _player->init(nullptr, nullptr);
+    _player->setCombatGrid(&_combatGrid);
+    _player->setCollisionWorld(collision);
+    _player->setTimerWheel(&_simulation.getTimers());
+    _player->setTaskScheduler(&_simulation.getTasks());
+    _player->setCombatEvents(&_simulation.getCombatEvents());
+
+    _boss.reset();
+    if (config.boss)
+    {
+        _boss.reset(new BossLogic());
+        _boss->setPosition3D(Vec3(0.0f, 0.0f, BOSS_SPAWN_Z));
+        _boss->init(nullptr, nullptr);
+        _boss->setTarget(_player->getEntityHandle());
+        _boss->setCollisionWorld(collision);
+        _boss->setTimerWheel(&_simulation.getTimers());
+        _boss->setTaskScheduler(&_simulation.getTasks());
+        _boss->setCombatEvents(&_simulation.getCombatEvents());
+    }
+
+    _enemyStore.setTarget(_player->getEntityHandle());
+    _enemyStore.setCombatEvents(&_simulation.getCombatEvents());
+    spawnEnemies();
+    rebuildCombatGrid();
+    return true;
+}
+
+void HeadlessSimulation::spawnEnemies()
+{
+    static const EnemyType TYPES[3] = { EnemyType::GOBLIN, EnemyType::KNIGHT, EnemyType::MINOTAUR };
+
+    for (int i = 0; i < _config.enemyCount; ++i)
+    {
+        // xorshift32：与平台 rand() 无关，保证跨机器结果一致
+        _rngState ^= _rngState << 13;
+        _rngState ^= _rngState >> 17;
+        _rngState ^= _rngState << 5;
+        float u = (_rngState & 0xFFFF) / 65535.0f;
+        float v = (_rngState >> 16) / 65535.0f;
+
+        EnemyType type = TYPES[i % 3];
+        Vec3 position(-CORRIDOR_LIMIT_X + u * CORRIDOR_LIMIT_X * 2.0f, 0.0f, CORRIDOR_END_Z * v);
+        _enemyStore.spawn(type, EnemyStore::getDefaultStats(type), position);
+    }
+    _enemiesSpawned += _config.enemyCount;
+}
+
+/**
+ * 脚本方向(世界坐标XZ)换算为 Maria 的输入方向：相机偏航为0时 runMove 把 (x, z) 映射为世界方向 (-x, z)
+ */
+static Vec3 toInputDirection(const Vec3& world)
+{
+    return Vec3(-world.x, 0.0f, world.z);
+}
+
+void HeadlessSimulation::applyInput(float dt)
+{
+    _input.poll(dt, _pendingInput);
+    for (const auto& event : _pendingInput)
+    {
+        switch (event.command)
+        {
+        case ScriptedCommand::MOVE:
+            _heldMove = event.direction;
+            _heldRunning = event.isRunning;
+            break;
+        case ScriptedCommand::STOP:
+            _heldMove = Vec3::ZERO;
+            break;
+        case ScriptedCommand::ATTACK:
+            _player->runAttackCombo();
+            break;
+        case ScriptedCommand::DODGE:
+            _player->runDodge(toInputDirection(event.direction));
+            break;
+        case ScriptedCommand::SKILL:
+            _player->runSkillShadow();
+            break;
+        case ScriptedCommand::JUMP:
+            _player->runJump();
+            break;
+        case ScriptedCommand::CROUCH:
+            _player->toggleCrouch();
+            break;
+        case ScriptedCommand::BLOCK:
+            _player->startBlock();
+            break;
+        case ScriptedCommand::UNBLOCK:
+            _player->stopBlock();
+            break;
+        case ScriptedCommand::RECOVER:
+            _player->runRecover();
+            break;
+        default:
+            break;
+        }
+    }
+
+    // 移动为持续输入：同 PlayerInputController::processMovement，每tick按按住的方向移动或停止
+    if (_heldMove.lengthSquared() > 0.001f)
+        _player->runMove(toInputDirection(_heldMove), _heldRunning);
+    else
+        _player->stopMove();
+}
+
+void HeadlessSimulation::clampToCorridor(Vec3& position)
+{
+    position.x = std::max(-CORRIDOR_LIMIT_X, std::min(position.x, CORRIDOR_LIMIT_X));
+    position.z = std::max(CORRIDOR_END_Z, std::min(position.z, CORRIDOR_START_Z));
+}
+
+void HeadlessSimulation::tallyCombatEvents()
+{
+    // 上一次结算的事件：主角造成的命中与主角承受的伤害
+    const EntityHandle player = _player->getEntityHandle();
+    for (const CombatEvent& event : _simulation.getCombatEvents().getEvents())
+    {
+        if (event.source == player && event.type == CombatEventType::HIT)
+            _playerHits++;
+        if (event.target == player && (event.type == CombatEventType::HIT || event.type == CombatEventType::BLOCK))
+            _playerDamageTaken += event.amount;
+    }
+}
+
+void HeadlessSimulation::rebuildCombatGrid()
+{
+    // 同 HelloWorld::rebuildCombatGrid：只登记存活单位(无代理的敌人按句柄登记)
+    _combatGrid.clear();
+
+    const int enemyCount = _enemyStore.getCount();
+    for (int i = 0; i < enemyCount; ++i)
+    {
+        if (!_enemyStore.isDead(i))
+            _combatGrid.insert(_enemyStore.getEntityHandle(i), EntityKind::STORED_ENEMY, _enemyStore.getPosition(i));
+    }
+
+    if (_boss && !_boss->IsDead())
+        _combatGrid.insert(_boss->getEntityHandle(), EntityKind::BOSS, _boss->getPosition3D());
+}
+
+void HeadlessSimulation::tick(float dt)
+{
+    tallyCombatEvents();
+
+    // 与 HelloWorld::simulateTick 同序：输入 -> 主角 -> Boss -> 敌人 -> 重建战斗网格
+    // 主角死亡后不再接受输入(场景中此时游戏结束，这里敌人继续运行)
+    if (!_player->isDead())
+    {
+        applyInput(dt);
+        _player->update(dt);
+        if (!_config.collision)
+        {
+            Vec3 position = _player->getPosition3D();
+            clampToCorridor(position);
+            _player->setPosition3D(position);
+        }
+    }
+
+    if (_boss && !_boss->IsDead())
+    {
+        _boss->update(dt);
+        if (!_config.collision)
+        {
+            Vec3 position = _boss->getPosition3D();
+            clampToCorridor(position);
+            _boss->setPosition3D(position);
+        }
+    }
+
+    _enemiesKilled += _enemyStore.removeDead(_deadProxies);
+    if (_config.respawn && _enemyStore.getCount() == 0)
+        spawnEnemies();
+
+    _enemyStore.tick(dt);
+    rebuildCombatGrid();
+    _awakeTotal += _enemyStore.getAwakeCount();
+    _sleepingTotal += _enemyStore.getSleepingCount();
+    if (_config.separation)
+    {
+        _neighbourChecksTotal += (double)_enemyStore.getSeparationStats().candidates;
+        _neighboursTotal += (double)_enemyStore.getSeparationStats().neighbours;
+    }
+}
+
+void HeadlessSimulation::stepFrame()
+{
+    _enemyStore.beginThinkFrame();
+    _simulation.advance(_simulation.getTickInterval(), [this](float dt) { tick(dt); });
+    _frames++;
+
+    const EnemyThinkStats& thinkStats = _enemyStore.getThinkStats();
+    _maxThinks = std::max(_maxThinks, thinkStats.thinks);
+    _maxThinkUs = std::max(_maxThinkUs, thinkStats.usedUs);
+    _thinkUsTotal += thinkStats.usedUs;
+}
+
+HeadlessReport HeadlessSimulation::run()
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < _config.frameCount; ++frame)
+        stepFrame();
+    auto end = std::chrono::steady_clock::now();
+
+    // 最后一帧的死亡者与最后一次结算的事件也计入
+    _enemiesKilled += _enemyStore.removeDead(_deadProxies);
+    tallyCombatEvents();
+
+    const SimulationStats& stats = _simulation.getStats();
+    HeadlessReport report;
+    report.frames = _frames;
+    report.ticks = stats.tickCount;
+    report.simulatedSeconds = stats.tickCount * _simulation.getTickInterval();
+    report.wallSeconds = std::chrono::duration<double>(end - begin).count();
+    report.framesPerSecond = report.wallSeconds > 0.0 ? _frames / report.wallSeconds : 0.0;
+    report.avgTickCostUs = stats.avgTickCostUs;
+    report.maxTickCostUs = stats.maxTickCostUs;
+    report.enemiesSpawned = _enemiesSpawned;
+    report.enemiesKilled = _enemiesKilled;
+    report.enemiesAlive = _enemyStore.getCount();
+    if (stats.tickCount > 0)
+    {
+        report.avgAwakeEnemies = (float)(_awakeTotal / stats.tickCount);
+        report.avgSleepingEnemies = (float)(_sleepingTotal / stats.tickCount);
+        report.avgNeighbourChecks = (float)(_neighbourChecksTotal / stats.tickCount);
+        report.avgNeighbours = (float)(_neighboursTotal / stats.tickCount);
+    }
+    const EnemyThinkStats& thinkStats = _enemyStore.getThinkStats();
+    report.avgThinksPerFrame = _frames > 0 ? (float)thinkStats.totalThinks / _frames : 0.0f;
+    report.maxThinksPerFrame = _maxThinks;
+    report.maxThinkUs = _maxThinkUs;
+    report.avgThinkUs = _frames > 0 ? (float)(_thinkUsTotal / _frames) : 0.0f;
+    report.thinksDeferred = thinkStats.totalDeferred;
+    report.overrunFrames = thinkStats.overrunFrames;
+    report.playerHp = _player->getHP();
+    report.playerDamageTaken = _playerDamageTaken;
+    report.playerHits = _playerHits;
+    report.playerDead = _player->isDead();
+    report.bossSpawned = _boss != nullptr;
+    report.bossHp = _boss ? _boss->getCurrentBlood() : 0;
+    report.bossDead = _boss && _boss->IsDead();
+    const CombatEventQueue& events = _simulation.getCombatEvents();
+    for (int type = 0; type < 4; ++type)
+        report.combatEvents[type] = events.getTotalCount((CombatEventType)type);
+    report.checksum = computeChecksum();
+    return report;
+}
+
+MassKillReport HeadlessSimulation::benchmarkMassKill(int enemyCount, float killFraction, int rounds, unsigned int seed)
+{
+    MassKillReport report;
+    report.enemies = enemyCount;
+    report.rounds = rounds;
+
+    unsigned int rng = seed ? seed : 1;
+    auto next = [&rng]() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+
+    EnemyStore store;
+    std::vector<int> order(enemyCount);
+    std::vector<EnemyBase*> removed;
+    const EnemyStats& stats = EnemyStore::getDefaultStats(EnemyType::GOBLIN);
+    const int killCount = (int)(enemyCount * killFraction);
+
+    for (int round = 0; round < rounds; ++round)
+    {
+        store.clear();
+        store.reserve(enemyCount);
+        for (int i = 0; i < enemyCount; ++i)
+        {
+            Vec3 position((next() % 20000) - 10000.0f, 0.0f, (next() % 20000) - 10000.0f);
+            store.spawn(EnemyType::GOBLIN, stats, position);
+            order[i] = i;
+        }
+
+        // 随机挑选被击杀的敌人（部分洗牌）
+        for (int i = 0; i < killCount; ++i)
+            std::swap(order[i], order[i + next() % (enemyCount - i)]);
+
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < killCount; ++i)
+            store.applyDamage(order[i], stats.maxHp);
+        auto killed = std::chrono::steady_clock::now();
+        report.killed = store.removeDead(removed);
+        auto end = std::chrono::steady_clock::now();
+
+        double killUs = std::chrono::duration<double, std::micro>(killed - begin).count();
+        double removeUs = std::chrono::duration<double, std::micro>(end - killed).count();
+        report.avgKillUs += killUs / rounds;
+        report.avgRemoveUs += removeUs / rounds;
+        report.maxRemoveUs = std::max(report.maxRemoveUs, removeUs);
+    }
+    return report;
+}
+
+std::vector<ThreadScalingResult> HeadlessSimulation::benchmarkThreads(int enemyCount, int frameCount, int maxThreads, unsigned int seed)
+{
+    std::vector<ThreadScalingResult> results;
+    ScriptedInput script;
+
+    for (int threads = 1; threads <= maxThreads; ++threads)
+    {
+        HeadlessConfig config;
+        config.enemyCount = enemyCount;
+        config.frameCount = frameCount;
+        config.seed = seed;
+        config.aiLod = false;
+        config.threads = threads;
+
+        // 骑士格挡与Boss闪避判定使用 rand()：每次运行前复位为进程初始状态，与单独运行的结果一致
+        srand(1);
+
+        HeadlessSimulation simulation;
+        simulation.init(config, script);
+        HeadlessReport report = simulation.run();
+
+        ThreadScalingResult result;
+        result.threads = threads;
+        result.avgTickUs = report.avgTickCostUs;
+        result.speedup = results.empty() || result.avgTickUs <= 0.0 ? 1.0 : results[0].avgTickUs / result.avgTickUs;
+        result.checksum = report.checksum;
+        results.push_back(result);
+    }
+    JobSystem::getInstance()->stop();
+    return results;
+}
+
+std::vector<DispatchResult> HeadlessSimulation::benchmarkDispatch(int enemyCount, int frameCount, unsigned int seed)
+{
+    static const EnemyDispatchMode MODES[3] = { EnemyDispatchMode::VIRTUAL, EnemyDispatchMode::SWITCH, EnemyDispatchMode::GROUPED };
+    static const char* NAMES[3] = { "virtual", "switch", "grouped" };
+
+    std::vector<DispatchResult> results;
+    ScriptedInput script;
+
+    for (int m = 0; m < 3; ++m)
+    {
+        HeadlessConfig config;
+        config.enemyCount = enemyCount;
+        config.frameCount = frameCount;
+        config.seed = seed;
+        config.aiLod = false;
+        config.collision = false;   // 墙体扫掠在积分中占大头，关闭后只比较分派本身
+        config.dispatch = MODES[m];
+
+        srand(1);
+
+        HeadlessSimulation simulation;
+        simulation.init(config, script);
+        HeadlessReport report = simulation.run();
+
+        // 一帧一个tick（固定步长与帧间隔相同），每帧思考耗时即每tick的更新耗时
+        DispatchResult result;
+        result.name = NAMES[m];
+        result.avgUpdateUs = report.avgThinkUs;
+        result.avgTickUs = report.avgTickCostUs;
+        result.nsPerEnemy = enemyCount > 0 ? result.avgUpdateUs * 1000.0 / enemyCount : 0.0;
+        result.speedup = results.empty() || result.avgUpdateUs <= 0.0 ? 1.0 : results[0].avgUpdateUs / result.avgUpdateUs;
+        result.checksum = report.checksum;
+        results.push_back(result);
+    }
+    return results;
+}
+
+FlowFieldReport HeadlessSimulation::benchmarkFlowField(int followers, int ticks, unsigned int seed)
+{
+    FlowFieldReport report;
+    report.followers = followers;
+    report.ticks = ticks;
+
+    unsigned int rng = seed ? seed : 1;
+    auto next = [&rng]() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+
+    // 走廊内每隔300单位左右各一根柱子，迫使跟随者绕行
+    FlowField field;
+    field.setBounds(-CORRIDOR_LIMIT_X, CORRIDOR_END_Z, CORRIDOR_LIMIT_X, CORRIDOR_START_Z, FLOW_FIELD_CELL_SIZE);
+    for (float z = -300.0f; z > CORRIDOR_END_Z + 300.0f; z -= 300.0f)
+    {
+        field.blockArea(-250.0f, z - 40.0f, -150.0f, z + 40.0f);
+        field.blockArea(150.0f, z - 40.0f, 250.0f, z + 40.0f);
+    }
+    report.cells = field.getWidth() * field.getHeight();
+
+    std::vector<float> posX(followers);
+    std::vector<float> posZ(followers);
+    for (int i = 0; i < followers; ++i)
+    {
+        posX[i] = -CORRIDOR_LIMIT_X + (next() % 800);
+        posZ[i] = CORRIDOR_END_Z + (next() % 2750);
+    }
+
+    // 目标以奔跑速度在走廊中往返
+    const float dt = 1.0f / 60.0f;
+    const float goalSpeed = 250.0f;
+    const float followerSpeed = 120.0f;
+    Vec3 goal(0.0f, 0.0f, CORRIDOR_START_Z - 50.0f);
+    float goalDir = -1.0f;
+    double fieldUs = 0.0;
+    double rebuildUs = 0.0;
+    double sampleUs = 0.0;
+
+    for (int tick = 0; tick < ticks; ++tick)
+    {
+        goal.z += goalDir * goalSpeed * dt;
+        if (goal.z < CORRIDOR_END_Z + 50.0f || goal.z > CORRIDOR_START_Z - 50.0f)
+            goalDir = -goalDir;
+        goal.x = sinf(tick * 0.01f) * 300.0f;
+
+        auto begin = std::chrono::steady_clock::now();
+        bool rebuilt = field.setGoal(goal);
+        auto updated = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < followers; ++i)
+        {
+            float dirX = 0.0f;
+            float dirZ = 0.0f;
+            if (!field.sample(posX[i], posZ[i], dirX, dirZ))
+            {
+                float dx = goal.x - posX[i];
+                float dz = goal.z - posZ[i];
+                float length = sqrtf(dx * dx + dz * dz);
+                if (length < 1.0f)
+                    continue;
+                dirX = dx / length;
+                dirZ = dz / length;
+            }
+            posX[i] += dirX * followerSpeed * dt;
+            posZ[i] += dirZ * followerSpeed * dt;
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double updateUs = std::chrono::duration<double, std::micro>(updated - begin).count();
+        fieldUs += updateUs;
+        if (rebuilt)
+            rebuildUs += updateUs;
+        sampleUs += std::chrono::duration<double, std::micro>(end - updated).count();
+    }
+
+    report.rebuilds = field.getRebuildCount();
+    report.avgFieldUs = ticks > 0 ? fieldUs / ticks : 0.0;
+    report.avgRebuildUs = report.rebuilds > 0 ? rebuildUs / report.rebuilds : 0.0;
+    report.avgSampleUs = ticks > 0 ? sampleUs / ticks : 0.0;
+    report.nsPerFollower = followers > 0 ? report.avgSampleUs * 1000.0 / followers : 0.0;
+    return report;
+}
+
+SeparationReport HeadlessSimulation::benchmarkSeparation(int agents, int rounds, unsigned int seed)
+{
+    SeparationReport report;
+    report.agents = agents;
+    report.rounds = rounds;
+    report.bruteForcePairs = (double)agents * (agents - 1);
+
+    unsigned int rng = seed ? seed : 1;
+    auto next = [&rng]() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+
+    const float discRadius = sqrtf(agents * 1600.0f / 3.14159265f);
+    std::vector<float> posX(agents);
+    std::vector<float> posZ(agents);
+    std::vector<float> outX(agents);
+    std::vector<float> outZ(agents);
+    std::vector<int> indices(agents);
+    EnemySeparation separation;
+    EnemySeparationStats stats;
+
+    for (int round = 0; round < rounds; ++round)
+    {
+        for (int i = 0; i < agents; ++i)
+        {
+            // 圆盘内均匀分布
+            float radius = discRadius * sqrtf((next() & 0xFFFF) / 65535.0f);
+            float angle = (next() & 0xFFFF) / 65535.0f * 6.2831853f;
+            posX[i] = radius * cosf(angle);
+            posZ[i] = radius * sinf(angle);
+            indices[i] = i;
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        separation.build(posX.data(), posZ.data(), indices.data(), agents, 40.0f);
+        auto built = std::chrono::steady_clock::now();
+        separation.compute(0, agents, 60.0f, 60.0f, outX.data(), outZ.data(), stats);
+        auto end = std::chrono::steady_clock::now();
+
+        report.avgBuildUs += std::chrono::duration<double, std::micro>(built - begin).count() / rounds;
+        report.avgComputeUs += std::chrono::duration<double, std::micro>(end - built).count() / rounds;
+    }
+
+    report.cells = separation.getCellCount();
+    if (agents > 0 && rounds > 0)
+    {
+        report.candidatesPerAgent = (double)stats.candidates / ((double)agents * rounds);
+        report.neighboursPerAgent = (double)stats.neighbours / ((double)agents * rounds);
+    }
+    return report;
+}
+
+CollisionReport HeadlessSimulation::benchmarkCollision(int movers, int ticks, unsigned int seed)
+{
+    CollisionReport report;
+    report.movers = movers;
+    report.ticks = ticks;
+
+    unsigned int rng = seed ? seed : 1;
+    auto next = [&rng]() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+
+    // 走廊边界 + 每隔300单位左右各一根柱子(同流场基准)
+    CollisionWorld world;
+    world.addBox(-CORRIDOR_LIMIT_X, CORRIDOR_END_Z, CORRIDOR_LIMIT_X, CORRIDOR_START_Z, WALL_MIN_Y, WALL_MAX_Y);
+    for (float z = -300.0f; z > CORRIDOR_END_Z + 300.0f; z -= 300.0f)
+    {
+        world.addBox(-250.0f, z - 40.0f, -150.0f, z + 40.0f, -100.0f, 500.0f);
+        world.addBox(150.0f, z - 40.0f, 250.0f, z + 40.0f, -100.0f, 500.0f);
+    }
+    auto begin = std::chrono::steady_clock::now();
+    world.build();
+    auto built = std::chrono::steady_clock::now();
+    report.avgBuildUs = std::chrono::duration<double, std::micro>(built - begin).count();
+    report.segments = world.getSegmentCount();
+    report.nodes = world.getNodeCount();
+
+    // 移动者从走廊中线附近出发，每隔一段时间随机换方向
+    const float dt = 1.0f / 60.0f;
+    const float speed = 250.0f;
+    std::vector<Vec3> positions(movers);
+    std::vector<Vec3> velocities(movers);
+    for (int i = 0; i < movers; ++i)
+    {
+        positions[i] = Vec3(-100.0f + (next() % 200), 0.0f, CORRIDOR_END_Z + 50.0f + (next() % 2700));
+        if (fabsf(positions[i].x) < 20.0f)
+            positions[i].x = 0.0f;
+    }
+
+    CollisionQueryStats stats;
+    double totalUs = 0.0;
+    unsigned int moves = 0;
+    for (int tick = 0; tick < ticks; ++tick)
+    {
+        for (int i = 0; i < movers; ++i)
+        {
+            if ((tick + i) % 60 == 0)
+            {
+                float angle = (next() & 0xFFFF) / 65535.0f * 6.2831853f;
+                velocities[i] = Vec3(cosf(angle) * speed, 0.0f, sinf(angle) * speed);
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < movers; ++i)
+            positions[i] = world.moveAndSlide(positions[i], positions[i] + velocities[i] * dt, 20.0f, 100.0f, &stats);
+        auto end = std::chrono::steady_clock::now();
+        totalUs += std::chrono::duration<double, std::micro>(end - start).count();
+        moves += movers;
+    }
+
+    for (const Vec3& position : positions)
+    {
+        if (position.x < -CORRIDOR_LIMIT_X || position.x > CORRIDOR_LIMIT_X ||
+            position.z < CORRIDOR_END_Z || position.z > CORRIDOR_START_Z)
+            report.escaped++;
+    }
+
+    report.avgTickUs = ticks > 0 ? totalUs / ticks : 0.0;
+    report.nsPerQuery = moves > 0 ? totalUs * 1000.0 / moves : 0.0;
+    if (stats.queries > 0)
+    {
+        report.nodesPerQuery = (double)stats.nodesVisited / stats.queries;
+        report.segmentsPerQuery = (double)stats.segmentsTested / stats.queries;
+    }
+    return report;
+}
+
+std::vector<CameraReplayResult> HeadlessSimulation::replayCamera(int seconds, unsigned int seed)
+{
+    // 1. 录制主角路径（每tick一个位置，无敌人）
+    HeadlessConfig config;
+    config.enemyCount = 0;
+    config.frameCount = seconds * (int)config.tickRate;
+    config.seed = seed;
+    config.boss = false;
+    std::vector<Vec3> path;
+    {
+        ScriptedInput script;
+        HeadlessSimulation simulation;
+        simulation.init(config, script);
+        path.push_back(simulation.getPlayer().getPosition3D());
+        for (int frame = 0; frame < config.frameCount; ++frame)
+        {
+            simulation.stepFrame();
+            path.push_back(simulation.getPlayer().getPosition3D());
+        }
+    }
+
+    // 走廊边界 + 两排柱子（同碰撞基准）
+    CollisionWorld world;
+    world.addBox(-CORRIDOR_LIMIT_X, CORRIDOR_END_Z, CORRIDOR_LIMIT_X, CORRIDOR_START_Z, WALL_MIN_Y, WALL_MAX_Y);
+    for (float z = -300.0f; z > CORRIDOR_END_Z + 300.0f; z -= 300.0f)
+    {
+        world.addBox(-250.0f, z - 40.0f, -150.0f, z + 40.0f, -100.0f, 500.0f);
+        world.addBox(150.0f, z - 40.0f, 250.0f, z + 40.0f, -100.0f, 500.0f);
+    }
+    world.build();
+
+    // 录制时主角只受走廊边界约束，再让路径经过柱子碰撞，得到主角实际能走出的路径
+    const std::vector<Vec3> recorded = path;
+    for (size_t k = 1; k < path.size(); ++k)
+    {
+        Vec3 step = recorded[k] - recorded[k - 1];
+        path[k] = world.moveAndSlide(path[k - 1], path[k - 1] + step, PLAYER_COLLISION_RADIUS, PLAYER_COLLISION_HEIGHT);
+    }
+
+    // 2. 按帧间隔序列回放，帧间隔为 pattern 循环
+    struct Playback
+    {
+        const char* name;
+        float intervals[2];
+    };
+    static const Playback PLAYBACKS[] = {
+        { "144 Hz", { 1.0f / 144.0f, 1.0f / 144.0f } },
+        { "60 Hz", { 1.0f / 60.0f, 1.0f / 60.0f } },
+        { "30 Hz", { 1.0f / 30.0f, 1.0f / 30.0f } },
+        { "uneven 45/90 Hz", { 1.0f / 45.0f, 1.0f / 90.0f } },
+        { "144 Hz (repeat)", { 1.0f / 144.0f, 1.0f / 144.0f } },
+    };
+    const float JITTER_STEP = 0.01f;   // 小于该位移(单位/帧)的往返不计为抖动
+    const double duration = seconds;
+    const float tickRate = config.tickRate;
+
+    std::vector<CameraReplayResult> results;
+    std::vector<Vec3> reference;   // 参考帧率在整秒时刻的跟随点
+
+    for (const Playback& playback : PLAYBACKS)
+    {
+        CameraReplayResult result;
+        result.name = playback.name;
+
+        CameraSpringArm arm;
+        arm.setArmLength(250.0f);
+        arm.setCollisionWorld(&world);
+
+        std::vector<Vec3> samples;
+        Vec3 prevPos;
+        Vec3 prevStep;
+        bool prevReversed = false;
+        int history = 0;
+        double time = 0.0;
+        int nextSecond = 1;
+        result.minLength = arm.getArmLength();
+        unsigned int hash = 2166136261u;
+
+        for (int frame = 0; time < duration; ++frame)
+        {
+            // 跨越整秒的帧截断到整秒，保证各帧率都在同一时刻采样
+            float dt = playback.intervals[frame & 1];
+            if (time + dt > nextSecond - 1e-6)
+                dt = (float)(nextSecond - time);
+            time += dt;
+
+            // 路径按tick线性插值；偏航角往复摆动
+            double tick = std::min(time * tickRate, (double)(path.size() - 1));
+            int index = std::min((int)tick, (int)path.size() - 2);
+            float alpha = (float)(tick - index);
+            Vec3 target = path[index] + (path[index + 1] - path[index]) * alpha;
+            float yaw = CC_DEGREES_TO_RADIANS(180.0f + 70.0f * sinf((float)time * 0.5f));
+            float pitch = CC_DEGREES_TO_RADIANS(25.0f);
+            Vec3 direction(sinf(yaw) * cosf(pitch), sinf(pitch), cosf(yaw) * cosf(pitch));
+
+            auto begin = std::chrono::steady_clock::now();
+            arm.update(target, direction, dt);
+            auto end = std::chrono::steady_clock::now();
+            double us = std::chrono::duration<double, std::micro>(end - begin).count();
+            result.avgUpdateUs += us;
+            result.maxUpdateUs = std::max(result.maxUpdateUs, us);
+            result.frames++;
+
+            const Vec3& position = arm.getCameraPosition();
+            if (arm.getCurrentLength() < arm.getArmLength() - 0.01f)
+                result.occludedFrames++;
+            result.minLength = std::min(result.minLength, arm.getCurrentLength());
+
+            // 抖动：位移连续两帧反向(来-回-来)，且每步都不是微小位移
+            if (history >= 1)
+            {
+                Vec3 step = position - prevPos;
+                bool reversed = history >= 2 && step.dot(prevStep) < 0.0f &&
+                    step.length() > JITTER_STEP && prevStep.length() > JITTER_STEP;
+                if (reversed && prevReversed)
+                    result.jitterFrames++;
+                prevReversed = reversed;
+                prevStep = step;
+            }
+            prevPos = position;
+            history++;
+
+            if (time >= nextSecond - 1e-6)
+            {
+                samples.push_back(arm.getPivot());
+                nextSecond++;
+            }
+            const float coords[3] = { position.x, position.y, position.z };
+            for (int k = 0; k < 3; ++k)
+            {
+                const unsigned char* bytes = (const unsigned char*)&coords[k];
+                for (size_t b = 0; b < sizeof(float); ++b)
+                {
+                    hash ^= bytes[b];
+                    hash *= 16777619u;
+                }
+            }
+        }
+
+        if (reference.empty())
+            reference = samples;
+        for (size_t k = 0; k < samples.size() && k < reference.size(); ++k)
+            result.maxDeviation = std::max(result.maxDeviation, samples[k].distance(reference[k]));
+
+        const CollisionQueryStats& stats = arm.getQueryStats();
+        result.avgUpdateUs = result.frames > 0 ? result.avgUpdateUs / result.frames : 0.0;
+        result.cacheRefreshes = arm.getCacheRefreshCount();
+        result.segmentsPerCast = stats.queries > 0 ? (double)stats.segmentsTested / stats.queries : 0.0;
+        result.checksum = hash;
+        results.push_back(result);
+    }
+    return results;
+}
+
+// 基准中作为所属实体登记的占位角色(只需能登记句柄，不参与战斗)
+struct BenchOwner : public Player
+{
+    HitResult takeDamage(int) override { return HitResult::none(); }
+    Vec3 getPosition3D() const override { return Vec3::ZERO; }
+    void attackEnemy(EnemyBase*) override {}
+};
+
+// 定时器基准的共享状态
+struct TimerBenchContext
+{
+    TimerWheel* wheel = nullptr;
+    std::vector<EntityHandle> owners;
+    unsigned int rng = 1;
+    unsigned long long fired = 0;
+
+    // 1~600 tick(最长10秒，跨第0层与第1层)
+    uint32_t nextDelay()
+    {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return 1 + rng % 600;
+    }
+};
+
+// 到期后计数并以新的延迟重新登记自己(模拟连续的动作结束回调)
+struct TimerBenchCallback
+{
+    TimerBenchContext* context;
+    int owner;
+
+    void operator()() const
+    {
+        context->fired++;
+        context->wheel->scheduleTicks(context->owners[owner], context->nextDelay(), *this);
+    }
+};
+
+TimerReport HeadlessSimulation::benchmarkTimers(int timers, int owners, int ticks, unsigned int seed)
+{
+    TimerReport report;
+    report.timers = timers;
+    report.owners = owners;
+    report.ticks = ticks;
+    if (timers <= 0 || owners <= 0)
+        return report;
+
+    const int INTERRUPTS_PER_TICK = 2;   // 每tick被打断(受击/死亡)的实体数
+    const int WARMUP_TICKS = 600;
+
+    // 所属实体在注册表中登记(触发时按句柄校验)
+    auto registry = EntityRegistry::getInstance();
+    std::vector<BenchOwner> actors(owners);
+    TimerWheel wheel;
+    TimerBenchContext context;
+    context.wheel = &wheel;
+    context.rng = seed ? seed : 1;
+    for (auto& actor : actors)
+        context.owners.push_back(registry->createPlayer(&actor));
+
+    // 1. 登记(槽位预分配)
+    wheel.reserve(timers);
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < timers; ++i)
+    {
+        TimerBenchCallback callback = { &context, i % owners };
+        wheel.scheduleTicks(context.owners[i % owners], context.nextDelay(), callback);
+    }
+    auto end = std::chrono::steady_clock::now();
+    report.nsPerSchedule = std::chrono::duration<double, std::nano>(end - begin).count() / timers;
+
+    // 2. 推进：到期重新登记，每tick打断几个实体后按原数量重新登记
+    double cancelNs = 0.0;
+    unsigned long long cancelled = 0;
+    double tickUs = 0.0;
+    unsigned long long firedBefore = 0;
+    unsigned long long allocationsBefore = 0;
+    unsigned int growsBefore = 0;
+    for (int tick = 0; tick < WARMUP_TICKS + ticks; ++tick)
+    {
+        if (tick == WARMUP_TICKS)
+        {
+            firedBefore = context.fired;
+            allocationsBefore = getAllocationCount();
+            growsBefore = wheel.getGrowCount();
+            cancelNs = 0.0;
+            cancelled = 0;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < INTERRUPTS_PER_TICK; ++i)
+        {
+            int owner = (int)(context.nextDelay() * 7919u % (uint32_t)owners);
+            auto cancelStart = std::chrono::steady_clock::now();
+            int count = wheel.cancelOwner(context.owners[owner]);
+            auto cancelEnd = std::chrono::steady_clock::now();
+            cancelNs += std::chrono::duration<double, std::nano>(cancelEnd - cancelStart).count();
+            cancelled += count;
+
+            TimerBenchCallback callback = { &context, owner };
+            for (int j = 0; j < count; ++j)
+                wheel.scheduleTicks(context.owners[owner], context.nextDelay(), callback);
+        }
+        wheel.advance();
+        auto finish = std::chrono::steady_clock::now();
+        if (tick >= WARMUP_TICKS)
+            tickUs += std::chrono::duration<double, std::micro>(finish - start).count();
+    }
+    report.avgTickUs = ticks > 0 ? tickUs / ticks : 0.0;
+    report.nsPerCancel = cancelled > 0 ? cancelNs / cancelled : 0.0;
+    report.firedPerTick = ticks > 0 ? (double)(context.fired - firedBefore) / ticks : 0.0;
+    report.cancelledPerTick = ticks > 0 ? (double)cancelled / ticks : 0.0;
+    report.allocationsPerTick = ticks > 0 ? (double)(getAllocationCount() - allocationsBefore) / ticks : 0.0;
+    report.grows = wheel.getGrowCount() - growsBefore;
+
+    for (EntityHandle handle : context.owners)
+        registry->destroy(handle);
+
+    // 3. 对照：按到期tick排序的 std::multimap，回调存 std::function(捕获同样的内容)
+    std::multimap<uint64_t, std::function<void()>> queue;
+    uint64_t now = 0;
+    std::function<void(int)> scheduleBaseline = [&](int owner) {
+        queue.emplace(now + context.nextDelay(), [&context, &scheduleBaseline, owner]() {
+            context.fired++;
+            scheduleBaseline(owner);
+        });
+    };
+    for (int i = 0; i < timers; ++i)
+        scheduleBaseline(i % owners);
+
+    double baselineUs = 0.0;
+    unsigned long long baselineAllocations = 0;
+    for (int tick = 0; tick < WARMUP_TICKS + ticks; ++tick)
+    {
+        unsigned long long allocationsStart = getAllocationCount();
+        auto start = std::chrono::steady_clock::now();
+        now++;
+        while (!queue.empty() && queue.begin()->first <= now)
+        {
+            std::function<void()> callback = std::move(queue.begin()->second);
+            queue.erase(queue.begin());
+            callback();
+        }
+        auto finish = std::chrono::steady_clock::now();
+        if (tick >= WARMUP_TICKS)
+        {
+            baselineUs += std::chrono::duration<double, std::micro>(finish - start).count();
+            baselineAllocations += getAllocationCount() - allocationsStart;
+        }
+    }
+    report.baselineTickUs = ticks > 0 ? baselineUs / ticks : 0.0;
+    report.baselineAllocationsPerTick = ticks > 0 ? (double)baselineAllocations / ticks : 0.0;
+    return report;
+}
+
+unsigned int HeadlessSimulation::computeChecksum() const
+{
+    // FNV-1a：覆盖敌人位置、血量、状态与主角、Boss的位置、血量
+    unsigned int hash = 2166136261u;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 16777619u;
+        }
+    };
+
+    const int count = _enemyStore.getCount();
+    for (int i = 0; i < count; ++i)
+    {
+        mix(&_enemyStore.posX[i], sizeof(float));
+        mix(&_enemyStore.posZ[i], sizeof(float));
+        mix(&_enemyStore.hp[i], sizeof(int));
+        mix(&_enemyStore.state[i], sizeof(EnemyState));
+    }
+
+    Vec3 position = _player->getPosition3D();
+    int hp = _player->getHP();
+    mix(&position.x, sizeof(float));
+    mix(&position.z, sizeof(float));
+    mix(&hp, sizeof(int));
+
+    if (_boss)
+    {
+        Vec3 bossPosition = _boss->getPosition3D();
+        int bossHp = _boss->getCurrentBlood();
+        mix(&bossPosition.x, sizeof(float));
+        mix(&bossPosition.z, sizeof(float));
+        mix(&bossHp, sizeof(int));
+    }
+    return hash;
+}
+
+// 脚本任务基准中的角色(任务内存池内嵌在角色中)
+struct TaskBenchActor
+{
+    BenchOwner player;
+    TaskArena arena;
+    EntityHandle handle;
+    uint32_t windup = 1;        // 本次攻击的前摇tick数
+    bool attacking = false;
+    unsigned long long attacks = 0;
+};
+
+// 攻击时间线：前摇 → 等到偶数tick(模拟等待动画标记/条件) → 后摇
+struct BenchAttackTask : public GameplayTask
+{
+    TaskBenchActor* actor;
+
+    explicit BenchAttackTask(TaskBenchActor* owner) : actor(owner) {}
+
+    bool resume() override
+    {
+        TASK_BEGIN();
+        TASK_AWAIT_TICKS(actor->windup);
+        TASK_AWAIT_UNTIL(getCurrentTick() % 2 == 0);
+        TASK_AWAIT_SECONDS(0.25f);
+        actor->attacks++;
+        actor->attacking = false;
+        TASK_END();
+    }
+};
+
+TaskReport HeadlessSimulation::benchmarkTasks(int actors, int ticks, unsigned int seed)
+{
+    TaskReport report;
+    report.actors = actors;
+    report.ticks = ticks;
+    if (actors <= 0)
+        return report;
+
+    unsigned int rng = seed ? seed : 1;
+    auto next = [&rng]() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+
+    const int INTERRUPTS_PER_TICK = 5;   // 每tick被打断(受击)的角色数
+    const int WARMUP_TICKS = 120;
+
+    auto registry = EntityRegistry::getInstance();
+    std::vector<TaskBenchActor> cast(actors);
+    for (auto& actor : cast)
+        actor.handle = registry->createPlayer(&actor.player);
+
+    TaskScheduler scheduler;
+    scheduler.reserve(actors);
+
+    double startNs = 0.0;
+    double tickUs = 0.0;
+    unsigned long long starts = 0;
+    unsigned long long cancelled = 0;
+    unsigned long long resumesBefore = 0;
+    unsigned long long attacksBefore = 0;
+    unsigned long long allocationsBefore = 0;
+    unsigned int rejectedBefore = 0;
+    for (int tick = 0; tick < WARMUP_TICKS + ticks; ++tick)
+    {
+        if (tick == WARMUP_TICKS)
+        {
+            startNs = 0.0;
+            starts = 0;
+            cancelled = 0;
+            resumesBefore = scheduler.getResumeCount();
+            rejectedBefore = scheduler.getRejectedCount();
+            allocationsBefore = getAllocationCount();
+            attacksBefore = 0;
+            for (const auto& actor : cast)
+                attacksBefore += actor.attacks;
+        }
+
+        // 打断：取消任务后按空闲处理
+        for (int i = 0; i < INTERRUPTS_PER_TICK; ++i)
+        {
+            TaskBenchActor& actor = cast[next() % actors];
+            cancelled += scheduler.cancelOwner(actor.handle);
+            actor.attacking = false;
+        }
+
+        // 空闲的角色开始下一次攻击
+        auto begin = std::chrono::steady_clock::now();
+        for (auto& actor : cast)
+        {
+            if (actor.attacking)
+                continue;
+            actor.windup = 10 + next() % 20;
+            actor.attacking = scheduler.start<BenchAttackTask>(actor.arena, actor.handle, &actor) != nullptr;
+            starts++;
+        }
+        auto started = std::chrono::steady_clock::now();
+        scheduler.advance();
+        auto end = std::chrono::steady_clock::now();
+
+        if (tick >= WARMUP_TICKS)
+        {
+            startNs += std::chrono::duration<double, std::nano>(started - begin).count();
+            tickUs += std::chrono::duration<double, std::micro>(end - started).count();
+        }
+    }
+
+    unsigned long long attacks = 0;
+    for (const auto& actor : cast)
+        attacks += actor.attacks;
+
+    report.nsPerStart = starts > 0 ? startNs / starts : 0.0;
+    report.avgTickUs = ticks > 0 ? tickUs / ticks : 0.0;
+    report.resumesPerTick = ticks > 0 ? (double)(scheduler.getResumeCount() - resumesBefore) / ticks : 0.0;
+    report.startsPerTick = ticks > 0 ? (double)starts / ticks : 0.0;
+    report.cancelledPerTick = ticks > 0 ? (double)cancelled / ticks : 0.0;
+    report.allocationsPerTick = ticks > 0 ? (double)(getAllocationCount() - allocationsBefore) / ticks : 0.0;
+    report.rejected = scheduler.getRejectedCount() - rejectedBefore;
+    report.attacks = attacks - attacksBefore;
+
+    scheduler.clear();
+    for (const auto& actor : cast)
+        registry->destroy(actor.handle);
+    return report;
+}
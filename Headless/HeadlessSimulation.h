@@ -0,0 +1,332 @@
+#pragma once
+#include "cocos2d.h"
+#include "Core/SimulationDriver.h"
+#include "Core/FlowField.h"
+#include "Core/CollisionWorld.h"
+#include "Core/CameraSpringArm.h"
+#include "Core/CombatantGrid.h"
+#include "Enemy/EnemyStore.h"
+#include "Enemy/Boss/BossLogic.h"
+#include "Player/MariaLogic.h"
+#include "ScriptedInput.h"
+#include <memory>
+#include <vector>
+
+// 无头模拟配置
+struct HeadlessConfig
+{
+    int enemyCount = 1000;        // 敌人数量（地精/骑士/牛头人轮流生成）
+    int frameCount = 60000;       // 模拟帧数
+    float tickRate = 60.0f;       // 逻辑频率
+    unsigned int seed = 1;        // 出生位置随机种子
+    bool respawn = false;         // 敌人全灭后重新生成（长时间压测）
+    bool aiLod = true;            // 启用 AI 细节层级（远处待机的敌人降频/休眠）
+    float thinkBudgetUs = 0.0f;   // 每帧思考预算（微秒，<=0 不限；按真实耗时裁剪，启用后结果不再可复现）
+    bool separation = true;       // 敌人之间的群体分离
+    bool flowField = true;        // 追击使用走廊流场（同 HelloWorld；关闭时直线逼近）
+    bool collision = true;        // 主角、Boss与敌人按走廊墙体做扫掠碰撞（关闭时主角与Boss按走廊范围截断）
+    bool boss = true;             // 在走廊尽头生成Boss（以主角为目标）
+    int threads = 1;              // 敌人更新使用的线程数（含主线程，1 为串行；结果与线程数无关）
+    EnemyDispatchMode dispatch = EnemyDispatchMode::SWITCH;   // 敌人决策/计时器的分派方式（结果与分派方式无关）
+};
+
+// 无头模拟结果
+struct HeadlessReport
+{
+    int frames = 0;
+    unsigned int ticks = 0;
+    float simulatedSeconds = 0.0f;
+    double wallSeconds = 0.0;
+    double framesPerSecond = 0.0;
+    float avgTickCostUs = 0.0f;
+    float maxTickCostUs = 0.0f;
+    int enemiesSpawned = 0;
+    int enemiesKilled = 0;
+    int enemiesAlive = 0;
+    float avgAwakeEnemies = 0.0f;     // 每tick参与更新的敌人数（平均）
+    float avgSleepingEnemies = 0.0f;  // 每tick休眠的敌人数（平均）
+    float avgNeighbourChecks = 0.0f;  // 每tick分离检查的候选对数（平均）
+    float avgNeighbours = 0.0f;       // 每tick分离半径内的邻居对数（平均）
+    float avgThinksPerFrame = 0.0f;   // 每帧思考次数（平均）
+    int maxThinksPerFrame = 0;
+    float maxThinkUs = 0.0f;          // 单帧思考耗时峰值（微秒）
+    float avgThinkUs = 0.0f;          // 每帧思考耗时（平均，不限预算时含计时器与积分）
+    unsigned int thinksDeferred = 0;  // 因预算推迟的思考次数
+    unsigned int overrunFrames = 0;   // 超出预算的帧数
+    int playerHp = 0;
+    int playerDamageTaken = 0;
+    int playerHits = 0;
+    bool playerDead = false;
+    bool bossSpawned = false;
+    int bossHp = 0;
+    bool bossDead = false;
+    unsigned long long combatEvents[4] = {};   // 按 CombatEventType 累计的战斗事件数
+    unsigned int checksum = 0;    // 终态校验和：同配置同脚本的两次运行必须一致
+};
+
+// 批量死亡基准结果
+struct MassKillReport
+{
+    int enemies = 0;
+    int killed = 0;
+    int rounds = 0;
+    double avgKillUs = 0.0;      // 伤害结算（含死亡登记）平均耗时
+    double avgRemoveUs = 0.0;    // removeDead 平均耗时
+    double maxRemoveUs = 0.0;
+};
+
+// 线程扩展基准的单项结果
+struct ThreadScalingResult
+{
+    int threads = 0;
+    double avgTickUs = 0.0;      // 敌人更新平均每tick耗时
+    double speedup = 0.0;        // 相对单线程的加速比
+    unsigned int checksum = 0;   // 各线程数的终态校验和必须一致
+};
+
+// 分派基准的单项结果
+struct DispatchResult
+{
+    const char* name = "";
+    double avgUpdateUs = 0.0;    // 敌人计时器/决策/积分平均每tick耗时
+    double avgTickUs = 0.0;      // 敌人更新平均每tick耗时（含感知、LOD、分离）
+    double nsPerEnemy = 0.0;     // 每个敌人每tick的计时器/决策/积分耗时
+    double speedup = 0.0;        // 相对虚函数分派的加速比（按 avgUpdateUs）
+    unsigned int checksum = 0;   // 各分派方式的终态校验和必须一致
+};
+
+// 流场基准结果
+struct FlowFieldReport
+{
+    int followers = 0;
+    int ticks = 0;
+    int cells = 0;
+    unsigned int rebuilds = 0;
+    double avgFieldUs = 0.0;     // 每tick更新目标(含换格重建)的平均耗时
+    double avgRebuildUs = 0.0;   // 单次重建平均耗时
+    double avgSampleUs = 0.0;    // 每tick全部跟随者采样+移动的平均耗时
+    double nsPerFollower = 0.0;
+};
+
+// 群体分离基准结果
+struct SeparationReport
+{
+    int agents = 0;
+    int rounds = 0;
+    int cells = 0;
+    double avgBuildUs = 0.0;        // 建网格平均耗时
+    double avgComputeUs = 0.0;      // 计算分离速度平均耗时
+    double candidatesPerAgent = 0.0;
+    double neighboursPerAgent = 0.0;
+    double bruteForcePairs = 0.0;   // 两两检查需要的对数（对比）
+};
+
+// 碰撞查询基准结果
+struct CollisionReport
+{
+    int movers = 0;
+    int ticks = 0;
+    int segments = 0;
+    int nodes = 0;
+    double avgBuildUs = 0.0;        // 建层次包围盒耗时
+    double avgTickUs = 0.0;         // 每tick全部移动者 moveAndSlide 的平均耗时
+    double nsPerQuery = 0.0;        // 每次 moveAndSlide 的平均耗时
+    double nodesPerQuery = 0.0;     // 每次扫掠访问的节点数
+    double segmentsPerQuery = 0.0;  // 每次扫掠精确检测的墙段数
+    int escaped = 0;                // 结束时跑出走廊的移动者数（应为0）
+};
+
+// 定时器基准结果
+struct TimerReport
+{
+    int timers = 0;                 // 等待中的定时器数
+    int owners = 0;                 // 所属实体数
+    int ticks = 0;
+    double nsPerSchedule = 0.0;     // 登记一个定时器的平均耗时
+    double nsPerCancel = 0.0;       // cancelOwner 平均每个定时器的耗时
+    double avgTickUs = 0.0;         // 每tick推进(含触发回调与重新登记)的平均耗时
+    double firedPerTick = 0.0;
+    double cancelledPerTick = 0.0;
+    double allocationsPerTick = 0.0;   // 测量区间内每tick的堆分配次数(应为0)
+    unsigned int grows = 0;         // 测量区间内槽位扩容次数(应为0)
+    double baselineTickUs = 0.0;        // 对照：std::multimap + std::function 的每tick耗时
+    double baselineAllocationsPerTick = 0.0;
+};
+
+// 脚本任务基准结果
+struct TaskReport
+{
+    int actors = 0;
+    int ticks = 0;
+    double nsPerStart = 0.0;        // 启动一个任务(含执行到第一个挂起点)的平均耗时
+    double avgTickUs = 0.0;         // 每tick推进调度器的平均耗时
+    double resumesPerTick = 0.0;
+    double startsPerTick = 0.0;
+    double cancelledPerTick = 0.0;
+    double allocationsPerTick = 0.0;   // 测量区间内每tick的堆分配次数(应为0)
+    unsigned int rejected = 0;      // 内存池已满而未能启动的次数(应为0)
+    unsigned long long attacks = 0; // 完整走完的攻击时间线数
+};
+
+// 相机回放的单项结果（一种帧率）
+struct CameraReplayResult
+{
+    const char* name = "";
+    int frames = 0;
+    double avgUpdateUs = 0.0;       // 弹簧臂每帧平均耗时
+    double maxUpdateUs = 0.0;
+    int jitterFrames = 0;           // 位移连续两帧反向的帧数（来回抖动）
+    int occludedFrames = 0;         // 臂长被遮挡缩短的帧数
+    float minLength = 0.0f;         // 最短臂长
+    unsigned int cacheRefreshes = 0;
+    double segmentsPerCast = 0.0;   // 每次扫掠检测的候选墙段数
+    float maxDeviation = 0.0f;      // 整秒时刻与首项（参考帧率）的跟随点最大偏差
+    unsigned int checksum = 0;      // 相机轨迹校验和
+};
+
+/**
+ * 无头模拟
+ * 与 HelloWorld 使用同一套固定步长驱动与敌人数据仓库，但不创建 Director/GLView/场景节点：
+ * 敌人只登记数据（无渲染代理），主角与Boss直接运行 MariaLogic/BossLogic（无表现接口，不加载动画片段，
+ * 动作按兜底时长推进），攻击经战斗网格查询并通过战斗事件队列结算，输入来自脚本流。
+ * 每一帧按固定步长推进，因此结果只取决于配置、种子与脚本，可用于回归比对与性能剖析。
+ */
+class HeadlessSimulation
+{
+public:
+    HeadlessSimulation();
+    ~HeadlessSimulation();
+
+    /**
+     * 初始化：生成敌人、放置主角
+     * @param config 模拟配置
+     * @param script 脚本输入（为空时使用内置默认脚本）
+     */
+    bool init(const HeadlessConfig& config, const ScriptedInput& script);
+
+    /** 推进一帧（一个固定步长） */
+    void stepFrame();
+
+    /** 运行全部帧并生成报告 */
+    HeadlessReport run();
+
+    /** 计算当前状态的校验和 */
+    unsigned int computeChecksum() const;
+
+    /**
+     * 批量死亡基准：同一帧内击杀一部分敌人并移除
+     * @param enemyCount 敌人数量
+     * @param killFraction 同一帧击杀的比例
+     * @param rounds 重复轮数(每轮重新生成)
+     * @param seed 随机种子
+     */
+    static MassKillReport benchmarkMassKill(int enemyCount, float killFraction, int rounds, unsigned int seed);
+
+    /**
+     * 线程扩展基准：同一场景分别以 1..maxThreads 个线程运行（关闭LOD，全部敌人参与更新）
+     * @param enemyCount 敌人数量
+     * @param frameCount 每次运行的帧数
+     * @param maxThreads 最大线程数
+     * @param seed 随机种子
+     */
+    static std::vector<ThreadScalingResult> benchmarkThreads(int enemyCount, int frameCount, int maxThreads, unsigned int seed);
+
+    /**
+     * 分派基准：同一混合类型场景（三种敌人轮流生成）分别以虚函数分派、逐个类型分支、
+     * 按类型分组的特化内核运行（单线程、关闭LOD与墙体碰撞，全部敌人每tick更新）
+     * @param enemyCount 敌人数量
+     * @param frameCount 每次运行的帧数
+     * @param seed 随机种子
+     */
+    static std::vector<DispatchResult> benchmarkDispatch(int enemyCount, int frameCount, unsigned int seed);
+
+    /**
+     * 流场基准：目标沿走廊移动，跟随者每tick采样流场前进(走廊内加入两排柱子)
+     * @param followers 跟随者数量
+     * @param ticks tick数
+     * @param seed 随机种子
+     */
+    static FlowFieldReport benchmarkFlowField(int followers, int ticks, unsigned int seed);
+
+    /**
+     * 群体分离基准：敌人随机分布在圆盘内(平均每个敌人占 40x40 的面积)，建网格并计算分离速度
+     * @param agents 敌人数量
+     * @param rounds 重复轮数(每轮重新分布)
+     * @param seed 随机种子
+     */
+    static SeparationReport benchmarkSeparation(int agents, int rounds, unsigned int seed);
+
+    /**
+     * 碰撞查询基准：走廊边界加两排柱子(每根柱子一个盒子)，移动者随机游走并沿墙滑动
+     * @param movers 移动者数量
+     * @param ticks tick数
+     * @param seed 随机种子
+     */
+    static CollisionReport benchmarkCollision(int movers, int ticks, unsigned int seed);
+
+    /**
+     * 相机回放测试：先用脚本输入录制主角路径，再以不同帧率(含不均匀帧间隔)回放给弹簧臂，
+     * 偏航角往复摆动使相机扫过柱子；首项为参考帧率，末项以参考帧率重复运行以检查可复现
+     * @param seconds 录制时长(秒)
+     * @param seed 随机种子
+     */
+    static std::vector<CameraReplayResult> replayCamera(int seconds, unsigned int seed);
+
+    /**
+     * 定时器基准：大量等待中的定时器分属一批实体，到期后立即重新登记；
+     * 每tick打断几个实体(cancelOwner 后重新登记同样数量)，并与 std::multimap + std::function 对照
+     * @param timers 定时器数量
+     * @param owners 所属实体数量
+     * @param ticks 测量的tick数
+     * @param seed 随机种子
+     */
+    static TimerReport benchmarkTimers(int timers, int owners, int ticks, unsigned int seed);
+
+    /**
+     * 脚本任务基准：每个角色循环运行攻击时间线(前摇tick → 等待条件 → 后摇秒数)，
+     * 结束后立即开始下一次；每tick打断几个角色(cancelOwner 后重新开始)
+     * @param actors 角色数量
+     * @param ticks 测量的tick数
+     * @param seed 随机种子
+     */
+    static TaskReport benchmarkTasks(int actors, int ticks, unsigned int seed);
+
+    const EnemyStore& getEnemyStore() const { return _enemyStore; }
+    const MariaLogic& getPlayer() const { return *_player; }
+
+private:
+    void spawnEnemies();
+    void applyInput(float dt);
+    void clampToCorridor(cocos2d::Vec3& position);
+    void tallyCombatEvents();
+    void rebuildCombatGrid();
+    void tick(float dt);
+
+    HeadlessConfig _config;
+    SimulationDriver _simulation;
+    EnemyStore _enemyStore;
+    std::unique_ptr<MariaLogic> _player;       // 主角逻辑（init 时重建，换发新句柄）
+    std::unique_ptr<BossLogic> _boss;          // Boss逻辑（config.boss 关闭时为空）
+    CombatantGrid _combatGrid;                 // 主角攻击判定用的战斗单位网格
+    FlowField _flowField;                      // 走廊追击流场
+    CollisionWorld _collision;                 // 走廊墙体碰撞
+    ScriptedInput _input;
+    cocos2d::Vec3 _heldMove;                   // 按住的移动方向（世界XZ，为零表示松开）
+    bool _heldRunning = false;
+    std::vector<ScriptedEvent> _pendingInput;  // 复用的输入缓冲
+    std::vector<EnemyBase*> _deadProxies;      // 无代理，仅满足接口
+
+    unsigned int _rngState = 1;
+    int _enemiesSpawned = 0;
+    int _enemiesKilled = 0;
+    int _playerHits = 0;           // 主角造成的命中（来自战斗事件）
+    int _playerDamageTaken = 0;    // 主角承受的伤害（来自战斗事件）
+    int _frames = 0;
+    double _awakeTotal = 0.0;      // 逐tick累计，用于报告平均值
+    double _sleepingTotal = 0.0;
+    double _neighbourChecksTotal = 0.0;
+    double _neighboursTotal = 0.0;
+    int _maxThinks = 0;
+    float _maxThinkUs = 0.0f;
+    double _thinkUsTotal = 0.0;
+};
@@ -0,0 +1,44 @@
+#include "HitWindowManifest.h"
+#include "Enemy/EnemyArchetype.h"
+
+namespace
+{
+    HitWindowBakeSpec makeSpec(const char* modelPath, const char* clipName, float scale, float radius)
+    {
+        HitWindowBakeSpec spec;
+        spec.modelPath = modelPath;
+        spec.clipName = clipName;
+        spec.scale = scale;
+        spec.radius = radius;
+        return spec;
+    }
+
+    HitWindowBakeSpec makeEnemySpec(EnemyType type)
+    {
+        const EnemyArchetype& archetype = EnemyArchetypes::get(type);
+        return makeSpec(archetype.modelPath, archetype.clips[(int)EnemyClip::ATTACK], archetype.modelScale, archetype.hitRadius);
+    }
+}
+
+std::vector<HitWindowBakeSpec> getHitWindowManifest()
+{
+    // 出招骨骼留空：取片段中峰值速度最大的骨骼(挥剑的手、踢腿的脚)
+    return {
+        // 玩家(模型缩放0.4)：三段连招与影子技能
+        makeSpec("Maria.c3b", "Armature|slash_1", 0.4f, 60.0f),
+        makeSpec("Maria.c3b", "Armature|slash_4", 0.4f, 60.0f),
+        makeSpec("Maria.c3b", "Armature|slash_2", 0.4f, 60.0f),
+        makeSpec("Maria.c3b", "Armature|slide_attack", 0.4f, 60.0f),
+        makeSpec("Maria.c3b", "Armature|right_kick", 0.4f, 60.0f),
+        makeSpec("Maria.c3b", "Armature|highSpinAttack", 0.4f, 60.0f),
+        makeSpec("Maria.c3b", "Armature|left_kick", 0.4f, 60.0f),
+        // 小怪(模型、缩放与判定球半径取自敌人原型表)
+        makeEnemySpec(EnemyType::GOBLIN),
+        makeEnemySpec(EnemyType::KNIGHT),
+        makeEnemySpec(EnemyType::MINOTAUR),
+        // Boss
+        makeSpec("Mutant/Mutant.c3b", "Armature|maw_punch", 1.0f, 90.0f),
+        makeSpec("Mutant/Mutant.c3b", "Armature|maw_swipe", 1.0f, 90.0f),
+        makeSpec("Mutant/Mutant.c3b", "Armature|maw_jumpAttack_2", 1.0f, 110.0f),
+    };
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include "Core/HitWindowBaker.h"
+#include <vector>
+
+/**
+ * 需要烘焙命中窗口的攻击片段清单(--bake-hit-windows 使用)
+ * 模型路径、片段名与各角色 preloadAnimations 中登记的一致；缩放为游戏内模型节点的缩放
+ */
+std::vector<HitWindowBakeSpec> getHitWindowManifest();
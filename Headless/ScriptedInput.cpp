@@ -0,0 +1,160 @@
+#include "ScriptedInput.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+USING_NS_CC;
+
+bool ScriptedInput::parse(const std::string& text)
+{
+    _events.clear();
+    rewind();
+
+    bool ok = true;
+    std::istringstream stream(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(stream, line))
+    {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+
+        std::istringstream fields(line);
+        ScriptedEvent event;
+        std::string name;
+        if (!(fields >> event.time))
+            continue;  // 空行
+        fields >> name;
+
+        if (name == "move")
+        {
+            float dx = 0.0f, dz = 0.0f;
+            std::string mode;
+            if (!(fields >> dx >> dz))
+            {
+                CCLOGERROR("ScriptedInput: line %d: move needs dx dz", lineNumber);
+                ok = false;
+                continue;
+            }
+            fields >> mode;
+            event.command = ScriptedCommand::MOVE;
+            event.direction = Vec3(dx, 0.0f, dz);
+            if (event.direction.lengthSquared() > 0.0f)
+                event.direction.normalize();
+            event.isRunning = (mode == "run");
+        }
+        else if (name == "dodge")
+        {
+            float dx = 0.0f, dz = 0.0f;
+            if (fields >> dx && !(fields >> dz))
+            {
+                CCLOGERROR("ScriptedInput: line %d: dodge needs dx dz or no direction", lineNumber);
+                ok = false;
+                continue;
+            }
+            event.command = ScriptedCommand::DODGE;
+            event.direction = Vec3(dx, 0.0f, dz);
+            if (event.direction.lengthSquared() > 0.0f)
+                event.direction.normalize();
+        }
+        else if (name == "stop")
+            event.command = ScriptedCommand::STOP;
+        else if (name == "attack")
+            event.command = ScriptedCommand::ATTACK;
+        else if (name == "skill")
+            event.command = ScriptedCommand::SKILL;
+        else if (name == "jump")
+            event.command = ScriptedCommand::JUMP;
+        else if (name == "crouch")
+            event.command = ScriptedCommand::CROUCH;
+        else if (name == "block")
+            event.command = ScriptedCommand::BLOCK;
+        else if (name == "unblock")
+            event.command = ScriptedCommand::UNBLOCK;
+        else if (name == "recover")
+            event.command = ScriptedCommand::RECOVER;
+        else if (name == "loop")
+            event.command = ScriptedCommand::LOOP;
+        else
+        {
+            CCLOGERROR("ScriptedInput: line %d: unknown command '%s'", lineNumber, name.c_str());
+            ok = false;
+            continue;
+        }
+        _events.push_back(event);
+    }
+
+    // 同一时间的指令保持书写顺序
+    std::stable_sort(_events.begin(), _events.end(),
+        [](const ScriptedEvent& a, const ScriptedEvent& b) { return a.time < b.time; });
+    return ok;
+}
+
+bool ScriptedInput::loadFile(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        CCLOGERROR("ScriptedInput: cannot open %s", path.c_str());
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return parse(buffer.str());
+}
+
+const char* ScriptedInput::getDefaultScript()
+{
+    return
+        "0.0 move 0 -1 run\n"
+        "0.8 attack\n"
+        "1.2 attack\n"
+        "1.6 attack\n"
+        "2.2 move 1 0\n"
+        "2.6 dodge 1 0\n"
+        "3.0 attack\n"
+        "3.4 attack\n"
+        "4.0 move 0 1 run\n"
+        "4.8 attack\n"
+        "5.6 move -1 0\n"
+        "6.4 attack\n"
+        "6.8 stop\n"
+        "6.8 block\n"
+        "7.6 unblock\n"
+        "8.0 skill\n"
+        "11.0 recover\n"
+        "12.0 loop\n";
+}
+
+int ScriptedInput::poll(float dt, std::vector<ScriptedEvent>& out)
+{
+    out.clear();
+    if (_events.empty())
+        return 0;
+
+    _clock += dt;
+    while (_cursor < _events.size() && _events[_cursor].time <= _clock)
+    {
+        const ScriptedEvent& event = _events[_cursor++];
+        if (event.command == ScriptedCommand::LOOP)
+        {
+            // 超出的时间带入下一轮
+            _clock -= event.time;
+            _cursor = 0;
+            if (event.time <= 0.0f)
+                break;  // 防止零时长循环卡死
+            continue;
+        }
+        out.push_back(event);
+    }
+    return (int)out.size();
+}
+
+void ScriptedInput::rewind()
+{
+    _cursor = 0;
+    _clock = 0.0f;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "cocos2d.h"
+#include <string>
+#include <vector>
+
+// 脚本输入指令类型
+enum class ScriptedCommand : unsigned char
+{
+    MOVE,    // 移动(持续到下一条 move/stop)：move dx dz [run]
+    STOP,    // 停止移动：stop
+    ATTACK,  // 攻击连招：attack
+    DODGE,   // 闪避(省略方向为后闪避)：dodge [dx dz]
+    SKILL,   // 幻影技能：skill
+    JUMP,    // 跳跃：jump
+    CROUCH,  // 切换下蹲：crouch
+    BLOCK,   // 开始格挡：block
+    UNBLOCK, // 结束格挡：unblock
+    RECOVER, // 使用恢复：recover
+    LOOP     // 脚本时钟回到0重新执行：loop
+};
+
+// 一条脚本输入
+struct ScriptedEvent
+{
+    float time = 0.0f;
+    ScriptedCommand command = ScriptedCommand::STOP;
+    cocos2d::Vec3 direction;   // MOVE/DODGE 的世界方向(XZ平面，已标准化；DODGE 可为零)
+    bool isRunning = false;    // MOVE 是否奔跑
+};
+
+/**
+ * 脚本输入流
+ * 代替键鼠输入驱动无头模拟，每行一条指令："时间(秒) 指令 参数"，
+ * # 开头为注释；指令按时间排序后依次触发。示例：
+ *   0.0 move 0 -1 run
+ *   1.2 attack
+ *   1.6 dodge 1 0
+ *   2.0 stop
+ *   4.0 loop
+ */
+class ScriptedInput
+{
+public:
+    /**
+     * 从文本解析脚本
+     * @param text 脚本内容
+     * @return 全部行解析成功返回true（错误行会被跳过并记录日志）
+     */
+    bool parse(const std::string& text);
+
+    /**
+     * 从文件加载脚本
+     * @param path 脚本文件路径
+     */
+    bool loadFile(const std::string& path);
+
+    /** 内置默认脚本：绕圈奔跑并持续攻击，穿插闪避、格挡、技能与恢复 */
+    static const char* getDefaultScript();
+
+    /**
+     * 推进脚本时钟并取出到期的指令
+     * @param dt 步长
+     * @param out 输出到期指令(先清空，调用方复用以避免分配)
+     * @return 指令数量
+     */
+    int poll(float dt, std::vector<ScriptedEvent>& out);
+
+    /** 回到脚本开头 */
+    void rewind();
+
+    bool isEmpty() const { return _events.empty(); }
+    int getEventCount() const { return (int)_events.size(); }
+
+private:
+    std::vector<ScriptedEvent> _events;
+    size_t _cursor = 0;
+    float _clock = 0.0f;
+};
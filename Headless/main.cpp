@@ -0,0 +1,318 @@
+/**
+ * 无头模拟入口
+ * 不创建 Director/GLView，可在无显示环境的 CI 机器上运行平衡性与性能回归：
+ *   HeadlessSim --enemies 2000 --frames 60000 --script input.txt --seed 7
+ * 输出各项统计与终态校验和，同参数两次运行的校验和必须一致。
+ */
+#include "HeadlessSimulation.h"
+#include "Enemy/EnemySenseKernel.h"
+#include "Core/JobSystem.h"
+#include "Core/HitWindowTable.h"
+#include "HitWindowManifest.h"
+#include <thread>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void printUsage(const char* program)
+{
+    printf("usage: %s [--enemies N] [--frames N] [--tick-rate HZ] [--seed N] [--script FILE] [--respawn] [--no-lod] [--think-budget US] [--threads N] [--no-flow-field] [--no-separation] [--no-collision] [--no-boss]\n", program);
+    printf("       %s --bench-kill [--enemies N] [--fraction F] [--seed N]\n", program);
+    printf("       %s --bench-separation [--seed N]\n", program);
+    printf("       %s --bench-flow [--frames N] [--seed N]\n", program);
+    printf("       %s --bench-collision [--frames N] [--seed N]\n", program);
+    printf("       %s --test-camera [--seed N]\n", program);
+    printf("       %s --bench-timers [--frames N] [--seed N]\n", program);
+    printf("       %s --bench-tasks [--enemies N] [--frames N] [--seed N]\n", program);
+    printf("       %s --bench-threads [--enemies N] [--frames N] [--threads N] [--seed N]\n", program);
+    printf("       %s --bench-dispatch [--enemies N] [--frames N] [--seed N]\n", program);
+    printf("       %s --bake-hit-windows FILE [--asset-root DIR]\n", program);
+}
+
+int main(int argc, char** argv)
+{
+    HeadlessConfig config;
+    ScriptedInput script;
+    bool benchKill = false;
+    bool benchThreads = false;
+    bool benchDispatch = false;
+    bool benchFlow = false;
+    bool benchSeparation = false;
+    bool benchCollision = false;
+    bool testCamera = false;
+    bool benchTimers = false;
+    bool benchTasks = false;
+    bool enemiesGiven = false;
+    bool framesGiven = false;
+    bool threadsGiven = false;
+    float killFraction = 0.1f;
+    const char* bakeOutput = nullptr;
+    const char* assetRoot = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--enemies") == 0 && value)
+        {
+            config.enemyCount = atoi(argv[++i]);
+            enemiesGiven = true;
+        }
+        else if (strcmp(arg, "--frames") == 0 && value)
+        {
+            config.frameCount = atoi(argv[++i]);
+            framesGiven = true;
+        }
+        else if (strcmp(arg, "--tick-rate") == 0 && value)
+            config.tickRate = (float)atof(argv[++i]);
+        else if (strcmp(arg, "--seed") == 0 && value)
+            config.seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(arg, "--script") == 0 && value)
+        {
+            if (!script.loadFile(argv[++i]))
+                return 1;
+        }
+        else if (strcmp(arg, "--respawn") == 0)
+            config.respawn = true;
+        else if (strcmp(arg, "--no-lod") == 0)
+            config.aiLod = false;
+        else if (strcmp(arg, "--think-budget") == 0 && value)
+            config.thinkBudgetUs = (float)atof(argv[++i]);
+        else if (strcmp(arg, "--threads") == 0 && value)
+        {
+            config.threads = atoi(argv[++i]);
+            threadsGiven = true;
+        }
+        else if (strcmp(arg, "--no-flow-field") == 0)
+            config.flowField = false;
+        else if (strcmp(arg, "--no-separation") == 0)
+            config.separation = false;
+        else if (strcmp(arg, "--no-collision") == 0)
+            config.collision = false;
+        else if (strcmp(arg, "--no-boss") == 0)
+            config.boss = false;
+        else if (strcmp(arg, "--bench-collision") == 0)
+            benchCollision = true;
+        else if (strcmp(arg, "--test-camera") == 0)
+            testCamera = true;
+        else if (strcmp(arg, "--bench-timers") == 0)
+            benchTimers = true;
+        else if (strcmp(arg, "--bench-tasks") == 0)
+            benchTasks = true;
+        else if (strcmp(arg, "--bench-separation") == 0)
+            benchSeparation = true;
+        else if (strcmp(arg, "--bench-flow") == 0)
+            benchFlow = true;
+        else if (strcmp(arg, "--bench-threads") == 0)
+            benchThreads = true;
+        else if (strcmp(arg, "--bench-dispatch") == 0)
+            benchDispatch = true;
+        else if (strcmp(arg, "--bake-hit-windows") == 0 && value)
+            bakeOutput = argv[++i];
+        else if (strcmp(arg, "--asset-root") == 0 && value)
+            assetRoot = argv[++i];
+        else if (strcmp(arg, "--bench-kill") == 0)
+            benchKill = true;
+        else if (strcmp(arg, "--fraction") == 0 && value)
+            killFraction = (float)atof(argv[++i]);
+        else
+        {
+            printUsage(argv[0]);
+            return strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    // 命中窗口烘焙：读入清单中各攻击片段的骨骼动画，写出游戏加载的二进制表
+    if (bakeOutput)
+    {
+        if (assetRoot)
+            cocos2d::FileUtils::getInstance()->addSearchPath(assetRoot);
+        const auto manifest = getHitWindowManifest();
+        auto table = HitWindowTable::getInstance();
+        table->clear();
+        int baked = HitWindowBaker::bake(manifest, table);
+        bool saved = table->save(bakeOutput);
+        printf("hit windows      : %d of %d clips baked -> %s%s\n", baked, (int)manifest.size(), bakeOutput,
+            saved ? "" : " (write failed)");
+        HitWindowTable::destroyInstance();
+        return saved && baked == (int)manifest.size() ? 0 : 1;
+    }
+
+    // 批量死亡基准：默认 1 万敌人，同一帧击杀 10%
+    if (benchKill)
+    {
+        int enemies = enemiesGiven ? config.enemyCount : 10000;
+        MassKillReport bench = HeadlessSimulation::benchmarkMassKill(enemies, killFraction, 50, config.seed);
+        printf("mass kill        : %d of %d enemies in one frame, %d rounds\n", bench.killed, bench.enemies, bench.rounds);
+        printf("damage + death   : avg %.1f us\n", bench.avgKillUs);
+        printf("removeDead       : avg %.1f us, max %.1f us\n", bench.avgRemoveUs, bench.maxRemoveUs);
+        return 0;
+    }
+
+    // 群体分离基准：1千/5千/2万个敌人，对比两两检查的对数
+    if (benchSeparation)
+    {
+        printf("separation       : %s\n", EnemySeparation::getInstructionSet());
+        const int AGENTS[3] = { 1000, 5000, 20000 };
+        for (int agents : AGENTS)
+        {
+            SeparationReport bench = HeadlessSimulation::benchmarkSeparation(agents, 50, config.seed);
+            printf("  %5d agents   : build %.1f us, compute %.1f us, %d cells\n", bench.agents, bench.avgBuildUs, bench.avgComputeUs, bench.cells);
+            printf("                   checks %.1f/agent (%.0f total vs %.0f brute force), neighbours %.2f/agent\n",
+                bench.candidatesPerAgent, bench.candidatesPerAgent * bench.agents, bench.bruteForcePairs, bench.neighboursPerAgent);
+        }
+        return 0;
+    }
+
+    // 流场基准：同一场景分别以 10 与 1 万个跟随者运行，流场开销应与跟随者数量无关
+    if (benchFlow)
+    {
+        int ticks = framesGiven ? config.frameCount : 3600;
+        const int FOLLOWERS[2] = { 10, 10000 };
+        for (int followers : FOLLOWERS)
+        {
+            FlowFieldReport bench = HeadlessSimulation::benchmarkFlowField(followers, ticks, config.seed);
+            printf("flow field       : %d followers, %d ticks, %d cells, %u rebuilds\n", bench.followers, bench.ticks, bench.cells, bench.rebuilds);
+            printf("  field update   : avg %.2f us/tick, rebuild avg %.1f us\n", bench.avgFieldUs, bench.avgRebuildUs);
+            printf("  follow         : avg %.1f us/tick, %.1f ns/follower\n", bench.avgSampleUs, bench.nsPerFollower);
+        }
+        return 0;
+    }
+
+    // 碰撞查询基准：1千与1万个移动者，每次查询访问的节点/墙段数应与移动者数量无关
+    if (benchCollision)
+    {
+        int ticks = framesGiven ? config.frameCount : 600;
+        const int MOVERS[2] = { 1000, 10000 };
+        for (int movers : MOVERS)
+        {
+            CollisionReport bench = HeadlessSimulation::benchmarkCollision(movers, ticks, config.seed);
+            printf("collision        : %d movers, %d ticks, %d segments, %d nodes, build %.1f us\n",
+                bench.movers, bench.ticks, bench.segments, bench.nodes, bench.avgBuildUs);
+            printf("  move and slide : avg %.1f us/tick, %.1f ns/query\n", bench.avgTickUs, bench.nsPerQuery);
+            printf("  per sweep      : %.1f nodes, %.1f segments, escaped %d\n", bench.nodesPerQuery, bench.segmentsPerQuery, bench.escaped);
+        }
+        return 0;
+    }
+
+    // 相机回放测试：同一条录制路径在各帧率下不抖动、整秒时刻位置一致，重复运行结果相同
+    if (testCamera)
+    {
+        const float MAX_DEVIATION = 4.0f;   // 跟随点与参考帧率的允许偏差（世界单位；30Hz 下目标按帧采样约差3）
+        auto results = HeadlessSimulation::replayCamera(30, config.seed);
+        bool passed = true;
+        for (const auto& result : results)
+        {
+            bool ok = result.jitterFrames == 0 && result.maxDeviation <= MAX_DEVIATION;
+            passed = passed && ok;
+            printf("camera %-16s: %5d frames, avg %.2f us, max %.1f us, jitter %d, deviation %.3f, %s\n",
+                result.name, result.frames, result.avgUpdateUs, result.maxUpdateUs, result.jitterFrames, result.maxDeviation, ok ? "ok" : "FAIL");
+            printf("  occlusion             : %d frames, min length %.1f, %.1f segments/cast, %u cache refreshes, checksum %08x\n",
+                result.occludedFrames, result.minLength, result.segmentsPerCast, result.cacheRefreshes, result.checksum);
+        }
+        bool repeatable = results.front().checksum == results.back().checksum;
+        printf("deterministic    : %s\n", repeatable ? "yes" : "NO");
+        printf("camera replay    : %s\n", passed && repeatable ? "passed" : "FAILED");
+        return passed && repeatable ? 0 : 1;
+    }
+
+    // 定时器基准：10 万个等待中的定时器分属 1 千个实体，稳定运行后每tick不应再有堆分配
+    if (benchTimers)
+    {
+        int ticks = framesGiven ? config.frameCount : 3600;
+        TimerReport bench = HeadlessSimulation::benchmarkTimers(100000, 1000, ticks, config.seed);
+        printf("timer wheel      : %d timers, %d owners, %d ticks\n", bench.timers, bench.owners, bench.ticks);
+        printf("  schedule       : %.1f ns/timer\n", bench.nsPerSchedule);
+        printf("  cancel owner   : %.1f ns/timer, %.1f timers/tick\n", bench.nsPerCancel, bench.cancelledPerTick);
+        printf("  advance        : avg %.1f us/tick, fired %.1f/tick\n", bench.avgTickUs, bench.firedPerTick);
+        printf("  allocations    : %.2f/tick, pool grows %u\n", bench.allocationsPerTick, bench.grows);
+        printf("  multimap+func  : avg %.1f us/tick, allocations %.2f/tick\n", bench.baselineTickUs, bench.baselineAllocationsPerTick);
+        return bench.allocationsPerTick == 0.0 && bench.grows == 0 ? 0 : 1;
+    }
+
+    // 脚本任务基准：默认 1 千个角色循环运行攻击时间线，启动与恢复都不应有堆分配
+    if (benchTasks)
+    {
+        int actors = enemiesGiven ? config.enemyCount : 1000;
+        int ticks = framesGiven ? config.frameCount : 3600;
+        TaskReport bench = HeadlessSimulation::benchmarkTasks(actors, ticks, config.seed);
+        printf("gameplay tasks   : %d actors, %d ticks, %llu attacks finished\n", bench.actors, bench.ticks, bench.attacks);
+        printf("  start          : %.1f ns/task, %.1f starts/tick\n", bench.nsPerStart, bench.startsPerTick);
+        printf("  advance        : avg %.1f us/tick, %.1f resumes/tick, cancelled %.1f/tick\n",
+            bench.avgTickUs, bench.resumesPerTick, bench.cancelledPerTick);
+        printf("  allocations    : %.2f/tick, arena rejected %u\n", bench.allocationsPerTick, bench.rejected);
+        return bench.allocationsPerTick == 0.0 && bench.rejected == 0 ? 0 : 1;
+    }
+
+    // 线程扩展基准：默认 2 万敌人、600 帧，从 1 个线程测到硬件线程数
+    if (benchThreads)
+    {
+        int enemies = enemiesGiven ? config.enemyCount : 20000;
+        int frames = framesGiven ? config.frameCount : 600;
+        int maxThreads = threadsGiven ? config.threads : std::max(1, (int)std::thread::hardware_concurrency());
+        auto results = HeadlessSimulation::benchmarkThreads(enemies, frames, maxThreads, config.seed);
+
+        bool consistent = true;
+        printf("thread scaling   : %d enemies, %d frames, ai lod off\n", enemies, frames);
+        for (const auto& result : results)
+        {
+            consistent = consistent && result.checksum == results[0].checksum;
+            printf("  %2d threads     : avg %.1f us/tick, speedup %.2fx, checksum %08x\n",
+                result.threads, result.avgTickUs, result.speedup, result.checksum);
+        }
+        printf("deterministic    : %s\n", consistent ? "yes" : "NO");
+        JobSystem::destroyInstance();
+        return consistent ? 0 : 1;
+    }
+
+    // 分派基准：默认 2 万混合类型敌人、600 帧，虚函数分派 / 逐个类型分支 / 按类型分组特化内核
+    if (benchDispatch)
+    {
+        int enemies = enemiesGiven ? config.enemyCount : 20000;
+        int frames = framesGiven ? config.frameCount : 600;
+        auto results = HeadlessSimulation::benchmarkDispatch(enemies, frames, config.seed);
+
+        bool consistent = true;
+        printf("enemy dispatch   : %d enemies (3 types interleaved), %d frames, ai lod off, collision off\n", enemies, frames);
+        for (const auto& result : results)
+        {
+            consistent = consistent && result.checksum == results[0].checksum;
+            printf("  %-14s : update avg %.1f us/tick (%.1f ns/enemy), speedup %.2fx, tick %.1f us, checksum %08x\n",
+                result.name, result.avgUpdateUs, result.nsPerEnemy, result.speedup, result.avgTickUs, result.checksum);
+        }
+        printf("deterministic    : %s\n", consistent ? "yes" : "NO");
+        return consistent ? 0 : 1;
+    }
+
+    HeadlessSimulation simulation;
+    if (!simulation.init(config, script))
+        return 1;
+
+    HeadlessReport report = simulation.run();
+    JobSystem::destroyInstance();
+
+    printf("sense kernel     : %s\n", EnemySenseKernel::getInstructionSet());
+    printf("frames           : %d (%.1f s simulated, %u ticks)\n", report.frames, report.simulatedSeconds, report.ticks);
+    printf("wall time        : %.3f s\n", report.wallSeconds);
+    printf("frames/s         : %.0f\n", report.framesPerSecond);
+    printf("tick cost        : avg %.2f us, max %.2f us\n", report.avgTickCostUs, report.maxTickCostUs);
+    printf("enemies          : spawned %d, killed %d, alive %d\n", report.enemiesSpawned, report.enemiesKilled, report.enemiesAlive);
+    printf("ai lod           : %s, awake avg %.1f, sleeping avg %.1f\n", config.aiLod ? "on" : "off",
+        report.avgAwakeEnemies, report.avgSleepingEnemies);
+    printf("threads          : %d, flow field %s, collision %s\n", config.threads, config.flowField ? "on" : "off",
+        config.collision ? "on" : "off");
+    printf("separation       : %s, checks avg %.0f/tick, neighbours avg %.0f/tick\n", config.separation ? "on" : "off",
+        report.avgNeighbourChecks, report.avgNeighbours);
+    printf("ai think         : avg %.1f/frame, max %d/frame, peak %.1f us, deferred %u, over budget %u frames\n",
+        report.avgThinksPerFrame, report.maxThinksPerFrame, report.maxThinkUs, report.thinksDeferred, report.overrunFrames);
+    printf("player           : hp %d, damage taken %d, hits %d%s\n", report.playerHp, report.playerDamageTaken, report.playerHits, report.playerDead ? " (dead)" : "");
+    if (report.bossSpawned)
+        printf("boss             : hp %d%s\n", report.bossHp, report.bossDead ? " (dead)" : "");
+    printf("combat events    : hits %llu, blocks %llu, dodges %llu, deaths %llu\n",
+        report.combatEvents[(int)CombatEventType::HIT], report.combatEvents[(int)CombatEventType::BLOCK],
+        report.combatEvents[(int)CombatEventType::DODGE], report.combatEvents[(int)CombatEventType::DEATH]);
+    printf("checksum         : %08x\n", report.checksum);
+    return 0;
+}
@@ -4,6 +4,9 @@
 #include <windows.h>
 #endif
 #include "SimpleAudioEngine.h"
+#include "Core/ProfilerOverlay.h"
+#include "Core/JobSystem.h"
+#include "Core/HitWindowTable.h"
 
 USING_NS_CC;
 using namespace CocosDenshion;
@@ -24,17 +27,43 @@ Scene* HelloWorld::createScene() {
  * 注：控制器未加入节点树，需手动释放
  */
 HelloWorld::~HelloWorld() {
+    if (_afterDrawListener) {
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_afterDrawListener);
+    }
     CC_SAFE_RELEASE(_cameraController);
     CC_SAFE_RELEASE(_inputController);
+    CC_SAFE_RELEASE(_streamedSkybox);
+    CC_SAFE_RELEASE(_streamedColosseum);
+
+    // 排空本场景的延迟销毁队列，仍挂在本场景下的敌人节点交还对象池，供下一局复用
+    _destroyQueue.drain();
+    auto enemyPool = EnemyPool::getInstance();
+    if (enemyPool->getDestroyQueue() == &_destroyQueue) {
+        enemyPool->setDestroyQueue(nullptr);
+    }
+    if (_enemyLayer) {
+        enemyPool->reclaim(_enemyLayer);
+    }
 }
 
 /**
  * 初始化场景
- * 流程：初始化相机->玩家->环境->敌人->UI->启动帧更新
+ * 流程：配置模拟驱动->预加载动画->初始化相机->玩家->环境->敌人->UI->启动帧更新
  */
 bool HelloWorld::init() {
     if (!Scene::init()) return false;
 
+    // 固定步长模拟：逻辑频率与渲染帧率解耦
+    _simulation.setTickRate(SIMULATION_TICK_RATE);
+    _simulation.setMaxTicksPerFrame(MAX_TICKS_PER_FRAME);
+    _simulation.getTimers().reserve(TIMER_RESERVE);
+    _simulation.getCombatEvents().reserve(COMBAT_EVENT_RESERVE);
+
+    // 渲染结束后撤销插值，帧间的输入事件与动作读到的是真实模拟位置
+    _afterDrawListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(
+        Director::EVENT_AFTER_DRAW, [this](EventCustom*) { _simulation.restoreSimulationState(); });
+
+    preloadAnimationClips();
     setupCamera();
     setupPlayer();
     setupEnvironment();
@@ -51,73 +80,31 @@ bool HelloWorld::init() {
 //------------------------------
 
 /**
- * 辅助函数：空气墙玩家位置修正
- * 处理玩家位置越界限制逻辑：
- * - 玩家非空安全校验，避免空指针异常
- * - 寺庙场景（未切换关卡）的X轴宽度限制
- * - 寺庙场景（未切换关卡）的Z轴长度限制
- * - 玩家越界位置的修正与应用
+ * 辅助函数：敌人更新与清理
+ * - 死亡敌人从数据仓库压缩移除，其渲染代理从场景移除
+ * - 存活敌人在数据仓库中统一执行一次逻辑tick
  */
-void HelloWorld::correctPlayerPositionByAirWall()
+void HelloWorld::updateAndCleanEnemies(float dt)
 {
-    // 原空气墙逻辑完整迁移，无任何修改
-    if (!_player) return; // 增加玩家非空判断，更健壮
-
-    // 获取控制器更新后的最新位置
-    Vec3 currentPos = _player->getPosition3D();
-    bool needCorrection = false; // 标记是否需要修正
-
-    if (!_isLevelSwitched) {
-        // --- 场景一：寺庙 (长条形走廊) ---
-        // 基于传送门位置: Vec3(0, 25, -2500)
-
-        // A. X轴限制 (走廊宽度)
-        float limitX = 400.0f;
-
-        if (currentPos.x < -limitX) {
-            currentPos.x = -limitX;
-            needCorrection = true;
-        }
-        else if (currentPos.x > limitX) {
-            currentPos.x = limitX;
-            needCorrection = true;
-        }
-
-        // B. Z轴限制 (走廊长度)
-        float startZ = 200.0f;
-        float endZ = -2550.0f;
-
-        if (currentPos.z > startZ) {
-            currentPos.z = startZ; // 封锁入口，不能后退
-            needCorrection = true;
-        }
-        else if (currentPos.z < endZ) {
-            currentPos.z = endZ;   // 封锁尽头，不能穿过传送门后面的墙
-            needCorrection = true;
+    if (_enemyStore.removeDead(_deadEnemies) > 0) {
+        for (auto enemy : _deadEnemies) {
+            EnemyFactory::retireEnemy(enemy); // 播完死亡动画后回到对象池
         }
+        _deadEnemies.clear();
     }
 
-    // 如果位置出界了，应用修正后的位置
-    if (needCorrection) {
-        _player->setPosition3D(currentPos);
-    }
+    _enemyStore.tick(dt);
 }
 
 /**
- * 帧更新函数
- * 处理游戏核心逻辑：
- * - 状态检查（暂停/结束/玩家死亡）
- * - 控制器更新（输入+相机）
- * - 敌人与Boss更新
- * - 场景切换逻辑
+ * 单个固定步长逻辑tick
+ * 玩家、敌人、Boss的逻辑只在这里被调用（它们自身不再 scheduleUpdate），
+ * 因此无论渲染帧率是144Hz还是30Hz，每秒执行的逻辑次数都相同
  */
-void HelloWorld::update(float dt)
+void HelloWorld::simulateTick(float step)
 {
-    // 暂停/结束状态直接返回
-    if (_isGamePaused || _isGameOver) return;
-
-    // 玩家为空时终止更新
-    if (!_player) return;
+    PROFILE_SCOPE("Tick");
+    if (_isGameOver) return;
 
     // 玩家死亡判定（带最低HP容错）
     if (_player->getHP() <= 0) {
@@ -126,18 +113,23 @@ void HelloWorld::update(float dt)
         return;
     }
 
-    // 更新控制器（输入+相机）
-    if (_player && _inputController) _inputController->update(dt);
-    if (_camera && _cameraController) _cameraController->update(dt);
-
-    // 调用拆分后的空气墙位置修正函数
-    this->correctPlayerPositionByAirWall();
+    // 输入与玩家逻辑
+    {
+        PROFILE_SCOPE("Input");
+        if (_inputController) _inputController->update(step);
+    }
+    {
+        PROFILE_SCOPE("Player");
+        _player->update(step);
+    }
 
     // Boss战逻辑
     if (_isLevelSwitched && _boss) {
+        PROFILE_SCOPE("BossAI");
         // Boss死亡判定（延迟显示胜利界面）
         if (_boss->IsDead()) {
             _isGameOver = true;
+            _combatGrid.clear(); // 之后不再重建，避免持有即将移除的Boss
             this->runAction(Sequence::create(
                 DelayTime::create(2.0f),  // 延迟2秒显示，预留死亡动画时间
                 CallFunc::create([this]() { showEndGameUI(true); }),
@@ -145,33 +137,104 @@ void HelloWorld::update(float dt)
             ));
             return;
         }
-        _boss->update(dt);
+        _boss->update(step);
     }
 
-    updateUI(dt); // 更新UI显示
-
     // 普通敌人更新与清理
-    auto it = _enemies.begin();
-    while (it != _enemies.end()) {
-        if (*it == nullptr) {
-            it = _enemies.erase(it);  // 移除空指针
-        }
-        else if ((*it)->isDead()) {
-            (*it)->removeFromParent(); // 从场景移除
-            it = _enemies.erase(it);   // 从容器移除
-        }
-        else {
-            (*it)->update(dt);         // 更新敌人状态
-            ++it;
-        }
+    {
+        PROFILE_SCOPE("Enemies");
+        updateAndCleanEnemies(step);
+    }
+
+    // 位置与存活状态已确定，刷新攻击判定用的网格
+    {
+        PROFILE_SCOPE("CombatGrid");
+        rebuildCombatGrid();
     }
 
-    // 场景切换逻辑
-    if (!_isLevelSwitched && _enemies.empty()) {
+    // 场景切换逻辑：小怪清空即开始预取，传送时资源已常驻
+    if (!_isLevelSwitched && _enemyStore.getCount() == 0) {
+        PROFILE_SCOPE("Portal");
+        startBossLevelPrefetch();
         checkPortalTeleport();
     }
 }
 
+/**
+ * 辅助函数：重建战斗单位网格
+ * 只登记存活单位，死亡/已移除的敌人不会被攻击判定查到
+ */
+void HelloWorld::rebuildCombatGrid()
+{
+    _combatGrid.clear();
+
+    const int enemyCount = _enemyStore.getCount();
+    for (int i = 0; i < enemyCount; ++i) {
+        if (!_enemyStore.isDead(i)) {
+            _combatGrid.insert(_enemyStore.getProxy(i), _enemyStore.getPosition(i));
+        }
+    }
+
+    if (_boss && !_boss->IsDead()) {
+        _combatGrid.insert(_boss, _boss->getPosition3D());
+    }
+}
+
+/**
+ * 帧更新函数
+ * 处理游戏核心逻辑：
+ * - 状态检查（暂停/结束）
+ * - 按固定步长推进逻辑tick（见 simulateTick）
+ * - 表现层更新（相机、UI），读取插值后的位置
+ */
+void HelloWorld::update(float dt)
+{
+    PROFILE_FRAME("Frame");
+
+    // 排空上一帧（含动作回调中）提交的销毁请求，一帧只做一次场景树删除
+    {
+        PROFILE_SCOPE("Destroy");
+        _destroyQueue.drain();
+    }
+
+    // 暂停/结束状态直接返回
+    if (_isGamePaused || _isGameOver) return;
+
+    // 玩家为空时终止更新
+    if (!_player) return;
+
+    {
+        PROFILE_SCOPE("Simulation");
+        _enemyStore.beginThinkFrame();
+        _simulation.advance(dt, [this](float step) { this->simulateTick(step); });
+    }
+
+    // 敌人渲染代理每帧同步一次（与模拟驱动使用同一插值系数）
+    {
+        PROFILE_SCOPE("SyncProxies");
+        _enemyStore.syncProxies(_simulation.getInterpolationAlpha());
+    }
+
+    // tick中可能已判定胜负
+    if (_isGameOver) return;
+
+    // 相机与UI属于表现层，按渲染帧更新
+    {
+        PROFILE_SCOPE("Camera");
+        if (_camera && _cameraController) _cameraController->update(dt);
+    }
+    {
+        PROFILE_SCOPE("UI");
+        updateUI(dt);
+    }
+
+    // Boss关卡预取的主线程阶段按帧分片推进
+    {
+        PROFILE_SCOPE("Streaming");
+        _bossLevelStreamer.update(STREAMING_BUDGET_MS);
+    }
+}
+
 //------------------------------
 // 基础交互回调
 //------------------------------
@@ -187,6 +250,28 @@ void HelloWorld::menuCloseCallback(Ref* pSender) {
 // 初始化相关实现
 //------------------------------
 
+/**
+ * 预加载动画片段
+ * 玩家、三种小怪与Boss的片段一次性登记进缓存，运行时只按片段ID取用
+ */
+void HelloWorld::preloadAnimationClips() {
+    Maria::preloadAnimations();
+    EnemyGoblin::preloadAnimations();
+    EnemyKnight::preloadAnimations();
+    EnemyMinotaur::preloadAnimations();
+    Boss::preloadAnimations("Mutant/Mutant.c3b");
+
+    // 攻击命中窗口按片段ID关联(表缺失时各角色沿用代码中的判定时机)
+    auto hitWindows = HitWindowTable::getInstance();
+    if (hitWindows->load(HIT_WINDOW_FILE))
+        hitWindows->bindClips();
+
+    // 计数清零：此后出现的未命中即为战斗中的运行时加载
+    auto cache = AnimationClipCache::getInstance();
+    cache->resetCounters();
+    CCLOG("AnimationClipCache: %d clips preloaded", cache->getClipCount());
+}
+
 /**
  * 初始化相机
  * 配置：透视相机，60度FOV，绑定USER1相机标志
@@ -209,6 +294,14 @@ void HelloWorld::setupPlayer() {
     _player->setGlobalZOrder(100);
     _player->setScale(0.4f);
     this->addChild(_player);
+    _simulation.addInterpolatedNode(_player);
+    _player->setCombatGrid(&_combatGrid); // 攻击判定通过场景维护的网格查询敌人
+    // 残影节点在加载时一次性创建，释放影子技能时只借出/归还
+    _afterimagePool.init(this, "Maria.c3b", AFTERIMAGE_POOL_SIZE, (unsigned short)CameraFlag::USER1);
+    _player->setAfterimagePool(&_afterimagePool);
+    _player->setTimerWheel(&_simulation.getTimers()); // 动作结束等延迟在模拟tick中触发
+    _player->setTaskScheduler(&_simulation.getTasks()); // 技能时间线作为脚本任务运行
+    _player->setCombatEvents(&_simulation.getCombatEvents()); // 命中在tick结束时统一结算
 
     // 初始化相机控制器（绑定相机与玩家）
     _cameraController = TPSCameraController::create(_camera, _player);
@@ -296,6 +389,16 @@ void HelloWorld::setupEnvironment() {
         this->addChild(_temple);
     }
 
+    // 寺庙碰撞：模型中的墙体、柱子 + 走廊边界（原空气墙：两侧、入口、传送门后方的墙）
+    _templeCollision.clear();
+    if (_temple) {
+        _templeCollision.addModel("background/background/3d/temple1.c3b", _temple->getNodeToWorldTransform());
+    }
+    _templeCollision.addBox(-400.0f, -2550.0f, 400.0f, 200.0f, -10000.0f, 10000.0f);
+    _templeCollision.build();
+    _player->setCollisionWorld(&_templeCollision);
+    if (_cameraController) _cameraController->setCollisionWorld(&_templeCollision); // 相机被柱子挡住时收臂
+
     // 传送门（带浮动动画与粒子特效）
     _portal = Sprite3D::create("background/background/3d/portal.c3b");
     if (_portal) {
@@ -340,6 +443,52 @@ void HelloWorld::setupEnvironment() {
 // 场景切换相关实现
 //------------------------------
 
+/**
+ * 辅助函数：创建熔岩主题天空盒
+ * 立方体贴图没有异步接口，只能在主线程整体创建
+ */
+static Skybox* createLavaSkybox()
+{
+    return Skybox::create(
+        "background/background/picture/lava.png", "background/background/picture/lava.png",
+        "background/background/picture/lava.png", "background/background/picture/lava.png",
+        "background/background/picture/lava.png", "background/background/picture/lava.png"
+    );
+}
+
+/**
+ * 开始预取Boss关卡资源
+ * - 斗兽场模型、Boss模型：工作线程解析，主线程构建（Boss模型只为填充 Sprite3D 缓存）
+ * - 地板纹理：工作线程解码，主线程上传进纹理缓存
+ * - 熔岩天空盒、传送音效：主线程步骤，按帧预算分片执行
+ * bgm2 已在 setupEnvironment 中预加载
+ */
+void HelloWorld::startBossLevelPrefetch()
+{
+    if (_bossLevelStreamer.isStarted()) return;
+
+    _bossLevelStreamer.addModel("background/background/3d/colliseum.c3b", [this](Sprite3D* model) {
+        if (_isLevelSwitched || _streamedColosseum) return; // 已同步加载过，丢弃迟到的结果
+        _streamedColosseum = model;
+        _streamedColosseum->retain();
+    });
+    _bossLevelStreamer.addModel("Mutant/Mutant.c3b");
+    _bossLevelStreamer.addTexture("background/background/picture/ground.png");
+
+    _bossLevelStreamer.addMainThreadStep("lava skybox", [this]() {
+        _streamedSkybox = createLavaSkybox();
+        if (!_streamedSkybox) return false;
+        _streamedSkybox->retain();
+        return true;
+    });
+    _bossLevelStreamer.addMainThreadStep("teleport.wav", []() {
+        SimpleAudioEngine::getInstance()->preloadEffect("background/background/music/teleport.wav");
+        return true;
+    });
+
+    _bossLevelStreamer.start();
+}
+
 /**
  * 辅助函数：清理旧场景资源并替换天空盒
  * 处理旧场景的资源销毁与天空盒更新逻辑：
@@ -364,12 +513,15 @@ void HelloWorld::cleanOldSceneResources()
         _skybox = nullptr; // 安全置空
     }
 
-    // 2. 创建新的天空盒 
-    _skybox = Skybox::create(
-        "background/background/picture/lava.png", "background/background/picture/lava.png",
-        "background/background/picture/lava.png", "background/background/picture/lava.png",
-        "background/background/picture/lava.png", "background/background/picture/lava.png"
-    );
+    // 2. 取用预取好的天空盒，预取未完成时同步创建 
+    if (_streamedSkybox) {
+        _skybox = _streamedSkybox;
+        _skybox->autorelease(); // 所有权交给场景树
+        _streamedSkybox = nullptr;
+    }
+    else {
+        _skybox = createLavaSkybox();
+    }
 
     // 3. 设置新天空盒属性
     if (_skybox) {
@@ -392,8 +544,15 @@ void HelloWorld::cleanOldSceneResources()
  */
 void HelloWorld::loadBossLevelResourcesAndInit()
 {
-    // B.加载新的模型 (Colliseum)
-    _newModel = Sprite3D::create("background/background/3d/colliseum.c3b");
+    // B.加载新的模型 (Colliseum)：优先取用预取好的节点
+    if (_streamedColosseum) {
+        _newModel = _streamedColosseum;
+        _newModel->autorelease(); // 所有权交给场景树
+        _streamedColosseum = nullptr;
+    }
+    else {
+        _newModel = Sprite3D::create("background/background/3d/colliseum.c3b");
+    }
     if (_newModel) {
         _newModel->setScale(10.0f);
         _newModel->setPosition3D(Vec3(1400, 700, -2300));
@@ -402,6 +561,15 @@ void HelloWorld::loadBossLevelResourcesAndInit()
         _newModel->setColor(Color3B(80, 60, 40));
         this->addChild(_newModel);
     }
+
+    // 斗兽场碰撞：从模型提取围墙，玩家、Boss与相机改用新关卡的碰撞
+    _colosseumCollision.clear();
+    if (_newModel) {
+        _colosseumCollision.addModel("background/background/3d/colliseum.c3b", _newModel->getNodeToWorldTransform());
+    }
+    _colosseumCollision.build();
+    _player->setCollisionWorld(&_colosseumCollision);
+    if (_cameraController) _cameraController->setCollisionWorld(&_colosseumCollision);
     // C.给第二关加个大地板
     _secondFloor = Sprite::create("background/background/picture/ground.png");
 
@@ -445,6 +613,9 @@ void HelloWorld::loadBossLevelResourcesAndInit()
  */
 void HelloWorld::switchToBossLevel()
 {
+    // 预取未完成时先补完剩余的主线程步骤；未就绪的异步资源走同步加载
+    _bossLevelStreamer.flushMainThreadSteps();
+
     // 第一步：清理旧场景资源（旧模型+天空盒替换）
     this->cleanOldSceneResources();
 
@@ -466,6 +637,9 @@ void HelloWorld::checkPortalTeleport() {
 
         if (distance < TELEPORT_DISTANCE) {
             _isLevelSwitched = true; // 标记关卡已切换，防止重复触发
+            _enemyStore.setFlowField(nullptr); // 斗兽场不使用寺庙流场与碰撞
+            _enemyStore.setCollisionWorld(nullptr);
+            _templeFlowField.clear();
 
             // 调用拆分后的场景切换辅助函数，执行具体切换逻辑
             this->switchToBossLevel();
@@ -482,12 +656,26 @@ void HelloWorld::spawnBoss() {
 
     _boss = Boss::createBoss("Mutant/Mutant.c3b");
     if (_boss) {
-        _boss->setPosition3D(TEMPLE_DESTINATION + Vec3(300, 0, 0)); // 玩家侧方300单位
-        _boss->setTarget(_player);
+        _boss->setSpawnPosition(TEMPLE_DESTINATION + Vec3(300, 0, 0)); // 玩家侧方300单位
+        _boss->setTarget(_player->getEntityHandle());
+        _boss->setCollisionWorld(&_colosseumCollision);
+        _boss->setTimerWheel(&_simulation.getTimers());
+        _boss->setTaskScheduler(&_simulation.getTasks());
+        _boss->setCombatEvents(&_simulation.getCombatEvents());
         _boss->setGlobalZOrder(100);
         _boss->setScale(1.0f);
         _boss->setCameraMask((unsigned short)CameraFlag::USER1);
         this->addChild(_boss);
+        _simulation.addInterpolatedNode(_boss);
+        if (_gameHUD) _gameHUD->bindBoss(_boss);
+
+        // 死亡表现结束后经延迟销毁队列移除
+        _boss->setDeathFinishedCallback([this](Boss* boss) {
+            if (_gameHUD) _gameHUD->bindBoss(nullptr);
+            _simulation.removeInterpolatedNode(boss);
+            _destroyQueue.push(boss);
+            _boss = nullptr;
+        });
     }
 }
 
@@ -500,33 +688,52 @@ void HelloWorld::spawnBoss() {
  * 生成：地精->骑士->牛头人，并加入敌人容器
  */
 void HelloWorld::setupEnemies() {
-    _enemies.clear();
+    _enemyStore.clear();
+    _enemyStore.setTarget(_player->getEntityHandle()); // 所有敌人统一以玩家为目标
+    _enemyStore.setThinkBudget(ENEMY_THINK_BUDGET_US);  // 大批敌人同时接敌时分摊到多帧思考
+    _enemyStore.setJobSystem(JobSystem::getInstance()); // 敌人较多时感知/计时器/移动并行更新
+    _enemyStore.setCombatEvents(&_simulation.getCombatEvents()); // 对玩家的命中登记到事件队列
+
+    // 追击流场覆盖寺庙走廊（与走廊边界一致），敌人沿流场绕开不可行走区域
+    _templeFlowField.setBounds(-400.0f, -2550.0f, 400.0f, 200.0f, FLOW_FIELD_CELL_SIZE);
+    _enemyStore.setFlowField(&_templeFlowField);
+    _enemyStore.setCollisionWorld(&_templeCollision); // 与玩家共用寺庙墙体碰撞
+
+    // 敌人统一挂在专用容器下，死亡回收时批量移除，不影响场景的子节点列表
+    _enemyLayer = EntityLayer::create();
+    this->addChild(_enemyLayer);
+
+    // 对象池预热：之后的生成只从池中取，不再读取模型或创建动作
+    auto pool = EnemyPool::getInstance();
+    pool->prewarm(EnemyType::GOBLIN, ENEMY_POOL_PREWARM);
+    pool->prewarm(EnemyType::KNIGHT, ENEMY_POOL_PREWARM);
+    pool->prewarm(EnemyType::MINOTAUR, ENEMY_POOL_PREWARM);
+    pool->setDestroyQueue(&_destroyQueue);
 
     // 地精敌人
-    auto goblin = EnemyGoblin::create();
-    goblin->setPosition3D(Vec3(200, 0, -200));
+    auto goblin = EnemyFactory::acquireEnemy(EnemyType::GOBLIN, Vec3(200, 0, -200));
     goblin->setScale(1.5f);
-    goblin->setTarget(_player);
     goblin->setCameraMask((unsigned short)CameraFlag::USER1);
-    this->addChild(goblin);
-    _enemies.push_back(goblin);
+    _enemyLayer->addChild(goblin);
+    _enemyStore.add(goblin);
 
     // 骑士敌人
-    auto knight = EnemyKnight::create();
-    knight->setPosition3D(Vec3(-200, 0, -1500));
-    knight->setTarget(_player);
+    auto knight = EnemyFactory::acquireEnemy(EnemyType::KNIGHT, Vec3(-200, 0, -1500));
     knight->setScale(3.8f);
     knight->setCameraMask((unsigned short)CameraFlag::USER1);
-    this->addChild(knight);
-    _enemies.push_back(knight);
+    _enemyLayer->addChild(knight);
+    _enemyStore.add(knight);
 
     // 牛头人敌人
-    auto minotaur = EnemyMinotaur::create();
-    minotaur->setPosition3D(Vec3(0, 0, -750));
-    minotaur->setTarget(_player);
+    auto minotaur = EnemyFactory::acquireEnemy(EnemyType::MINOTAUR, Vec3(0, 0, -750));
     minotaur->setCameraMask((unsigned short)CameraFlag::USER1);
-    this->addChild(minotaur);
-    _enemies.push_back(minotaur);
+    _enemyLayer->addChild(minotaur);
+    _enemyStore.add(minotaur);
+
+    // 首帧之前先同步一次代理（播放待机动画）
+    _enemyStore.syncProxies(1.0f);
+
+    rebuildCombatGrid();
 }
 
 //------------------------------
@@ -540,6 +747,19 @@ void HelloWorld::setupEnemies() {
 void HelloWorld::showEndGameUI(bool isVictory) {
     auto visibleSize = Director::getInstance()->getWinSize();
 
+    // 运行统计只在调试构建输出（发布构建 CCLOG 为空）
+#if defined(COCOS2D_DEBUG) && COCOS2D_DEBUG > 0
+    auto clipCache = AnimationClipCache::getInstance();
+    CCLOG("AnimationClipCache: %u hits, %u misses", clipCache->getHitCount(), clipCache->getMissCount());
+    CCLOG("AfterimagePool: high-water %d / %d, exhausted %d", _afterimagePool.getHighWaterMark(),
+        _afterimagePool.getCapacity(), _afterimagePool.getExhaustedCount());
+    if (_gameHUD) CCLOG("GameHUD: %u refreshes", _gameHUD->getRefreshCount());
+    EnemyPool::getInstance()->logStats();
+    const EnemyThinkStats& thinkStats = _enemyStore.getThinkStats();
+    CCLOG("EnemyStore AI: %u thinks, %u deferred, %u over-budget frames", thinkStats.totalThinks,
+        thinkStats.totalDeferred, thinkStats.overrunFrames);
+#endif
+
     // 半透明遮罩层
     _endGameUI = LayerColor::create(Color4B(0, 0, 0, 180));
     this->addChild(_endGameUI, 100);
@@ -672,125 +892,18 @@ void HelloWorld::updateStatusInPause() {
 
 /** 初始化游戏HUD元素 */
 void HelloWorld::setupGameUI() {
-    auto visibleSize = Director::getInstance()->getWinSize();
-
-    // 1. 初始化玩家 HUD 节点
-    _playerHUD = DrawNode::create();
-    this->addChild(_playerHUD, 100);
-
-    // 2. 初始化 Boss UI 容器
-    _bossUIContainer = Node::create();
-    _bossUIContainer->setVisible(false);
-    this->addChild(_bossUIContainer, 100);
-
-    _bossHUD = DrawNode::create();
-    _bossUIContainer->addChild(_bossHUD);
-
-    _bossNameLabel = Label::createWithSystemFont("BOSS", "Arial", 26);
-    _bossNameLabel->setPosition(Vec2(visibleSize.width / 2, visibleSize.height + 40));
-    _bossUIContainer->addChild(_bossNameLabel);
-
-    _recoverUI = DrawNode::create();
-    this->addChild(_recoverUI, 100);
+    // 保留模式HUD：几何只绘制一次，由玩家/Boss的状态变化回调驱动刷新
+    _gameHUD = GameHUD::create();
+    this->addChild(_gameHUD, 100);
+    _gameHUD->bindPlayer(_player);
+
+#if FRAME_PROFILER_ENABLED
+    // 调试构建：帧耗时分析面板（F3 显示/隐藏，F4 导出 Chrome trace）
+    this->addChild(ProfilerOverlay::create(), 200);
+#endif
 }
 
-/** 更新游戏UI（每帧调用） */
+/** 更新游戏UI（每帧调用，数值刷新由HUD回调完成，这里只处理表现层动画） */
 void HelloWorld::updateUI(float dt) {
-    if (!_player) return;
-    auto visibleSize = Director::getInstance()->getWinSize();
-
-    // --- 玩家 UI 更新 ---
-    _playerHUD->clear(); // 清除上一帧的图形
-
-    // A. 血条 (HP)
-    float hpPercent = (float)_player->getHP() / 180.0f; // 假设满血 180
-    // 底色 (深灰色背景)
-    _playerHUD->drawSolidRect(Vec2(20, visibleSize.height - 40), Vec2(220, visibleSize.height - 20), Color4F(0, 0, 0, 0.5f));
-    // 红色条 (根据百分比计算右侧坐标)
-    _playerHUD->drawSolidRect(Vec2(20, visibleSize.height - 40), Vec2(20 + 200 * hpPercent, visibleSize.height - 20), Color4F::RED);
-
-    // B. 法条 (MP)
-    float mpPercent = (float)_player->getMP() / 100.0f; // 假设满蓝 100
-    // 底色
-    _playerHUD->drawSolidRect(Vec2(20, visibleSize.height - 55), Vec2(170, visibleSize.height - 45), Color4F(0, 0, 0, 0.5f));
-    // 蓝色条
-    _playerHUD->drawSolidRect(Vec2(20, visibleSize.height - 55), Vec2(20 + 150 * mpPercent, visibleSize.height - 45), Color4F::BLUE);
-
-    updateRecoverUI();
-
-    // --- Boss UI 更新逻辑 ---
-    if (_isLevelSwitched && _boss && !_boss->IsDead()) {
-        _bossUIContainer->setVisible(true);
-        _bossHUD->clear(); // 每一帧重绘前必须清除旧的矩形
-
-        auto visibleSize = Director::getInstance()->getWinSize();
-
-        // 1. 计算血量百分比
-        float currentHP = (float)_boss->getCurrentBlood();
-        float maxHP = (float)_boss->getMaxBlood();
-        float bossPercent = currentHP / maxHP;
-
-        // 2. 设置位置参数 (屏幕正下方)
-        float marginBottom = 60.0f; // 距离底部高度
-        float barHalfWidth = 300.0f; // 血条半宽
-        float barHeight = 25.0f;    // 血条厚度
-        Vec2 centerPos = Vec2(visibleSize.width / 2, marginBottom);
-
-        // 3. 绘制底色背景矩形
-        _bossHUD->drawSolidRect(
-            Vec2(centerPos.x - barHalfWidth, centerPos.y),
-            Vec2(centerPos.x + barHalfWidth, centerPos.y + barHeight),
-            Color4F(0, 0, 0, 0.7f)
-        );
-
-        // 4. Boss 阶段判定逻辑
-        Color4F bossColor = Color4F::RED; // 默认红色
-        if (bossPercent < 0.5f) {
-            // 进入狂暴状态：颜色变紫红
-            bossColor = Color4F(0.8f, 0.0f, 0.8f, 1.0f);
-            _bossNameLabel->setString("BOSS - MAW (RAGE MODE)");
-            _bossNameLabel->setColor(Color3B::RED);
-
-            // 狂暴震动效果：让 UI 容器产生轻微随机位移
-            _bossUIContainer->setPosition(Vec2(rand() % 3 - 1, rand() % 3 - 1));
-        }
-        else {
-            // 正常状态
-            _bossNameLabel->setString("BOSS - MUTANT");
-            _bossNameLabel->setColor(Color3B::WHITE);
-            _bossUIContainer->setPosition(Vec2::ZERO); // 恢复原位
-        }
-
-        // 5. 绘制实际血量条 (根据 bossPercent 缩放宽度)
-        _bossHUD->drawSolidRect(
-            Vec2(centerPos.x - barHalfWidth, centerPos.y),
-            Vec2(centerPos.x - barHalfWidth + (barHalfWidth * 2 * bossPercent), centerPos.y + barHeight),
-            bossColor
-        );
-
-        // 6. 同步名字标签位置 (放在血条上方)
-        _bossNameLabel->setPosition(Vec2(centerPos.x, centerPos.y + barHeight + 20));
-
-    }
-    else {
-        // Boss 没出现或已死，隐藏 UI 并重置位置
-        _bossUIContainer->setVisible(false);
-    }
-}
-
-/** 更新恢复道具UI显示 */
-void HelloWorld::updateRecoverUI() {
-    if (!_player || !_recoverUI) return;
-
-    _recoverUI->clear();
-    int count = _player->getRecoverCount();
-    Vec2 startPos = Vec2(50, 50); // 左下角起始位置
-    float radius = 10.0f;
-    float spacing = 25.0f;
-
-    for (int i = 0; i < 5; ++i) {
-        // 金色表示可用，灰色表示已使用
-        Color4F color = (i < count) ? Color4F(1.0f, 0.84f, 0.0f, 1.0f) : Color4F(0.5f, 0.5f, 0.5f, 0.5f);
-        _recoverUI->drawSolidCircle(startPos + Vec2(i * spacing, 0), radius, 0, 32, color);
-    }
+    if (_gameHUD) _gameHUD->update(dt);
 }
\ No newline at end of file
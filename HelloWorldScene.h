@@ -8,8 +8,19 @@
 #include "Enemy/EnemyKnight.h"
 #include "Enemy/EnemyMinotaur.h"
 #include "Enemy/Boss/Boss.h"
+#include "Enemy/EnemyStore.h"
+#include "Enemy/EnemyFactory.h"
+#include "Enemy/EnemyPool.h"
 #include "TPSCameraController.h"
 #include "PlayerInputController.h"
+#include "Core/SimulationDriver.h"
+#include "Core/AssetStreamer.h"
+#include "Core/DeferredDestroyQueue.h"
+#include "Core/EntityLayer.h"
+#include "Core/FlowField.h"
+#include "Core/CollisionWorld.h"
+#include "Core/FrameProfiler.h"
+#include "UI/GameHUD.h"
 #include "ui/CocosGUI.h"
 #include <vector>
 
@@ -48,6 +59,9 @@ public:
     /** 切换暂停状态 */
     void togglePause();
 
+    /** 获取固定步长模拟的统计数据（帧节奏、tick耗时） */
+    const SimulationStats& getSimulationStats() const { return _simulation.getStats(); }
+
 private:
     //------------------------------
     // 初始化相关函数
@@ -67,6 +81,9 @@ private:
     /** 初始化基础UI（暂停界面等） */
     void setupUI();
 
+    /** 预加载所有角色的动画片段（之后战斗中不应再有运行时加载） */
+    void preloadAnimationClips();
+
     //------------------------------
     // 游戏逻辑相关函数
     //------------------------------
@@ -76,6 +93,9 @@ private:
     /** 检查玩家是否触发传送门（距离判定与场景切换） */
     void checkPortalTeleport();
 
+    /** 开始后台预取Boss关卡资源（小怪清空后调用，重复调用无效） */
+    void startBossLevelPrefetch();
+
     /** 切换至Boss关卡：处理场景切换的具体逻辑（移除旧模型、加载新场景等） */
     void switchToBossLevel(); // 新增：场景切换调度函数声明
 
@@ -94,11 +114,14 @@ private:
     // ======================================
     // 关键补充：拆分后的辅助函数声明（START）
     // ======================================
-    /** 空气墙位置修正：限制玩家在场景边界内，防止越界 */
-    void correctPlayerPositionByAirWall();
-
-    /** 敌人更新与清理：更新存活敌人状态，移除死亡/空指针敌人 */
+    /** 敌人更新与清理：移除死亡敌人，再以数据仓库推进存活敌人一个tick */
     void updateAndCleanEnemies(float dt);
+
+    /** 单个固定步长逻辑tick：玩家、Boss、敌人、传送门判定 */
+    void simulateTick(float step);
+
+    /** 用存活的敌人与Boss重建战斗单位网格（每个tick末尾调用） */
+    void rebuildCombatGrid();
     // ======================================
     // 关键补充：拆分后的辅助函数声明（END）
     // ======================================
@@ -109,12 +132,9 @@ private:
     /** 初始化游戏HUD（玩家状态、Boss状态等） */
     void setupGameUI();
 
-    /** 更新UI显示（每帧刷新血条、状态等） */
+    /** 更新UI表现层（Boss狂暴抖动），数值变化由HUD回调刷新 */
     void updateUI(float dt);
 
-    /** 更新恢复道具UI显示 */
-    void updateRecoverUI();
-
     /** 创建暂停界面（遮罩、标题、按钮） */
     void createPauseLayer();
 
@@ -135,9 +155,20 @@ private:
     //------------------------------
     cocos2d::Camera* _camera = nullptr;               // 游戏主相机
     Maria* _player = nullptr;                         // 玩家角色
-    std::vector<EnemyBase*> _enemies;                 // 敌人容器
+    EnemyStore _enemyStore;                           // 普通敌人数据仓库（节点仅作渲染代理）
+    std::vector<EnemyBase*> _deadEnemies;             // 本tick移除的敌人代理（复用，避免分配）
     TPSCameraController* _cameraController = nullptr; // 相机控制器
     PlayerInputController* _inputController = nullptr;// 输入控制器
+    SimulationDriver _simulation;                     // 固定步长模拟驱动器（唯一的逻辑调用者）
+    cocos2d::EventListenerCustom* _afterDrawListener = nullptr; // 渲染结束后恢复模拟位置
+    CombatantGrid _combatGrid;                        // 战斗单位空间网格（攻击判定宽相位）
+    AfterimagePool _afterimagePool;                   // 影子技能残影节点池
+    AssetStreamer _bossLevelStreamer;                 // Boss关卡资源预取器
+    DeferredDestroyQueue _destroyQueue;               // 延迟销毁队列（每帧开头排空一次）
+    EntityLayer* _enemyLayer = nullptr;               // 普通敌人容器节点（批量移除）
+    FlowField _templeFlowField;                       // 寺庙走廊的追击流场（敌人共用）
+    CollisionWorld _templeCollision;                  // 寺庙墙体碰撞（模型墙体 + 走廊边界）
+    CollisionWorld _colosseumCollision;               // 斗兽场墙体碰撞
 
     //------------------------------
     // 场景模型成员
@@ -159,17 +190,23 @@ private:
     //------------------------------
     // HUD UI组件
     //------------------------------
-    cocos2d::DrawNode* _playerHUD = nullptr;          // 左上角玩家状态UI
-    cocos2d::DrawNode* _bossHUD = nullptr;            // 顶部Boss状态UI
-    cocos2d::Node* _bossUIContainer = nullptr;        // Boss UI容器
-    cocos2d::Label* _bossNameLabel = nullptr;         // Boss名称标签
-    cocos2d::DrawNode* _recoverUI = nullptr;          // 恢复道具UI
+    GameHUD* _gameHUD = nullptr;                      // 玩家/Boss状态HUD（保留模式）
     cocos2d::Label* _statusLabel = nullptr;           // 暂停界面状态文字
 
     //------------------------------
     // 常量定义
     //------------------------------
     const float TELEPORT_DISTANCE = 60.0f;            // 触发传送的距离阈值
+    const float SIMULATION_TICK_RATE = 60.0f;         // 逻辑tick频率（次/秒）
+    const int MAX_TICKS_PER_FRAME = 5;                // 每帧最多追赶的tick数
+    const int AFTERIMAGE_POOL_SIZE = 8;               // 残影池容量（影子技能同时最多5个残影）
+    const int TIMER_RESERVE = 256;                    // 玩法定时器预分配槽位数
+    const int COMBAT_EVENT_RESERVE = 128;             // 单tick战斗命中预分配数
+    const char* HIT_WINDOW_FILE = "hitwindows.bin";   // 离线烘焙的攻击命中窗口表
+    const float STREAMING_BUDGET_MS = 4.0f;           // 预取主线程步骤的每帧预算（毫秒）
+    const int ENEMY_POOL_PREWARM = 4;                 // 每种敌人预热的池节点数
+    const float ENEMY_THINK_BUDGET_US = 500.0f;       // 敌人AI思考的每帧预算（微秒）
+    const float FLOW_FIELD_CELL_SIZE = 50.0f;         // 追击流场的格子边长
     const cocos2d::Vec3 TEMPLE_DESTINATION = cocos2d::Vec3(0, 0, 0); // 传送目标位置
 
     //地板和天空盒相关
@@ -177,6 +214,8 @@ private:
     cocos2d::Skybox* _skybox = nullptr;
     cocos2d::Node* _haloEffect;  // 光晕特效 
     cocos2d::Sprite3D* _newModel;    // 新场景模型
+    cocos2d::Skybox* _streamedSkybox = nullptr;       // 预取完成的熔岩天空盒（手动持有）
+    cocos2d::Sprite3D* _streamedColosseum = nullptr;  // 预取完成的斗兽场模型（手动持有）
 
 
 };
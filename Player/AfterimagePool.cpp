@@ -0,0 +1,80 @@
+#include "AfterimagePool.h"
+
+AfterimagePool::~AfterimagePool()
+{
+    for (auto node : _nodes)
+    {
+        CC_SAFE_RELEASE(node);
+    }
+    _nodes.clear();
+    _freeList.clear();
+}
+
+bool AfterimagePool::init(Node* parent, const std::string& modelPath, int capacity, unsigned short cameraMask)
+{
+    if (!parent || capacity <= 0)
+        return false;
+
+    _nodes.reserve(capacity);
+    _freeList.reserve(capacity);
+
+    for (int i = 0; i < capacity; ++i)
+    {
+        auto node = Sprite3D::create(modelPath);
+        if (!node)
+        {
+            CCLOGERROR("AfterimagePool: failed to create %s", modelPath.c_str());
+            return false;
+        }
+
+        node->setCameraMask(cameraMask);
+        node->setCascadeOpacityEnabled(true);
+        node->setLightMask(0);
+        node->setVisible(false);
+        node->retain();
+        parent->addChild(node);
+
+        _freeList.push_back((int)_nodes.size());
+        _nodes.push_back(node);
+    }
+    return true;
+}
+
+Sprite3D* AfterimagePool::acquire()
+{
+    if (_freeList.empty())
+    {
+        _exhaustedCount++;
+        CCLOG("AfterimagePool exhausted (capacity %d)", (int)_nodes.size());
+        return nullptr;
+    }
+
+    int index = _freeList.back();
+    _freeList.pop_back();
+
+    int inUse = getInUseCount();
+    if (inUse > _highWaterMark)
+        _highWaterMark = inUse;
+
+    auto node = _nodes[index];
+    node->setVisible(true);
+    return node;
+}
+
+void AfterimagePool::release(Sprite3D* node)
+{
+    for (int i = 0; i < (int)_nodes.size(); ++i)
+    {
+        if (_nodes[i] != node)
+            continue;
+
+        // 已归还的节点不重复入栈
+        if (!node->isVisible())
+            return;
+
+        node->stopAllActions();
+        node->setVisible(false);
+        _freeList.push_back(i);
+        return;
+    }
+}
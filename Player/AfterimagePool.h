@@ -0,0 +1,54 @@
+#pragma once
+
+#include "cocos2d.h"
+#include "3d/CCSprite3D.h"
+#include <string>
+#include <vector>
+
+USING_NS_CC;
+
+/**
+ * 残影节点池
+ * 场景加载时预先创建固定数量的轻量 Sprite3D(与Maria共用同一模型文件，
+ * 网格/骨骼数据由 Sprite3D 缓存共享)，不含 Player 接口与更新逻辑。
+ * 影子技能运行时只借出/归还节点，不再创建或销毁，也不分配内存。
+ */
+class AfterimagePool
+{
+public:
+    AfterimagePool() {}
+    ~AfterimagePool();
+
+    /**
+     * 预创建全部残影节点并挂到父节点下(初始隐藏)
+     * @param parent 残影所在父节点(通常为场景)
+     * @param modelPath 模型文件路径
+     * @param capacity 池容量
+     * @param cameraMask 相机掩码
+     * @return 全部节点创建成功返回true
+     */
+    bool init(Node* parent, const std::string& modelPath, int capacity, unsigned short cameraMask);
+
+    /**
+     * 借出一个残影节点(已显示，变换与透明度需调用方设置)
+     * @return 空闲节点，池已耗尽返回nullptr
+     */
+    Sprite3D* acquire();
+
+    /**
+     * 归还残影节点：停止动作并隐藏
+     * @param node 由 acquire 借出的节点
+     */
+    void release(Sprite3D* node);
+
+    int getCapacity() const { return (int)_nodes.size(); }
+    int getInUseCount() const { return (int)_nodes.size() - (int)_freeList.size(); }
+    int getHighWaterMark() const { return _highWaterMark; }     // 同时借出数量的历史峰值
+    int getExhaustedCount() const { return _exhaustedCount; }   // 池耗尽导致借出失败的次数
+
+private:
+    std::vector<Sprite3D*> _nodes;    // 持有引用
+    std::vector<int> _freeList;       // 空闲节点下标(栈)
+    int _highWaterMark = 0;
+    int _exhaustedCount = 0;
+};
@@ -1,57 +1,11 @@
 #include "Maria.h"
-#include "Enemy/EnemyBase.h"
-#include "Enemy/Boss/Boss.h"
 #include "base/CCDirector.h"
 #include "renderer/CCMaterial.h" 
-#include "2d/CCActionInterval.h" // DelayTime
-#include "2d/CCActionInstant.h"  // Sequence, CallFunc
+#include "2d/CCActionInterval.h"
+#include "Core/AnimationClipCache.h"
 
 // =========================================================================
-// ̬
-// =========================================================================
-const std::string Maria::ANIM_MODEL_PATH = "Maria.c3b";
-
-// 
-const std::string Maria::ANIM_IDLE = "Armature|idle";
-const std::string Maria::ANIM_WALK = "Armature|walk";
-const std::string Maria::ANIM_RUN = "Armature|run_forward";
-
-// 
-const std::string Maria::ANIM_P_ATTACK1 = "Armature|slash_1";
-const std::string Maria::ANIM_P_ATTACK2 = "Armature|slash_4";
-const std::string Maria::ANIM_P_ATTACK3 = "Armature|slash_2";
-
-// ܶ
-const std::string Maria::ANIM_SKILL_START = "Armature|pose";
-const std::string Maria::ANIM_GHOST_1 = "Armature|slash_2";
-const std::string Maria::ANIM_GHOST_2 = "Armature|slide_attack";
-const std::string Maria::ANIM_GHOST_3 = "Armature|right_kick";
-const std::string Maria::ANIM_GHOST_4 = "Armature|highSpinAttack";
-const std::string Maria::ANIM_GHOST_5 = "Armature|left_kick";
-
-// ״̬
-const std::string Maria::ANIM_JUMP = "Armature|jump";            // Ծ
-const std::string Maria::ANIM_START_CROUCH = "Armature|crouch";  // ʼ¶
-const std::string Maria::ANIM_CROUCH_IDLE = "Armature|crouching";// ¶״
-const std::string Maria::ANIM_DE_CROUCH = "Armature|decrouch";   // ¶
-
-const std::string Maria::ANIM_START_BLOCK = "Armature|block";    // ʼ
-const std::string Maria::ANIM_BLOCK_IDLE = "Armature|block_hold";// 񵲴
-const std::string Maria::ANIM_DE_BLOCK = "Armature|deblock";     // 
-
-// ܶ
-const std::string Maria::ANIM_DODGE_BACK = "Armature|dodge_backword";
-const std::string Maria::ANIM_DODGE_FRONT = "Armature|dodge_forward";
-const std::string Maria::ANIM_DODGE_LEFT = "Armature|dodge_right";
-const std::string Maria::ANIM_DODGE_RIGHT = "Armature|dodge_left";
-
-// ܻ
-const std::string Maria::ANIM_HURT = "Armature|impact_small";    // ܻ
-const std::string Maria::ANIM_DEAD = "Armature|dead";            // 
-const std::string Maria::ANIM_RECOVER = "Armature|casting";      // Ѫ
-
-// =========================================================================
-// ʼط
+// ʼط
 // =========================================================================
 
 Maria* Maria::create(const std::string& modelPath)
@@ -76,31 +30,41 @@ bool Maria::init(const std::string& modelPath)
         CCLOGERROR("Failed to load 3D model: %s", modelPath.c_str());
         return false;
     }
-    _moveBasePos = getPosition3D();
-    setState(MariaState::IDLE);
-    this->scheduleUpdate();
-
+    // ֡£update() ɳĹ̶ģͳһ
+    // ʵ߼Ǽ(ʱ߼ע)
+    _logic.setPosition3D(getPosition3D());
+    _logic.init(this, this);
     return true;
 }
 
+/**
+ * ߼ºͬڵ任(ģtick֮ȡڵλֵ)
+ * @param dt ̶
+ */
+void Maria::update(float dt)
+{
+    _logic.update(dt);
+    setPosition3D(_logic.getPosition3D());
+    setRotation3D(Vec3(0, _logic.getYaw(), 0));
+}
+
 // =========================================================================
-// ط
+// ֽӿ
 // =========================================================================
 
 /**
  * ָ
- * @param animName 
+ * @param clip ƬID
  * @param loop Ƿѭ
+ * @return Ƭβڷfalse
  */
-void Maria::playAnimation(const std::string& animName, bool loop)
+bool Maria::playClip(ClipId clip, bool loop)
 {
-    this->stopAllActions();
+    stopClip();
 
-    auto anim = Animation3D::create(Maria::ANIM_MODEL_PATH, animName);
+    auto anim = AnimationClipCache::getInstance()->getClip(clip);
     if (!anim) {
-        CCLOGERROR("Animation not found: %s", animName.c_str());
-        setState(MariaState::IDLE);
-        return;
+        return false;
     }
 
     auto animate = Animate3D::create(anim); // ȷȡAnimation3D*
@@ -111,780 +75,44 @@ void Maria::playAnimation(const std::string& animName, bool loop)
     else {
         this->runAction(animate);
     }
+    return true;
 }
 
 /**
- * ɻص
- * @param animName ɵĶ
- */
-void Maria::onAnimationFinished(const std::string& animName)
-{
-    // д
-    if (_comboWindowAction) {
-        this->stopAction(_comboWindowAction);
-        _comboWindowAction = nullptr;
-    }
-
-    // ǹ/¶/״̬Զidle
-    if (_currentState != MariaState::ATTACKING &&
-        _currentState != MariaState::CROUCH_IDLE &&
-        _currentState != MariaState::BLOCK_IDLE)
-    {
-        setState(MariaState::IDLE);
-    }
-}
-
-// =========================================================================
-// ״̬
-// =========================================================================
-
-/**
- * ýɫ״̬лӦ
- * @param newState ״̬ */
-
-void Maria::setState(MariaState newState)
-{
-    if (_currentState == newState)
-        return;
-
-    MariaState oldState = _currentState; // ¼״̬
-    _currentState = newState;
-
-    // /״̬ʱ»׼λ
-    if (oldState == MariaState::ATTACKING || oldState == MariaState::DODGING) {
-        _moveBasePos = getPosition3D();
-        _isAttacking = false;           // ȷ״̬
-    }
-
-    // ֹͣѭ (Tag 100ڶ׷//Ծĳ)
-    this->stopActionByTag(100);
-
-    switch (newState)
-    {
-        case MariaState::IDLE:
-            playAnimation(ANIM_IDLE, true);
-            _moveSpeed = 0.0f;
-            _moveBasePos = getPosition3D(); // û׼λ
-            break;
-
-        case MariaState::HURT:
-            _moveSpeed = 0.0f;
-            _isAttacking = false; // ܻʱֹͣй
-            break;
-
-        case MariaState::WALK:
-            playAnimation(ANIM_WALK, true);
-            _moveSpeed = _walkSpeed;
-            break;
-
-        case MariaState::RUN:
-            playAnimation(ANIM_RUN, true);
-            _moveSpeed = _runSpeed;
-            break;
-
-        case MariaState::BLOCK_IDLE:
-            playAnimation(ANIM_BLOCK_IDLE, true);
-            _moveSpeed = 0.0f;
-            break;
-
-        case MariaState::CROUCH_IDLE:
-            playAnimation(ANIM_CROUCH_IDLE, true);
-            _moveSpeed = 0.0f;
-            break;
-
-        case MariaState::JUMPING:
-            // JUMPING״̬runJump()д
-            break;
-
-        case MariaState::DODGING:
-            _moveSpeed = 0.0f; // ٶupdateattack߼д
-            break;
-
-        default:
-            break;
-    }
-}
-
-// =========================================================================
-// ƶתط
-// =========================================================================
-
-/**
- * ȡɫǰǰ(XZƽ)
- * @return ׼ǰ
- */
-Vec3 Maria::getForwardVector() const
-{
-    float yaw = CC_DEGREES_TO_RADIANS(getRotation3D().y);
-    return Vec3(sinf(yaw), 0, cosf(yaw)).getNormalized();
-}
-
-/**
- * ִƶ߼
- * @param direction 뷽
- * @param isRunning ǷΪ״̬
- */
-void Maria::runMove(const Vec3& direction, bool isRunning)
-{
-    // ״̬½ת
-    if (_isAttacking) {
-        if (_isRotationLocked) {
-            // ״̬³
-            float targetAngle = CC_RADIANS_TO_DEGREES(atan2f(_lockedDirection.x, _lockedDirection.z));
-            setRotation3D(Vec3(0, targetAngle, 0));
-        }
-        else {
-            // ״̬³ƶ
-            Vec3 dir(direction.x, 0, direction.z);
-            if (dir.lengthSquared() > 0.01f) {
-                dir.normalize();
-                float angle = CC_RADIANS_TO_DEGREES(atan2f(dir.x, dir.z));
-                setRotation3D(getRotation3D().lerp(Vec3(0, angle, 0), 0.2f));
-            }
-        }
-        return;
-    }
-
-    // /״̬²ƶ
-    if (_currentState == MariaState::DODGING || _isAttacking) {
-        return;
-    }
-
-    // 1. 뷽 (directionΪϵķ: X/Z)
-    Vec3 moveInput(direction.x, 0, direction.z);
-    if (moveInput.lengthSquared() < 0.0001f) {
-        // ʱֹͣƶ
-        if (_currentState == MariaState::WALK || _currentState == MariaState::RUN) {
-            setState(MariaState::IDLE);
-        }
-        return;
-    }
-    moveInput.normalize();
-
-    // 2. תǶΪ
-    float cameraYaw = CC_DEGREES_TO_RADIANS(this->_cameraYawAngle);
-
-    // 3. ϵǰ (XZƽ)
-    Vec3 camForward = Vec3(sinf(cameraYaw), 0.0f, cosf(cameraYaw));
-    Vec3 camRight = Vec3(camForward.z, 0.0f, -camForward.x);
-
-    // 4. 뷽תΪϵ
-    Vec3 moveDir = camForward * moveInput.z - camRight * moveInput.x;
-    moveDir.normalize();
-
-    // ɫת
-    if (!_isRotationLocked) {
-        // ĿǶ
-        float targetAngle = CC_RADIANS_TO_DEGREES(atan2f(moveDir.x, moveDir.z));
-        float currentAngle = getRotation3D().y;
-        float angleDiff = targetAngle - currentAngle;
-
-        // ǶȿԽ0/360ȱ߽
-        while (angleDiff > 180.0f)  angleDiff -= 360.0f;
-        while (angleDiff < -180.0f) angleDiff += 360.0f;
-
-        // ƽת
-        float newAngle = currentAngle + angleDiff * 0.2f;
-        setRotation3D(Vec3(0, newAngle, 0));
-    }
-    else {
-        // ״̬³
-        float targetAngle = CC_RADIANS_TO_DEGREES(atan2f(_lockedDirection.x, _lockedDirection.z));
-        float currentAngle = getRotation3D().y;
-        float angleDiff = targetAngle - currentAngle;
-
-        while (angleDiff > 180.0f)  angleDiff -= 360.0f;
-        while (angleDiff < -180.0f) angleDiff += 360.0f;
-
-        setRotation3D(Vec3(0, currentAngle + angleDiff, 0));
-    }
-
-    // ƶ״̬
-    setState(isRunning ? MariaState::RUN : MariaState::WALK);
-    _moveDirection = moveDir; // 洢update()
-}
-
-/**
- * ֹͣƶ
- */
-void Maria::stopMove()
-{
-    // /״̬ʱֹͣ
-    if (_currentState == MariaState::WALK || _currentState == MariaState::RUN) {
-        setState(MariaState::IDLE);
-    }
-}
-
-// =========================================================================
-// ط
-// =========================================================================
-
-/**
- * ִܶ
- * @param direction ܷ
- */
-void Maria::runDodge(const Vec3& direction)
-{
-    // idle/walk/run״̬
-    if (_currentState != MariaState::IDLE &&
-        _currentState != MariaState::WALK &&
-        _currentState != MariaState::RUN) {
-        return;
-    }
-
-    this->stopAllActions();
-
-    // 1. ȷܶͷ
-    std::string dodgeAnim = ANIM_DODGE_BACK; // ĬϺ
-    Vec3 worldDodgeDir;
-
-    // ϵת
-    float cameraYaw = CC_DEGREES_TO_RADIANS(this->_cameraYawAngle);
-    Vec3 camForward = Vec3(sinf(cameraYaw), 0.0f, cosf(cameraYaw));
-    Vec3 camRight = Vec3(camForward.z, 0.0f, -camForward.x);
-
-    // ת뷽ϵ
-    Vec3 inputDir = camForward * direction.z - camRight * direction.x;
-
-    if (direction.lengthSquared() < 0.01f) {
-        // ʱĬϺ
-        dodgeAnim = ANIM_DODGE_BACK;
-        worldDodgeDir = -getForwardVector();
-    }
-    else {
-        worldDodgeDir = inputDir;
-        worldDodgeDir.normalize();
-
-        // 뷽ѡ񶯻
-        if (std::abs(direction.z) >= std::abs(direction.x)) {
-            dodgeAnim = (direction.z > 0) ? ANIM_DODGE_FRONT : ANIM_DODGE_BACK;
-        }
-        else {
-            dodgeAnim = (direction.x > 0) ? ANIM_DODGE_RIGHT : ANIM_DODGE_LEFT;
-        }
-    }
-
-    // 2. ״̬
-    setState(MariaState::DODGING);
-    _isAttacking = true;
-    _attackStartPos = getPosition3D();
-    _attackDirection = worldDodgeDir;
-    _attackDistance = 15.0f;
-    _attackDuration = 0.45f;
-    _attackElapsed = 0.0f;
-
-    // 3. Ŷûص
-    auto anim3d = Animation3D::create(Maria::ANIM_MODEL_PATH, dodgeAnim);
-    if (anim3d) {
-        auto animate = Animate3D::create(anim3d);
-        auto seq = Sequence::create(
-            animate,
-            CallFunc::create([=]() {
-                _moveBasePos = getPosition3D();
-                _isAttacking = false;
-                setState(MariaState::IDLE);
-                }),
-            nullptr
-        );
-        this->stopAllActions();
-        this->runAction(seq);
-    }
-}
-
-// =========================================================================
-// Ŀط
-// =========================================================================
-
-/**
- * лĿ״̬
- * @param isLocked ǷĿ
- * @param targetDir Ŀ귽
- */
-void Maria::toggleLock(bool isLocked, const cocos2d::Vec3& targetDir)
-{
-    _isRotationLocked = isLocked;
-
-    if (isLocked) {
-        // Ŀ귽(XZƽ)
-        _lockedDirection = Vec3(targetDir.x, 0, targetDir.z).getNormalized();
-
-        // Ŀ
-        float targetAngle = CC_RADIANS_TO_DEGREES(atan2f(_lockedDirection.x, _lockedDirection.z));
-        setRotation3D(Vec3(0, targetAngle, 0));
-    }
-}
-
-// =========================================================================
-// Ծط
-// =========================================================================
-
-/**
- * ִԾ
- */
-void Maria::runJump()
-{
-    if (_currentState == MariaState::IDLE ||
-        _currentState == MariaState::WALK ||
-        _currentState == MariaState::RUN) {
-        setState(MariaState::JUMPING);
-        playAnimation(ANIM_JUMP, false);
-
-        // Ծ󷵻idle
-        this->runAction(Sequence::create(
-            DelayTime::create(0.8f),
-            CallFunc::create([=]() { setState(MariaState::IDLE); }),
-            nullptr
-        ));
-    }
-}
-
-// =========================================================================
-// ¶ط
-// =========================================================================
-
-/**
- * л¶״̬
- */
-void Maria::toggleCrouch()
-{
-    if (_currentState == MariaState::IDLE || _currentState == MariaState::WALK) {
-        // վл¶
-        playAnimation(ANIM_START_CROUCH, false);
-
-        auto action = Sequence::create(
-            DelayTime::create(0.5f),
-            CallFunc::create([=]() { setState(MariaState::CROUCH_IDLE); }),
-            nullptr
-        );
-        action->setTag(100);
-        this->runAction(action);
-
-    }
-    else if (_currentState == MariaState::CROUCH_IDLE) {
-        // ¶лվ
-        playAnimation(ANIM_DE_CROUCH, false);
-
-        auto action = Sequence::create(
-            DelayTime::create(0.5f),
-            CallFunc::create([=]() { setState(MariaState::IDLE); }),
-            nullptr
-        );
-        action->setTag(100);
-        this->runAction(action);
-    }
-}
-
-/**
- * ʼ
- */
-void Maria::startBlock()
-{
-    if (_currentState == MariaState::IDLE || _currentState == MariaState::WALK) {
-        playAnimation(ANIM_START_BLOCK, false);
-
-        auto action = Sequence::create(
-            DelayTime::create(0.3f),
-            CallFunc::create([=]() { setState(MariaState::BLOCK_IDLE); }),
-            nullptr
-        );
-        action->setTag(100);
-        this->runAction(action);
-    }
-}
-
-/**
- * 
- */
-void Maria::stopBlock()
-{
-    if (_currentState == MariaState::BLOCK_IDLE) {
-        playAnimation(ANIM_DE_BLOCK, false);
-
-        auto action = Sequence::create(
-            DelayTime::create(0.3f),
-            CallFunc::create([=]() { setState(MariaState::IDLE); }),
-            nullptr
-        );
-        action->setTag(100);
-        this->runAction(action);
-    }
-}
-
-// =========================================================================
-// ֡·
-// =========================================================================
-
-/**
- * ÿ֡߼
- * @param dt ֡ʱ
- */
-void Maria::update(float dt)
-{
-    // /״̬µλƸ
-    if (_isAttacking && (_currentState == MariaState::ATTACKING ||
-        _currentState == MariaState::DODGING)) {
-        _attackElapsed += dt;
-        float t = std::min(_attackElapsed / _attackDuration, 1.0f);
-
-        float ease = 1.0f - (1.0f - t) * (1.0f - t);
-        float currentTotalDist = _attackDistance * ease;
-
-        // »׼λòýɫλ
-        _moveBasePos = _attackStartPos + _attackDirection * currentTotalDist;
-        setPosition3D(_moveBasePos);
-    }
-    // /״̬µƶ
-    else if (_currentState == MariaState::WALK || _currentState == MariaState::RUN) {
-        Vec3 moveDelta = _moveDirection * _moveSpeed * dt;
-        _moveBasePos += moveDelta;
-        setPosition3D(_moveBasePos);
-    }
-
-    // MPԶָ(״̬)
-    if (_currentState != MariaState::DEAD) {
-        if (_mp < _maxMp) {
-            float regen = _mpRegenRate * dt;
-            _mp = std::min((float)_maxMp, (float)_mp + regen);
-        }
-    }
-}
-
-// =========================================================================
-// ϵͳ
-// =========================================================================
-
-/**
- * ִй
- */
-void Maria::runAttackCombo()
-{
-    // 1. ״̬
-    if (!canPerformAttack()) return;
-
-    // 2. л
-    if (_currentState == MariaState::ATTACKING) {
-        _isNextComboBuffered = true;
-        return;
-    }
-
-    // 3. ʼ
-    _isNextComboBuffered = false;
-    _attackStartPos = _moveBasePos;
-    _attackDirection = getForwardVector();
-    _attackElapsed = 0.0f;
-    _isAttacking = true;
-    _currentState = MariaState::ATTACKING;
-
-    // 4. ȡǰϢ
-    _comboCount = (_comboCount % 3) + 1;
-    std::string nextAnim;
-    getComboData(_comboCount, nextAnim, _attackDistance, _attackDuration);
-
-    // 5. Ź
-    auto anim3d = Animation3D::create(Maria::ANIM_MODEL_PATH, nextAnim);
-    auto animateAction = Animate3D::create(anim3d);
-
-    auto attackSequence = Sequence::create(
-        animateAction,
-        CallFunc::create([this]() {
-            this->executeDamageDetection(); // ִ˺
-            this->_isAttacking = false;     // ״̬
-            this->handleComboEnd();         // н
-            }),
-        nullptr
-    );
-
-    this->stopAllActions();
-    this->runAction(attackSequence);
-}
-
-/**
- * Ƿִй
- * @return ǷԹ
- */
-bool Maria::canPerformAttack() {
-    return !(_currentState == MariaState::SKILLING ||
-        _currentState == MariaState::HURT ||
-        _currentState == MariaState::BLOCK_IDLE ||
-        _currentState == MariaState::CROUCH_IDLE);
-}
-
-/**
- * ȡ
- * @param combo 
- * @param animName 
- * @param distance λƾ
- * @param duration ʱ
- */
-void Maria::getComboData(int combo, std::string& animName, float& distance, float& duration) {
-    if (combo == 1) {
-        animName = ANIM_P_ATTACK1;
-        distance = 1.8f;
-        duration = 0.35f;
-    }
-    else if (combo == 2) {
-        animName = ANIM_P_ATTACK2;
-        distance = 3.0f;
-        duration = 0.4f;
-    }
-    else {
-        animName = ANIM_P_ATTACK3;
-        distance = 15.0f;
-        duration = 0.5f;
-    }
-}
-
-/**
- * ִ˺
- */
-void Maria::executeDamageDetection() {
-    auto scene = this->getParent();
-    if (!scene) return;
-
-    // ƫ15.0f
-    Vec3 attackCenter = this->getPosition3D() + _attackDirection * 15.0f;
-
-    for (auto node : scene->getChildren()) {
-        // ͨ
-        if (auto enemy = dynamic_cast<EnemyBase*>(node)) {
-            if (!enemy->isDead() && attackCenter.distance(enemy->getPosition3D()) < 100.0f) {
-                enemy->takeDamage(_attackPower);
-            }
-        }
-        // Boss
-        else if (auto boss = dynamic_cast<Boss*>(node)) {
-            if (!boss->IsDead() && attackCenter.distance(boss->getPosition3D()) < 200.0f) {
-                boss->TakeDamage(_attackPower);
-            }
-        }
-    }
-}
-
-/**
- * н߼
- */
-void Maria::handleComboEnd() {
-    if (_isNextComboBuffered) {
-        // лIDLE״̬һι
-        _currentState = MariaState::IDLE;
-        runAttackCombo();
-    }
-    else {
-        _comboCount = 0;
-        setState(MariaState::IDLE);
-    }
-}
-
-// =========================================================================
-// ӰӼϵͳ
-// =========================================================================
-
-/**
- * ִӰӼ
+ * ֹͣеĶ()
  */
-void Maria::runSkillShadow()
+void Maria::stopClip()
 {
-    // ״̬
-    if (_currentState != MariaState::IDLE &&
-        _currentState != MariaState::WALK &&
-        _currentState != MariaState::RUN) {
-        return;
-    }
-
-    // MP
-    if (_mp < SKILL_MP_COST) {
-        CCLOG("MP not enough! current: %d, need: %d", (int)_mp, SKILL_MP_COST);
-        return;
-    }
-
-    // MP
-    _mp -= SKILL_MP_COST;
-    CCLOG("Skill showed! cost %d MP, rest: %d", SKILL_MP_COST, (int)_mp);
-
-    // ִм߼
-    _currentState = MariaState::SKILLING;
     this->stopAllActions();
-    this->playAnimation(ANIM_SKILL_START, false);
-
-    // ֡
-    auto skillSequence = Sequence::create(
-        DelayTime::create(0.4f),
-        CallFunc::create([=]() { spawnGhostShadow(Vec3(5, 0, 10), ANIM_GHOST_1, 0.2f); }),
-        DelayTime::create(0.6f),
-        CallFunc::create([=]() { spawnGhostShadow(Vec3(0, 0, 0), ANIM_GHOST_2, 0.3f); }),
-        DelayTime::create(0.5f),
-        CallFunc::create([=]() { spawnGhostShadow(Vec3(0, 0, 8), ANIM_GHOST_3, 0.2f); }),
-        DelayTime::create(0.4f),
-        CallFunc::create([=]() { spawnGhostShadow(Vec3(0, 0, 15), ANIM_GHOST_4, 0.4f); }),
-        DelayTime::create(0.5f),
-        CallFunc::create([=]() { spawnGhostShadow(Vec3(-10, 0, 5), ANIM_GHOST_5, 0.2f); }),
-        DelayTime::create(0.6f),
-        CallFunc::create([=]() { this->onAnimationFinished(ANIM_SKILL_START); }),
-        nullptr
-    );
-
-    this->runAction(skillSequence);
 }
 
 /**
- * ӰӲִй
- * @param offset Ӱڽɫƫ
- * @param animName ӰӲŵĶ
- * @param delayDamage ˺ӳʱ
+ * ӲӰؽӰӽڵ㲢Ŷʱ黹
+ * @param position Ӱλ
+ * @param yaw Ӱ(Ƕ)
+ * @param clip ӰŵĶƬID
+ * @param lifetime Ӱʱ()
  */
-void Maria::spawnGhostShadow(const Vec3& offset, const std::string& animName, float delayDamage)
+void Maria::spawnAfterimage(const Vec3& position, float yaw, ClipId clip, float lifetime)
 {
-    // Ӱʵ
-    auto ghost = Maria::create(Maria::ANIM_MODEL_PATH);
+    // ӲӰؽӰӽڵ(ɳԤ)
+    if (!_afterimagePool) return;
+    auto ghost = _afterimagePool->acquire();
     if (!ghost) return;
+    auto pool = _afterimagePool;
 
     // Ӱ
-    ghost->setPosition3D(this->getPosition3D() + offset);
-    ghost->setRotation3D(this->getRotation3D());
-    ghost->setCameraMask(this->getCameraMask());
-    ghost->setCascadeOpacityEnabled(true);
+    ghost->setPosition3D(position);
+    ghost->setRotation3D(Vec3(0, yaw, 0));
     ghost->setOpacity(180);
-    ghost->setLightMask(0);
     ghost->setScale(0.5f);
 
-    // ӰӲҪ߼
-    ghost->unscheduleUpdate();
-    this->getParent()->addChild(ghost);
+    // ӰֻŶ(˺߼Ǽ)
+    auto anim3d = AnimationClipCache::getInstance()->getClip(clip);
+    if (anim3d) ghost->runAction(Animate3D::create(anim3d));
 
-    // ӰӶ
-    auto anim3d = Animation3D::create(Maria::ANIM_MODEL_PATH, animName);
-    auto animate = Animate3D::create(anim3d);
-
-    // ˺߼
-    auto damageLogic = CallFunc::create([this, ghost]() {
-        float damageRange = 60.0f;
-        int damageValue = (int)(this->_attackPower * 0.8f);
-        Vec3 ghostPos = ghost->getPosition3D();
-
-        auto scene = this->getParent();
-        for (auto node : scene->getChildren()) {
-            // ͨ˼
-            auto enemy = dynamic_cast<EnemyBase*>(node);
-            if (enemy && !enemy->isDead()) {
-                if (ghostPos.distance(enemy->getPosition3D()) < damageRange) {
-                    enemy->takeDamage(damageValue);
-                }
-            }
-            // Boss
-            auto boss = dynamic_cast<Boss*>(node);
-            if (boss && !boss->IsDead()) {
-                if (ghostPos.distance(boss->getPosition3D()) < 50.0f) {
-                    boss->TakeDamage(damageValue);
-                }
-            }
-        }
-        });
-
-    // Ӱ
-    ghost->runAction(Sequence::create(
-        Spawn::create(
-            animate,
-            Sequence::create(DelayTime::create(delayDamage), damageLogic, nullptr),
-            nullptr
-        ),
-        CallFunc::create([ghost]() { ghost->removeFromParent(); }),
-        nullptr
-    ));
-}
-
-// =========================================================================
-// ˺Ѫϵͳ
-// =========================================================================
-
-/**
- * ܵ˺
- * @param damage ˺ֵ
- */
-void Maria::takeDamage(int damage) {
-    // ״̬
-    if (_currentState == MariaState::DEAD || _currentState == MariaState::DODGING) {
-        return;
-    }
-
-    // ˺(񵲼)
-    int finalDamage = damage;
-    if (_currentState == MariaState::BLOCK_IDLE) {
-        finalDamage = std::max(1, (int)(damage * 0.2f)); // 1˺
-    }
-
-    _hp -= finalDamage;
-    CCLOG("Maria took %d damage, remaining HP: %d", finalDamage, _hp);
-
-    // Ѫ״̬⴦
-    if (_currentState == MariaState::RECOVER) {
-        if (_hp <= 0) { /* ... */ }
-        return;
-    }
-
-    // ֹͣǰж
-    this->stopAllActions();
-
-    if (_hp <= 0) {
-        _hp = 0;
-        setState(MariaState::DEAD);
-        playAnimation(ANIM_DEAD, false);
-    }
-    else {
-        setState(MariaState::HURT);
-        playAnimation(ANIM_HURT, false);
-
-        // ܻ󷵻idle
-        this->runAction(Sequence::create(
-            DelayTime::create(0.5f),
-            CallFunc::create([this]() {
-                if (_currentState != MariaState::DEAD) {
-                    this->setState(MariaState::IDLE);
-                    this->playAnimation(ANIM_IDLE, true);
-                }
-                }),
-            nullptr
-        ));
-    }
-}
-
-/**
- * ִлѪ
- */
-void Maria::runRecover() {
-    if (_recoverCount <= 0 ||
-        _currentState == MariaState::DEAD ||
-        _currentState == MariaState::RECOVER) {
-        return;
-    }
-
-    // 1. ۳Ѫ
-    _recoverCount--;
-    _hp = std::min(_hp + RECOVER_AMOUNT, 180);
-
-    // 2. Ѫ״̬Ŷ
-    setState(MariaState::RECOVER);
-    auto anim3d = Animation3D::create(Maria::ANIM_MODEL_PATH, ANIM_RECOVER);
-    if (anim3d) {
-        auto animate = Animate3D::create(anim3d);
-        auto seq = Sequence::create(
-            animate,
-            CallFunc::create([this]() {
-                // ָ IDLE ״̬
-                this->setState(MariaState::IDLE);
-                this->playAnimation(ANIM_IDLE, true);
-                }),
-            nullptr
-        );
-        this->runAction(seq);
-    }
-}
-
-/**
- * 
- * @param enemy Ŀ
- */
-void Maria::attackEnemy(EnemyBase* enemy) {
-    if (enemy && !enemy->isDead()) {
-        enemy->takeDamage(_attackPower);
-    }
+    // 黹Ӱ(ʩߣʩ߱ʱٳӰճ)
+    TimerWheel* timers = _logic.getTimerWheel();
+    if (timers)
+        timers->schedule(EntityHandle(), lifetime, [pool, ghost]() { pool->release(ghost); });
 }
\ No newline at end of file
@@ -4,35 +4,18 @@
 #include "3d/CCSprite3D.h"
 #include "3d/CCAnimation3D.h"
 #include "3d/CCAnimate3D.h"
-#include <map>
-#include "Player.h"
+#include <functional>
+#include "MariaLogic.h"
+#include "AfterimagePool.h"
 
 USING_NS_CC;
 
 /**
- * Mariaɫ״̬ö
- * ɫܵ״̬
+ * Mariaɫ(Ⱦ)
+ * ̳Sprite3D߼ȫڳе MariaLogic У
+ * תѯӿڣʵֶӰ֣߼ºλ/ͬڵ
  */
-enum class MariaState {
-    IDLE,           //  idle״̬
-    WALK,           //  ״̬
-    RUN,            //  ״̬
-    ATTACKING,      //  ״̬
-    SKILLING,       //  ͷ״̬
-    BLOCK_IDLE,     //  񵲳״̬
-    CROUCH_IDLE,    //  ¶׳״̬
-    JUMPING,        //  Ծ״̬
-    HURT,           //  ܻ״̬
-    DODGING,        //  ״̬
-    DEAD,           //  ״̬
-    RECOVER         //  Ѫ״̬
-};
-
-/**
- * Mariaɫ
- * ̳Sprite3Dʵֽɫƶսȹ
- */
-class Maria : public Sprite3D, public Player
+class Maria : public Sprite3D, public MariaView
 {
 public:
     /**
@@ -49,282 +32,109 @@ public:
      */
     bool init(const std::string& modelPath);
 
-
-    //------------------------------
-    // ɫΪӦⲿӿ
-    //------------------------------
-
-    /**
-     * ִй
-     * ʵ߼
-     */
-    void runAttackCombo();
-
-    /**
-     * ȡɫǰ(XZƽ)
-     * @return ׼ǰ
-     */
-    Vec3 getForwardVector() const;
-
     /**
-     * ִӰӼ
-     * ͷӰЧ
+     * ԤȫƬβǼƬID
+     * ʱһΣ֮󲥷Ŷʱ
      */
-    void runSkillShadow();
+    static void preloadAnimations() { MariaLogic::preloadAnimations(); }
 
-    /**
-     * ִԾ
-     * ӦShift
-     */
-    void runJump();
-
-    /**
-     * л¶״̬(¶/վ)
-     * ӦQ
-     */
-    void toggleCrouch();
-
-    /**
-     * ʼ
-     * ӦҼ¼
-     */
-    void startBlock();
-
-    /**
-     * 
-     * ӦҼͷ¼
-     */
-    void stopBlock();
-
-    /**
-     * ƶɫ
-     * ӦWASDSpaceʵƶ
-     * @param direction ƶ
-     * @param isRunning ǷΪ״̬
-     */
-    void runMove(const Vec3& direction, bool isRunning);
-
-    /**
-     * ֹͣƶ
-     * ˳ƶ״̬
-     */
-    void stopMove();
-
-    /**
-     * ִܶ
-     * @param direction ܷ
-     */
-    void runDodge(const Vec3& direction);
 
     //------------------------------
-    // ؽӿ
+    // ɫΪӦⲿӿ(ת߼)
     //------------------------------
 
-    /**
-     * YתǶ
-     * @param angle Ƕֵ(Ƕ)
-     */
-    void setCameraYawAngle(float angle) { _cameraYawAngle = angle; }
-
-    /**
-    * ZתǶ
-    * @param angle Ƕֵ(Ƕ)
-	*/
-    void setCameraPitchAngle(float angle) { _cameraPitchAngle = angle; }
-
-    /**
-     * лĿ״̬
-     * @param isLocked ǷĿ
-     * @param targetDir Ŀ귽(ʱΪĿ귽δʱΪɫǰ)
-     */
-    void toggleLock(bool isLocked, const Vec3& targetDir);
+    void runAttackCombo() { _logic.runAttackCombo(); }                // 
+    Vec3 getForwardVector() const { return _logic.getForwardVector(); }
+    void runSkillShadow() { _logic.runSkillShadow(); }                // ӰӼ
+    void runJump() { _logic.runJump(); }                              // Ծ(Shift)
+    void toggleCrouch() { _logic.toggleCrouch(); }                    // л¶(Q)
+    void startBlock() { _logic.startBlock(); }                        // ʼ(Ҽ)
+    void stopBlock() { _logic.stopBlock(); }                          // (Ҽͷ)
+    void runMove(const Vec3& direction, bool isRunning) { _logic.runMove(direction, isRunning); }  // ƶ(WASD)
+    void stopMove() { _logic.stopMove(); }                            // ֹͣƶ
+    void runDodge(const Vec3& direction) { _logic.runDodge(direction); }  // 
+    void runRecover() { _logic.runRecover(); }                        // Ѫ
 
-    /**
-     * ȡǰǷת״̬
-     * @return ״̬(trueΪfalseΪδ)
-     */
-    bool isRotationLocked() const { return _isRotationLocked; }
-    bool _isRotationLocked = false;  // Ƿת״̬
-
-    void runRecover();                  // ѪΪ
-    int getRecoverCount() const { return _recoverCount; }  // ȡʣѪ
-
-    //------------------------------
-    // Playerӿʵ
-    //------------------------------
-    virtual void takeDamage(int damage) override;
-    virtual cocos2d::Vec3 getPosition3D() const override { return Sprite3D::getPosition3D(); }
-    virtual void attackEnemy(EnemyBase* enemy) override;
-
-    // ȡǰHPֵ
-    int getHP() const { return _hp; }
-
-    // ȡǰMPֵ
-    int getMP() const { return _mp; }
-    int getMaxMP() const { return _maxMp; }
-
-private:
-    //------------------------------
-    // ״̬
-    //------------------------------
-    MariaState _currentState = MariaState::IDLE;  // ǰɫ״̬
-    int _comboCount = 0;                          // м
-    bool _isAttacking = false;                    // Ƿڹ
-    bool _isNextComboBuffered = false;            // Ƿ񻺴һιָ
-
-    //------------------------------
-    // ر
-    //------------------------------
-    Vec3 _attackStartPos;         // ʼʱλ(λƼ)
-    float _attackElapsed = 0.0f;  // ѳʱ
-    float _attackDuration = 0.0f; // ʱ
-    float _attackDistance = 0.0f; // λƾ
-    Vec3 _attackDirection;        // (λƷ)
-
-    //------------------------------
-    // MPر
-    //------------------------------
-    int _mp = 100;
-    int _maxMp = 100;
-    int _mpRegenRate = 5;         // ÿMPָ
-    const int SKILL_MP_COST = 30; // MPֵ
-
-    //------------------------------
-    // ֵ˺ر
-    //------------------------------
-    int _hp = 180;
-    int _attackPower = 50;
-    float _attackRange = 30.0f;   // ⷶΧ
-    int _recoverCount = 5;        // ʼѪ
-    const int RECOVER_AMOUNT = 30;// ÿλѪֵ
-
-    //------------------------------
-    // ƶر
     //------------------------------
-    Vec3 _moveBasePos;            // ƶ׼λ
-    Vec3 _moveDirection;          // ƶ
-    float _moveSpeed = 0.0f;      // ǰƶٶ
-    const float _walkSpeed = 200.0f;   // ٶ
-    const float _runSpeed = 400.0f;   // ٶ
-
-    //------------------------------
-    // ر
+    // ؽӿ
     //------------------------------
-    const float _dodgeDistance = 12.0f;  // ܾ
-    const float _dodgeDuration = 0.4f;   // ܳʱ
 
-    //------------------------------
-    // ر
-    //------------------------------
-    float _cameraYawAngle = 0.0f;        // YתǶ(Ƕ)
-	float _cameraPitchAngle = 0.0f;      // ZתǶ(Ƕ)
-    Vec3 _lockedDirection = Vec3::ZERO;  // ʱɫķ
+    void setCameraYawAngle(float angle) { _logic.setCameraYawAngle(angle); }
+    void setCameraPitchAngle(float angle) { _logic.setCameraPitchAngle(angle); }
+    void toggleLock(bool isLocked, const Vec3& targetDir) { _logic.toggleLock(isLocked, targetDir); }
+    bool isRotationLocked() const { return _logic.isRotationLocked(); }
 
     //------------------------------
-    // ر
+    // ״̬ѯ
     //------------------------------
-    Action* _comboWindowAction = nullptr;  // дڶ
 
-    //------------------------------
-    // Դ·
-    //------------------------------
-    const static std::string ANIM_MODEL_PATH;  // ģļ·
-
-    // 
-    const static std::string ANIM_IDLE;        // 
-    const static std::string ANIM_WALK;        // ߶
-    const static std::string ANIM_RUN;         // ܶ
-
-    // 
-    const static std::string ANIM_P_ATTACK1;   // ͨ1
-    const static std::string ANIM_P_ATTACK2;   // ͨ2
-    const static std::string ANIM_P_ATTACK3;   // ͨ3
+    /** ɫ߼(Ⱦ) */
+    MariaLogic& getLogic() { return _logic; }
 
-    // ܶ
-    const static std::string ANIM_SKILL_START; // ܿʼ
-    const static std::string ANIM_GHOST_1;     // ӰӼ1
-    const static std::string ANIM_GHOST_2;     // ӰӼ2
-    const static std::string ANIM_GHOST_3;     // ӰӼ3
-    const static std::string ANIM_GHOST_4;     // ӰӼ4
-    const static std::string ANIM_GHOST_5;     // ӰӼ5
+    // ȡʵ(/BossԴΪĿ)
+    EntityHandle getEntityHandle() const { return _logic.getEntityHandle(); }
 
-    // ״̬
-    const static std::string ANIM_JUMP;        // Ծ
-    const static std::string ANIM_START_CROUCH;// ʼ¶׶
-    const static std::string ANIM_CROUCH_IDLE; // ¶״
-    const static std::string ANIM_DE_CROUCH;   // ¶׶
-    const static std::string ANIM_START_BLOCK; // ʼ񵲶
-    const static std::string ANIM_BLOCK_IDLE;  // 񵲴
-    const static std::string ANIM_DE_BLOCK;    // 񵲶
-    const static std::string ANIM_HURT;        // ܻ
-    const static std::string ANIM_DEAD;        // 
-    const static std::string ANIM_RECOVER;     // Ѫ
-
-    // ܶ
-    const static std::string ANIM_DODGE_BACK;  // 
-    const static std::string ANIM_DODGE_FRONT; // ǰ
-    const static std::string ANIM_DODGE_LEFT;  // 
-    const static std::string ANIM_DODGE_RIGHT; // 
-
-    //------------------------------
-    // ڲ
-    //------------------------------
+    int getHP() const { return _logic.getHP(); }
+    int getMP() const { return _logic.getMP(); }
+    int getMaxMP() const { return _logic.getMaxMP(); }
+    int getRecoverCount() const { return _logic.getRecoverCount(); }  // ȡʣѪ
 
     /**
-     * Ŷ
-     * @param animName 
-     * @param loop Ƿѭ
+     * սλ(ɳά)жͨѯ
+     * @param grid սλ
      */
-    void playAnimation(const std::string& animName, bool loop = false);
+    void setCombatGrid(const CombatantGrid* grid) { _logic.setCombatGrid(grid); }
 
     /**
-     * ɻص
-     * @param animName ɵĶ
+     * ùؿ̬ײ(ɳУлؿʱ)ƶ빥λײǽʱǽ
+     * @param collision ײ(Ϊʱǽײ)
      */
-    void onAnimationFinished(const std::string& animName);
+    void setCollisionWorld(const CollisionWorld* collision) { _logic.setCollisionWorld(collision); }
 
     /**
-     * ýɫ״̬
-     * @param newState ״̬
+     * ӰӼʹõĲӰڵ(ɳ)
+     * @param pool Ӱڵ
      */
-    void setState(MariaState newState);
+    void setAfterimagePool(AfterimagePool* pool) { _afterimagePool = pool; }
 
     /**
-     * ֡º
-     * @param dt ֡ʱ
+     * 淨ʱ(ɳģ)ֶܷεӳ߼еǼ
+     * @param timers ʱ
      */
-    void update(float dt) override;
+    void setTimerWheel(TimerWheel* timers) { _logic.setTimerWheel(timers); }
 
     /**
-     * ӰӲִй
-     * @param offset ڽɫƫλ
-     * @param animName ӰӲŵĶ
-     * @param delayDamage ˺ӳʱ(϶֡)
+     * ýű(ɳģ)ʱΪ
+     * @param tasks 
      */
-    void spawnGhostShadow(const Vec3& offset, const std::string& animName, float delayDamage);
+    void setTaskScheduler(TaskScheduler* tasks) { _logic.setTaskScheduler(tasks); }
 
     /**
-     * Ƿִй
-     * @return ǷԹ
+     * ս¼(ɳģ)жеǼУtickʱͳһ
+     * @param events ¼
      */
-    bool canPerformAttack();
+    void setCombatEvents(CombatEventQueue* events) { _logic.setCombatEvents(events); }
 
     /**
-     * ݵǰȡ
-     * @param combo 
-     * @param animName 
-     * @param distance λƾ
-     * @param duration ʱ
+     * ״̬仯ص(HP/MP/Ѫ仯ʱ)HUDݴ˰ˢ
+     * @param callback ص
      */
-    void getComboData(int combo, std::string& animName, float& distance, float& duration);
+    void setStatusChangedCallback(const std::function<void()>& callback) { _logic.setStatusChangedCallback(callback); }
 
     /**
-     * ִзΧ˺
+     * ߼(ɳĹ̶ģ)֮߼λ/ͬڵ
+     * @param dt ̶
      */
-    void executeDamageDetection();
+    void update(float dt) override;
 
-    /**
-     * н߼
-     */
-    void handleComboEnd();
+    //------------------------------
+    // MariaViewӿʵ
+    //------------------------------
+    virtual bool playClip(ClipId clip, bool loop) override;
+    virtual void stopClip() override;
+    virtual void spawnAfterimage(const Vec3& position, float yaw, ClipId clip, float lifetime) override;
+
+private:
+    MariaLogic _logic;                          // ɫ߼
+    AfterimagePool* _afterimagePool = nullptr;  // ӰӼܲӰ()
 };
\ No newline at end of file
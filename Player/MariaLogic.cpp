@@ -0,0 +1,1038 @@
+#include "MariaLogic.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/EnemyStore.h"
+#include "Enemy/Boss/BossLogic.h"
+#include "Core/CollisionWorld.h"
+#include "Core/HitWindowTable.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+// =========================================================================
+// 静态常量定义(动画片段ID在 preloadAnimations 中登记)
+// =========================================================================
+const std::string MariaLogic::ANIM_MODEL_PATH = "Maria.c3b";
+
+// 碰撞胶囊尺寸
+static const float COLLISION_RADIUS = 25.0f;
+static const float COLLISION_HEIGHT = 150.0f;
+
+// 命中窗口判定时目标的身体半径
+static const float ENEMY_HIT_RADIUS = 40.0f;
+static const float BOSS_HIT_RADIUS = 140.0f;
+
+// 动画片段缺失时的兜底时长
+static const float RECOVER_FALLBACK_DURATION = 1.0f;   // 回血动画
+static const float GHOST_FALLBACK_LIFETIME = 1.0f;     // 影子存在时长
+
+// 基础动画
+ClipId MariaLogic::ANIM_IDLE = INVALID_CLIP;
+ClipId MariaLogic::ANIM_WALK = INVALID_CLIP;
+ClipId MariaLogic::ANIM_RUN = INVALID_CLIP;
+
+// 攻击动画
+ClipId MariaLogic::ANIM_P_ATTACK1 = INVALID_CLIP;
+ClipId MariaLogic::ANIM_P_ATTACK2 = INVALID_CLIP;
+ClipId MariaLogic::ANIM_P_ATTACK3 = INVALID_CLIP;
+
+// 技能动画
+ClipId MariaLogic::ANIM_SKILL_START = INVALID_CLIP;
+ClipId MariaLogic::ANIM_GHOST_1 = INVALID_CLIP;
+ClipId MariaLogic::ANIM_GHOST_2 = INVALID_CLIP;
+ClipId MariaLogic::ANIM_GHOST_3 = INVALID_CLIP;
+ClipId MariaLogic::ANIM_GHOST_4 = INVALID_CLIP;
+ClipId MariaLogic::ANIM_GHOST_5 = INVALID_CLIP;
+
+// 特殊状态动画
+ClipId MariaLogic::ANIM_JUMP = INVALID_CLIP;
+ClipId MariaLogic::ANIM_START_CROUCH = INVALID_CLIP;
+ClipId MariaLogic::ANIM_CROUCH_IDLE = INVALID_CLIP;
+ClipId MariaLogic::ANIM_DE_CROUCH = INVALID_CLIP;
+
+ClipId MariaLogic::ANIM_START_BLOCK = INVALID_CLIP;
+ClipId MariaLogic::ANIM_BLOCK_IDLE = INVALID_CLIP;
+ClipId MariaLogic::ANIM_DE_BLOCK = INVALID_CLIP;
+
+// 闪避动画
+ClipId MariaLogic::ANIM_DODGE_BACK = INVALID_CLIP;
+ClipId MariaLogic::ANIM_DODGE_FRONT = INVALID_CLIP;
+ClipId MariaLogic::ANIM_DODGE_LEFT = INVALID_CLIP;
+ClipId MariaLogic::ANIM_DODGE_RIGHT = INVALID_CLIP;
+
+// 受击与死亡动画
+ClipId MariaLogic::ANIM_HURT = INVALID_CLIP;
+ClipId MariaLogic::ANIM_DEAD = INVALID_CLIP;
+ClipId MariaLogic::ANIM_RECOVER = INVALID_CLIP;
+
+/**
+ * 网格候选是否为存活的普通敌人
+ * 有渲染代理的按代理判断，无代理的(无头模拟)按数据仓库判断
+ */
+static bool isLivingEnemy(EntityRegistry* registry, const Combatant& candidate)
+{
+    if (candidate.kind == EntityKind::ENEMY) {
+        auto enemy = registry->getEnemy(candidate.handle);
+        return enemy && !enemy->isDead();
+    }
+    if (candidate.kind == EntityKind::STORED_ENEMY) {
+        int index = -1;
+        auto store = registry->getStoredEnemy(candidate.handle, index);
+        return store && !store->isDead(index);
+    }
+    return false;
+}
+
+// =========================================================================
+// 初始化与销毁相关方法
+// =========================================================================
+
+/**
+ * 预加载Maria的全部动画片段(场景加载时调用一次)
+ * 之后播放动画只按片段ID取缓存，不再按名字创建 Animation3D
+ */
+void MariaLogic::preloadAnimations()
+{
+    auto cache = AnimationClipCache::getInstance();
+
+    // 基础动画
+    ANIM_IDLE = cache->registerClip(ANIM_MODEL_PATH, "Armature|idle");
+    ANIM_WALK = cache->registerClip(ANIM_MODEL_PATH, "Armature|walk");
+    ANIM_RUN = cache->registerClip(ANIM_MODEL_PATH, "Armature|run_forward");
+
+    // 攻击动画
+    ANIM_P_ATTACK1 = cache->registerClip(ANIM_MODEL_PATH, "Armature|slash_1");
+    ANIM_P_ATTACK2 = cache->registerClip(ANIM_MODEL_PATH, "Armature|slash_4");
+    ANIM_P_ATTACK3 = cache->registerClip(ANIM_MODEL_PATH, "Armature|slash_2");
+
+    // 技能动画
+    ANIM_SKILL_START = cache->registerClip(ANIM_MODEL_PATH, "Armature|pose");
+    ANIM_GHOST_1 = cache->registerClip(ANIM_MODEL_PATH, "Armature|slash_2");
+    ANIM_GHOST_2 = cache->registerClip(ANIM_MODEL_PATH, "Armature|slide_attack");
+    ANIM_GHOST_3 = cache->registerClip(ANIM_MODEL_PATH, "Armature|right_kick");
+    ANIM_GHOST_4 = cache->registerClip(ANIM_MODEL_PATH, "Armature|highSpinAttack");
+    ANIM_GHOST_5 = cache->registerClip(ANIM_MODEL_PATH, "Armature|left_kick");
+
+    // 特殊状态动画
+    ANIM_JUMP = cache->registerClip(ANIM_MODEL_PATH, "Armature|jump");            // 跳跃动画
+    ANIM_START_CROUCH = cache->registerClip(ANIM_MODEL_PATH, "Armature|crouch");  // 开始下蹲
+    ANIM_CROUCH_IDLE = cache->registerClip(ANIM_MODEL_PATH, "Armature|crouching");// 下蹲待机
+    ANIM_DE_CROUCH = cache->registerClip(ANIM_MODEL_PATH, "Armature|decrouch");   // 结束下蹲
+
+    ANIM_START_BLOCK = cache->registerClip(ANIM_MODEL_PATH, "Armature|block");    // 开始格挡
+    ANIM_BLOCK_IDLE = cache->registerClip(ANIM_MODEL_PATH, "Armature|block_hold");// 格挡待机
+    ANIM_DE_BLOCK = cache->registerClip(ANIM_MODEL_PATH, "Armature|deblock");     // 结束格挡
+
+    // 闪避动画
+    ANIM_DODGE_BACK = cache->registerClip(ANIM_MODEL_PATH, "Armature|dodge_backword");
+    ANIM_DODGE_FRONT = cache->registerClip(ANIM_MODEL_PATH, "Armature|dodge_forward");
+    ANIM_DODGE_LEFT = cache->registerClip(ANIM_MODEL_PATH, "Armature|dodge_right");
+    ANIM_DODGE_RIGHT = cache->registerClip(ANIM_MODEL_PATH, "Armature|dodge_left");
+
+    // 受击与死亡动画
+    ANIM_HURT = cache->registerClip(ANIM_MODEL_PATH, "Armature|impact_small");    // 受击动画
+    ANIM_DEAD = cache->registerClip(ANIM_MODEL_PATH, "Armature|dead");            // 死亡动画
+    ANIM_RECOVER = cache->registerClip(ANIM_MODEL_PATH, "Armature|casting");      // 回血动画
+}
+
+/**
+ * 登记实体句柄并进入待机状态
+ * @param view 表现接口(无头模拟中为nullptr)
+ * @param node 对应的场景节点(无头模拟中为nullptr)
+ */
+void MariaLogic::init(MariaView* view, Node* node)
+{
+    _view = view;
+    _moveBasePos = _position;
+    _currentState = MariaState::IDLE;
+    playAnimation(ANIM_IDLE, true);
+
+    EntityRegistry::getInstance()->destroy(_entityHandle);
+    _entityHandle = EntityRegistry::getInstance()->createPlayer(this, node);
+}
+
+/**
+ * 析构：注销实体句柄，之后敌人/Boss与延迟回调查到的目标为空
+ */
+MariaLogic::~MariaLogic()
+{
+    EntityRegistry::getInstance()->destroy(_entityHandle);
+}
+
+/**
+ * 放置角色
+ * @param position 世界坐标
+ */
+void MariaLogic::setPosition3D(const Vec3& position)
+{
+    _position = position;
+    _moveBasePos = position;
+}
+
+/**
+ * 动画片段时长(片段缺失时返回兜底时长)
+ * @param clip 动画片段ID
+ * @param fallback 兜底时长
+ */
+float MariaLogic::getClipDuration(ClipId clip, float fallback)
+{
+    float duration = AnimationClipCache::getInstance()->getDuration(clip);
+    return duration > 0.0f ? duration : fallback;
+}
+
+// =========================================================================
+// 动画播放相关方法
+// =========================================================================
+
+/**
+ * 播放指定动画
+ * @param clip 动画片段ID
+ * @param loop 是否循环播放
+ */
+void MariaLogic::playAnimation(ClipId clip, bool loop)
+{
+    if (!_view) return;
+
+    if (!_view->playClip(clip, loop)) {
+        CCLOGERROR("Animation not found: %d", clip);
+        setState(MariaState::IDLE);
+    }
+}
+
+/**
+ * 动画播放完成回调处理
+ * @param clip 完成的动画片段ID（当前处理与具体片段无关）
+ */
+void MariaLogic::onAnimationFinished(ClipId /*clip*/)
+{
+    // 非攻击/下蹲/格挡状态自动返回idle
+    if (_currentState != MariaState::ATTACKING &&
+        _currentState != MariaState::CROUCH_IDLE &&
+        _currentState != MariaState::BLOCK_IDLE)
+    {
+        setState(MariaState::IDLE);
+    }
+}
+
+// =========================================================================
+// 状态管理方法
+// =========================================================================
+
+/**
+ * 设置角色状态并切换对应动画
+ * @param newState 新状态
+ */
+void MariaLogic::setState(MariaState newState)
+{
+    if (_currentState == newState)
+        return;
+
+    MariaState oldState = _currentState; // 记录旧状态
+    _currentState = newState;
+
+    // 攻击/闪避状态结束时更新基准位置
+    if (oldState == MariaState::ATTACKING || oldState == MariaState::DODGING) {
+        _moveBasePos = _position;
+        _isAttacking = false;           // 确保攻击状态结束
+    }
+
+    // 取消上一状态登记的过渡定时器(跳跃/受击/回血结束等)，避免过期回调打断新状态
+    if (_timers) _timers->cancel(_stateTimer);
+
+    switch (newState)
+    {
+        case MariaState::IDLE:
+            playAnimation(ANIM_IDLE, true);
+            _moveSpeed = 0.0f;
+            _moveBasePos = _position; // 重置基准位置
+            break;
+
+        case MariaState::HURT:
+            _moveSpeed = 0.0f;
+            _isAttacking = false; // 受击时停止所有攻击
+            break;
+
+        case MariaState::WALK:
+            playAnimation(ANIM_WALK, true);
+            _moveSpeed = _walkSpeed;
+            break;
+
+        case MariaState::RUN:
+            playAnimation(ANIM_RUN, true);
+            _moveSpeed = _runSpeed;
+            break;
+
+        case MariaState::BLOCK_IDLE:
+            playAnimation(ANIM_BLOCK_IDLE, true);
+            _moveSpeed = 0.0f;
+            break;
+
+        case MariaState::CROUCH_IDLE:
+            playAnimation(ANIM_CROUCH_IDLE, true);
+            _moveSpeed = 0.0f;
+            break;
+
+        case MariaState::JUMPING:
+            // JUMPING状态在runJump()中处理动画
+            break;
+
+        case MariaState::DODGING:
+            _moveSpeed = 0.0f; // 速度在update的attack逻辑中处理
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * 只停止正在播放的动画
+ */
+void MariaLogic::stopActions()
+{
+    if (_view) _view->stopClip();
+}
+
+/**
+ * 停止动画并取消自身的定时器与脚本任务
+ * 约定：只在真正打断当前行为处调用(受击、闪避、开始新一段连招或技能)；
+ * 普通的动画/状态切换只调用 stopActions，不影响已登记的过渡定时器与刚启动的任务
+ */
+void MariaLogic::stopActionsAndTimers()
+{
+    stopActions();
+    if (_timers) _timers->cancelOwner(_entityHandle);
+    if (_tasks) _tasks->cancelOwner(_entityHandle);
+}
+
+/**
+ * 登记状态过渡定时器
+ * @param seconds 过渡时长
+ * @param newState 过渡结束后的状态
+ */
+void MariaLogic::scheduleStateChange(float seconds, MariaState newState)
+{
+    if (_timers) _timers->cancel(_stateTimer);
+    _stateTimer = scheduleTimer(seconds, [this, newState]() { setState(newState); });
+}
+
+// =========================================================================
+// 移动与旋转相关方法
+// =========================================================================
+
+/**
+ * 获取角色当前前向向量(XZ平面)
+ * @return 标准化的前向向量
+ */
+Vec3 MariaLogic::getForwardVector() const
+{
+    float yaw = CC_DEGREES_TO_RADIANS(_yaw);
+    return Vec3(sinf(yaw), 0, cosf(yaw)).getNormalized();
+}
+
+/**
+ * 执行移动逻辑
+ * @param direction 输入方向向量
+ * @param isRunning 是否为奔跑状态
+ */
+void MariaLogic::runMove(const Vec3& direction, bool isRunning)
+{
+    // 攻击状态下仅允许旋转
+    if (_isAttacking) {
+        if (_isRotationLocked) {
+            // 锁定状态下朝向锁定方向
+            _yaw = CC_RADIANS_TO_DEGREES(atan2f(_lockedDirection.x, _lockedDirection.z));
+        }
+        else {
+            // 非锁定状态下朝向移动方向
+            Vec3 dir(direction.x, 0, direction.z);
+            if (dir.lengthSquared() > 0.01f) {
+                dir.normalize();
+                float angle = CC_RADIANS_TO_DEGREES(atan2f(dir.x, dir.z));
+                _yaw += (angle - _yaw) * 0.2f;
+            }
+        }
+        return;
+    }
+
+    // 闪避/攻击状态下不能移动
+    if (_currentState == MariaState::DODGING || _isAttacking) {
+        return;
+    }
+
+    // 1. 处理输入方向 (direction为本地坐标系的方向: X/Z)
+    Vec3 moveInput(direction.x, 0, direction.z);
+    if (moveInput.lengthSquared() < 0.0001f) {
+        // 无输入时停止移动
+        if (_currentState == MariaState::WALK || _currentState == MariaState::RUN) {
+            setState(MariaState::IDLE);
+        }
+        return;
+    }
+    moveInput.normalize();
+
+    // 2. 转换相机角度为弧度
+    float cameraYaw = CC_DEGREES_TO_RADIANS(this->_cameraYawAngle);
+
+    // 3. 计算相机坐标系的前向和右向向量 (XZ平面)
+    Vec3 camForward = Vec3(sinf(cameraYaw), 0.0f, cosf(cameraYaw));
+    Vec3 camRight = Vec3(camForward.z, 0.0f, -camForward.x);
+
+    // 4. 将输入方向转换为世界坐标系方向
+    Vec3 moveDir = camForward * moveInput.z - camRight * moveInput.x;
+    moveDir.normalize();
+
+    // 角色旋转处理
+    if (!_isRotationLocked) {
+        // 计算目标角度
+        float targetAngle = CC_RADIANS_TO_DEGREES(atan2f(moveDir.x, moveDir.z));
+        float angleDiff = targetAngle - _yaw;
+
+        // 处理角度跨越0/360度边界的情况
+        while (angleDiff > 180.0f)  angleDiff -= 360.0f;
+        while (angleDiff < -180.0f) angleDiff += 360.0f;
+
+        // 平滑旋转
+        _yaw += angleDiff * 0.2f;
+    }
+    else {
+        // 锁定状态下朝向锁定方向
+        float targetAngle = CC_RADIANS_TO_DEGREES(atan2f(_lockedDirection.x, _lockedDirection.z));
+        float angleDiff = targetAngle - _yaw;
+
+        while (angleDiff > 180.0f)  angleDiff -= 360.0f;
+        while (angleDiff < -180.0f) angleDiff += 360.0f;
+
+        _yaw += angleDiff;
+    }
+
+    // 设置移动状态
+    setState(isRunning ? MariaState::RUN : MariaState::WALK);
+    _moveDirection = moveDir; // 存储方向用于update()
+}
+
+/**
+ * 停止移动
+ */
+void MariaLogic::stopMove()
+{
+    // 仅在行走/奔跑状态时停止
+    if (_currentState == MariaState::WALK || _currentState == MariaState::RUN) {
+        setState(MariaState::IDLE);
+    }
+}
+
+// =========================================================================
+// 闪避相关方法
+// =========================================================================
+
+/**
+ * 执行闪避动作
+ * @param direction 闪避方向向量
+ */
+void MariaLogic::runDodge(const Vec3& direction)
+{
+    // 仅在idle/walk/run状态可闪避
+    if (_currentState != MariaState::IDLE &&
+        _currentState != MariaState::WALK &&
+        _currentState != MariaState::RUN) {
+        return;
+    }
+
+    stopActionsAndTimers();
+
+    // 1. 确定闪避动画和方向
+    ClipId dodgeAnim = ANIM_DODGE_BACK; // 默认后闪避
+    Vec3 worldDodgeDir;
+
+    // 相机坐标系转换
+    float cameraYaw = CC_DEGREES_TO_RADIANS(this->_cameraYawAngle);
+    Vec3 camForward = Vec3(sinf(cameraYaw), 0.0f, cosf(cameraYaw));
+    Vec3 camRight = Vec3(camForward.z, 0.0f, -camForward.x);
+
+    // 转换输入方向到世界坐标系
+    Vec3 inputDir = camForward * direction.z - camRight * direction.x;
+
+    if (direction.lengthSquared() < 0.01f) {
+        // 无输入时默认后闪避
+        dodgeAnim = ANIM_DODGE_BACK;
+        worldDodgeDir = -getForwardVector();
+    }
+    else {
+        worldDodgeDir = inputDir;
+        worldDodgeDir.normalize();
+
+        // 根据输入方向选择动画
+        if (std::abs(direction.z) >= std::abs(direction.x)) {
+            dodgeAnim = (direction.z > 0) ? ANIM_DODGE_FRONT : ANIM_DODGE_BACK;
+        }
+        else {
+            dodgeAnim = (direction.x > 0) ? ANIM_DODGE_RIGHT : ANIM_DODGE_LEFT;
+        }
+    }
+
+    // 2. 设置状态
+    setState(MariaState::DODGING);
+    _isAttacking = true;
+    _attackStartPos = _position;
+    _attackDirection = worldDodgeDir;
+    _attackDistance = 15.0f;
+    _attackDuration = 0.45f;
+    _attackElapsed = 0.0f;
+
+    // 3. 播放动画，动画结束时返回idle(片段缺失时按闪避时长结束)
+    if (_view) _view->playClip(dodgeAnim, false);
+    // 离开闪避状态时 setState 会更新基准位置并结束攻击标记
+    scheduleStateChange(getClipDuration(dodgeAnim, _dodgeDuration), MariaState::IDLE);
+}
+
+// =========================================================================
+// 目标锁定相关方法
+// =========================================================================
+
+/**
+ * 切换目标锁定状态
+ * @param isLocked 是否锁定目标
+ * @param targetDir 目标方向向量
+ */
+void MariaLogic::toggleLock(bool isLocked, const Vec3& targetDir)
+{
+    _isRotationLocked = isLocked;
+
+    if (isLocked) {
+        // 锁定目标方向(XZ平面)
+        _lockedDirection = Vec3(targetDir.x, 0, targetDir.z).getNormalized();
+
+        // 朝向目标
+        _yaw = CC_RADIANS_TO_DEGREES(atan2f(_lockedDirection.x, _lockedDirection.z));
+    }
+}
+
+// =========================================================================
+// 跳跃相关方法
+// =========================================================================
+
+/**
+ * 执行跳跃动作
+ */
+void MariaLogic::runJump()
+{
+    if (_currentState == MariaState::IDLE ||
+        _currentState == MariaState::WALK ||
+        _currentState == MariaState::RUN) {
+        setState(MariaState::JUMPING);
+        playAnimation(ANIM_JUMP, false);
+
+        // 跳跃结束后返回idle
+        scheduleStateChange(0.8f, MariaState::IDLE);
+    }
+}
+
+// =========================================================================
+// 下蹲与格挡相关方法
+// =========================================================================
+
+/**
+ * 切换下蹲状态
+ */
+void MariaLogic::toggleCrouch()
+{
+    if (_currentState == MariaState::IDLE || _currentState == MariaState::WALK) {
+        // 从站立切换到下蹲
+        playAnimation(ANIM_START_CROUCH, false);
+
+        scheduleStateChange(0.5f, MariaState::CROUCH_IDLE);
+    }
+    else if (_currentState == MariaState::CROUCH_IDLE) {
+        // 从下蹲切换到站立
+        playAnimation(ANIM_DE_CROUCH, false);
+
+        scheduleStateChange(0.5f, MariaState::IDLE);
+    }
+}
+
+/**
+ * 开始格挡
+ */
+void MariaLogic::startBlock()
+{
+    if (_currentState == MariaState::IDLE || _currentState == MariaState::WALK) {
+        playAnimation(ANIM_START_BLOCK, false);
+
+        scheduleStateChange(0.3f, MariaState::BLOCK_IDLE);
+    }
+}
+
+/**
+ * 结束格挡
+ */
+void MariaLogic::stopBlock()
+{
+    if (_currentState == MariaState::BLOCK_IDLE) {
+        playAnimation(ANIM_DE_BLOCK, false);
+
+        scheduleStateChange(0.3f, MariaState::IDLE);
+    }
+}
+
+// =========================================================================
+// 帧更新方法
+// =========================================================================
+
+/**
+ * 从当前位置移动到期望位置，经过关卡碰撞修正
+ * @param desired 期望位置
+ * @return 实际到达的位置(未设置碰撞时即期望位置)
+ */
+Vec3 MariaLogic::resolveMovement(const Vec3& desired) const
+{
+    if (!_collision) return desired;
+    return _collision->moveAndSlide(_position, desired, COLLISION_RADIUS, COLLISION_HEIGHT);
+}
+
+/**
+ * 每帧更新逻辑
+ * @param dt 帧间隔时间
+ */
+void MariaLogic::update(float dt)
+{
+    // 攻击/闪避状态下的位移更新
+    if (_isAttacking && (_currentState == MariaState::ATTACKING ||
+        _currentState == MariaState::DODGING)) {
+        _attackElapsed += dt;
+        float t = std::min(_attackElapsed / _attackDuration, 1.0f);
+
+        float ease = 1.0f - (1.0f - t) * (1.0f - t);
+        float currentTotalDist = _attackDistance * ease;
+
+        // 更新基准位置并设置角色位置(撞墙时沿墙滑动)
+        _moveBasePos = resolveMovement(_attackStartPos + _attackDirection * currentTotalDist);
+        _position = _moveBasePos;
+    }
+    // 行走/奔跑状态下的移动更新
+    else if (_currentState == MariaState::WALK || _currentState == MariaState::RUN) {
+        Vec3 moveDelta = _moveDirection * _moveSpeed * dt;
+        _moveBasePos = resolveMovement(_moveBasePos + moveDelta);
+        _position = _moveBasePos;
+    }
+
+    // MP自动恢复(非死亡状态)
+    if (_currentState != MariaState::DEAD) {
+        if (_mp < _maxMp) {
+            int oldMp = _mp;
+            float regen = _mpRegenRate * dt;
+            _mp = std::min((float)_maxMp, (float)_mp + regen);
+            if (_mp != oldMp) notifyStatusChanged();
+        }
+    }
+}
+
+// =========================================================================
+// 攻击连招系统
+// =========================================================================
+
+/**
+ * 执行攻击连招
+ */
+void MariaLogic::runAttackCombo()
+{
+    // 1. 状态检查
+    if (!canPerformAttack()) return;
+
+    // 2. 处理连招缓冲
+    if (_currentState == MariaState::ATTACKING) {
+        _isNextComboBuffered = true;
+        return;
+    }
+
+    // 3. 初始化攻击参数
+    _isNextComboBuffered = false;
+    _attackStartPos = _moveBasePos;
+    _attackDirection = getForwardVector();
+    _attackElapsed = 0.0f;
+    _isAttacking = true;
+    _currentState = MariaState::ATTACKING;
+
+    // 4. 获取当前连招信息
+    _comboCount = (_comboCount % 3) + 1;
+    ClipId nextAnim = INVALID_CLIP;
+    getComboData(_comboCount, nextAnim, _attackDistance, _attackDuration);
+
+    // 5. 播放攻击动画，动画结束时结算
+    stopActionsAndTimers();
+    if (_view) _view->playClip(nextAnim, false);
+    if (_tasks) _tasks->start<AttackComboTask>(_taskArena, _entityHandle, this, nextAnim);
+}
+
+/**
+ * 检查是否可以执行攻击
+ * @return 是否可以攻击
+ */
+bool MariaLogic::canPerformAttack() {
+    return !(_currentState == MariaState::SKILLING ||
+        _currentState == MariaState::HURT ||
+        _currentState == MariaState::BLOCK_IDLE ||
+        _currentState == MariaState::CROUCH_IDLE);
+}
+
+/**
+ * 获取连招数据
+ * @param combo 连招序号
+ * @param animName 输出动画片段ID
+ * @param distance 输出位移距离
+ * @param duration 输出持续时间
+ */
+void MariaLogic::getComboData(int combo, ClipId& animName, float& distance, float& duration) {
+    if (combo == 1) {
+        animName = ANIM_P_ATTACK1;
+        distance = 1.8f;
+        duration = 0.35f;
+    }
+    else if (combo == 2) {
+        animName = ANIM_P_ATTACK2;
+        distance = 3.0f;
+        duration = 0.4f;
+    }
+    else {
+        animName = ANIM_P_ATTACK3;
+        distance = 15.0f;
+        duration = 0.5f;
+    }
+}
+
+/**
+ * 执行伤害检测
+ */
+void MariaLogic::executeDamageDetection() {
+    if (!_combatGrid) return;
+
+    // 攻击中心偏移15.0f
+    Vec3 attackCenter = _position + _attackDirection * 15.0f;
+
+    // 先按较大的Boss判定半径查询网格，再按单位类型精确判定
+    auto registry = EntityRegistry::getInstance();
+    _combatGrid->queryRadius(attackCenter, 200.0f, _hitCandidates);
+    for (const auto& candidate : _hitCandidates) {
+        // 检测普通敌人
+        if (isLivingEnemy(registry, candidate)) {
+            if (attackCenter.distance(candidate.getPosition()) < 100.0f) {
+                submitHit(candidate.handle, _attackPower);
+            }
+        }
+        // 检测Boss
+        else if (candidate.kind == EntityKind::BOSS) {
+            auto boss = registry->getBoss(candidate.handle);
+            if (boss && !boss->IsDead() && attackCenter.distance(boss->getPosition3D()) < 200.0f) {
+                submitHit(candidate.handle, _attackPower);
+            }
+        }
+    }
+}
+
+/**
+ * 命中窗口内的逐tick判定
+ * @param window 命中窗口
+ * @param hits 本次攻击已命中的目标
+ * @param hitCount 已命中数量
+ * @param maxHits hits 容量
+ */
+void MariaLogic::sweepHitWindow(const HitWindow& window, EntityHandle* hits, int& hitCount, int maxHits) {
+    if (!_combatGrid) return;
+
+    Vec3 center = window.shape.getCenter(_position, _yaw);
+
+    auto registry = EntityRegistry::getInstance();
+    _combatGrid->queryRadius(center, window.shape.radius + BOSS_HIT_RADIUS, _hitCandidates);
+    for (const auto& candidate : _hitCandidates) {
+        if (hitCount >= maxHits) return;
+        if (std::find(hits, hits + hitCount, candidate.handle) != hits + hitCount) continue;
+
+        // 普通敌人检测
+        if (isLivingEnemy(registry, candidate)) {
+            if (center.distance(candidate.getPosition()) < window.shape.radius + ENEMY_HIT_RADIUS) {
+                submitHit(candidate.handle, _attackPower);
+                hits[hitCount++] = candidate.handle;
+            }
+        }
+        // Boss检测
+        else if (candidate.kind == EntityKind::BOSS) {
+            auto boss = registry->getBoss(candidate.handle);
+            if (boss && !boss->IsDead() &&
+                center.distance(boss->getPosition3D()) < window.shape.radius + BOSS_HIT_RADIUS) {
+                submitHit(candidate.handle, _attackPower);
+                hits[hitCount++] = candidate.handle;
+            }
+        }
+    }
+}
+
+/**
+ * 登记对目标的一次命中(受击方的状态变化在tick结束时按登记顺序统一发生)
+ * @param target 目标句柄
+ * @param damage 伤害值
+ */
+void MariaLogic::submitHit(EntityHandle target, int damage) {
+    if (_combatEvents) _combatEvents->pushHit(_entityHandle, target, damage);
+}
+
+/**
+ * 处理连招结束逻辑
+ */
+void MariaLogic::handleComboEnd() {
+    if (_isNextComboBuffered) {
+        // 切换到IDLE状态以允许下一次攻击
+        _currentState = MariaState::IDLE;
+        runAttackCombo();
+    }
+    else {
+        _comboCount = 0;
+        setState(MariaState::IDLE);
+    }
+}
+
+// =========================================================================
+// 影子技能系统
+// =========================================================================
+
+/**
+ * 普通攻击时间线：片段有烘焙的命中窗口时在窗口打开期间逐tick判定(同一目标只命中一次)，
+ * 否则沿用动画结束时的范围判定；动画结束后处理连招(片段缺失时以攻击位移时长为动画时长)
+ */
+struct MariaLogic::AttackComboTask : public GameplayTask
+{
+    static const int MAX_HITS = 8;
+
+    MariaLogic* self;
+    ClipId clip;
+    const HitWindow* window = nullptr;
+    int windowIndex = 0;
+    int hitCount = 0;
+    EntityHandle hits[MAX_HITS];
+
+    AttackComboTask(MariaLogic* owner, ClipId attackClip) : self(owner), clip(attackClip) {}
+
+    bool resume() override
+    {
+        TASK_BEGIN();
+        startClip(clip, self->_attackDuration);
+        for (windowIndex = 0; (window = HitWindowTable::getInstance()->getWindow(clip, windowIndex)) != nullptr; ++windowIndex) {
+            TASK_AWAIT_CLIP_TIME(window->start);
+            TASK_AWAIT_UNTIL((self->sweepHitWindow(*window, hits, hitCount, MAX_HITS), getClipTime() >= window->end));
+        }
+        TASK_AWAIT_MARKER(1.0f);  // 动画结束
+        if (windowIndex == 0)
+            self->executeDamageDetection();  // 无烘焙窗口：动画结束时范围判定
+        self->_isAttacking = false;          // 结束攻击状态
+        self->handleComboEnd();              // 处理连招结束(可能启动下一段攻击任务)
+        TASK_END();
+    }
+};
+
+/**
+ * 影子技能时间线：依次召唤五个影子，最后一段结束技能
+ */
+struct MariaLogic::ShadowSkillTask : public GameplayTask
+{
+    struct Ghost {
+        float delay;          // 距上一个影子的间隔
+        float x, y, z;        // 影子偏移
+        ClipId* clip;         // 影子动画
+        float delayDamage;    // 影子伤害延迟
+    };
+
+    MariaLogic* self;
+    int ghost = 0;
+
+    explicit ShadowSkillTask(MariaLogic* owner) : self(owner) {}
+
+    bool resume() override
+    {
+        static const Ghost GHOSTS[] = {
+            { 0.4f,   5, 0, 10, &ANIM_GHOST_1, 0.2f },
+            { 0.6f,   0, 0,  0, &ANIM_GHOST_2, 0.3f },
+            { 0.5f,   0, 0,  8, &ANIM_GHOST_3, 0.2f },
+            { 0.4f,   0, 0, 15, &ANIM_GHOST_4, 0.4f },
+            { 0.5f, -10, 0,  5, &ANIM_GHOST_5, 0.2f },
+        };
+        static const int GHOST_COUNT = sizeof(GHOSTS) / sizeof(GHOSTS[0]);
+
+        TASK_BEGIN();
+        for (ghost = 0; ghost < GHOST_COUNT; ++ghost) {
+            TASK_AWAIT_SECONDS(GHOSTS[ghost].delay);
+            self->spawnGhostShadow(Vec3(GHOSTS[ghost].x, GHOSTS[ghost].y, GHOSTS[ghost].z),
+                *GHOSTS[ghost].clip, GHOSTS[ghost].delayDamage);
+        }
+        TASK_AWAIT_SECONDS(0.6f);
+        self->onAnimationFinished(ANIM_SKILL_START);
+        TASK_END();
+    }
+};
+
+/**
+ * 执行影子技能
+ */
+void MariaLogic::runSkillShadow()
+{
+    // 状态检查
+    if (_currentState != MariaState::IDLE &&
+        _currentState != MariaState::WALK &&
+        _currentState != MariaState::RUN) {
+        return;
+    }
+
+    // MP检查
+    if (_mp < SKILL_MP_COST) {
+        CCLOG("MP not enough! current: %d, need: %d", (int)_mp, SKILL_MP_COST);
+        return;
+    }
+
+    // 消耗MP
+    _mp -= SKILL_MP_COST;
+    CCLOG("Skill showed! cost %d MP, rest: %d", SKILL_MP_COST, (int)_mp);
+    notifyStatusChanged();
+
+    // 执行技能逻辑(打断当前行为：取消未触发的定时器与任务)
+    stopActionsAndTimers();
+    _currentState = MariaState::SKILLING;
+    this->playAnimation(ANIM_SKILL_START, false);
+
+    // 技能时间线作为脚本任务运行(被打断时随自身任务一起取消)
+    if (_tasks) _tasks->start<ShadowSkillTask>(_taskArena, _entityHandle, this);
+}
+
+/**
+ * 生成影子并执行攻击
+ * @param offset 影子相对于角色的偏移
+ * @param animName 影子播放的动画片段ID
+ * @param delayDamage 伤害延迟时间(片段无烘焙命中窗口时使用)
+ */
+void MariaLogic::spawnGhostShadow(const Vec3& offset, ClipId animName, float delayDamage)
+{
+    // 影子原地播放动画，位置与朝向在召出时确定
+    const Vec3 ghostPos = _position + offset;
+    const float lifetime = getClipDuration(animName, GHOST_FALLBACK_LIFETIME);
+    if (_view) _view->spawnAfterimage(ghostPos, _yaw, animName, lifetime);
+    if (!_timers) return;
+
+    // 伤害检测逻辑(延迟触发：只捕获施放者句柄与数值，触发时查表确认施放者仍存活)
+    // 不属于施放者：施放者被打断时已召出的影子照常结算
+    // 片段有烘焙的命中窗口时在窗口打开处、以判定球位置结算，否则沿用传入的延迟；结算不晚于影子消失
+    const HitWindow* window = HitWindowTable::getInstance()->getWindow(animName, 0);
+    if (window) delayDamage = window->start;
+    delayDamage = std::min(delayDamage, lifetime);
+
+    const Vec3 center = window ? window->shape.getCenter(ghostPos, _yaw) : ghostPos;
+    const float x = center.x, y = center.y, z = center.z;
+    const float damageRange = window ? window->shape.radius : 60.0f;
+    EntityHandle owner = _entityHandle;
+    _timers->schedule(EntityHandle(), delayDamage, [owner, x, y, z, damageRange]() {
+        auto registry = EntityRegistry::getInstance();
+        auto self = static_cast<MariaLogic*>(registry->getPlayer(owner));
+        if (!self || !self->_combatGrid) return;
+
+        const Vec3 ghostPos(x, y, z);
+        int damageValue = (int)(self->_attackPower * 0.8f);
+
+        self->_combatGrid->queryRadius(ghostPos, damageRange, self->_hitCandidates);
+        for (const auto& candidate : self->_hitCandidates) {
+            // 普通敌人检测
+            if (isLivingEnemy(registry, candidate)) {
+                if (ghostPos.distance(candidate.getPosition()) < damageRange) {
+                    self->submitHit(candidate.handle, damageValue);
+                }
+            }
+            // Boss检测
+            else if (candidate.kind == EntityKind::BOSS) {
+                auto boss = registry->getBoss(candidate.handle);
+                if (boss && !boss->IsDead() && ghostPos.distance(boss->getPosition3D()) < 50.0f) {
+                    self->submitHit(candidate.handle, damageValue);
+                }
+            }
+        }
+        });
+}
+
+// =========================================================================
+// 伤害与回血系统
+// =========================================================================
+
+/**
+ * 受到伤害处理
+ * @param damage 伤害值
+ */
+HitResult MariaLogic::takeDamage(int damage) {
+    // 免疫状态检查
+    if (_currentState == MariaState::DEAD) {
+        return HitResult::none();
+    }
+    if (_currentState == MariaState::DODGING) {
+        return HitResult::make(CombatEventType::DODGE, damage, false);
+    }
+
+    // 计算最终伤害(格挡减伤)
+    int finalDamage = damage;
+    CombatEventType type = CombatEventType::HIT;
+    if (_currentState == MariaState::BLOCK_IDLE) {
+        finalDamage = std::max(1, (int)(damage * 0.2f)); // 格挡至少受1点伤害
+        type = CombatEventType::BLOCK;
+    }
+
+    _hp -= finalDamage;
+    CCLOG("Maria took %d damage, remaining HP: %d", finalDamage, _hp);
+    notifyStatusChanged();
+
+    // 回血状态特殊处理
+    if (_currentState == MariaState::RECOVER) {
+        if (_hp <= 0) { /* 处理死亡... */ }
+        return HitResult::make(type, finalDamage, false);
+    }
+
+    // 停止当前所有动作与定时器
+    stopActionsAndTimers();
+
+    if (_hp <= 0) {
+        _hp = 0;
+        setState(MariaState::DEAD);
+        playAnimation(ANIM_DEAD, false);
+    }
+    else {
+        setState(MariaState::HURT);
+        playAnimation(ANIM_HURT, false);
+
+        // 受击后返回idle(死亡等状态切换会取消该定时器)
+        scheduleStateChange(0.5f, MariaState::IDLE);
+    }
+    return HitResult::make(type, finalDamage, _currentState == MariaState::DEAD);
+}
+
+/**
+ * 执行回血动作
+ */
+void MariaLogic::runRecover() {
+    if (_recoverCount <= 0 ||
+        _currentState == MariaState::DEAD ||
+        _currentState == MariaState::RECOVER) {
+        return;
+    }
+
+    // 1. 立即扣除次数并增加血量
+    _recoverCount--;
+    _hp = std::min(_hp + RECOVER_AMOUNT, 180);
+    notifyStatusChanged();
+
+    // 2. 进入回血状态并播放动画
+    setState(MariaState::RECOVER);
+    if (_view) _view->playClip(ANIM_RECOVER, false);
+
+    // 动画结束后恢复到 IDLE 状态(片段缺失时按兜底时长)
+    scheduleStateChange(getClipDuration(ANIM_RECOVER, RECOVER_FALLBACK_DURATION), MariaState::IDLE);
+}
+
+/**
+ * 攻击敌人
+ * @param enemy 目标敌人
+ */
+void MariaLogic::attackEnemy(EnemyBase* enemy) {
+    if (enemy && !enemy->isDead()) {
+        submitHit(enemy->getEntityHandle(), _attackPower);
+    }
+}
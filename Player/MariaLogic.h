@@ -0,0 +1,425 @@
+#pragma once
+
+#include "cocos2d.h"
+#include <functional>
+#include <vector>
+#include "Player.h"
+#include "Core/CombatantGrid.h"
+#include "Core/AnimationClipCache.h"
+#include "Core/TimerWheel.h"
+#include "Core/GameplayTask.h"
+#include "Core/CombatEventQueue.h"
+
+class CollisionWorld;
+struct HitWindow;
+
+/**
+ * Maria角色状态枚举
+ * 定义角色可能的所有状态
+ */
+enum class MariaState {
+    IDLE,           //  idle状态
+    WALK,           //  行走状态
+    RUN,            //  奔跑状态
+    ATTACKING,      //  攻击状态
+    SKILLING,       //  技能释放状态
+    BLOCK_IDLE,     //  格挡持续状态
+    CROUCH_IDLE,    //  下蹲持续状态
+    JUMPING,        //  跳跃状态
+    HURT,           //  受击状态
+    DODGING,        //  闪避状态
+    DEAD,           //  死亡状态
+    RECOVER         //  回血状态
+};
+
+/**
+ * Maria的表现接口(由渲染代理实现)
+ * 逻辑只通过它播放动画与召出残影，无头模拟中没有表现接口
+ */
+class MariaView
+{
+public:
+    virtual ~MariaView() {}
+
+    /**
+     * 播放动画片段(先停止正在播放的动画)
+     * @param clip 动画片段ID
+     * @param loop 是否循环播放
+     * @return 片段不存在返回false
+     */
+    virtual bool playClip(ClipId clip, bool loop) = 0;
+
+    /** 停止正在播放的动画 */
+    virtual void stopClip() = 0;
+
+    /**
+     * 召出影子技能的残影(只是表现，伤害由逻辑登记)
+     * @param position 残影位置
+     * @param yaw 残影朝向(角度制)
+     * @param clip 残影播放的动画片段ID
+     * @param lifetime 残影存在时长(秒)
+     */
+    virtual void spawnAfterimage(const cocos2d::Vec3& position, float yaw, ClipId clip, float lifetime) = 0;
+};
+
+/**
+ * Maria的逻辑(状态机、移动、连招、技能、受击)
+ * 位置与朝向保存在逻辑中，不依赖 Sprite3D/Action：动作时长与延迟全部经时间轮和脚本任务推进，
+ * 动画片段缺失(如无头模拟不加载资源)时按各动作的兜底时长推进。
+ * 场景中由 Maria 节点持有并把位置/朝向同步到节点；无头模拟直接持有本类。
+ */
+class MariaLogic : public Player
+{
+public:
+    MariaLogic() {}
+    virtual ~MariaLogic();
+
+    MariaLogic(const MariaLogic&) = delete;
+    MariaLogic& operator=(const MariaLogic&) = delete;
+
+    /**
+     * 登记实体句柄并进入待机状态
+     * @param view 表现接口(无头模拟中为nullptr)
+     * @param node 对应的场景节点(无头模拟中为nullptr)
+     */
+    void init(MariaView* view, cocos2d::Node* node);
+
+    /**
+     * 预加载全部动画片段并登记片段ID
+     * 场景加载时调用一次，之后播放动画不再有运行时加载
+     */
+    static void preloadAnimations();
+
+    //------------------------------
+    // 角色行为响应外部接口
+    //------------------------------
+
+    /** 执行攻击连招 */
+    void runAttackCombo();
+
+    /**
+     * 获取角色当前朝向向量(XZ平面)
+     * @return 标准化的前向向量
+     */
+    cocos2d::Vec3 getForwardVector() const;
+
+    /** 执行影子技能 */
+    void runSkillShadow();
+
+    /** 执行跳跃动作 */
+    void runJump();
+
+    /** 切换下蹲状态(下蹲/站立) */
+    void toggleCrouch();
+
+    /** 开始格挡 */
+    void startBlock();
+
+    /** 结束格挡 */
+    void stopBlock();
+
+    /**
+     * 移动角色
+     * @param direction 移动方向向量(相机坐标系)
+     * @param isRunning 是否为奔跑状态
+     */
+    void runMove(const cocos2d::Vec3& direction, bool isRunning);
+
+    /** 停止移动 */
+    void stopMove();
+
+    /**
+     * 执行闪避动作
+     * @param direction 闪避方向向量(相机坐标系)
+     */
+    void runDodge(const cocos2d::Vec3& direction);
+
+    /** 执行回血动作 */
+    void runRecover();
+
+    //------------------------------
+    // 相机与锁定
+    //------------------------------
+
+    void setCameraYawAngle(float angle) { _cameraYawAngle = angle; }
+    void setCameraPitchAngle(float angle) { _cameraPitchAngle = angle; }
+
+    /**
+     * 切换目标锁定状态
+     * @param isLocked 是否锁定目标
+     * @param targetDir 目标方向向量
+     */
+    void toggleLock(bool isLocked, const cocos2d::Vec3& targetDir);
+    bool isRotationLocked() const { return _isRotationLocked; }
+
+    //------------------------------
+    // Player接口实现
+    //------------------------------
+    virtual HitResult takeDamage(int damage) override;
+    virtual cocos2d::Vec3 getPosition3D() const override { return _position; }
+    virtual void attackEnemy(EnemyBase* enemy) override;
+
+    /** 放置角色(同时重置移动基准位置) */
+    void setPosition3D(const cocos2d::Vec3& position);
+
+    float getYaw() const { return _yaw; }             // 朝向(绕Y轴，角度制)
+    MariaState getState() const { return _currentState; }
+    bool isDead() const { return _currentState == MariaState::DEAD; }
+    EntityHandle getEntityHandle() const { return _entityHandle; }
+
+    int getHP() const { return _hp; }
+    int getMP() const { return _mp; }
+    int getMaxMP() const { return _maxMp; }
+    int getRecoverCount() const { return _recoverCount; }
+
+    void setCombatGrid(const CombatantGrid* grid) { _combatGrid = grid; }
+    void setCollisionWorld(const CollisionWorld* collision) { _collision = collision; }
+    void setTimerWheel(TimerWheel* timers) { _timers = timers; }
+    TimerWheel* getTimerWheel() const { return _timers; }
+    void setTaskScheduler(TaskScheduler* tasks) { _tasks = tasks; }
+    void setCombatEvents(CombatEventQueue* events) { _combatEvents = events; }
+    void setStatusChangedCallback(const std::function<void()>& callback) { _onStatusChanged = callback; }
+
+    /**
+     * 逻辑更新(由固定步长模拟调用)
+     * @param dt 固定步长
+     */
+    void update(float dt);
+
+private:
+    //------------------------------
+    // 状态管理变量
+    //------------------------------
+    MariaState _currentState = MariaState::IDLE;  // 当前角色状态
+    int _comboCount = 0;                          // 连招计数
+    bool _isAttacking = false;                    // 是否正在攻击
+    bool _isNextComboBuffered = false;            // 是否缓存了下一次攻击指令
+    bool _isRotationLocked = false;               // 是否处于旋转锁定状态
+
+    //------------------------------
+    // 变换
+    //------------------------------
+    cocos2d::Vec3 _position;      // 模拟位置
+    float _yaw = 0.0f;            // 朝向(绕Y轴，角度制)
+
+    //------------------------------
+    // 攻击相关变量
+    //------------------------------
+    cocos2d::Vec3 _attackStartPos;   // 攻击开始时的位置(用于位移计算)
+    float _attackElapsed = 0.0f;     // 攻击已持续时间
+    float _attackDuration = 0.0f;    // 攻击总时长
+    float _attackDistance = 0.0f;    // 攻击位移距离
+    cocos2d::Vec3 _attackDirection;  // 攻击方向(位移方向)
+
+    //------------------------------
+    // MP相关变量
+    //------------------------------
+    int _mp = 100;
+    int _maxMp = 100;
+    int _mpRegenRate = 5;         // 每秒MP恢复量
+    const int SKILL_MP_COST = 30; // 技能消耗MP值
+
+    //------------------------------
+    // 生命值与伤害相关变量
+    //------------------------------
+    int _hp = 180;
+    int _attackPower = 50;
+    float _attackRange = 30.0f;   // 攻击检测范围
+    int _recoverCount = 5;        // 初始回血次数
+    const int RECOVER_AMOUNT = 30;// 每次回血值
+    std::function<void()> _onStatusChanged;  // 状态变化回调
+
+    /** 通知HP/MP/回血次数已变化 */
+    void notifyStatusChanged() { if (_onStatusChanged) _onStatusChanged(); }
+
+    //------------------------------
+    // 移动相关变量
+    //------------------------------
+    cocos2d::Vec3 _moveBasePos;   // 移动基准位置
+    cocos2d::Vec3 _moveDirection; // 移动方向向量
+    float _moveSpeed = 0.0f;      // 当前移动速度
+    const float _walkSpeed = 200.0f;   // 行走速度
+    const float _runSpeed = 400.0f;    // 奔跑速度
+
+    //------------------------------
+    // 闪避相关变量
+    //------------------------------
+    const float _dodgeDistance = 12.0f;  // 闪避距离
+    const float _dodgeDuration = 0.4f;   // 闪避持续时间(闪避动画缺失时的兜底时长)
+
+    //------------------------------
+    // 相机相关变量
+    //------------------------------
+    float _cameraYawAngle = 0.0f;        // 相机Y轴旋转角度(角度制)
+    float _cameraPitchAngle = 0.0f;      // 相机Z轴旋转角度(角度制)
+    cocos2d::Vec3 _lockedDirection;      // 锁定时角色朝向的方向
+
+    //------------------------------
+    // 攻击判定与外部系统
+    //------------------------------
+    MariaView* _view = nullptr;                 // 表现接口(无头模拟中为空)
+    const CombatantGrid* _combatGrid = nullptr; // 战斗单位网格(场景持有)
+    const CollisionWorld* _collision = nullptr; // 关卡墙体碰撞(场景持有)
+    std::vector<Combatant> _hitCandidates;      // 网格查询结果(复用，避免每次分配)
+    EntityHandle _entityHandle;                 // 实体句柄
+    TimerWheel* _timers = nullptr;              // 玩法定时器(场景持有)
+    TimerHandle _stateTimer;                    // 状态过渡定时器(跳跃/闪避/受击/回血结束、蹲伏/格挡过渡)，状态切换时取消
+    TaskScheduler* _tasks = nullptr;            // 脚本任务调度器(场景持有)
+    TaskArena _taskArena;                       // 自身脚本任务的内存池
+    CombatEventQueue* _combatEvents = nullptr;  // 战斗事件队列(场景持有)
+
+    //------------------------------
+    // 动画资源路径与片段ID
+    //------------------------------
+    const static std::string ANIM_MODEL_PATH;  // 模型文件路径
+
+    // 基础动画
+    static ClipId ANIM_IDLE;        // 待机动画
+    static ClipId ANIM_WALK;        // 行走动画
+    static ClipId ANIM_RUN;         // 奔跑动画
+
+    // 攻击动画
+    static ClipId ANIM_P_ATTACK1;   // 普通攻击1
+    static ClipId ANIM_P_ATTACK2;   // 普通攻击2
+    static ClipId ANIM_P_ATTACK3;   // 普通攻击3
+
+    // 技能动画
+    static ClipId ANIM_SKILL_START; // 技能开始动画
+    static ClipId ANIM_GHOST_1;     // 影子技能1
+    static ClipId ANIM_GHOST_2;     // 影子技能2
+    static ClipId ANIM_GHOST_3;     // 影子技能3
+    static ClipId ANIM_GHOST_4;     // 影子技能4
+    static ClipId ANIM_GHOST_5;     // 影子技能5
+
+    // 特殊状态动画
+    static ClipId ANIM_JUMP;        // 跳跃动画
+    static ClipId ANIM_START_CROUCH;// 开始下蹲动画
+    static ClipId ANIM_CROUCH_IDLE; // 下蹲待机动画
+    static ClipId ANIM_DE_CROUCH;   // 结束下蹲动画
+    static ClipId ANIM_START_BLOCK; // 开始格挡动画
+    static ClipId ANIM_BLOCK_IDLE;  // 格挡待机动画
+    static ClipId ANIM_DE_BLOCK;    // 结束格挡动画
+    static ClipId ANIM_HURT;        // 受击动画
+    static ClipId ANIM_DEAD;        // 死亡动画
+    static ClipId ANIM_RECOVER;     // 回血动画
+
+    // 闪避动画
+    static ClipId ANIM_DODGE_BACK;  // 后闪避
+    static ClipId ANIM_DODGE_FRONT; // 前闪避
+    static ClipId ANIM_DODGE_LEFT;  // 左闪避
+    static ClipId ANIM_DODGE_RIGHT; // 右闪避
+
+    //------------------------------
+    // 内部方法
+    //------------------------------
+
+    /**
+     * 播放动画(片段缺失时回到idle；没有表现接口时忽略)
+     * @param clip 动画片段ID
+     * @param loop 是否循环播放
+     */
+    void playAnimation(ClipId clip, bool loop = false);
+
+    /**
+     * 动画播放完成回调
+     * @param clip 完成的动画片段ID
+     */
+    void onAnimationFinished(ClipId clip);
+
+    /**
+     * 设置角色状态
+     * @param newState 新状态
+     */
+    void setState(MariaState newState);
+
+    /** 只停止正在播放的动画(切换动画时调用)，定时器与脚本任务照常进行 */
+    void stopActions();
+
+    /**
+     * 停止动画并取消自身的定时器与脚本任务
+     * 只在真正打断当前行为处调用：受击、闪避、开始新一段连招或技能
+     */
+    void stopActionsAndTimers();
+
+    /**
+     * 登记状态过渡定时器(先取消尚未触发的上一次过渡)
+     * 任何状态切换都会取消它，因此必须在进入当前状态之后登记
+     * @param seconds 过渡时长
+     * @param newState 过渡结束后的状态
+     */
+    void scheduleStateChange(float seconds, MariaState newState);
+
+    /**
+     * 以自身为所属实体登记定时器(未设置时间轮时不登记)
+     * @param seconds 延迟秒数
+     * @param callback 到期回调(只捕获 this 与数值)
+     */
+    template <typename F>
+    TimerHandle scheduleTimer(float seconds, const F& callback)
+    {
+        return _timers ? _timers->schedule(_entityHandle, seconds, callback) : TimerHandle();
+    }
+
+    /**
+     * 动画片段时长，片段缺失时返回兜底时长
+     * @param clip 动画片段ID
+     * @param fallback 兜底时长
+     */
+    static float getClipDuration(ClipId clip, float fallback);
+
+    /**
+     * 生成影子并执行攻击检测
+     * @param offset 相对于角色的偏移位置
+     * @param animName 影子播放的动画片段ID
+     * @param delayDamage 伤害检测延迟时间(配合动画帧)
+     */
+    void spawnGhostShadow(const cocos2d::Vec3& offset, ClipId animName, float delayDamage);
+
+    // 影子技能时间线(脚本任务)
+    struct ShadowSkillTask;
+    // 普通攻击时间线(脚本任务)：命中窗口判定→动作结束
+    struct AttackComboTask;
+
+    /**
+     * 检查是否可以执行攻击
+     * @return 是否可以攻击
+     */
+    bool canPerformAttack();
+
+    /**
+     * 根据当前连招数获取攻击参数
+     * @param combo 连招序号
+     * @param animName 输出动画片段ID
+     * @param distance 输出位移距离
+     * @param duration 输出持续时间
+     */
+    void getComboData(int combo, ClipId& animName, float& distance, float& duration);
+
+    /** 执行范围伤害检测 */
+    void executeDamageDetection();
+
+    /**
+     * 命中窗口内的逐tick判定：对接触判定球的目标造成伤害，已命中的目标跳过
+     * @param window 命中窗口
+     * @param hits 本次攻击已命中的目标(追加新命中)
+     * @param hitCount 已命中数量
+     * @param maxHits hits 容量
+     */
+    void sweepHitWindow(const HitWindow& window, EntityHandle* hits, int& hitCount, int maxHits);
+
+    /**
+     * 登记对目标的一次命中(tick结束时结算)
+     * @param target 目标句柄
+     * @param damage 伤害值
+     */
+    void submitHit(EntityHandle target, int damage);
+
+    /** 处理连招结束逻辑 */
+    void handleComboEnd();
+
+    /**
+     * 经过关卡碰撞修正后的移动目标位置
+     * @param desired 期望位置
+     */
+    cocos2d::Vec3 resolveMovement(const cocos2d::Vec3& desired) const;
+};
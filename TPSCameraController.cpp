@@ -24,7 +24,7 @@ bool TPSCameraController::init(Camera* camera, Node* target)
 
     _camera = camera;
     _target = target;
-    _currentCameraPos = _camera->getPosition3D();  // ʼλ
+    _springArm.setArmLength(50.0f);
 
     return true;
 }
@@ -60,31 +60,14 @@ void TPSCameraController::update(float dt)
         sinf(radiansPitch),                     // Yƫƣ߶ȣ
         cosf(radiansYaw) * cosf(radiansPitch)   // Zƫ
     );
-    offset.normalize();              // ׼
-    offset *= _distance;             // ƫ
+    offset.normalize();              // ׼ɵɱ۾
 
-    // λãĿλ + ƫ
-    Vec3 desiredPos = targetPos + offset;
-
-    // 㵱ǰλλõľ
-    float dist = _currentCameraPos.distance(desiredPos);
-
-    // λø
-    if (dist > 100.0f)
-    {
-        // ԶֱĿλã쳣µĹӳ٣
-        _currentCameraPos = desiredPos;
-    }
-    else
-    {
-        // ƽɵλãԲֵ
-        _currentCameraPos = _currentCameraPos.lerp(desiredPos, 1.0f - _lag);
-    }
+    // ɱۣƽƽĿ꣬ƫƷڵʱձֱۣ֡Ӿλ
+    _springArm.update(targetPos, offset, dt);
 
     // ʵλ
-    _camera->setPosition3D(_currentCameraPos);
+    _camera->setPosition3D(_springArm.getCameraPosition());
 
-    // ĿϷYƫ10λӽǹͣ
-    Vec3 lookAtTarget = targetPos + Vec3(0, 10, 0);
-    _camera->lookAt(lookAtTarget, Vec3(0, 1, 0));  // YΪϷ
+    // 㣨ĿϷ10λӽǹͣ
+    _camera->lookAt(_springArm.getPivot(), Vec3(0, 1, 0));  // YΪϷ
 }
@@ -2,10 +2,12 @@
 #define __TPS_CAMERA_CONTROLLER_H__
 
 #include "cocos2d.h"
+#include "Core/CameraSpringArm.h"
 
 /**
  * ˳ӽ
  * Ŀꡢӽǵȹ
+ * λɵɱۼ㣺水ٽƽ(֡޹)ǽڵʱձ
  */
 class TPSCameraController : public cocos2d::Ref
 {
@@ -27,7 +29,7 @@ public:
     bool init(cocos2d::Camera* camera, cocos2d::Node* target);
 
     /**
-     * ÿ֡λãƽ߼
+     * ÿ֡λãɱ۸ + ڵ⣩
      * @param dt ֡ʱ
      */
     void update(float dt);
@@ -39,10 +41,16 @@ public:
      */
     void handleMouseMove(float deltaX, float deltaY);
 
+    /**
+     * ڵʹõĹؿײɳУлؿʱ
+     * @param collision ײ磬Ϊʱڵ
+     */
+    void setCollisionWorld(const CollisionWorld* collision) { _springArm.setCollisionWorld(collision); }
+
     // ԵĽӿ
-    void setDistance(float distance) { _distance = distance; }       // Ŀľ
+    void setDistance(float distance) { _springArm.setArmLength(distance); }  // Ŀľ
     void setSensitivity(float sensitivity) { _sensitivity = sensitivity; } // 
-    void setLag(float lag) { _lag = lag; }               // ƽӳ٣0-1֮䣩
+    void setSmoothTime(float seconds) { _springArm.setSmoothTime(seconds); } // øƽʱ䣨룬ԽСԽ
     void setPitch(float pitch) { _pitch = pitch; }         // ø
 
     // ȡԵĽӿ
@@ -59,11 +67,9 @@ private:
     // ״̬
     float _yaw = 0.0f;           // ƫǣˮƽתǶȣ
     float _pitch = 30.0f;        // ǣֱתǶȣĬ30ȣ
-    float _distance = 50.0f;     // Ŀľ
     float _sensitivity = 0.2f;   // ȣתٶϵ
-    float _lag = 0.2f;           // ƽӳ٣ֵԽСԽ죩
 
-    cocos2d::Vec3 _currentCameraPos;  // ǰλãƽɼ㣩
+    CameraSpringArm _springArm;  // ɱۣƽڵձۣ
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "GameHUD.h"
+#include "Player/Maria.h"
+#include "Enemy/Boss/Boss.h"
+
+USING_NS_CC;
+
+DrawNode* GameHUD::createBar(float width, float height, const Color4F& color)
+{
+    auto bar = DrawNode::create();
+    bar->drawSolidRect(Vec2::ZERO, Vec2(width, height), color);
+    return bar;
+}
+
+bool GameHUD::init()
+{
+    if (!Node::init())
+        return false;
+
+    auto visibleSize = Director::getInstance()->getWinSize();
+
+    // --- 玩家血条 / 法条：底色 + 按比例缩放的填充 ---
+    Vec2 hpOrigin(20, visibleSize.height - 40);
+    auto hpBack = createBar(HP_BAR_WIDTH, 20, Color4F(0, 0, 0, 0.5f));
+    hpBack->setPosition(hpOrigin);
+    this->addChild(hpBack);
+    _hpFill = createBar(HP_BAR_WIDTH, 20, Color4F::RED);
+    _hpFill->setPosition(hpOrigin);
+    this->addChild(_hpFill);
+
+    Vec2 mpOrigin(20, visibleSize.height - 55);
+    auto mpBack = createBar(MP_BAR_WIDTH, 10, Color4F(0, 0, 0, 0.5f));
+    mpBack->setPosition(mpOrigin);
+    this->addChild(mpBack);
+    _mpFill = createBar(MP_BAR_WIDTH, 10, Color4F::BLUE);
+    _mpFill->setPosition(mpOrigin);
+    this->addChild(_mpFill);
+
+    // --- 回血道具：灰色底点一次画完，金色点按剩余次数显示 ---
+    Vec2 pipStart(50, 50);
+    float pipRadius = 10.0f;
+    float pipSpacing = 25.0f;
+    auto pipBack = DrawNode::create();
+    for (int i = 0; i < 5; ++i) {
+        pipBack->drawSolidCircle(pipStart + Vec2(i * pipSpacing, 0), pipRadius, 0, 32, Color4F(0.5f, 0.5f, 0.5f, 0.5f));
+    }
+    this->addChild(pipBack);
+    for (int i = 0; i < 5; ++i) {
+        _recoverPips[i] = DrawNode::create();
+        _recoverPips[i]->drawSolidCircle(Vec2::ZERO, pipRadius, 0, 32, Color4F(1.0f, 0.84f, 0.0f, 1.0f));
+        _recoverPips[i]->setPosition(pipStart + Vec2(i * pipSpacing, 0));
+        this->addChild(_recoverPips[i]);
+    }
+
+    // --- Boss血条（屏幕正下方） ---
+    _bossContainer = Node::create();
+    _bossContainer->setVisible(false);
+    this->addChild(_bossContainer);
+
+    Vec2 bossOrigin(visibleSize.width / 2 - BOSS_BAR_HALF_WIDTH, BOSS_BAR_MARGIN_BOTTOM);
+    auto bossBack = createBar(BOSS_BAR_HALF_WIDTH * 2, BOSS_BAR_HEIGHT, Color4F(0, 0, 0, 0.7f));
+    bossBack->setPosition(bossOrigin);
+    _bossContainer->addChild(bossBack);
+
+    _bossFill = createBar(BOSS_BAR_HALF_WIDTH * 2, BOSS_BAR_HEIGHT, Color4F::RED);
+    _bossFill->setPosition(bossOrigin);
+    _bossContainer->addChild(_bossFill);
+
+    _bossRageFill = createBar(BOSS_BAR_HALF_WIDTH * 2, BOSS_BAR_HEIGHT, Color4F(0.8f, 0.0f, 0.8f, 1.0f));
+    _bossRageFill->setPosition(bossOrigin);
+    _bossRageFill->setVisible(false);
+    _bossContainer->addChild(_bossRageFill);
+
+    _bossNameLabel = Label::createWithSystemFont("BOSS - MUTANT", "Arial", 26);
+    _bossNameLabel->setPosition(Vec2(visibleSize.width / 2, BOSS_BAR_MARGIN_BOTTOM + BOSS_BAR_HEIGHT + 20));
+    _bossContainer->addChild(_bossNameLabel);
+
+    return true;
+}
+
+void GameHUD::bindPlayer(Maria* player)
+{
+    if (_player)
+        _player->setStatusChangedCallback(nullptr);
+
+    _player = player;
+    if (_player) {
+        _player->setStatusChangedCallback([this]() { this->refreshPlayer(); });
+        refreshPlayer();
+    }
+}
+
+void GameHUD::bindBoss(Boss* boss)
+{
+    if (_boss)
+        _boss->setHealthChangedCallback(nullptr);
+
+    _boss = boss;
+    _shownBossHp = -1;
+    if (_boss) {
+        _boss->setHealthChangedCallback([this]() { this->refreshBoss(); });
+        refreshBoss();
+    }
+    else {
+        _bossContainer->setVisible(false);
+    }
+}
+
+void GameHUD::update(float dt)
+{
+    // 狂暴震动效果：让 UI 容器产生轻微随机位移
+    if (_isBossRage && _bossContainer->isVisible()) {
+        _bossContainer->setPosition(Vec2(rand() % 3 - 1, rand() % 3 - 1));
+    }
+}
+
+void GameHUD::refreshPlayer()
+{
+    int hp = _player->getHP();
+    int mp = _player->getMP();
+    int recoverCount = _player->getRecoverCount();
+    if (hp == _shownHp && mp == _shownMp && recoverCount == _shownRecoverCount)
+        return;
+
+    _refreshCount++;
+
+    if (hp != _shownHp) {
+        _shownHp = hp;
+        _hpFill->setScaleX(clampf((float)hp / PLAYER_MAX_HP, 0.0f, 1.0f));
+    }
+
+    if (mp != _shownMp) {
+        _shownMp = mp;
+        _mpFill->setScaleX(clampf((float)mp / _player->getMaxMP(), 0.0f, 1.0f));
+    }
+
+    if (recoverCount != _shownRecoverCount) {
+        _shownRecoverCount = recoverCount;
+        for (int i = 0; i < 5; ++i) {
+            _recoverPips[i]->setVisible(i < recoverCount);
+        }
+    }
+}
+
+void GameHUD::refreshBoss()
+{
+    int hp = _boss->getCurrentBlood();
+    if (hp == _shownBossHp)
+        return;
+
+    _refreshCount++;
+    _shownBossHp = hp;
+
+    // Boss已死（或血量耗尽）：隐藏血条
+    if (hp <= 0 || _boss->IsDead()) {
+        _bossContainer->setVisible(false);
+        return;
+    }
+    _bossContainer->setVisible(true);
+
+    float percent = clampf((float)hp / _boss->getMaxBlood(), 0.0f, 1.0f);
+    _bossFill->setScaleX(percent);
+    _bossRageFill->setScaleX(percent);
+
+    // 阶段切换：只在状态变化时改颜色与文字
+    bool isRage = percent < 0.5f;
+    if (isRage != _isBossRage) {
+        _isBossRage = isRage;
+        _bossFill->setVisible(!isRage);
+        _bossRageFill->setVisible(isRage);
+        if (isRage) {
+            _bossNameLabel->setString("BOSS - MAW (RAGE MODE)");
+            _bossNameLabel->setColor(Color3B::RED);
+        }
+        else {
+            _bossNameLabel->setString("BOSS - MUTANT");
+            _bossNameLabel->setColor(Color3B::WHITE);
+            _bossContainer->setPosition(Vec2::ZERO); // 恢复原位
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "cocos2d.h"
+
+class Maria;
+class Boss;
+
+/**
+ * 战斗HUD（保留模式）
+ * 血条、法条、回血道具与Boss血条的几何在创建时只绘制一次：
+ * - 条形以左端为原点，按比例 setScaleX，只改变节点变换，不重建顶点
+ * - 回血道具为预先绘制的五个圆点，按剩余次数切换可见性
+ * - Boss名称只在进入/退出狂暴时 setString，避免每帧重排字形
+ * 刷新由 Maria / Boss 的状态变化回调驱动，数值没有变化的帧不做任何刷新
+ */
+class GameHUD : public cocos2d::Node
+{
+public:
+    CREATE_FUNC(GameHUD);
+
+    virtual bool init() override;
+
+    /**
+     * 绑定玩家：注册状态变化回调并立即刷新一次
+     * @param player 玩家角色
+     */
+    void bindPlayer(Maria* player);
+
+    /**
+     * 绑定Boss：注册血量变化回调并显示Boss血条，传入nullptr则隐藏
+     * @param boss Boss对象
+     */
+    void bindBoss(Boss* boss);
+
+    /**
+     * 表现层更新（由场景每帧调用）
+     * 仅处理狂暴状态下Boss血条的抖动，只改变容器位置
+     */
+    virtual void update(float dt) override;
+
+    /** 数值变化导致的实际刷新次数（无变化的帧应保持不变） */
+    unsigned int getRefreshCount() const { return _refreshCount; }
+
+private:
+    void refreshPlayer();
+    void refreshBoss();
+
+    static cocos2d::DrawNode* createBar(float width, float height, const cocos2d::Color4F& color);
+
+    Maria* _player = nullptr;
+    Boss* _boss = nullptr;
+
+    // 玩家
+    cocos2d::DrawNode* _hpFill = nullptr;
+    cocos2d::DrawNode* _mpFill = nullptr;
+    cocos2d::DrawNode* _recoverPips[5] = {};
+    int _shownHp = -1;
+    int _shownMp = -1;
+    int _shownRecoverCount = -1;
+
+    // Boss
+    cocos2d::Node* _bossContainer = nullptr;
+    cocos2d::DrawNode* _bossFill = nullptr;       // 普通状态（红色）
+    cocos2d::DrawNode* _bossRageFill = nullptr;   // 狂暴状态（紫红色）
+    cocos2d::Label* _bossNameLabel = nullptr;
+    int _shownBossHp = -1;
+    bool _isBossRage = false;
+
+    unsigned int _refreshCount = 0;
+
+    const int PLAYER_MAX_HP = 180;         // 与 Maria 回血上限一致
+    const float HP_BAR_WIDTH = 200.0f;
+    const float MP_BAR_WIDTH = 150.0f;
+    const float BOSS_BAR_HALF_WIDTH = 300.0f;
+    const float BOSS_BAR_HEIGHT = 25.0f;
+    const float BOSS_BAR_MARGIN_BOTTOM = 60.0f;
+};